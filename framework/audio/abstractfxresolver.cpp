@@ -68,6 +68,20 @@ void AbstractFxResolver::refresh()
 {
 }
 
+void AbstractFxResolver::clearFx(const TrackId trackId)
+{
+    auto it = m_tracksFxMap.find(trackId);
+    if (it == m_tracksFxMap.end()) {
+        return;
+    }
+
+    for (const auto& pair : it->second) {
+        removeTrackFx(trackId, pair.second->params().resourceMeta.id, pair.first);
+    }
+
+    m_tracksFxMap.erase(it);
+}
+
 void AbstractFxResolver::clearAllFx()
 {
     m_tracksFxMap.clear();
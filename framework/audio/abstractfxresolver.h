@@ -36,6 +36,7 @@ public:
     std::vector<IFxProcessorPtr> resolveFxList(const TrackId trackId, const AudioFxChain& fxChain) override;
     std::vector<IFxProcessorPtr> resolveMasterFxList(const AudioFxChain& fxChain) override;
     void refresh() override;
+    void clearFx(const TrackId trackId) override;
     void clearAllFx() override;
 
 protected:
@@ -59,6 +59,7 @@ enum class Err {
     NoAudioToExport = 349,
     ErrorEncode = 350,
     UnknownPluginType = 351,
+    PluginLoadingTimeout = 352,
 
     // clock
     InvalidTimeLoop = 360,
@@ -0,0 +1,156 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiometer.h"
+
+#include <algorithm>
+
+using namespace muse::audio;
+
+AudioMeter::AudioMeter()
+{
+    resetLoudness();
+}
+
+void AudioMeter::setSampleRate(unsigned int sampleRate)
+{
+    m_peakHoldSamples = static_cast<samples_t>(sampleRate * PEAK_HOLD_SECONDS);
+}
+
+void AudioMeter::setChannelsCount(audioch_t channels)
+{
+    m_channelsCount.store(std::min(channels, MAX_CHANNELS), std::memory_order_release);
+}
+
+void AudioMeter::update(audioch_t audioChNum, float peak, float rms, samples_t samplesCount)
+{
+    if (audioChNum >= MAX_CHANNELS) {
+        return;
+    }
+
+    HoldState& hold = m_holdStates[audioChNum];
+
+    if (peak >= hold.peakHold || hold.heldSamples >= m_peakHoldSamples) {
+        hold.peakHold = peak;
+        hold.heldSamples = 0;
+    } else {
+        hold.heldSamples += samplesCount;
+    }
+
+    m_isReset = false;
+    publish(m_slots[audioChNum], { peak, rms, hold.peakHold });
+}
+
+void AudioMeter::updateLoudness(float momentaryLufs, float shortTermLufs, float integratedLufs, float truePeak)
+{
+    publish(m_loudnessSlot, { momentaryLufs, shortTermLufs, integratedLufs, toDbfs(truePeak) });
+}
+
+void AudioMeter::reset()
+{
+    if (m_isReset) {
+        return;
+    }
+
+    for (audioch_t audioChNum = 0; audioChNum < MAX_CHANNELS; ++audioChNum) {
+        m_holdStates[audioChNum] = HoldState();
+        publish(m_slots[audioChNum], { 0.f, 0.f, 0.f });
+    }
+
+    m_isReset = true;
+}
+
+void AudioMeter::resetLoudness()
+{
+    const float minimum = MINIMUM_OPERABLE_DBFS_LEVEL;
+    publish(m_loudnessSlot, { minimum, minimum, minimum, minimum });
+}
+
+audioch_t AudioMeter::channelsCount() const
+{
+    return m_channelsCount.load(std::memory_order_acquire);
+}
+
+AudioMeterValue AudioMeter::value(audioch_t audioChNum) const
+{
+    if (audioChNum >= MAX_CHANNELS) {
+        return AudioMeterValue();
+    }
+
+    const std::array<float, 3> values = read(m_slots[audioChNum]);
+
+    return AudioMeterValue { values[0], values[1], values[2] };
+}
+
+AudioLoudnessValue AudioMeter::loudness() const
+{
+    const std::array<float, 4> values = read(m_loudnessSlot);
+
+    return AudioLoudnessValue { values[0], values[1], values[2], values[3] };
+}
+
+volume_dbfs_t AudioMeter::toDbfs(float amplitude)
+{
+    if (amplitude <= 0.f) {
+        return MINIMUM_OPERABLE_DBFS_LEVEL;
+    }
+
+    return std::max(volume_dbfs_t(muse::linear_to_db(amplitude)), MINIMUM_OPERABLE_DBFS_LEVEL);
+}
+
+template<size_t N>
+void AudioMeter::publish(Slot<N>& slot, const std::array<float, N>& values)
+{
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < N; ++i) {
+        slot.values[i].store(values[i], std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+template<size_t N>
+std::array<float, N> AudioMeter::read(const Slot<N>& slot)
+{
+    std::array<float, N> result;
+
+    //! NOTE An odd sequence means the worker is in the middle of publishing; a changed one means the read was torn
+    for (;;) {
+        uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+
+        for (size_t i = 0; i < N; ++i) {
+            result[i] = slot.values[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (slot.sequence.load(std::memory_order_relaxed) == before) {
+            return result;
+        }
+    }
+}
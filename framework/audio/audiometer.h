@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_AUDIOMETER_H
+#define MUSE_AUDIO_AUDIOMETER_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "audiotypes.h"
+
+namespace muse::audio {
+struct AudioMeterValue {
+    float peak = 0.f;
+    float rms = 0.f;
+    float peakHold = 0.f;
+};
+
+//! NOTE EBU R128 loudness of the whole bus, published only while the loudness analysis is enabled
+struct AudioLoudnessValue {
+    float momentaryLufs = MINIMUM_OPERABLE_DBFS_LEVEL;
+    float shortTermLufs = MINIMUM_OPERABLE_DBFS_LEVEL;
+    float integratedLufs = MINIMUM_OPERABLE_DBFS_LEVEL;
+    float truePeakDbtp = MINIMUM_OPERABLE_DBFS_LEVEL;
+};
+
+//! NOTE Fixed-size bank of per-channel meter slots shared between the audio worker and the UI.
+//! The worker is the only writer; readers poll values at their own rate through a seqlock,
+//! so publishing a block never allocates, locks or queues anything on the audio thread
+class AudioMeter
+{
+public:
+    static constexpr audioch_t MAX_CHANNELS = 8;
+    static constexpr float PEAK_HOLD_SECONDS = 1.5f;
+
+    AudioMeter();
+    AudioMeter(const AudioMeter&) = delete;
+    AudioMeter& operator=(const AudioMeter&) = delete;
+
+    // worker side
+    void setSampleRate(unsigned int sampleRate);
+    void setChannelsCount(audioch_t channels);
+    void update(audioch_t audioChNum, float peak, float rms, samples_t samplesCount);
+    void updateLoudness(float momentaryLufs, float shortTermLufs, float integratedLufs, float truePeak);
+    void reset();
+    void resetLoudness();
+
+    // reader side
+    audioch_t channelsCount() const;
+    AudioMeterValue value(audioch_t audioChNum) const;
+    AudioLoudnessValue loudness() const;
+
+    static volume_dbfs_t toDbfs(float amplitude);
+
+private:
+    template<size_t N>
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> sequence = 0;
+        std::array<std::atomic<float>, N> values = {};
+    };
+
+    using ValueSlot = Slot<3>;    // peak, rms, peak-hold
+    using LoudnessSlot = Slot<4>; // momentary, short-term, integrated, true-peak
+
+    struct HoldState {
+        float peakHold = 0.f;
+        samples_t heldSamples = 0;
+    };
+
+    template<size_t N>
+    static void publish(Slot<N>& slot, const std::array<float, N>& values);
+
+    template<size_t N>
+    static std::array<float, N> read(const Slot<N>& slot);
+
+    std::array<ValueSlot, MAX_CHANNELS> m_slots;
+    LoudnessSlot m_loudnessSlot;
+    std::atomic<audioch_t> m_channelsCount = 0;
+
+    std::array<HoldState, MAX_CHANNELS> m_holdStates;
+    samples_t m_peakHoldSamples = 0;
+    bool m_isReset = true;
+};
+
+using AudioMeterPtr = std::shared_ptr<AudioMeter>;
+}
+
+#endif // MUSE_AUDIO_AUDIOMETER_H
@@ -212,6 +212,12 @@ void AudioModule::onInit(const IApplication::RunMode& mode)
 
     m_audioBuffer->init(m_configuration->audioChannelsCount());
 
+    //! NOTE The worker refills the buffer as soon as the driver has consumed it,
+    //! the worker interval is only a fallback
+    m_audioBuffer->setOnReserveLow([this]() {
+        m_audioWorker->wake();
+    });
+
     m_audioOutputController->init();
 
     // Setup audio driver
@@ -257,16 +263,19 @@ void AudioModule::setupAudioDriver(const IApplication::RunMode& mode)
 
     if (m_configuration->shouldMeasureInputLag()) {
         requiredSpec.callback = [this](void* /*userdata*/, uint8_t* stream, int byteCount) {
-            auto samplesPerChannel = byteCount / (2 * sizeof(float));  // 2 == m_configuration->audioChannelsCount()
+            auto samplesPerChannel = byteCount / (m_audioBuffer->audioChannelCount() * sizeof(float));
             float* dest = reinterpret_cast<float*>(stream);
             m_audioBuffer->pop(dest, samplesPerChannel);
             measureInputLag(dest, samplesPerChannel * m_audioBuffer->audioChannelCount());
         };
     } else {
         requiredSpec.callback = [this](void* /*userdata*/, uint8_t* stream, int byteCount) {
-            auto samplesPerChannel = byteCount / (2 * sizeof(float));
+            auto samplesPerChannel = byteCount / (m_audioBuffer->audioChannelCount() * sizeof(float));
             m_audioBuffer->pop(reinterpret_cast<float*>(stream), samplesPerChannel);
         };
+        requiredSpec.planarCallback = [this](void* /*userdata*/, float* const* channels, int samplesPerChannel) {
+            m_audioBuffer->popPlanar(channels, samplesPerChannel);
+        };
     }
 
     if (mode == IApplication::RunMode::GuiApp) {
@@ -87,12 +87,29 @@ enum class SoundTrackType {
     WAV
 };
 
+//! NOTE Scales the whole export to the target EBU R128 integrated loudness,
+//! the gain is lowered if the true-peak would exceed the ceiling
+struct SoundTrackNormalization {
+    bool enabled = false;
+    float targetLufs = -14.f;
+    float truePeakCeilingDbtp = -1.f;
+
+    bool operator==(const SoundTrackNormalization& other) const
+    {
+        return enabled == other.enabled
+               && muse::is_equal(targetLufs, other.targetLufs)
+               && muse::is_equal(truePeakCeilingDbtp, other.truePeakCeilingDbtp);
+    }
+};
+
 struct SoundTrackFormat {
     SoundTrackType type = SoundTrackType::Undefined;
     sample_rate_t sampleRate = 0;
     samples_t samplesPerChannel = 0;
     audioch_t audioChannelsNumber = 0;
     int bitRate = 0;
+    int bitDepth = 0; // lossless integer formats, 0 selects the default of the encoder (16 bit)
+    SoundTrackNormalization normalization;
 
     bool operator==(const SoundTrackFormat& other) const
     {
@@ -100,7 +117,9 @@ struct SoundTrackFormat {
                && sampleRate == other.sampleRate
                && audioChannelsNumber == other.audioChannelsNumber
                && samplesPerChannel == other.samplesPerChannel
-               && bitRate == other.bitRate;
+               && bitRate == other.bitRate
+               && bitDepth == other.bitDepth
+               && normalization == other.normalization;
     }
 
     bool isValid() const
@@ -340,53 +359,7 @@ struct AudioParams {
     AudioOutputParams out;
 };
 
-struct AudioSignalVal {
-    float amplitude = 0.f;
-    volume_dbfs_t pressure = 0.f;
-};
-
-using AudioSignalValuesMap = std::map<audioch_t, AudioSignalVal>;
-using AudioSignalChanges = async::Channel<AudioSignalValuesMap>;
-
 static constexpr volume_dbfs_t MINIMUM_OPERABLE_DBFS_LEVEL = volume_dbfs_t::make(-100.f);
-struct AudioSignalsNotifier {
-    void updateSignalValues(const audioch_t audioChNumber, const float newAmplitude)
-    {
-        volume_dbfs_t newPressure = (newAmplitude > 0.f) ? volume_dbfs_t(muse::linear_to_db(newAmplitude)) : MINIMUM_OPERABLE_DBFS_LEVEL;
-        newPressure = std::max(newPressure, MINIMUM_OPERABLE_DBFS_LEVEL);
-
-        AudioSignalVal& signalVal = m_signalValuesMap[audioChNumber];
-
-        if (muse::is_equal(signalVal.pressure, newPressure)) {
-            return;
-        }
-
-        if (std::abs(signalVal.pressure - newPressure) < PRESSURE_MINIMAL_VALUABLE_DIFF) {
-            return;
-        }
-
-        signalVal.amplitude = newAmplitude;
-        signalVal.pressure = newPressure;
-
-        m_needNotifyAboutChanges = true;
-    }
-
-    void notifyAboutChanges()
-    {
-        if (m_needNotifyAboutChanges) {
-            audioSignalChanges.send(m_signalValuesMap);
-            m_needNotifyAboutChanges = false;
-        }
-    }
-
-    AudioSignalChanges audioSignalChanges;
-
-private:
-    static constexpr volume_dbfs_t PRESSURE_MINIMAL_VALUABLE_DIFF = volume_dbfs_t::make(2.5f);
-
-    AudioSignalValuesMap m_signalValuesMap;
-    bool m_needNotifyAboutChanges = false;
-};
 
 enum class PlaybackStatus {
     Stopped = 0,
@@ -436,6 +409,11 @@ enum class RenderMode {
     IdleMode,
     OfflineMode
 };
+
+enum class AudioThreadPoolType {
+    TaskQueue = 0,  // muse::TaskScheduler, a task queue guarded by a mutex
+    WorkStealing    // muse::WorkStealingScheduler, lock-free fork/join
+};
 }
 
 #endif // MUSE_AUDIO_AUDIOTYPES_H
@@ -64,6 +64,11 @@ public:
 
     virtual size_t desiredAudioThreadNumber() const = 0;
     virtual size_t minTrackCountForMultithreading() const = 0;
+    virtual AudioThreadPoolType audioThreadPoolType() const = 0;
+
+    virtual bool masterLimiterEnabled() const = 0;
+    virtual void setMasterLimiterEnabled(bool enabled) = 0;
+    virtual async::Channel<bool> masterLimiterEnabledChanged() const = 0;
 
     // synthesizers
     virtual AudioInputParams defaultAudioInputParams() const = 0;
@@ -47,6 +47,7 @@ public:
     };
 
     using Callback = std::function<void (void* userdata, uint8_t* stream, int len)>;
+    using PlanarCallback = std::function<void (void* userdata, float* const* channels, int samplesPerChannel)>;
 
     struct Spec
     {
@@ -55,6 +56,7 @@ public:
         uint8_t channels;             // Number of channels: 1 mono, 2 stereo
         uint16_t samples;             // Audio buffer size in sample FRAMES (total samples divided by channel count)
         Callback callback;            // Callback that feeds the audio device
+        PlanarCallback planarCallback; // Optional, feeds one float buffer per channel, for devices with non-interleaved ports
         void* userdata;               // Userdata passed to callback (ignored for NULL callbacks).
     };
 
@@ -30,6 +30,7 @@
 #include "global/async/channel.h"
 
 #include "audiotypes.h"
+#include "audiometer.h"
 
 namespace muse::audio {
 class IAudioOutput
@@ -48,8 +49,13 @@ public:
 
     virtual async::Promise<AudioResourceMetaList> availableOutputResources() const = 0;
 
-    virtual async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const = 0;
-    virtual async::Promise<AudioSignalChanges> masterSignalChanges() const = 0;
+    //! NOTE The meters are written by the audio worker and are meant to be polled, e.g. at the UI frame rate
+    virtual async::Promise<AudioMeterPtr> audioMeter(const TrackSequenceId sequenceId, const TrackId trackId) const = 0;
+    virtual async::Promise<AudioMeterPtr> masterAudioMeter() const = 0;
+
+    //! NOTE Publishes the EBU R128 loudness and the true-peak through the meter, see AudioMeter::loudness
+    virtual void setLoudnessAnalysisEnabled(const TrackSequenceId sequenceId, const TrackId trackId, bool enabled) = 0;
+    virtual void setMasterLoudnessAnalysisEnabled(bool enabled) = 0;
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
@@ -48,6 +48,15 @@ public:
 
     //! move buffer forward for sampleCount samples
     virtual samples_t process(float* buffer, samples_t samplesPerChannel) = 0;
+
+    //! NOTE A source which renders non-interleaved audio natively also provides the planar mode:
+    //! buffers holds audioChannelsCount() pointers to samplesPerChannel samples each, zeroed by the caller
+    virtual bool supportsPlanarProcessing() const { return false; }
+    virtual samples_t processPlanar(float* const* /*buffers*/, samples_t /*samplesPerChannel*/) { return 0; }
+
+    //! NOTE False while the source is still being loaded asynchronously (e.g. a plugin on the main thread),
+    //! until then it outputs silence. May be called from any thread
+    virtual bool isReady() const { return true; }
 };
 
 using IAudioSourcePtr = std::shared_ptr<IAudioSource>;
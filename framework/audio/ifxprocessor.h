@@ -41,6 +41,14 @@ public:
     virtual void setActive(bool active) = 0;
 
     virtual void process(float* buffer, unsigned int sampleCount) = 0;
+
+    //! NOTE Same as process(), on one buffer per audio channel
+    virtual bool supportsPlanarProcessing() const { return false; }
+    virtual void processPlanar(float* const* /*buffers*/, unsigned int /*sampleCount*/) {}
+
+    //! NOTE False while the fx is still being loaded asynchronously, until then it passes the input through.
+    //! May be called from any thread
+    virtual bool isReady() const { return true; }
 };
 
 using IFxProcessorPtr = std::shared_ptr<IFxProcessor>;
@@ -47,6 +47,7 @@ public:
         virtual std::vector<IFxProcessorPtr> resolveMasterFxList(const AudioFxChain& fxChain) = 0;
         virtual AudioResourceMetaList resolveResources() const = 0;
         virtual void refresh() = 0;
+        virtual void clearFx(const audio::TrackId trackId) = 0;
         virtual void clearAllFx() = 0;
     };
     using IResolverPtr = std::shared_ptr<IResolver>;
@@ -55,6 +56,7 @@ public:
     virtual std::vector<IFxProcessorPtr> resolveFxList(const TrackId trackId, const AudioFxChain& fxChain) = 0;
     virtual AudioResourceMetaList resolveAvailableResources() const = 0;
     virtual void registerResolver(const AudioFxType type, IResolverPtr resolver) = 0;
+    virtual void clearFx(const TrackId trackId) = 0;
     virtual void clearAllFx() = 0;
 };
 
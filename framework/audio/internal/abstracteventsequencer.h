@@ -23,13 +23,11 @@
 #ifndef MUSE_AUDIO_ABSTRACTEVENTSEQUENCER_H
 #define MUSE_AUDIO_ABSTRACTEVENTSEQUENCER_H
 
-#include <map>
-#include <set>
-
 #include "global/async/asyncable.h"
 #include "mpe/events.h"
 
 #include "audiosanitizer.h"
+#include "eventtimeline.h"
 #include "../audiotypes.h"
 
 namespace muse::audio {
@@ -38,15 +36,14 @@ class AbstractEventSequencer : public async::Asyncable
 {
 public:
     using EventType = std::variant<Types...>;
-    using EventSequence = std::set<EventType>;
-    using EventSequenceMap = std::map<msecs_t, EventSequence>;
-
-    typedef typename EventSequenceMap::const_iterator SequenceIterator;
-    typedef typename EventSequence::const_iterator EventIterator;
+    using TimedEvent = audio::TimedEvent<EventType>;
+    using EventTimeline = audio::EventTimeline<EventType>;
+    using EventSpan = audio::EventSpan<EventType>;
 
     virtual ~AbstractEventSequencer()
     {
         m_playbackData.mainStream.resetOnReceive(this);
+        m_playbackData.mainStreamDelta.resetOnReceive(this);
         m_playbackData.offStream.resetOnReceive(this);
     }
 
@@ -69,6 +66,10 @@ public:
             }
         });
 
+        m_playbackData.mainStreamDelta.onReceive(this, [this](const mpe::MainStreamDelta& delta) {
+            updateMainStreamDelta(delta);
+        });
+
         m_playbackData.offStream.onReceive(this, [this](const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) {
             updateOffStreamEvents(events, params);
         });
@@ -81,6 +82,29 @@ public:
         return m_playbackData;
     }
 
+    //! NOTE Splices the changed range into the current events if the sequencer supports it,
+    //! otherwise falls back to the full update
+    void updateMainStreamDelta(const mpe::MainStreamDelta& delta)
+    {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        //! NOTE Checked against the data before the change
+        const bool canUpdateRange = !m_shouldUpdateMainStreamEvents && canUpdateMainStreamRange(delta);
+
+        m_playbackData.applyDelta(delta);
+
+        if (canUpdateRange) {
+            updateMainStreamRange(delta);
+            return;
+        }
+
+        m_shouldUpdateMainStreamEvents = true;
+
+        if (m_isActive) {
+            updateMainStream();
+        }
+    }
+
     void updateMainStream()
     {
         if (m_shouldUpdateMainStreamEvents) {
@@ -91,14 +115,12 @@ public:
 
     void flushOffstream()
     {
-        if (m_offStreamEvents.empty()) {
-            return;
-        }
+        bool hasPendingEvents = m_offStreamCursor < m_offStreamEvents.size();
 
         m_offStreamEvents.clear();
-        updateOffSequenceIterator();
+        updateOffStreamCursor();
 
-        if (m_onOffStreamFlushed) {
+        if (hasPendingEvents && m_onOffStreamFlushed) {
             m_onOffStreamFlushed();
         }
     }
@@ -126,7 +148,7 @@ public:
         ONLY_AUDIO_WORKER_THREAD;
 
         m_playbackPosition = newPlaybackPosition;
-        resetAllIterators();
+        resetAllCursors();
     }
 
     msecs_t playbackPosition() const
@@ -165,37 +187,40 @@ public:
         return mpe::dynamicLevelFromType(muse::mpe::DynamicType::Natural);
     }
 
-    EventSequenceMap movePlaybackForward(const msecs_t nextMsecs)
+    //! NOTE Returns the events up to the new position. The span points into the timeline,
+    //! it stays valid until the events are updated, i.e. during the current render block
+    EventSpan movePlaybackForward(const msecs_t nextMsecs)
     {
         ONLY_AUDIO_WORKER_THREAD;
 
-        EventSequenceMap result;
-
         if (!m_isActive) {
-            result.emplace(m_offstreamPosition, EventSequence());
-
-            if (m_currentOffSequenceIt == m_offStreamEvents.cend()) {
-                return result;
+            if (m_offStreamCursor >= m_offStreamEvents.size()) {
+                return makeSpan(m_offStreamEvents, m_offstreamPosition, m_offstreamPosition, m_offStreamCursor, m_offStreamCursor);
             }
 
+            msecs_t from = m_offstreamPosition;
             m_offstreamPosition += nextMsecs;
-            handleOffStream(result);
 
-            return result;
-        }
+            size_t first = m_offStreamCursor;
+            m_offStreamCursor = m_offStreamEvents.upperBound(first, m_offstreamPosition);
 
-        // Empty sequence means to continue the previous sequence
-        result.emplace(m_playbackPosition, EventSequence());
-        m_playbackPosition += nextMsecs;
+            EventSpan span = makeSpan(m_offStreamEvents, from, m_offstreamPosition, first, m_offStreamCursor);
+
+            //! NOTE The timeline itself is cleared on the next update, the span still points into it
+            if (m_offStreamCursor >= m_offStreamEvents.size()) {
+                m_offstreamPosition = 0;
+            }
 
-        if (m_currentMainSequenceIt == m_mainStreamEvents.cend()) {
-            return result;
+            return span;
         }
 
-        handleMainStream(result);
-        handleDynamicChanges(result);
+        msecs_t from = m_playbackPosition;
+        m_playbackPosition += nextMsecs;
+
+        size_t first = m_mainStreamCursor;
+        m_mainStreamCursor = m_mainStreamEvents.upperBound(first, m_playbackPosition);
 
-        return result;
+        return makeSpan(m_mainStreamEvents, from, m_playbackPosition, first, m_mainStreamCursor);
     }
 
 protected:
@@ -203,85 +228,58 @@ protected:
     virtual void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                         const mpe::PlaybackParamLayers& params) = 0;
 
-    void resetAllIterators()
+    //! NOTE Whether updateMainStreamRange() can handle the delta, otherwise the whole main stream is rebuilt
+    virtual bool canUpdateMainStreamRange(const mpe::MainStreamDelta&) const
     {
-        updateMainSequenceIterator();
-        updateOffSequenceIterator();
-        updateDynamicChangesIterator();
+        return false;
     }
 
-    void updateMainSequenceIterator()
+    //! NOTE Replaces the events generated from the source events within the delta range
+    virtual void updateMainStreamRange(const mpe::MainStreamDelta&)
     {
-        m_currentMainSequenceIt = m_mainStreamEvents.lower_bound(m_playbackPosition);
     }
 
-    void updateOffSequenceIterator()
+    void resetAllCursors()
     {
-        m_currentOffSequenceIt = m_offStreamEvents.cbegin();
-        m_offstreamPosition = 0;
+        m_mainStreamCursor = m_mainStreamEvents.lowerBound(m_playbackPosition);
+        updateOffStreamCursor();
     }
 
-    void updateDynamicChangesIterator()
+    //! NOTE Must be called after the main stream events have been added
+    void updateMainStreamCursor()
     {
-        m_currentDynamicsIt = m_dynamicEvents.lower_bound(m_playbackPosition);
+        m_mainStreamEvents.sort();
+        m_mainStreamCursor = m_mainStreamEvents.lowerBound(m_playbackPosition);
     }
 
-    void handleOffStream(EventSequenceMap& result)
+    //! NOTE Must be called after the off stream events have been added
+    void updateOffStreamCursor()
     {
-        if (m_offStreamEvents.empty()) {
-            return;
-        }
-
-        while (m_currentOffSequenceIt != m_offStreamEvents.end()
-               && m_currentOffSequenceIt->first <= m_offstreamPosition) {
-            EventSequence& sequence = result[m_currentOffSequenceIt->first];
-            sequence.insert(m_currentOffSequenceIt->second.cbegin(),
-                            m_currentOffSequenceIt->second.cend());
-            m_currentOffSequenceIt = std::next(m_currentOffSequenceIt);
-        }
-
-        if (m_currentOffSequenceIt == m_offStreamEvents.end()) {
-            m_offStreamEvents.clear();
-            updateOffSequenceIterator();
-        }
-    }
-
-    void handleMainStream(EventSequenceMap& result)
-    {
-        while (m_currentMainSequenceIt != m_mainStreamEvents.end()
-               && m_currentMainSequenceIt->first <= m_playbackPosition) {
-            EventSequence& sequence = result[m_currentMainSequenceIt->first];
-            sequence.insert(m_currentMainSequenceIt->second.cbegin(),
-                            m_currentMainSequenceIt->second.cend());
-            m_currentMainSequenceIt = std::next(m_currentMainSequenceIt);
-        }
+        m_offStreamEvents.sort();
+        m_offStreamCursor = 0;
+        m_offstreamPosition = 0;
     }
 
-    void handleDynamicChanges(EventSequenceMap& result)
+    static EventSpan makeSpan(const EventTimeline& timeline, const msecs_t from, const msecs_t to, const size_t first, const size_t last)
     {
-        if (m_dynamicEvents.empty()) {
-            return;
-        }
+        EventSpan span;
+        span.from = from;
+        span.to = to;
+        span.first = timeline.data() + first;
+        span.last = timeline.data() + last;
 
-        while (m_currentDynamicsIt != m_dynamicEvents.end()
-               && m_currentDynamicsIt->first <= m_playbackPosition) {
-            EventSequence& sequence = result[m_currentDynamicsIt->first];
-            sequence.insert(m_currentDynamicsIt->second.cbegin(),
-                            m_currentDynamicsIt->second.cend());
-            m_currentDynamicsIt = std::next(m_currentDynamicsIt);
-        }
+        return span;
     }
 
     mutable msecs_t m_playbackPosition = 0;
     mutable msecs_t m_offstreamPosition = 0;
 
-    SequenceIterator m_currentMainSequenceIt;
-    SequenceIterator m_currentOffSequenceIt;
-    SequenceIterator m_currentDynamicsIt;
+    size_t m_mainStreamCursor = 0;
+    size_t m_offStreamCursor = 0;
 
-    EventSequenceMap m_mainStreamEvents;
-    EventSequenceMap m_offStreamEvents;
-    EventSequenceMap m_dynamicEvents;
+    //! NOTE The main stream also contains the dynamic changes
+    EventTimeline m_mainStreamEvents;
+    EventTimeline m_offStreamEvents;
 
     mpe::PlaybackData m_playbackData;
 
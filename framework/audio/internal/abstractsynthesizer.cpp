@@ -35,7 +35,9 @@ AbstractSynthesizer::AbstractSynthesizer(const AudioInputParams& params, const m
     ONLY_AUDIO_WORKER_THREAD;
 
     audioEngine()->modeChanged().onNotify(this, [this]() {
-        updateRenderingMode(audioEngine()->mode());
+        if (!m_fixedRenderMode) {
+            updateRenderingMode(audioEngine()->mode());
+        }
     });
 }
 
@@ -68,6 +70,18 @@ void AbstractSynthesizer::revokePlayingNotes()
     ONLY_AUDIO_WORKER_THREAD;
 }
 
+void AbstractSynthesizer::setFixedRenderMode(const RenderMode mode)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_fixedRenderMode == mode) {
+        return;
+    }
+
+    m_fixedRenderMode = mode;
+    updateRenderingMode(mode);
+}
+
 void AbstractSynthesizer::updateRenderingMode(const RenderMode /*mode*/)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -77,6 +91,10 @@ RenderMode AbstractSynthesizer::currentRenderMode() const
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    if (m_fixedRenderMode) {
+        return m_fixedRenderMode.value();
+    }
+
     return audioEngine()->mode();
 }
 
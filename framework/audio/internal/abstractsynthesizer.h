@@ -23,6 +23,8 @@
 #ifndef MUSE_AUDIO_ISYNTHESIZER_H
 #define MUSE_AUDIO_ISYNTHESIZER_H
 
+#include <optional>
+
 #include "global/async/channel.h"
 #include "global/async/asyncable.h"
 #include "global/modularity/ioc.h"
@@ -51,6 +53,8 @@ public:
 
     void revokePlayingNotes() override;
 
+    void setFixedRenderMode(const RenderMode mode) override;
+
 protected:
 
     virtual void setupSound(const mpe::PlaybackSetupData& setupData) = 0;
@@ -67,6 +71,8 @@ protected:
     audio::AudioInputParams m_params;
     async::Channel<audio::AudioInputParams> m_paramsChanges;
 
+    std::optional<audio::RenderMode> m_fixedRenderMode;
+
     samples_t m_sampleRate = 0;
 };
 }
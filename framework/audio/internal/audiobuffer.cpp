@@ -21,16 +21,18 @@
  */
 #include "audiobuffer.h"
 
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <thread>
+
+#include "dsp/vectorkernels.h"
 
 #include "log.h"
 
 using namespace muse::audio;
 
-static constexpr size_t DEFAULT_SIZE_PER_CHANNEL = 1024 * 8;
-static constexpr size_t DEFAULT_SIZE = DEFAULT_SIZE_PER_CHANNEL * 2;
-
-static const std::vector<float> SILENT_FRAMES(DEFAULT_SIZE, 0.f);
+static const std::array<float, 4096> SILENT_SAMPLES = {};
 
 //#define DEBUG_AUDIO
 #ifdef DEBUG_AUDIO
@@ -39,95 +41,86 @@ static const std::vector<float> SILENT_FRAMES(DEFAULT_SIZE, 0.f);
 #define LOG_AUDIO LOGN
 #endif
 
-inline size_t reservedFrames(const size_t writeIdx, const size_t readIdx)
+//! NOTE Whole frames at a time, so that popPlanar() can deinterleave every part on its own
+template<typename Copy>
+static void copySilentSamples(Copy& copy, size_t destOffset, size_t count, const audioch_t audioChannelsCount)
 {
-    size_t result = 0;
-    if (readIdx <= writeIdx) {
-        result = writeIdx - readIdx;
-    } else {
-        result = writeIdx + DEFAULT_SIZE - readIdx;
-    }
+    const size_t chunk = SILENT_SAMPLES.size() / audioChannelsCount * audioChannelsCount;
 
-    return result;
+    while (count > 0) {
+        const size_t n = std::min(count, chunk);
+        copy(SILENT_SAMPLES.data(), destOffset, n);
+        destOffset += n;
+        count -= n;
+    }
 }
 
-struct BaseBufferProfiler {
-    size_t reservedFramesMax = 0;
-    size_t reservedFramesMin = 0;
-    double elapsedMax = 0.0;
-    double elapsedSum = 0.0;
-    double elapsedMin = 0.0;
-    uint64_t callCount = 0;
-    uint64_t maxCallCount = 0;
-    std::string tag;
-
-    BaseBufferProfiler(std::string&& profileTag, uint64_t profilerMaxCalls)
-        : maxCallCount(profilerMaxCalls), tag(std::move(profileTag)) {}
+void AudioBuffer::init(const audioch_t audioChannelsCount, const samples_t capacityPerChannel)
+{
+    IF_ASSERT_FAILED(audioChannelsCount > 0 && capacityPerChannel > 0) {
+        return;
+    }
 
-    ~BaseBufferProfiler()
-    {
-        if (!stopped()) {
-            return;
-        }
+    m_audioChannelsCount = audioChannelsCount;
+    m_capacity = capacityPerChannel * audioChannelsCount;
+    m_data.assign(m_capacity, 0.f);
+    m_readIndex.store(0, std::memory_order_relaxed);
+    m_writeIndex.store(0, std::memory_order_relaxed);
+
+    m_minSamplesPerChannelToReserve = capacityPerChannel / 4;
+    m_renderStep = m_minSamplesPerChannelToReserve;
+    m_adaptiveReserve = AdaptiveReserve();
+    applyReserve(m_minSamplesPerChannelToReserve);
+}
 
-        std::cout << "\n BUFFER PROFILE:    " << tag;
-        std::cout << "\n reservedFramesMax: " << reservedFramesMax;
-        std::cout << "\n reservedFramesMin: " << reservedFramesMin;
-        std::cout << "\n elapsedMax:        " << elapsedMax;
-        std::cout << "\n elapsedMin:        " << elapsedMin;
-        std::cout << "\n elapsedAvg:        " << elapsedSum / callCount;
-        std::cout << "\n total call count:  " << callCount;
-        std::cout << "\n ===================\n";
+template<typename Func>
+void AudioBuffer::withStorageLocked(Func func)
+{
+    //! NOTE Pairs with the check in popSamples(): either the driver sees the lock and plays silence,
+    //! or we see it popping and wait for the end of that one pop
+    m_storageLocked.store(true, std::memory_order_seq_cst);
+    while (m_popping.load(std::memory_order_seq_cst)) {
+        std::this_thread::yield();
     }
 
-    void add(size_t reservedFrames, double elapsed)
-    {
-        if (maxCallCount != 0 && callCount > maxCallCount) {
-            return;
-        }
+    func();
 
-        callCount++;
-
-        if (callCount == 1) {
-            reservedFramesMin = reservedFrames;
-            elapsedMin = elapsed;
-        } else {
-            reservedFramesMin = std::min(reservedFrames, reservedFramesMin);
-            elapsedMin = std::min(elapsed, elapsedMin);
-        }
+    m_storageLocked.store(false, std::memory_order_release);
+}
 
-        reservedFramesMax = std::max(reservedFrames, reservedFramesMax);
-        elapsedMax = std::max(elapsed, elapsedMax);
-        elapsedSum += elapsed;
+void AudioBuffer::resize(const samples_t capacityPerChannel)
+{
+    IF_ASSERT_FAILED(m_audioChannelsCount > 0 && capacityPerChannel > 0) {
+        return;
     }
 
-    bool stopped() const
-    {
-        return callCount >= maxCallCount && maxCallCount != 0;
+    const size_t newCapacity = std::max(capacityPerChannel, requiredCapacityPerChannel()) * m_audioChannelsCount;
+    if (newCapacity == m_capacity) {
+        return;
     }
 
-    void stop()
-    {
-        if (stopped()) {
-            return;
-        }
+    //! NOTE Both the allocation and the release happen here, on the worker thread
+    std::vector<float> data(newCapacity, 0.f);
 
-        maxCallCount = callCount - 1;
-        LOGD() << "\n PROFILE STOP";
-    }
-};
+    withStorageLocked([this, &data, newCapacity]() {
+        const size_t readIdx = m_readIndex.load(std::memory_order_relaxed);
+        const size_t writeIdx = m_writeIndex.load(std::memory_order_relaxed);
+        const size_t kept = std::min(reservedSamples(writeIdx, readIdx), newCapacity - m_audioChannelsCount);
 
-static BaseBufferProfiler READ_PROFILE("READ_PROFILE", 3000);
-static BaseBufferProfiler WRITE_PROFILE("WRITE_PROFILE", 0);
+        const size_t firstPart = std::min(kept, m_capacity - readIdx);
+        std::copy_n(m_data.data() + readIdx, firstPart, data.data());
+        std::copy_n(m_data.data(), kept - firstPart, data.data() + firstPart);
 
-void AudioBuffer::init(const audioch_t audioChannelsCount)
-{
-    m_audioChannelsCount = audioChannelsCount;
-    m_samplesPerChannel = DEFAULT_SIZE_PER_CHANNEL;
-    m_minSamplesToReserve = DEFAULT_SIZE_PER_CHANNEL / 2;
-    m_renderStep = m_minSamplesToReserve;
+        m_data.swap(data);
+        m_capacity = newCapacity;
+        m_readIndex.store(0, std::memory_order_relaxed);
+        m_writeIndex.store(kept, std::memory_order_relaxed);
+    });
+}
 
-    m_data.resize(m_samplesPerChannel * m_audioChannelsCount, 0.f);
+samples_t AudioBuffer::capacityPerChannel() const
+{
+    return m_audioChannelsCount > 0 ? m_capacity / m_audioChannelsCount : 0;
 }
 
 void AudioBuffer::setSource(IAudioSourcePtr source)
@@ -145,20 +138,127 @@ void AudioBuffer::setSource(IAudioSourcePtr source)
 
 void AudioBuffer::setMinSamplesPerChannelToReserve(const samples_t samplesPerChannel)
 {
-    IF_ASSERT_FAILED(samplesPerChannel > 0 && samplesPerChannel < DEFAULT_SIZE_PER_CHANNEL) {
+    IF_ASSERT_FAILED(samplesPerChannel > 0) {
         return;
     }
 
-    m_minSamplesToReserve = samplesPerChannel * m_audioChannelsCount;
+    m_minSamplesPerChannelToReserve = samplesPerChannel;
+    m_stableSamplesPerChannel = 0;
+    applyReserve(samplesPerChannel);
 }
 
 void AudioBuffer::setRenderStep(const samples_t renderStep)
 {
-    IF_ASSERT_FAILED(renderStep > 0 && renderStep < DEFAULT_SIZE_PER_CHANNEL) {
+    IF_ASSERT_FAILED(renderStep > 0) {
         return;
     }
 
     m_renderStep = renderStep;
+    ensureCapacity();
+}
+
+void AudioBuffer::setAdaptiveReserve(const AdaptiveReserve& adaptiveReserve)
+{
+    m_adaptiveReserve = adaptiveReserve;
+    m_lastUnderrunsCount = underrunsCount();
+    m_stableSamplesPerChannel = 0;
+
+    if (!m_adaptiveReserve.enabled) {
+        applyReserve(m_minSamplesPerChannelToReserve);
+    }
+}
+
+samples_t AudioBuffer::samplesPerChannelToReserve() const
+{
+    return m_audioChannelsCount > 0 ? m_minSamplesToReserve / m_audioChannelsCount : 0;
+}
+
+void AudioBuffer::setOnReserveLow(const OnReserveLow& func)
+{
+    m_onReserveLow = func;
+}
+
+size_t AudioBuffer::reservedSamples(const size_t writeIdx, const size_t readIdx) const
+{
+    if (readIdx <= writeIdx) {
+        return writeIdx - readIdx;
+    }
+
+    return writeIdx + m_capacity - readIdx;
+}
+
+//! NOTE The ring holds the reserve, one render step on top of it,
+//! and one more frame, which is never written, so that the full ring differs from the empty one
+samples_t AudioBuffer::requiredCapacityPerChannel() const
+{
+    return samplesPerChannelToReserve() + m_renderStep + 1;
+}
+
+void AudioBuffer::ensureCapacity()
+{
+    if (m_audioChannelsCount == 0) {
+        return;
+    }
+
+    const samples_t required = requiredCapacityPerChannel();
+    samples_t capacity = std::max<samples_t>(capacityPerChannel(), 1);
+    if (capacity >= required) {
+        return;
+    }
+
+    while (capacity < required) {
+        capacity *= 2;
+    }
+
+    LOGI() << "Buffer capacity per channel: " << capacity;
+
+    resize(capacity);
+}
+
+void AudioBuffer::applyReserve(const samples_t samplesPerChannel)
+{
+    m_minSamplesToReserve = samplesPerChannel * m_audioChannelsCount;
+    ensureCapacity();
+    m_reserveLowWatermark.store(m_minSamplesToReserve, std::memory_order_relaxed);
+}
+
+void AudioBuffer::adaptReserve(const samples_t renderedSamplesPerChannel)
+{
+    if (!m_adaptiveReserve.enabled) {
+        return;
+    }
+
+    const samples_t reserve = samplesPerChannelToReserve();
+    const uint64_t underruns = underrunsCount();
+
+    if (underruns != m_lastUnderrunsCount) {
+        m_lastUnderrunsCount = underruns;
+        m_stableSamplesPerChannel = 0;
+
+        const samples_t maxReserve = std::max(m_adaptiveReserve.maxSamplesPerChannel, m_minSamplesPerChannelToReserve);
+        const samples_t grownReserve = std::min(reserve + m_renderStep, maxReserve);
+        if (grownReserve != reserve) {
+            LOGI() << "Underrun, samples per channel to reserve: " << grownReserve;
+            applyReserve(grownReserve);
+        }
+
+        return;
+    }
+
+    if (reserve <= m_minSamplesPerChannelToReserve) {
+        return;
+    }
+
+    m_stableSamplesPerChannel += renderedSamplesPerChannel;
+    if (m_stableSamplesPerChannel < m_adaptiveReserve.stablePeriodSamplesPerChannel) {
+        return;
+    }
+
+    m_stableSamplesPerChannel = 0;
+
+    const samples_t shrunkReserve = reserve - std::min(m_renderStep, reserve - m_minSamplesPerChannelToReserve);
+    LOGI() << "Stable, samples per channel to reserve: " << shrunkReserve;
+    applyReserve(shrunkReserve);
 }
 
 void AudioBuffer::forward()
@@ -170,13 +270,19 @@ void AudioBuffer::forward()
     const auto currentWriteIdx = m_writeIndex.load(std::memory_order_relaxed);
     const auto currentReadIdx = m_readIndex.load(std::memory_order_acquire);
     size_t nextWriteIdx = currentWriteIdx;
+    samples_t renderedSamplesPerChannel = 0;
 
-    while (reservedFrames(nextWriteIdx, currentReadIdx) < m_minSamplesToReserve) {
+    while (reservedSamples(nextWriteIdx, currentReadIdx) < m_minSamplesToReserve) {
         samples_t renderStep = m_renderStep;
         samples_t samplesToRender = renderStep * m_audioChannelsCount;
 
-        if (nextWriteIdx + samplesToRender > DEFAULT_SIZE) {
-            renderStep = (DEFAULT_SIZE - nextWriteIdx) / m_audioChannelsCount;
+        const size_t freeSamples = m_capacity - m_audioChannelsCount - reservedSamples(nextWriteIdx, currentReadIdx);
+        IF_ASSERT_FAILED(samplesToRender <= freeSamples) {
+            break;
+        }
+
+        if (nextWriteIdx + samplesToRender > m_capacity) {
+            renderStep = (m_capacity - nextWriteIdx) / m_audioChannelsCount;
             samplesToRender = renderStep * m_audioChannelsCount;
             IF_ASSERT_FAILED(renderStep > 0) {
                 break;
@@ -184,67 +290,115 @@ void AudioBuffer::forward()
         }
 
         m_source->process(m_data.data() + nextWriteIdx, renderStep);
+        renderedSamplesPerChannel += renderStep;
 
         nextWriteIdx += samplesToRender;
-        if (nextWriteIdx >= DEFAULT_SIZE) {
+        if (nextWriteIdx >= m_capacity) {
             nextWriteIdx = 0;
         }
     }
 
     m_writeIndex.store(nextWriteIdx, std::memory_order_release);
+
+    adaptReserve(renderedSamplesPerChannel);
 }
 
 void AudioBuffer::pop(float* dest, size_t sampleCount)
 {
-    const auto currentReadIdx = m_readIndex.load(std::memory_order_relaxed);
-    const auto currentWriteIdx = m_writeIndex.load(std::memory_order_acquire);
-    if (currentReadIdx == currentWriteIdx) { // empty queue
-        std::memcpy(dest, SILENT_FRAMES.data(), sampleCount * sizeof(float) * m_audioChannelsCount);
+    popSamples(sampleCount, [dest](const float* src, size_t destOffset, size_t count) {
+        std::memcpy(dest + destOffset, src, count * sizeof(float));
+    });
+}
+
+void AudioBuffer::popPlanar(float* const* dest, size_t samplesPerChannel)
+{
+    const audioch_t channels = m_audioChannelsCount;
+
+    //! NOTE Both parts of the ring start on a frame boundary, so each one is deinterleaved on its own
+    popSamples(samplesPerChannel, [dest, channels](const float* src, size_t destOffset, size_t count) {
+        const size_t firstFrame = destOffset / channels;
+        const size_t frames = count / channels;
+
+        if (channels == 2) {
+            dsp::activeVectorKernels().deinterleaveStereo(dest[0] + firstFrame, dest[1] + firstFrame, src, frames);
+            return;
+        }
+
+        for (audioch_t ch = 0; ch < channels; ++ch) {
+            float* channel = dest[ch] + firstFrame;
+
+            for (size_t i = 0; i < frames; ++i) {
+                channel[i] = src[i * channels + ch];
+            }
+        }
+    });
+}
+
+template<typename Copy>
+void AudioBuffer::popSamples(size_t sampleCount, Copy copy)
+{
+    const size_t totalSampleCount = sampleCount * m_audioChannelsCount;
+
+    m_popping.store(true, std::memory_order_seq_cst);
+    if (m_storageLocked.load(std::memory_order_seq_cst)) { // the worker is resizing or resetting the storage
+        m_popping.store(false, std::memory_order_release);
+        copySilentSamples(copy, 0, totalSampleCount, m_audioChannelsCount);
         return;
     }
 
-#ifdef DEBUG_AUDIO
-    if (reservedFrames(currentWriteIdx, currentReadIdx) < (sampleCount * m_audioChannelsCount)) {
-        static size_t missingFramesTotal = 0;
-        missingFramesTotal += (sampleCount * m_audioChannelsCount);
-        LOG_AUDIO() << "\n FRAMES MISSED " << sampleCount * m_audioChannelsCount << ", reserve: " <<
-            reservedFrames(currentWriteIdx, currentReadIdx) << ", total: " << missingFramesTotal;
-    }
-#endif
+    const auto currentReadIdx = m_readIndex.load(std::memory_order_relaxed);
+    const auto currentWriteIdx = m_writeIndex.load(std::memory_order_acquire);
+    const size_t reserved = reservedSamples(currentWriteIdx, currentReadIdx);
+    const size_t available = std::min(reserved, totalSampleCount);
 
-    size_t newReadIdx = currentReadIdx;
-    const size_t totalSampleCount = sampleCount * m_audioChannelsCount;
+    if (available > 0) {
+        const size_t firstPart = std::min(available, m_capacity - currentReadIdx);
+        copy(m_data.data() + currentReadIdx, 0, firstPart);
+
+        if (available > firstPart) {
+            copy(m_data.data(), firstPart, available - firstPart);
+        }
 
-    size_t from = newReadIdx;
-    auto memStep = sizeof(float);
-    size_t to = from + totalSampleCount;
-    if (to > DEFAULT_SIZE) {
-        to = DEFAULT_SIZE;
+        size_t newReadIdx = currentReadIdx + available;
+        if (newReadIdx >= m_capacity) {
+            newReadIdx -= m_capacity;
+        }
+
+        m_readIndex.store(newReadIdx, std::memory_order_release);
     }
 
-    auto count = to - from;
-    std::memcpy(dest, m_data.data() + from, count * memStep);
-    newReadIdx += count;
+    m_popping.store(false, std::memory_order_release);
+
+    if (available < totalSampleCount) {
+        copySilentSamples(copy, available, totalSampleCount - available, m_audioChannelsCount);
+        m_underrunsCount.fetch_add(1, std::memory_order_relaxed);
 
-    size_t left = totalSampleCount - count;
-    if (left > 0) {
-        std::memcpy(dest + count, m_data.data(), left * memStep);
-        newReadIdx = left;
+#ifdef DEBUG_AUDIO
+        static size_t missingFramesTotal = 0;
+        missingFramesTotal += totalSampleCount - available;
+        LOG_AUDIO() << "\n FRAMES MISSED " << totalSampleCount - available << ", reserve: " << reserved << ", total: " << missingFramesTotal;
+#endif
     }
 
-    if (newReadIdx >= DEFAULT_SIZE) {
-        newReadIdx -= DEFAULT_SIZE;
+    //! NOTE After m_popping is cleared, so that the callback may call forward() right here
+    if (m_onReserveLow && reserved - available < m_reserveLowWatermark.load(std::memory_order_relaxed)) {
+        m_onReserveLow();
     }
+}
 
-    m_readIndex.store(newReadIdx, std::memory_order_release);
+uint64_t AudioBuffer::underrunsCount() const
+{
+    return m_underrunsCount.load(std::memory_order_relaxed);
 }
 
 void AudioBuffer::reset()
 {
-    m_readIndex.store(0, std::memory_order_release);
-    m_writeIndex.store(0, std::memory_order_release);
+    withStorageLocked([this]() {
+        m_readIndex.store(0, std::memory_order_relaxed);
+        m_writeIndex.store(0, std::memory_order_relaxed);
 
-    m_data = SILENT_FRAMES;
+        std::fill(m_data.begin(), m_data.end(), 0.f);
+    });
 }
 
 audioch_t AudioBuffer::audioChannelCount() const
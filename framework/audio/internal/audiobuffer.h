@@ -25,6 +25,7 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <functional>
 
 #include "iaudiosource.h"
 #include "audiotypes.h"
@@ -48,30 +49,90 @@ class AudioBuffer
 public:
     AudioBuffer() = default;
 
-    void init(const audioch_t audioChannelsCount);
+    static constexpr samples_t DEFAULT_CAPACITY_PER_CHANNEL = 1024 * 8;
+
+    void init(const audioch_t audioChannelsCount, const samples_t capacityPerChannel = DEFAULT_CAPACITY_PER_CHANNEL);
+
+    //! NOTE Keeps the rendered samples which haven't been played yet, if they fit.
+    //! Must be called on the worker thread; the driver plays silence while the storage is swapped
+    void resize(const samples_t capacityPerChannel);
+    samples_t capacityPerChannel() const;
 
     void setSource(IAudioSourcePtr source);
+
+    //! NOTE Can be retuned at any time, the capacity grows if the reserve doesn't fit
     void setMinSamplesPerChannelToReserve(const samples_t samplesPerChannel);
     void setRenderStep(const samples_t renderStep);
 
+    //! NOTE In the adaptive mode the reserve grows by the render step after every underrun, up to the maximum,
+    //! and goes back down by a render step after each stable period, but never below the minimum set above.
+    //! So it settles on the lowest latency that plays without underruns on this machine
+    struct AdaptiveReserve {
+        bool enabled = false;
+        samples_t maxSamplesPerChannel = 0;
+        samples_t stablePeriodSamplesPerChannel = 0; // rendered without underruns
+    };
+
+    void setAdaptiveReserve(const AdaptiveReserve& adaptiveReserve);
+
+    //! NOTE The current reserve, including what the adaptive mode has added
+    samples_t samplesPerChannelToReserve() const;
+
+    //! NOTE Called by pop(), on the driver thread, when the reserve drops below the minimum,
+    //! so that the worker can refill the buffer on demand. Must be set before the driver starts
+    using OnReserveLow = std::function<void ()>;
+    void setOnReserveLow(const OnReserveLow& func);
+
     void forward();
     void pop(float* dest, size_t sampleCount);
 
+    //! NOTE Same as pop(), deinterleaved straight from the ring into one buffer per audio channel
+    void popPlanar(float* const* dest, size_t samplesPerChannel);
+
     void reset();
 
+    //! NOTE The number of pops which didn't find enough rendered samples, since the start
+    uint64_t underrunsCount() const;
+
     audioch_t audioChannelCount() const;
 
 private:
+    //! NOTE copy(src, destOffset, count) receives the interleaved samples in order, up to two parts because of the wrap
+    template<typename Copy>
+    void popSamples(size_t sampleCount, Copy copy);
+
+    //! NOTE Runs func on the worker thread while the driver doesn't touch the storage
+    template<typename Func>
+    void withStorageLocked(Func func);
+
+    size_t reservedSamples(const size_t writeIdx, const size_t readIdx) const;
+    samples_t requiredCapacityPerChannel() const;
+    void ensureCapacity();
+    void applyReserve(const samples_t samplesPerChannel);
+    void adaptReserve(const samples_t renderedSamplesPerChannel);
+
     alignas(cache_line_size) std::atomic<size_t> m_writeIndex = 0;
     alignas(cache_line_size) std::atomic<size_t> m_readIndex = 0;
     alignas(cache_line_size) std::vector<float> m_data;
+    size_t m_capacity = 0; // samples of all channels, a whole number of frames
+
+    alignas(cache_line_size) std::atomic<bool> m_storageLocked = false;
+    alignas(cache_line_size) std::atomic<bool> m_popping = false;
 
-    samples_t m_samplesPerChannel = 0;
     audioch_t m_audioChannelsCount = 0;
-    samples_t m_minSamplesToReserve = 0;
+    samples_t m_minSamplesPerChannelToReserve = 0;
+    samples_t m_minSamplesToReserve = 0; // the current reserve of all channels
     samples_t m_renderStep = 0;
 
+    AdaptiveReserve m_adaptiveReserve;
+    uint64_t m_lastUnderrunsCount = 0;
+    samples_t m_stableSamplesPerChannel = 0;
+
     IAudioSourcePtr m_source = nullptr;
+
+    OnReserveLow m_onReserveLow;
+    std::atomic<size_t> m_reserveLowWatermark = 0; // m_minSamplesToReserve, readable by the driver thread
+    std::atomic<uint64_t> m_underrunsCount = 0;
 };
 
 using AudioBufferPtr = std::shared_ptr<AudioBuffer>;
@@ -43,6 +43,8 @@ static const Settings::Key AUDIO_BUFFER_SIZE_KEY("audio", "io/bufferSize");
 static const Settings::Key AUDIO_SAMPLE_RATE_KEY("audio", "io/sampleRate");
 static const Settings::Key AUDIO_MEASURE_INPUT_LAG("audio", "io/measureInputLag");
 static const Settings::Key AUDIO_DESIRED_THREAD_NUMBER_KEY("audio", "io/audioThreads");
+static const Settings::Key AUDIO_THREAD_POOL_TYPE_KEY("audio", "io/audioThreadPoolType");
+static const Settings::Key AUDIO_MASTER_LIMITER_KEY("audio", "io/masterLimiter");
 
 static const Settings::Key USER_SOUNDFONTS_PATHS("midi", "application/paths/mySoundfonts");
 
@@ -93,6 +95,12 @@ void AudioConfiguration::init()
     settings()->setDefaultValue(AUDIO_MEASURE_INPUT_LAG, Val(false));
 
     settings()->setDefaultValue(AUDIO_DESIRED_THREAD_NUMBER_KEY, Val(0));
+    settings()->setDefaultValue(AUDIO_THREAD_POOL_TYPE_KEY, Val(static_cast<int>(AudioThreadPoolType::WorkStealing)));
+
+    settings()->setDefaultValue(AUDIO_MASTER_LIMITER_KEY, Val(false));
+    settings()->valueChanged(AUDIO_MASTER_LIMITER_KEY).onReceive(nullptr, [this](const Val& val) {
+        m_masterLimiterEnabledChanged.send(val.toBool());
+    });
 
     updateSamplesToPreallocate();
 }
@@ -212,6 +220,26 @@ size_t AudioConfiguration::minTrackCountForMultithreading() const
     return 2;
 }
 
+AudioThreadPoolType AudioConfiguration::audioThreadPoolType() const
+{
+    return static_cast<AudioThreadPoolType>(settings()->value(AUDIO_THREAD_POOL_TYPE_KEY).toInt());
+}
+
+bool AudioConfiguration::masterLimiterEnabled() const
+{
+    return settings()->value(AUDIO_MASTER_LIMITER_KEY).toBool();
+}
+
+void AudioConfiguration::setMasterLimiterEnabled(bool enabled)
+{
+    settings()->setSharedValue(AUDIO_MASTER_LIMITER_KEY, Val(enabled));
+}
+
+async::Channel<bool> AudioConfiguration::masterLimiterEnabledChanged() const
+{
+    return m_masterLimiterEnabledChanged;
+}
+
 AudioInputParams AudioConfiguration::defaultAudioInputParams() const
 {
     AudioInputParams result;
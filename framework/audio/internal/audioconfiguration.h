@@ -67,6 +67,11 @@ public:
 
     size_t desiredAudioThreadNumber() const override;
     size_t minTrackCountForMultithreading() const override;
+    AudioThreadPoolType audioThreadPoolType() const override;
+
+    bool masterLimiterEnabled() const override;
+    void setMasterLimiterEnabled(bool enabled) override;
+    async::Channel<bool> masterLimiterEnabledChanged() const override;
 
     // synthesizers
     AudioInputParams defaultAudioInputParams() const override;
@@ -83,6 +88,7 @@ private:
 
     async::Channel<io::paths_t> m_soundFontDirsChanged;
     async::Channel<samples_t> m_samplesToPreallocateChanged;
+    async::Channel<bool> m_masterLimiterEnabledChanged;
 
     async::Notification m_audioOutputDeviceIdChanged;
     async::Notification m_driverBufferSizeChanged;
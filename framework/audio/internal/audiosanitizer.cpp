@@ -22,6 +22,7 @@
 #include "audiosanitizer.h"
 
 #include <thread>
+#include <mutex>
 
 #include "containers.h"
 
@@ -29,7 +30,8 @@ using namespace muse::audio;
 
 static std::thread::id s_as_mainThreadID;
 static std::thread::id s_as_workerThreadID;
-static std::set<std::thread::id> s_mixerThreadIdSet;
+static std::set<std::thread::id> s_extraWorkerThreadIdSet;
+static std::mutex s_extraWorkerThreadIdSetMutex;
 
 void AudioSanitizer::setupMainThread()
 {
@@ -51,9 +53,18 @@ void AudioSanitizer::setupWorkerThread()
     s_as_workerThreadID = std::this_thread::get_id();
 }
 
-void AudioSanitizer::setMixerThreads(const std::set<std::thread::id>& threadIdSet)
+void AudioSanitizer::registerWorkerThreads(const std::set<std::thread::id>& threadIdSet)
 {
-    s_mixerThreadIdSet = threadIdSet;
+    std::lock_guard lock(s_extraWorkerThreadIdSetMutex);
+    s_extraWorkerThreadIdSet.insert(threadIdSet.begin(), threadIdSet.end());
+}
+
+void AudioSanitizer::unregisterWorkerThreads(const std::set<std::thread::id>& threadIdSet)
+{
+    std::lock_guard lock(s_extraWorkerThreadIdSetMutex);
+    for (const std::thread::id& id : threadIdSet) {
+        s_extraWorkerThreadIdSet.erase(id);
+    }
 }
 
 std::thread::id AudioSanitizer::workerThread()
@@ -65,5 +76,10 @@ bool AudioSanitizer::isWorkerThread()
 {
     std::thread::id id = std::this_thread::get_id();
 
-    return id == s_as_workerThreadID || muse::contains(s_mixerThreadIdSet, id);
+    if (id == s_as_workerThreadID) {
+        return true;
+    }
+
+    std::lock_guard lock(s_extraWorkerThreadIdSetMutex);
+    return muse::contains(s_extraWorkerThreadIdSet, id);
 }
@@ -38,7 +38,9 @@ public:
     static bool isMainThread();
 
     static void setupWorkerThread();
-    static void setMixerThreads(const std::set<std::thread::id>& threadIdSet);
+    //! NOTE Threads which render on behalf of the worker thread (mixer thread pools, offline rendering)
+    static void registerWorkerThreads(const std::set<std::thread::id>& threadIdSet);
+    static void unregisterWorkerThreads(const std::set<std::thread::id>& threadIdSet);
     static std::thread::id workerThread();
     static bool isWorkerThread();
 };
@@ -21,6 +21,9 @@
  */
 #include "audiothread.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "global/runtime.h"
 #include "global/threadutils.h"
 #include "global/async/processevents.h"
@@ -33,6 +36,13 @@
 
 #ifdef Q_OS_WIN
 #include "global/platform/win/waitabletimer.h"
+#elif defined(Q_OS_LINUX)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
 #endif
 
 #include "log.h"
@@ -44,8 +54,127 @@ static uint64_t toWinTime(const msecs_t msecs)
     return msecs * 10000;
 }
 
+static uint64_t nowNanosecs()
+{
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+//! NOTE Linux: eventfd, Windows: auto-reset event, other platforms: condition variable.
+//! notify() must be safe to call from the driver callback, so it never takes a lock
+class AudioThread::WakeEvent
+{
+public:
+#ifdef Q_OS_WIN
+    WakeEvent()
+    {
+        m_event = ::CreateEventW(NULL, FALSE, FALSE, NULL);
+        if (!m_event) {
+            LOGE() << "Failed to create the audio worker wake event, error: " << ::GetLastError();
+        }
+    }
+
+    ~WakeEvent()
+    {
+        if (m_event) {
+            ::CloseHandle(m_event);
+        }
+    }
+
+    void notify()
+    {
+        if (m_event) {
+            ::SetEvent(m_event);
+        }
+    }
+
+    void wait(const msecs_t timeout)
+    {
+        if (!m_event || ::WaitForSingleObject(m_event, static_cast<DWORD>(timeout)) == WAIT_FAILED) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+        }
+    }
+
+    HANDLE handle() const
+    {
+        return m_event;
+    }
+
+private:
+    HANDLE m_event = NULL;
+#elif defined(Q_OS_LINUX)
+    WakeEvent()
+    {
+        m_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_fd < 0) {
+            LOGE() << "Failed to create the audio worker eventfd, errno: " << errno;
+        }
+    }
+
+    ~WakeEvent()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    void notify()
+    {
+        if (m_fd >= 0) {
+            const uint64_t value = 1;
+            [[maybe_unused]] ssize_t written = ::write(m_fd, &value, sizeof(value));
+        }
+    }
+
+    void wait(const msecs_t timeout)
+    {
+        if (m_fd < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+            return;
+        }
+
+        pollfd pfd { m_fd, POLLIN, 0 };
+        if (::poll(&pfd, 1, static_cast<int>(timeout)) > 0) {
+            uint64_t value = 0;
+            [[maybe_unused]] ssize_t read = ::read(m_fd, &value, sizeof(value));
+        }
+    }
+
+private:
+    int m_fd = -1;
+#else
+    void notify()
+    {
+        m_notified.store(true, std::memory_order_release);
+        m_condition.notify_one();
+    }
+
+    //! NOTE A notification which comes in between the check and the wait is lost,
+    //! in that case the timeout starts the next iteration
+    void wait(const msecs_t timeout)
+    {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait_for(lock, std::chrono::milliseconds(timeout), [this]() {
+            return m_notified.load(std::memory_order_acquire);
+        });
+
+        m_notified.store(false, std::memory_order_relaxed);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::atomic<bool> m_notified = false;
+#endif
+};
+
 std::thread::id AudioThread::ID;
 
+AudioThread::AudioThread()
+    : m_wakeEvent(std::make_unique<WakeEvent>())
+{
+}
+
 AudioThread::~AudioThread()
 {
     if (m_running) {
@@ -89,6 +218,8 @@ void AudioThread::stop(const Runnable& onFinished)
 {
     m_onFinished = onFinished;
     m_running = false;
+    m_wakeEvent->notify();
+
     if (m_thread) {
         m_thread->join();
     }
@@ -99,6 +230,57 @@ bool AudioThread::isRunning() const
     return m_running;
 }
 
+void AudioThread::wake()
+{
+    //! NOTE Only the first wake after an iteration has started signals the event,
+    //! the following ones are served by the same iteration
+    uint64_t noPendingWake = 0;
+    if (m_wakeTimeNanosecs.compare_exchange_strong(noPendingWake, nowNanosecs(), std::memory_order_acq_rel)) {
+        m_wakeEvent->notify();
+    }
+}
+
+AudioThread::LatencyStats AudioThread::latencyStats() const
+{
+    LatencyStats stats;
+    stats.wakeCount = m_wakeCount.load(std::memory_order_relaxed);
+    stats.timeoutCount = m_timeoutCount.load(std::memory_order_relaxed);
+
+    if (stats.wakeCount > 0) {
+        stats.minMsecs = m_latencyMinNanosecs.load(std::memory_order_relaxed) / 1e6;
+        stats.maxMsecs = m_latencyMaxNanosecs.load(std::memory_order_relaxed) / 1e6;
+        stats.avgMsecs = m_latencySumNanosecs.load(std::memory_order_relaxed) / 1e6 / stats.wakeCount;
+    }
+
+    return stats;
+}
+
+void AudioThread::resetLatencyStats()
+{
+    m_wakeCount.store(0, std::memory_order_relaxed);
+    m_timeoutCount.store(0, std::memory_order_relaxed);
+    m_latencyMinNanosecs.store(0, std::memory_order_relaxed);
+    m_latencyMaxNanosecs.store(0, std::memory_order_relaxed);
+    m_latencySumNanosecs.store(0, std::memory_order_relaxed);
+}
+
+void AudioThread::addLatency(uint64_t nanosecs)
+{
+    //! NOTE Only the worker thread writes the stats
+    const uint64_t count = m_wakeCount.load(std::memory_order_relaxed);
+
+    if (count == 0 || nanosecs < m_latencyMinNanosecs.load(std::memory_order_relaxed)) {
+        m_latencyMinNanosecs.store(nanosecs, std::memory_order_relaxed);
+    }
+
+    if (nanosecs > m_latencyMaxNanosecs.load(std::memory_order_relaxed)) {
+        m_latencyMaxNanosecs.store(nanosecs, std::memory_order_relaxed);
+    }
+
+    m_latencySumNanosecs.fetch_add(nanosecs, std::memory_order_relaxed);
+    m_wakeCount.store(count + 1, std::memory_order_relaxed);
+}
+
 void AudioThread::main()
 {
     runtime::setThreadName("audio_worker");
@@ -118,21 +300,33 @@ void AudioThread::main()
 #endif
 
     while (m_running) {
+        const uint64_t wakeTime = m_wakeTimeNanosecs.exchange(0, std::memory_order_acq_rel);
+
         async::processEvents();
 
         if (m_mainLoopBody) {
             m_mainLoopBody();
         }
 
+        if (wakeTime != 0) {
+            addLatency(nowNanosecs() - wakeTime);
+        } else {
+            m_timeoutCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
 #ifdef Q_OS_WIN
-        if (!timerValid || !timer.setAndWait(m_intervalInWinTime)) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(m_intervalMsecs));
+        if (!timerValid || !timer.setAndWait(m_intervalInWinTime, m_wakeEvent->handle())) {
+            m_wakeEvent->wait(m_intervalMsecs);
         }
 #else
-        std::this_thread::sleep_for(std::chrono::milliseconds(m_intervalMsecs));
+        m_wakeEvent->wait(m_intervalMsecs);
 #endif
     }
 
+    const LatencyStats stats = latencyStats();
+    LOGI() << "Audio worker wakes: " << stats.wakeCount << ", timeouts: " << stats.timeoutCount
+           << ", wake to render latency (ms) min: " << stats.minMsecs << ", avg: " << stats.avgMsecs << ", max: " << stats.maxMsecs;
+
     if (m_onFinished) {
         m_onFinished();
     }
@@ -34,20 +34,39 @@ namespace muse::audio {
 class AudioThread
 {
 public:
-    AudioThread() = default;
+    AudioThread();
     ~AudioThread();
 
     static std::thread::id ID;
 
     using Runnable = std::function<void ()>;
 
+    //! NOTE The loop body runs when wake() is called, or when the interval has elapsed without a wake
     void run(const Runnable& onStart, const Runnable& loopBody, const msecs_t interval = 1);
     void setInterval(const msecs_t interval);
     void stop(const Runnable& onFinished = nullptr);
     bool isRunning() const;
 
+    //! NOTE Requests the next iteration of the loop as soon as possible.
+    //! Doesn't lock or allocate, so it can be called from the audio driver callback
+    void wake();
+
+    struct LatencyStats {
+        uint64_t wakeCount = 0;    // iterations started by wake()
+        uint64_t timeoutCount = 0; // iterations started by the elapsed interval
+        double minMsecs = 0.0;     // from wake() until the end of the loop body
+        double avgMsecs = 0.0;
+        double maxMsecs = 0.0;
+    };
+
+    LatencyStats latencyStats() const;
+    void resetLatencyStats();
+
 private:
+    class WakeEvent;
+
     void main();
+    void addLatency(uint64_t nanosecs);
 
     Runnable m_onStart = nullptr;
     Runnable m_mainLoopBody = nullptr;
@@ -57,6 +76,15 @@ private:
 
     std::unique_ptr<std::thread> m_thread = nullptr;
     std::atomic<bool> m_running = false;
+
+    std::unique_ptr<WakeEvent> m_wakeEvent;
+    std::atomic<uint64_t> m_wakeTimeNanosecs = 0; // 0 if there is no pending wake
+
+    std::atomic<uint64_t> m_wakeCount = 0;
+    std::atomic<uint64_t> m_timeoutCount = 0;
+    std::atomic<uint64_t> m_latencyMinNanosecs = 0;
+    std::atomic<uint64_t> m_latencyMaxNanosecs = 0;
+    std::atomic<uint64_t> m_latencySumNanosecs = 0;
 };
 using AudioThreadPtr = std::shared_ptr<AudioThread>;
 }
@@ -23,6 +23,8 @@
 #ifndef MUSE_AUDIO_AUDIOMATHUTILS_H
 #define MUSE_AUDIO_AUDIOMATHUTILS_H
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <limits>
 
@@ -39,6 +41,21 @@ inline float samplesRootMeanSquare(const float squaredSum, const samples_t sampl
     return std::sqrt(squaredSum / sampleCount);
 }
 
+inline void samplesPeaks(const float* buffer, const samples_t samplesPerChannel, const audioch_t audioChannelsCount, float* peaks)
+{
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        peaks[audioChNum] = 0.f;
+    }
+
+    for (samples_t s = 0; s < samplesPerChannel; ++s) {
+        const float* frame = buffer + s * audioChannelsCount;
+
+        for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+            peaks[audioChNum] = std::max(peaks[audioChNum], std::abs(frame[audioChNum]));
+        }
+    }
+}
+
 inline float sampleAttackTimeCoefficient(const unsigned int sampleRate, const float attackTimeInSecs)
 {
     return std::exp(-std::log(9) / (sampleRate * attackTimeInSecs));
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "cpufeatures.h"
+
+#if defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_X64))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_X64))
+static bool cpuSupportsXsaveState(unsigned long long mask)
+{
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) {
+        return false;
+    }
+
+    return (_xgetbv(0) & mask) == mask;
+}
+
+static int cpuidLeaf7Ebx()
+{
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return 0;
+    }
+
+    __cpuidex(info, 7, 0);
+    return info[1];
+}
+
+#endif
+
+bool muse::audio::dsp::cpuSupportsAvx2()
+{
+    static const bool supported = []() {
+#if defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_X64))
+        //! NOTE The OS must save the YMM registers on context switch
+        return cpuSupportsXsaveState(0x6) && (cpuidLeaf7Ebx() & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }();
+
+    return supported;
+}
+
+bool muse::audio::dsp::cpuSupportsAvx512()
+{
+    static const bool supported = []() {
+#if defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_X64))
+        //! NOTE The OS must save the opmask and the full ZMM registers as well
+        return cpuSupportsXsaveState(0xE6) && (cpuidLeaf7Ebx() & (1 << 16)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        return __builtin_cpu_supports("avx512f");
+#else
+        return false;
+#endif
+    }();
+
+    return supported;
+}
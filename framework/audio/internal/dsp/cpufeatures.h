@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_CPUFEATURES_H
+#define MUSE_AUDIO_CPUFEATURES_H
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MUSE_AUDIO_ARCH_X86_64
+#endif
+
+//! NOTE The code for a wider instruction set is put between BEGIN and END, and built for it function by function.
+//! Not with a per file compiler flag: then the inline functions from the headers would be built for it too,
+//! and the linker might keep those copies for the whole binary, which crashes on older CPUs
+#if defined(__clang__)
+#define MUSE_AUDIO_BEGIN_AVX2_CODE _Pragma("clang attribute push (__attribute__((target(\"avx2\"))), apply_to = function)")
+#define MUSE_AUDIO_BEGIN_AVX512_CODE _Pragma("clang attribute push (__attribute__((target(\"avx512f\"))), apply_to = function)")
+#define MUSE_AUDIO_END_ISA_CODE _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+#define MUSE_AUDIO_BEGIN_AVX2_CODE _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#define MUSE_AUDIO_BEGIN_AVX512_CODE _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f\")")
+#define MUSE_AUDIO_END_ISA_CODE _Pragma("GCC pop_options")
+#else
+//! NOTE MSVC emits the instructions of any intrinsic without enabling the instruction set for the whole file
+#define MUSE_AUDIO_BEGIN_AVX2_CODE
+#define MUSE_AUDIO_BEGIN_AVX512_CODE
+#define MUSE_AUDIO_END_ISA_CODE
+#endif
+
+namespace muse::audio::dsp {
+//! NOTE Runtime checks of the instruction sets that are only enabled for the BEGIN/END code.
+//! They also check that the OS saves the wider registers on context switch
+bool cpuSupportsAvx2();
+bool cpuSupportsAvx512();
+}
+
+#endif // MUSE_AUDIO_CPUFEATURES_H
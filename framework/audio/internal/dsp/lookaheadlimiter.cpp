@@ -0,0 +1,265 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "lookaheadlimiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "truepeakfilter.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+static float absolutePeak(const float* buffer, size_t count)
+{
+    float peak = 0.f;
+
+    for (size_t i = 0; i < count; ++i) {
+        peak = std::max(peak, std::abs(buffer[i]));
+    }
+
+    return peak;
+}
+
+LookAheadLimiter::LookAheadLimiter(sample_rate_t sampleRate, audioch_t audioChannelsCount, float lookAheadMs)
+    : m_sampleRate(sampleRate), m_audioChannelsCount(audioChannelsCount)
+{
+    const TruePeakCoefficients& coefficients = truePeakCoefficients();
+
+    for (size_t p = 0; p < TRUE_PEAK_PHASES; ++p) {
+        float sum = 0.f;
+
+        for (size_t t = 0; t < TRUE_PEAK_TAPS; ++t) {
+            sum += std::abs(coefficients[t * TRUE_PEAK_PHASES + p]);
+        }
+
+        m_interpolationGain = std::max(m_interpolationGain, sum);
+    }
+
+    m_windows.resize(2 * TRUE_PEAK_TAPS * audioChannelsCount);
+
+    setCeiling(DEFAULT_CEILING);
+    setReleaseTime(DEFAULT_RELEASE_TIME);
+    setLookAheadMs(lookAheadMs);
+}
+
+bool LookAheadLimiter::isActive() const
+{
+    return m_isActive;
+}
+
+void LookAheadLimiter::setIsActive(const bool active)
+{
+    if (m_isActive == active) {
+        return;
+    }
+
+    //! NOTE Don't replay the content of the delay line left from the last activation
+    reset();
+    m_isActive = active;
+}
+
+sample_rate_t LookAheadLimiter::sampleRate() const
+{
+    return m_sampleRate;
+}
+
+audioch_t LookAheadLimiter::audioChannelsCount() const
+{
+    return m_audioChannelsCount;
+}
+
+float LookAheadLimiter::lookAheadMs() const
+{
+    return m_lookAheadMs;
+}
+
+void LookAheadLimiter::setLookAheadMs(float lookAheadMs)
+{
+    m_lookAheadMs = std::clamp(lookAheadMs, MIN_LOOK_AHEAD_MS, MAX_LOOK_AHEAD_MS);
+    m_lookAheadFrames = std::max<samples_t>(1, static_cast<samples_t>(std::lround(m_lookAheadMs * m_sampleRate / 1000.f)));
+
+    //! NOTE The hold window is one frame wider on both sides than the moving average,
+    //! so that a peak is caught even if the interpolation places it next to its frame
+    m_holdFrames = m_lookAheadFrames + 2;
+
+    m_delayLine.resize(latency() * m_audioChannelsCount);
+    m_heldGains.resize(m_holdFrames + 1);
+    m_smoothingGains.resize(m_lookAheadFrames);
+
+    reset();
+}
+
+volume_dbfs_t LookAheadLimiter::ceiling() const
+{
+    return muse::linear_to_db(m_ceiling);
+}
+
+void LookAheadLimiter::setCeiling(volume_dbfs_t ceiling)
+{
+    m_ceiling = muse::db_to_linear(ceiling);
+}
+
+void LookAheadLimiter::setReleaseTime(float releaseTimeInSecs)
+{
+    m_releaseCoefficient = std::exp(-1.f / (m_sampleRate * releaseTimeInSecs));
+}
+
+samples_t LookAheadLimiter::latency() const
+{
+    return m_lookAheadFrames + TRUE_PEAK_DELAY;
+}
+
+gain_t LookAheadLimiter::currentGain() const
+{
+    return m_currentGain;
+}
+
+void LookAheadLimiter::reset()
+{
+    std::fill(m_windows.begin(), m_windows.end(), 0.f);
+    m_windowPosition = 0;
+
+    std::fill(m_delayLine.begin(), m_delayLine.end(), 0.f);
+    m_delayPosition = 0;
+
+    m_heldFront = 0;
+    m_heldCount = 0;
+    m_frame = 0;
+
+    std::fill(m_smoothingGains.begin(), m_smoothingGains.end(), 1.f);
+    m_smoothingPosition = 0;
+    m_smoothingSum = static_cast<double>(m_lookAheadFrames);
+
+    m_releasedGain = 1.f;
+    m_currentGain = 1.f;
+}
+
+gain_t LookAheadLimiter::requiredGain() const
+{
+    const TruePeakCoefficients& coefficients = truePeakCoefficients();
+    float peak = 0.f;
+
+    //! NOTE One frame is too short for the vector kernels, the 4 phases are accumulated side by side instead,
+    //! which the compiler vectorizes
+    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+        const float* window = m_windows.data() + audioChNum * 2 * TRUE_PEAK_TAPS + m_windowPosition + 1;
+        float acc[TRUE_PEAK_PHASES] = {};
+
+        for (size_t t = 0; t < TRUE_PEAK_TAPS; ++t) {
+            for (size_t p = 0; p < TRUE_PEAK_PHASES; ++p) {
+                acc[p] += coefficients[t * TRUE_PEAK_PHASES + p] * window[t];
+            }
+        }
+
+        peak = std::max(peak, std::abs(window[TRUE_PEAK_DELAY - 1]));
+
+        for (size_t p = 0; p < TRUE_PEAK_PHASES; ++p) {
+            peak = std::max(peak, std::abs(acc[p]));
+        }
+    }
+
+    return peak > m_ceiling ? m_ceiling / peak : 1.f;
+}
+
+//! NOTE Sliding-window minimum: the ring buffer keeps the gains of the window that are lower
+//! than all the gains after them, so the front is the minimum and every gain is pushed and popped once
+gain_t LookAheadLimiter::holdMinimum(gain_t gain)
+{
+    const size_t capacity = m_heldGains.size();
+
+    auto index = [this, capacity](size_t offset) {
+        const size_t idx = m_heldFront + offset;
+        return idx < capacity ? idx : idx - capacity;
+    };
+
+    while (m_heldCount > 0 && m_heldGains[index(m_heldCount - 1)].gain >= gain) {
+        --m_heldCount;
+    }
+
+    m_heldGains[index(m_heldCount)] = { m_frame, gain };
+    ++m_heldCount;
+
+    while (m_heldGains[m_heldFront].frame + m_holdFrames <= m_frame) {
+        m_heldFront = index(1);
+        --m_heldCount;
+    }
+
+    ++m_frame;
+
+    return m_heldGains[m_heldFront].gain;
+}
+
+void LookAheadLimiter::process(float* buffer, samples_t samplesPerChannel)
+{
+    //! NOTE An interpolated value can't exceed the input peak times the gain of the filter,
+    //! so the true-peak of the frames is only measured when the ceiling may be reached
+    const float inputPeak = std::max(absolutePeak(buffer, samplesPerChannel * m_audioChannelsCount),
+                                     absolutePeak(m_windows.data(), m_windows.size()));
+    const bool isNearCeiling = inputPeak * m_interpolationGain > m_ceiling;
+
+    const size_t delayFrames = latency();
+    const double smoothingScale = 1.0 / static_cast<double>(m_lookAheadFrames);
+
+    for (samples_t s = 0; s < samplesPerChannel; ++s) {
+        float* frame = buffer + s * m_audioChannelsCount;
+
+        for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+            float* window = m_windows.data() + audioChNum * 2 * TRUE_PEAK_TAPS;
+            window[m_windowPosition] = frame[audioChNum];
+            window[m_windowPosition + TRUE_PEAK_TAPS] = frame[audioChNum];
+        }
+
+        const gain_t held = holdMinimum(isNearCeiling ? requiredGain() : 1.f);
+        if (++m_windowPosition == TRUE_PEAK_TAPS) {
+            m_windowPosition = 0;
+        }
+
+        if (held < m_releasedGain) {
+            m_releasedGain = held;
+        } else {
+            m_releasedGain = held + (m_releasedGain - held) * m_releaseCoefficient;
+        }
+
+        m_smoothingSum += m_releasedGain - m_smoothingGains[m_smoothingPosition];
+        m_smoothingGains[m_smoothingPosition] = m_releasedGain;
+        if (++m_smoothingPosition == m_lookAheadFrames) {
+            m_smoothingPosition = 0;
+        }
+
+        const gain_t gain = static_cast<gain_t>(m_smoothingSum * smoothingScale);
+
+        float* delayed = m_delayLine.data() + m_delayPosition * m_audioChannelsCount;
+
+        for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+            const float sample = delayed[audioChNum];
+            delayed[audioChNum] = frame[audioChNum];
+            frame[audioChNum] = sample * gain;
+        }
+
+        if (++m_delayPosition == delayFrames) {
+            m_delayPosition = 0;
+        }
+        m_currentGain = gain;
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_LOOKAHEADLIMITER_H
+#define MUSE_AUDIO_LOOKAHEADLIMITER_H
+
+#include <memory>
+#include <vector>
+
+#include "../../audiotypes.h"
+
+namespace muse::audio::dsp {
+//! NOTE Brick-wall limiter of an interleaved stream. The 4x oversampled true-peak of every frame
+//! is turned into a required gain, held over the look-ahead time by a sliding-window minimum
+//! and faded in with a moving average of the same length, so that the gain is fully reduced
+//! when the peak leaves the delay line. The channels share one gain envelope.
+//! All the memory is allocated in the constructor and in setLookAheadMs(), process() doesn't allocate
+class LookAheadLimiter
+{
+public:
+    static constexpr float MIN_LOOK_AHEAD_MS = 1.f;
+    static constexpr float MAX_LOOK_AHEAD_MS = 5.f;
+    static constexpr float DEFAULT_LOOK_AHEAD_MS = 1.5f;
+    static constexpr float DEFAULT_RELEASE_TIME = 0.05f; // secs
+    static constexpr volume_dbfs_t DEFAULT_CEILING = volume_dbfs_t::make(0.f);
+
+    LookAheadLimiter(sample_rate_t sampleRate, audioch_t audioChannelsCount, float lookAheadMs = DEFAULT_LOOK_AHEAD_MS);
+
+    bool isActive() const;
+    void setIsActive(const bool active);
+
+    sample_rate_t sampleRate() const;
+    audioch_t audioChannelsCount() const;
+
+    float lookAheadMs() const;
+    void setLookAheadMs(float lookAheadMs);
+
+    volume_dbfs_t ceiling() const;
+    void setCeiling(volume_dbfs_t ceiling);
+
+    void setReleaseTime(float releaseTimeInSecs);
+
+    //! NOTE The delay of the output in frames: the look-ahead plus the delay of the true-peak interpolation
+    samples_t latency() const;
+
+    gain_t currentGain() const;
+
+    void process(float* buffer, samples_t samplesPerChannel);
+    void reset();
+
+private:
+    struct HeldGain {
+        uint64_t frame = 0;
+        gain_t gain = 1.f;
+    };
+
+    gain_t requiredGain() const;
+    gain_t holdMinimum(gain_t gain);
+
+    sample_rate_t m_sampleRate = 0;
+    audioch_t m_audioChannelsCount = 0;
+    float m_lookAheadMs = 0.f;
+    samples_t m_lookAheadFrames = 0;
+    samples_t m_holdFrames = 0;
+
+    gain_t m_ceiling = 1.f;
+    float m_interpolationGain = 1.f; // the highest possible ratio of an interpolated value to the input peak
+    float m_releaseCoefficient = 0.f;
+
+    std::vector<float> m_windows;  // per channel: the last TRUE_PEAK_TAPS input samples, stored twice
+    size_t m_windowPosition = 0;
+
+    std::vector<float> m_delayLine; // interleaved
+    size_t m_delayPosition = 0;
+
+    std::vector<HeldGain> m_heldGains; // ring buffer of the ascending gains of the hold window
+    size_t m_heldFront = 0;
+    size_t m_heldCount = 0;
+    uint64_t m_frame = 0;
+
+    std::vector<gain_t> m_smoothingGains; // ring buffer of the moving average
+    size_t m_smoothingPosition = 0;
+    double m_smoothingSum = 0.0;
+
+    gain_t m_releasedGain = 1.f;
+    gain_t m_currentGain = 1.f;
+
+    bool m_isActive = false;
+};
+
+using LookAheadLimiterPtr = std::unique_ptr<LookAheadLimiter>;
+}
+
+#endif // MUSE_AUDIO_LOOKAHEADLIMITER_H
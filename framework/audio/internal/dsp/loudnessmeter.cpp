@@ -0,0 +1,309 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "loudnessmeter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "truepeakfilter.h"
+#include "vectorkernels.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+static constexpr double LOUDNESS_PI = 3.14159265358979323846;
+
+static constexpr double ABSOLUTE_GATE_LUFS = -70.0;
+static constexpr double RELATIVE_GATE_LU = -10.0;
+static constexpr double HISTOGRAM_BIN_LU = 0.1;
+
+//! NOTE The input is filtered in chunks of at most this many frames
+static constexpr samples_t LOUDNESS_CHUNK_FRAMES = 512;
+
+//! NOTE BS.1770-4 channel weights; the LFE channel of a 5.1 layout is not measured
+static double loudnessChannelWeight(audioch_t audioChNum, audioch_t audioChannelsCount)
+{
+    if (audioChannelsCount == 6) {
+        static constexpr double WEIGHTS_5_1[] = { 1.0, 1.0, 1.0, 0.0, 1.41, 1.41 };
+        return WEIGHTS_5_1[audioChNum];
+    }
+
+    return audioChNum < 3 ? 1.0 : 1.41;
+}
+
+static float energyToLoudness(double energy)
+{
+    const float minimum = MINIMUM_OPERABLE_DBFS_LEVEL;
+
+    if (energy <= 0.0) {
+        return minimum;
+    }
+
+    return std::max(static_cast<float>(-0.691 + 10.0 * std::log10(energy)), minimum);
+}
+
+static inline double processBiquad(double x, double b0, double b1, double b2, double a1, double a2, double& z1, double& z2)
+{
+    const double y = b0 * x + z1;
+    z1 = b1 * x - a1 * y + z2;
+    z2 = b2 * x - a2 * y;
+    return y;
+}
+
+LoudnessMeter::LoudnessMeter(sample_rate_t sampleRate, audioch_t audioChannelsCount)
+    : m_sampleRate(sampleRate), m_audioChannelsCount(audioChannelsCount)
+{
+    //! NOTE The K-weighting filters of BS.1770, recomputed for the actual sample rate
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(LOUDNESS_PI * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        m_shelvingFilter.b0 = (vh + vb * k / q + k * k) / a0;
+        m_shelvingFilter.b1 = 2.0 * (k * k - vh) / a0;
+        m_shelvingFilter.b2 = (vh - vb * k / q + k * k) / a0;
+        m_shelvingFilter.a1 = 2.0 * (k * k - 1.0) / a0;
+        m_shelvingFilter.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(LOUDNESS_PI * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        m_highPassFilter.b0 = 1.0;
+        m_highPassFilter.b1 = -2.0;
+        m_highPassFilter.b2 = 1.0;
+        m_highPassFilter.a1 = 2.0 * (k * k - 1.0) / a0;
+        m_highPassFilter.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    const size_t historyStride = TRUE_PEAK_TAPS - 1 + LOUDNESS_CHUNK_FRAMES;
+
+    m_channels.resize(audioChannelsCount);
+    m_histories.resize(historyStride * audioChannelsCount);
+    m_weightedSamples.resize(LOUDNESS_CHUNK_FRAMES);
+
+    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
+        m_channels[audioChNum].weight = loudnessChannelWeight(audioChNum, audioChannelsCount);
+        m_channels[audioChNum].history = m_histories.data() + audioChNum * historyStride;
+    }
+
+    m_subBlockFrames = std::max<samples_t>(1, sampleRate / 10);
+
+    truePeakCoefficients();
+    reset();
+}
+
+sample_rate_t LoudnessMeter::sampleRate() const
+{
+    return m_sampleRate;
+}
+
+audioch_t LoudnessMeter::audioChannelsCount() const
+{
+    return m_audioChannelsCount;
+}
+
+void LoudnessMeter::reset()
+{
+    for (ChannelState& channel : m_channels) {
+        channel.filterState.fill(0.0);
+    }
+
+    std::fill(m_histories.begin(), m_histories.end(), 0.f);
+
+    m_subBlockPosition = 0;
+    m_subBlockEnergy = 0.0;
+    m_subBlockEnergies.fill(0.0);
+    m_subBlocksCount = 0;
+
+    m_histogramEnergies.fill(0.0);
+    m_histogramCounts.fill(0);
+
+    m_momentaryEnergy = 0.0;
+    m_shortTermEnergy = 0.0;
+    m_integratedLoudness = MINIMUM_OPERABLE_DBFS_LEVEL;
+    m_truePeak = 0.f;
+}
+
+void LoudnessMeter::process(const float* buffer, samples_t samplesPerChannel)
+{
+    samples_t processed = 0;
+
+    while (processed < samplesPerChannel) {
+        const samples_t frames = std::min({ samplesPerChannel - processed,
+                                            m_subBlockFrames - m_subBlockPosition,
+                                            LOUDNESS_CHUNK_FRAMES });
+
+        processChunk(buffer + processed * m_audioChannelsCount, frames);
+
+        processed += frames;
+        m_subBlockPosition += frames;
+
+        if (m_subBlockPosition == m_subBlockFrames) {
+            finishSubBlock();
+        }
+    }
+}
+
+void LoudnessMeter::processChunk(const float* buffer, samples_t frames)
+{
+    const TruePeakCoefficients& coefficients = truePeakCoefficients();
+    const Biquad& s = m_shelvingFilter;
+    const Biquad& h = m_highPassFilter;
+
+    float truePeak = m_truePeak;
+
+    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+        ChannelState& channel = m_channels[audioChNum];
+        float* input = channel.history + TRUE_PEAK_TAPS - 1;
+
+        double& z1 = channel.filterState[0];
+        double& z2 = channel.filterState[1];
+        double& z3 = channel.filterState[2];
+        double& z4 = channel.filterState[3];
+
+        for (samples_t i = 0; i < frames; ++i) {
+            const float x = buffer[i * m_audioChannelsCount + audioChNum];
+            input[i] = x;
+
+            const double shelved = processBiquad(x, s.b0, s.b1, s.b2, s.a1, s.a2, z1, z2);
+            m_weightedSamples[i] = static_cast<float>(processBiquad(shelved, h.b0, h.b1, h.b2, h.a1, h.a2, z3, z4));
+        }
+
+        if (channel.weight > 0.0) {
+            m_subBlockEnergy += channel.weight * dsp::sumOfSquares(m_weightedSamples.data(), frames);
+        }
+
+        //! NOTE The original samples are checked too, the interpolation filter may slightly attenuate them
+        for (samples_t i = 0; i < frames; ++i) {
+            truePeak = std::max(truePeak, std::abs(input[i]));
+        }
+
+        truePeak = std::max(truePeak, dsp::interpolatedPeak(channel.history, frames, coefficients.data(), TRUE_PEAK_TAPS));
+
+        std::memmove(channel.history, channel.history + frames, (TRUE_PEAK_TAPS - 1) * sizeof(float));
+    }
+
+    m_truePeak = truePeak;
+}
+
+void LoudnessMeter::finishSubBlock()
+{
+    m_subBlockEnergies[m_subBlocksCount % SHORT_TERM_SUB_BLOCKS] = m_subBlockEnergy / m_subBlockFrames;
+    ++m_subBlocksCount;
+
+    m_subBlockPosition = 0;
+    m_subBlockEnergy = 0.0;
+
+    //! NOTE The windows are filled with silence until enough audio is measured
+    double momentary = 0.0;
+    double shortTerm = 0.0;
+
+    for (size_t i = 0; i < SHORT_TERM_SUB_BLOCKS; ++i) {
+        const size_t age = (m_subBlocksCount + SHORT_TERM_SUB_BLOCKS - 1 - i) % SHORT_TERM_SUB_BLOCKS;
+        shortTerm += m_subBlockEnergies[i];
+
+        if (age < MOMENTARY_SUB_BLOCKS) {
+            momentary += m_subBlockEnergies[i];
+        }
+    }
+
+    m_momentaryEnergy = momentary / MOMENTARY_SUB_BLOCKS;
+    m_shortTermEnergy = shortTerm / SHORT_TERM_SUB_BLOCKS;
+
+    //! NOTE The gating blocks are the momentary windows, overlapping by 75%
+    if (m_subBlocksCount < MOMENTARY_SUB_BLOCKS) {
+        return;
+    }
+
+    const double loudness = -0.691 + 10.0 * std::log10(std::max(m_momentaryEnergy, 1e-20));
+    if (loudness <= ABSOLUTE_GATE_LUFS) {
+        return;
+    }
+
+    const size_t bin = std::min(static_cast<size_t>((loudness - ABSOLUTE_GATE_LUFS) / HISTOGRAM_BIN_LU), HISTOGRAM_BINS - 1);
+    m_histogramEnergies[bin] += m_momentaryEnergy;
+    ++m_histogramCounts[bin];
+
+    updateIntegratedLoudness();
+}
+
+void LoudnessMeter::updateIntegratedLoudness()
+{
+    double energy = 0.0;
+    uint64_t count = 0;
+
+    for (size_t bin = 0; bin < HISTOGRAM_BINS; ++bin) {
+        energy += m_histogramEnergies[bin];
+        count += m_histogramCounts[bin];
+    }
+
+    if (count == 0) {
+        m_integratedLoudness = MINIMUM_OPERABLE_DBFS_LEVEL;
+        return;
+    }
+
+    //! NOTE The blocks of the bin containing the relative gate are all counted in, the error is below 0.1 LU
+    const double relativeGate = -0.691 + 10.0 * std::log10(energy / count) + RELATIVE_GATE_LU;
+    const double firstBin = std::max(0.0, std::floor((relativeGate - ABSOLUTE_GATE_LUFS) / HISTOGRAM_BIN_LU));
+
+    energy = 0.0;
+    count = 0;
+
+    for (size_t bin = static_cast<size_t>(firstBin); bin < HISTOGRAM_BINS; ++bin) {
+        energy += m_histogramEnergies[bin];
+        count += m_histogramCounts[bin];
+    }
+
+    m_integratedLoudness = count > 0 ? energyToLoudness(energy / count) : static_cast<float>(MINIMUM_OPERABLE_DBFS_LEVEL);
+}
+
+float LoudnessMeter::momentaryLoudness() const
+{
+    return energyToLoudness(m_momentaryEnergy);
+}
+
+float LoudnessMeter::shortTermLoudness() const
+{
+    return energyToLoudness(m_shortTermEnergy);
+}
+
+float LoudnessMeter::integratedLoudness() const
+{
+    return m_integratedLoudness;
+}
+
+float LoudnessMeter::truePeak() const
+{
+    return m_truePeak;
+}
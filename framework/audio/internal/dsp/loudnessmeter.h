@@ -0,0 +1,104 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_LOUDNESSMETER_H
+#define MUSE_AUDIO_LOUDNESSMETER_H
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "../../audiotypes.h"
+
+namespace muse::audio::dsp {
+//! NOTE EBU R128 / ITU-R BS.1770-4 loudness and 4x oversampled true-peak measurement of an interleaved stream.
+//! All the memory is allocated in the constructor, process() doesn't allocate and adds no latency to the signal.
+//! The loudness values are in LUFS and never go below MINIMUM_OPERABLE_DBFS_LEVEL
+class LoudnessMeter
+{
+public:
+    LoudnessMeter(sample_rate_t sampleRate, audioch_t audioChannelsCount);
+
+    sample_rate_t sampleRate() const;
+    audioch_t audioChannelsCount() const;
+
+    void process(const float* buffer, samples_t samplesPerChannel);
+    void reset();
+
+    float momentaryLoudness() const;  // 400 ms window
+    float shortTermLoudness() const;  // 3 s window
+    float integratedLoudness() const; // gated, since the last reset
+    float truePeak() const;           // linear, since the last reset
+
+private:
+    struct Biquad {
+        double b0 = 1.0;
+        double b1 = 0.0;
+        double b2 = 0.0;
+        double a1 = 0.0;
+        double a2 = 0.0;
+    };
+
+    struct ChannelState {
+        double weight = 1.0;
+        std::array<double, 4> filterState = {}; // two transposed direct form II biquads
+        float* history = nullptr;               // the last input frames for the true-peak interpolation
+    };
+
+    static constexpr size_t MOMENTARY_SUB_BLOCKS = 4;   // 4 x 100 ms
+    static constexpr size_t SHORT_TERM_SUB_BLOCKS = 30; // 30 x 100 ms
+    static constexpr size_t HISTOGRAM_BINS = 1000;      // 0.1 LU steps from -70 LUFS
+
+    void processChunk(const float* buffer, samples_t frames);
+    void finishSubBlock();
+    void updateIntegratedLoudness();
+
+    sample_rate_t m_sampleRate = 0;
+    audioch_t m_audioChannelsCount = 0;
+
+    Biquad m_shelvingFilter;
+    Biquad m_highPassFilter;
+
+    std::vector<ChannelState> m_channels;
+    std::vector<float> m_histories;       // per channel: the interpolation history followed by a chunk of input
+    std::vector<float> m_weightedSamples; // a chunk of one K-weighted channel
+
+    samples_t m_subBlockFrames = 0;
+    samples_t m_subBlockPosition = 0;
+    double m_subBlockEnergy = 0.0;
+
+    std::array<double, SHORT_TERM_SUB_BLOCKS> m_subBlockEnergies = {};
+    size_t m_subBlocksCount = 0;
+
+    std::array<double, HISTOGRAM_BINS> m_histogramEnergies = {};
+    std::array<uint64_t, HISTOGRAM_BINS> m_histogramCounts = {};
+
+    double m_momentaryEnergy = 0.0;
+    double m_shortTermEnergy = 0.0;
+    float m_integratedLoudness = 0.f;
+    float m_truePeak = 0.f;
+};
+
+using LoudnessMeterPtr = std::unique_ptr<LoudnessMeter>;
+}
+
+#endif // MUSE_AUDIO_LOUDNESSMETER_H
@@ -0,0 +1,323 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "polyphaseresampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+
+#include "vectorkernels.h"
+
+#include "log.h"
+
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+//! NOTE Ratios like 44100 -> 48001 would need tens of thousands of phases,
+//! so above this limit the nearest phase of a coarser table is used instead
+static constexpr uint64_t MAX_PHASES_COUNT = 1024;
+static constexpr double RESAMPLER_PI = 3.14159265358979323846;
+
+//! NOTE The history has room for this many blocks, so it is compacted once per this many process() calls at most
+static constexpr size_t INPUT_BLOCKS_CAPACITY = 4;
+
+struct QualityPreset {
+    size_t tapsCount = 0;
+    double attenuationDb = 0.0;
+};
+
+static QualityPreset qualityPreset(PolyphaseResampler::Quality quality)
+{
+    switch (quality) {
+    case PolyphaseResampler::Quality::Low: return { 24, 70.0 };
+    case PolyphaseResampler::Quality::Medium: return { 64, 100.0 };
+    case PolyphaseResampler::Quality::High: return { 128, 120.0 };
+    }
+
+    return { 64, 100.0 };
+}
+
+static double besselI0(const double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x / 2.0;
+
+    for (int k = 1; k < 64; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+
+    return sum;
+}
+
+static double kaiserBeta(const double attenuationDb)
+{
+    if (attenuationDb > 50.0) {
+        return 0.1102 * (attenuationDb - 8.7);
+    }
+
+    if (attenuationDb >= 21.0) {
+        return 0.5842 * std::pow(attenuationDb - 21.0, 0.4) + 0.07886 * (attenuationDb - 21.0);
+    }
+
+    return 0.0;
+}
+
+PolyphaseResampler::PolyphaseResampler(sample_rate_t sampleRateIn, sample_rate_t sampleRateOut, audioch_t audioChannelsCount,
+                                       Quality quality, samples_t maxInputFrames)
+    : m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut), m_audioChannelsCount(audioChannelsCount), m_quality(quality)
+{
+    IF_ASSERT_FAILED(sampleRateIn > 0 && sampleRateOut > 0 && audioChannelsCount > 0) {
+        m_sampleRateIn = m_sampleRateOut = 1;
+        m_audioChannelsCount = std::max<audioch_t>(audioChannelsCount, 1);
+    }
+
+    const uint64_t divisor = std::gcd<uint64_t>(m_sampleRateIn, m_sampleRateOut);
+    m_upFactor = m_sampleRateOut / divisor;
+    m_downFactor = m_sampleRateIn / divisor;
+
+    m_table = coefficientTable(m_upFactor, m_downFactor, m_quality);
+    m_inputs.resize(m_audioChannelsCount);
+
+    reserveInputs(std::max<samples_t>(maxInputFrames, 1));
+    reset();
+}
+
+sample_rate_t PolyphaseResampler::sampleRateIn() const
+{
+    return m_sampleRateIn;
+}
+
+sample_rate_t PolyphaseResampler::sampleRateOut() const
+{
+    return m_sampleRateOut;
+}
+
+audioch_t PolyphaseResampler::audioChannelsCount() const
+{
+    return m_audioChannelsCount;
+}
+
+PolyphaseResampler::Quality PolyphaseResampler::quality() const
+{
+    return m_quality;
+}
+
+samples_t PolyphaseResampler::maxOutputFrames(samples_t inputFrames) const
+{
+    const uint64_t frames = (static_cast<uint64_t>(inputFrames) * m_upFactor + m_downFactor - 1) / m_downFactor;
+    return static_cast<samples_t>(frames + 1);
+}
+
+samples_t PolyphaseResampler::latency() const
+{
+    //! NOTE The center of the prototype filter, converted from the upsampled rate to the output rate
+    const double center = (static_cast<double>(m_table->tapsCount * m_upFactor) - 1.0) / 2.0;
+    return static_cast<samples_t>(std::lround(center / static_cast<double>(m_downFactor)));
+}
+
+samples_t PolyphaseResampler::process(const float* in, samples_t inputFrames, float* out)
+{
+    const size_t tapsCount = m_table->tapsCount;
+    const size_t historySize = tapsCount - 1;
+
+    if (m_end + inputFrames > m_inputs.front().size()) {
+        //! NOTE Move the history back to the front
+        const size_t liveFrames = m_end - m_begin;
+        if (m_begin > 0) {
+            for (std::vector<float>& input : m_inputs) {
+                std::copy(input.begin() + m_begin, input.begin() + m_end, input.begin());
+            }
+
+            m_position -= m_begin;
+            m_begin = 0;
+            m_end = liveFrames;
+        }
+
+        //! NOTE Only a block larger than the one given to the constructor gets here
+        if (m_end + inputFrames > m_inputs.front().size()) {
+            reserveInputs(inputFrames);
+        }
+    }
+
+    for (audioch_t ch = 0; ch < m_audioChannelsCount; ++ch) {
+        float* dst = m_inputs[ch].data() + m_end;
+        for (samples_t frame = 0; frame < inputFrames; ++frame) {
+            dst[frame] = in[frame * m_audioChannelsCount + ch];
+        }
+    }
+
+    m_end += inputFrames;
+
+    const float* coefficients = m_table->coefficients.data();
+    const uint64_t phasesCount = m_table->phasesCount;
+
+    samples_t outputFrames = 0;
+
+    while (m_position < m_end) {
+        const uint64_t phaseIdx = phasesCount == m_upFactor ? m_phase : m_phase * phasesCount / m_upFactor;
+        const float* phaseCoefficients = coefficients + phaseIdx * tapsCount;
+        const size_t firstFrame = m_position - historySize;
+
+        float* dst = out + outputFrames * m_audioChannelsCount;
+        for (audioch_t ch = 0; ch < m_audioChannelsCount; ++ch) {
+            dst[ch] = dsp::dotProduct(m_inputs[ch].data() + firstFrame, phaseCoefficients, tapsCount);
+        }
+
+        ++outputFrames;
+
+        m_phase += m_downFactor;
+        m_position += m_phase / m_upFactor;
+        m_phase %= m_upFactor;
+    }
+
+    //! NOTE Keep only the history which the next output frames still need
+    m_begin = std::min(m_position - historySize, m_end);
+
+    return outputFrames;
+}
+
+void PolyphaseResampler::reset()
+{
+    const size_t historySize = m_table->tapsCount - 1;
+
+    for (std::vector<float>& input : m_inputs) {
+        std::fill_n(input.begin(), historySize, 0.f);
+    }
+
+    m_begin = 0;
+    m_end = historySize;
+    m_position = historySize;
+    m_phase = 0;
+}
+
+void PolyphaseResampler::reserveInputs(samples_t inputFrames)
+{
+    const size_t historySize = m_table->tapsCount - 1;
+    const size_t capacity = historySize + INPUT_BLOCKS_CAPACITY * inputFrames;
+
+    for (std::vector<float>& input : m_inputs) {
+        if (input.size() < capacity) {
+            input.resize(capacity, 0.f);
+        }
+    }
+}
+
+void PolyphaseResampler::prepareCommonTables(Quality quality)
+{
+    static const sample_rate_t COMMON_SAMPLE_RATES[] = { 44100, 48000, 96000 };
+
+    for (sample_rate_t rateIn : COMMON_SAMPLE_RATES) {
+        for (sample_rate_t rateOut : COMMON_SAMPLE_RATES) {
+            if (rateIn == rateOut) {
+                continue;
+            }
+
+            const uint64_t divisor = std::gcd<uint64_t>(rateIn, rateOut);
+            coefficientTable(rateOut / divisor, rateIn / divisor, quality);
+        }
+    }
+}
+
+PolyphaseResampler::CoefficientTablePtr PolyphaseResampler::coefficientTable(uint64_t upFactor, uint64_t downFactor, Quality quality)
+{
+    using Key = std::tuple<uint64_t, uint64_t, Quality>;
+
+    static std::mutex s_mutex;
+    static std::map<Key, CoefficientTablePtr> s_tables;
+
+    std::lock_guard lock(s_mutex);
+
+    CoefficientTablePtr& table = s_tables[Key(upFactor, downFactor, quality)];
+    if (!table) {
+        table = makeCoefficientTable(upFactor, downFactor, quality);
+    }
+
+    return table;
+}
+
+PolyphaseResampler::CoefficientTablePtr PolyphaseResampler::makeCoefficientTable(uint64_t upFactor, uint64_t downFactor,
+                                                                                   Quality quality)
+{
+    const QualityPreset preset = qualityPreset(quality);
+
+    //! NOTE The preset describes the filter at the lower of the two rates,
+    //! so when downsampling the filter is stretched over more input frames
+    const double narrowing = std::min(1.0, static_cast<double>(upFactor) / static_cast<double>(downFactor));
+    const size_t tapsCount = static_cast<size_t>(std::ceil(preset.tapsCount / narrowing));
+
+    const uint64_t phasesCount = std::min(upFactor, MAX_PHASES_COUNT);
+
+    //! NOTE Kaiser's estimate of the transition width, in cycles per sample of the lower rate;
+    //! the stopband starts exactly at the Nyquist frequency of the lower rate
+    const double transitionWidth = (preset.attenuationDb - 7.95) / (2.285 * 2.0 * RESAMPLER_PI * preset.tapsCount);
+    const double cutoff = (0.5 - transitionWidth / 2.0) * narrowing; // cycles per input frame
+
+    const double beta = kaiserBeta(preset.attenuationDb);
+    const double besselI0Beta = besselI0(beta);
+
+    const double filterLength = static_cast<double>(tapsCount * phasesCount);
+    const double center = (filterLength - 1.0) / 2.0;
+
+    auto prototype = [&](size_t idx) {
+        const double t = (static_cast<double>(idx) - center) / static_cast<double>(phasesCount); // in input frames
+        const double x = 2.0 * cutoff * t;
+        const double sinc = std::abs(x) < 1e-12 ? 1.0 : std::sin(RESAMPLER_PI * x) / (RESAMPLER_PI * x);
+
+        const double r = (static_cast<double>(idx) - center) / (center + 0.5);
+        const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0Beta;
+
+        return 2.0 * cutoff * sinc * window;
+    };
+
+    auto table = std::make_shared<CoefficientTable>();
+    table->phasesCount = phasesCount;
+    table->tapsCount = tapsCount;
+    table->coefficients.resize(phasesCount * tapsCount);
+
+    std::vector<double> phase(tapsCount);
+
+    for (size_t p = 0; p < phasesCount; ++p) {
+        double sum = 0.0;
+        for (size_t q = 0; q < tapsCount; ++q) {
+            phase[q] = prototype(p + q * phasesCount);
+            sum += phase[q];
+        }
+
+        //! NOTE Normalize every phase to the unity gain at DC, so that there is no DC ripple between the phases
+        float* dst = table->coefficients.data() + p * tapsCount;
+        for (size_t q = 0; q < tapsCount; ++q) {
+            dst[tapsCount - 1 - q] = static_cast<float>(phase[q] / sum);
+        }
+    }
+
+    return table;
+}
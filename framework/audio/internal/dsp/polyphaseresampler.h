@@ -0,0 +1,104 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_POLYPHASERESAMPLER_H
+#define MUSE_AUDIO_POLYPHASERESAMPLER_H
+
+#include <memory>
+#include <vector>
+
+#include "../../audiotypes.h"
+
+namespace muse::audio::dsp {
+//! NOTE Streaming sample rate conversion by a rational ratio L/M with a Kaiser windowed-sinc polyphase filter.
+//! The coefficient tables are computed once per ratio and quality, and shared between the instances
+class PolyphaseResampler
+{
+public:
+    static constexpr samples_t DEFAULT_MAX_INPUT_FRAMES = 4096;
+
+    enum class Quality {
+        Low,     // 24 taps, 70 dB stopband attenuation
+        Medium,  // 64 taps, 100 dB
+        High     // 128 taps, 120 dB
+    };
+
+    //! NOTE The input history is allocated here for blocks of up to maxInputFrames,
+    //! so that process() doesn't allocate as long as the blocks don't exceed it
+    PolyphaseResampler(sample_rate_t sampleRateIn, sample_rate_t sampleRateOut, audioch_t audioChannelsCount,
+                       Quality quality = Quality::Medium, samples_t maxInputFrames = DEFAULT_MAX_INPUT_FRAMES);
+
+    sample_rate_t sampleRateIn() const;
+    sample_rate_t sampleRateOut() const;
+    audioch_t audioChannelsCount() const;
+    Quality quality() const;
+
+    //! NOTE The size of the output buffer which process() needs for the given number of input frames
+    samples_t maxOutputFrames(samples_t inputFrames) const;
+
+    //! NOTE The delay of the filter, in output frames
+    samples_t latency() const;
+
+    //! NOTE Consumes all the input frames and writes the frames which can be computed so far.
+    //! The buffers are interleaved, returns the number of the written output frames
+    samples_t process(const float* in, samples_t inputFrames, float* out);
+
+    void reset();
+
+    //! NOTE Computes the tables of the common ratios (44.1, 48 and 96 kHz) ahead of time
+    static void prepareCommonTables(Quality quality);
+
+private:
+    struct CoefficientTable {
+        size_t phasesCount = 0;
+        size_t tapsCount = 0;
+        std::vector<float> coefficients; // phasesCount x tapsCount, the taps of a phase are reversed in time
+    };
+
+    using CoefficientTablePtr = std::shared_ptr<const CoefficientTable>;
+
+    static CoefficientTablePtr coefficientTable(uint64_t upFactor, uint64_t downFactor, Quality quality);
+    static CoefficientTablePtr makeCoefficientTable(uint64_t upFactor, uint64_t downFactor, Quality quality);
+
+    void reserveInputs(samples_t inputFrames);
+
+    sample_rate_t m_sampleRateIn = 0;
+    sample_rate_t m_sampleRateOut = 0;
+    audioch_t m_audioChannelsCount = 0;
+    Quality m_quality = Quality::Medium;
+
+    uint64_t m_upFactor = 1;   // L
+    uint64_t m_downFactor = 1; // M
+
+    CoefficientTablePtr m_table;
+
+    //! NOTE Per channel: the last (taps - 1) input frames followed by the not yet consumed ones, in [m_begin, m_end).
+    //! The window slides forward and is moved back to the front only when the next block doesn't fit behind it
+    std::vector<std::vector<float> > m_inputs;
+    size_t m_begin = 0;
+    size_t m_end = 0;
+    size_t m_position = 0; // the newest input frame of the next output frame, an index in m_inputs
+    uint64_t m_phase = 0;  // [0, L)
+};
+}
+
+#endif // MUSE_AUDIO_POLYPHASERESAMPLER_H
@@ -0,0 +1,61 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "truepeakfilter.h"
+
+#include <cmath>
+
+using namespace muse::audio::dsp;
+
+static constexpr double TRUE_PEAK_PI = 3.14159265358979323846;
+
+const TruePeakCoefficients& muse::audio::dsp::truePeakCoefficients()
+{
+    static const TruePeakCoefficients coefficients = []() {
+        TruePeakCoefficients result {};
+
+        const size_t length = TRUE_PEAK_PHASES * TRUE_PEAK_TAPS;
+        const double center = (static_cast<double>(length) - 1.0) / 2.0;
+
+        for (size_t p = 0; p < TRUE_PEAK_PHASES; ++p) {
+            double phase[TRUE_PEAK_TAPS];
+            double sum = 0.0;
+
+            for (size_t q = 0; q < TRUE_PEAK_TAPS; ++q) {
+                const size_t idx = p + q * TRUE_PEAK_PHASES;
+                const double t = (static_cast<double>(idx) - center) / TRUE_PEAK_PHASES;
+                const double sinc = std::abs(t) < 1e-12 ? 1.0 : std::sin(TRUE_PEAK_PI * t) / (TRUE_PEAK_PI * t);
+                const double window = 0.5 - 0.5 * std::cos(2.0 * TRUE_PEAK_PI * (static_cast<double>(idx) + 1.0) / (length + 1.0));
+
+                phase[q] = sinc * window;
+                sum += phase[q];
+            }
+
+            for (size_t q = 0; q < TRUE_PEAK_TAPS; ++q) {
+                result[(TRUE_PEAK_TAPS - 1 - q) * TRUE_PEAK_PHASES + p] = static_cast<float>(phase[q] / sum);
+            }
+        }
+
+        return result;
+    }();
+
+    return coefficients;
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_TRUEPEAKFILTER_H
+#define MUSE_AUDIO_TRUEPEAKFILTER_H
+
+#include <array>
+#include <cstddef>
+
+namespace muse::audio::dsp {
+//! NOTE The interpolation filter of the true-peak measurement: 4 phases of 12 taps, as in BS.1770-4 Annex 2
+static constexpr size_t TRUE_PEAK_PHASES = 4;
+static constexpr size_t TRUE_PEAK_TAPS = 12;
+
+//! NOTE The interpolated values of a window of TRUE_PEAK_TAPS input samples lie
+//! between the samples TRUE_PEAK_DELAY - 1 and TRUE_PEAK_DELAY of the window
+static constexpr size_t TRUE_PEAK_DELAY = TRUE_PEAK_TAPS / 2;
+
+using TruePeakCoefficients = std::array<float, TRUE_PEAK_PHASES * TRUE_PEAK_TAPS>;
+
+//! NOTE Hann windowed sinc with the cutoff at the input Nyquist frequency.
+//! The taps are reversed in time, the 4 phases of a tap are stored next to each other (see VectorKernels::interpolatedPeak)
+const TruePeakCoefficients& truePeakCoefficients();
+}
+
+#endif // MUSE_AUDIO_TRUEPEAKFILTER_H
@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "vectorkernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cpufeatures.h"
+#include "vectorkernels_p.h"
+
+#include "log.h"
+
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+static void accumulateScalar(float* dst, const float* src, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+static void accumulateScaledScalar(float* dst, const float* src, float gain, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+static void applyGainsScalar(float* buffer, samples_t samplesPerChannel, audioch_t channels, const gain_t* gains, float* squaredSums)
+{
+    for (audioch_t ch = 0; ch < channels; ++ch) {
+        squaredSums[ch] = 0.f;
+    }
+
+    kernels::applyGainsScalarTail(buffer, 0, samplesPerChannel * channels, channels, gains, squaredSums);
+}
+
+static float sumOfSquaresScalar(const float* src, size_t count)
+{
+    float sum = 0.f;
+
+    for (size_t i = 0; i < count; ++i) {
+        sum += src[i] * src[i];
+    }
+
+    return sum;
+}
+
+static float dotProductScalar(const float* a, const float* b, size_t count)
+{
+    float sum = 0.f;
+
+    for (size_t i = 0; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+static float interpolatedPeakScalar(const float* src, size_t count, const float* coefficients, size_t taps)
+{
+    float peak = 0.f;
+
+    for (size_t i = 0; i < count; ++i) {
+        float acc[4] = { 0.f, 0.f, 0.f, 0.f };
+
+        for (size_t j = 0; j < taps; ++j) {
+            for (size_t p = 0; p < 4; ++p) {
+                acc[p] += coefficients[j * 4 + p] * src[i + j];
+            }
+        }
+
+        for (size_t p = 0; p < 4; ++p) {
+            peak = std::max(peak, std::abs(acc[p]));
+        }
+    }
+
+    return peak;
+}
+
+static void interleaveStereoScalar(float* dst, const float* left, const float* right, samples_t frames)
+{
+    kernels::interleaveStereoScalarTail(dst, left, right, 0, frames);
+}
+
+static void deinterleaveStereoScalar(float* left, float* right, const float* src, samples_t frames)
+{
+    kernels::deinterleaveStereoScalarTail(left, right, src, 0, frames);
+}
+
+void kernels::applyGainsScalarTail(float* buffer, size_t begin, size_t end, audioch_t channels, const gain_t* gains,
+                                   float* squaredSums)
+{
+    audioch_t ch = begin % channels;
+
+    for (size_t i = begin; i < end; ++i) {
+        float sample = buffer[i] * gains[ch];
+        buffer[i] = sample;
+        squaredSums[ch] += sample * sample;
+
+        if (++ch == channels) {
+            ch = 0;
+        }
+    }
+}
+
+void kernels::interleaveStereoScalarTail(float* dst, const float* left, const float* right, samples_t begin, samples_t end)
+{
+    for (samples_t i = begin; i < end; ++i) {
+        dst[i * 2] = left[i];
+        dst[i * 2 + 1] = right[i];
+    }
+}
+
+void kernels::deinterleaveStereoScalarTail(float* left, float* right, const float* src, samples_t begin, samples_t end)
+{
+    for (samples_t i = begin; i < end; ++i) {
+        left[i] = src[i * 2];
+        right[i] = src[i * 2 + 1];
+    }
+}
+
+const VectorKernels* kernels::scalarKernels()
+{
+    static const VectorKernels kernels {
+        accumulateScalar,
+        accumulateScaledScalar,
+        applyGainsScalar,
+        sumOfSquaresScalar,
+        dotProductScalar,
+        interpolatedPeakScalar,
+        interleaveStereoScalar,
+        deinterleaveStereoScalar
+    };
+
+    return &kernels;
+}
+
+const VectorKernels* dsp::vectorKernels(VectorBackend backend)
+{
+    switch (backend) {
+    case VectorBackend::Scalar: return kernels::scalarKernels();
+    case VectorBackend::SSE2: return kernels::sse2Kernels();
+    case VectorBackend::AVX2: return cpuSupportsAvx2() ? kernels::avx2Kernels() : nullptr;
+    case VectorBackend::NEON: return kernels::neonKernels();
+    }
+
+    return nullptr;
+}
+
+bool dsp::isVectorBackendAvailable(VectorBackend backend)
+{
+    return vectorKernels(backend) != nullptr;
+}
+
+VectorBackend dsp::bestAvailableVectorBackend()
+{
+    static const VectorBackend best = []() {
+        for (VectorBackend backend : { VectorBackend::AVX2, VectorBackend::SSE2, VectorBackend::NEON }) {
+            if (isVectorBackendAvailable(backend)) {
+                return backend;
+            }
+        }
+
+        return VectorBackend::Scalar;
+    }();
+
+    return best;
+}
+
+const char* dsp::vectorBackendName(VectorBackend backend)
+{
+    switch (backend) {
+    case VectorBackend::Scalar: return "Scalar";
+    case VectorBackend::SSE2: return "SSE2";
+    case VectorBackend::AVX2: return "AVX2";
+    case VectorBackend::NEON: return "NEON";
+    }
+
+    return "Unknown";
+}
+
+const VectorKernels& dsp::activeVectorKernels()
+{
+    static const VectorKernels* kernels = []() {
+        VectorBackend backend = bestAvailableVectorBackend();
+        LOGI() << "Audio vector kernels: " << vectorBackendName(backend);
+        return vectorKernels(backend);
+    }();
+
+    return *kernels;
+}
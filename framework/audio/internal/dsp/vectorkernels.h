@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_VECTORKERNELS_H
+#define MUSE_AUDIO_VECTORKERNELS_H
+
+#include <cstddef>
+
+#include "../../audiotypes.h"
+
+namespace muse::audio::dsp {
+enum class VectorBackend {
+    Scalar = 0,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+//! NOTE Hot-path kernels of the mixer, operating on interleaved buffers,
+//! and the conversions between the interleaved and the planar layouts
+struct VectorKernels {
+    //! dst[i] += src[i]
+    void (*accumulate)(float* dst, const float* src, size_t count) = nullptr;
+
+    //! dst[i] += src[i] * gain
+    void (*accumulateScaled)(float* dst, const float* src, float gain, size_t count) = nullptr;
+
+    //! buffer[s * channels + ch] *= gains[ch], squaredSums[ch] receives the sum of squares of the result per channel
+    void (*applyGains)(float* buffer, samples_t samplesPerChannel, audioch_t channels, const gain_t* gains, float* squaredSums) = nullptr;
+
+    //! Returns the sum of src[i] * src[i]
+    float (*sumOfSquares)(const float* src, size_t count) = nullptr;
+
+    //! Returns the sum of a[i] * b[i]
+    float (*dotProduct)(const float* a, const float* b, size_t count) = nullptr;
+
+    //! 4x polyphase interpolation: returns the largest |sum_j coefficients[j * 4 + p] * src[i + j]| over i < count and p < 4.
+    //! src holds count + taps - 1 values
+    float (*interpolatedPeak)(const float* src, size_t count, const float* coefficients, size_t taps) = nullptr;
+
+    //! dst[i * 2] = left[i], dst[i * 2 + 1] = right[i]
+    void (*interleaveStereo)(float* dst, const float* left, const float* right, samples_t frames) = nullptr;
+
+    //! left[i] = src[i * 2], right[i] = src[i * 2 + 1]
+    void (*deinterleaveStereo)(float* left, float* right, const float* src, samples_t frames) = nullptr;
+};
+
+//! NOTE Returns nullptr if the backend is not compiled in or not supported by the CPU
+const VectorKernels* vectorKernels(VectorBackend backend);
+bool isVectorBackendAvailable(VectorBackend backend);
+VectorBackend bestAvailableVectorBackend();
+const char* vectorBackendName(VectorBackend backend);
+
+//! NOTE The kernels of the best available backend, resolved once
+const VectorKernels& activeVectorKernels();
+
+inline void accumulate(float* dst, const float* src, size_t count)
+{
+    activeVectorKernels().accumulate(dst, src, count);
+}
+
+inline void accumulateScaled(float* dst, const float* src, float gain, size_t count)
+{
+    activeVectorKernels().accumulateScaled(dst, src, gain, count);
+}
+
+inline void applyGains(float* buffer, samples_t samplesPerChannel, audioch_t channels, const gain_t* gains, float* squaredSums)
+{
+    activeVectorKernels().applyGains(buffer, samplesPerChannel, channels, gains, squaredSums);
+}
+
+inline float sumOfSquares(const float* src, size_t count)
+{
+    return activeVectorKernels().sumOfSquares(src, count);
+}
+
+inline float dotProduct(const float* a, const float* b, size_t count)
+{
+    return activeVectorKernels().dotProduct(a, b, count);
+}
+
+inline float interpolatedPeak(const float* src, size_t count, const float* coefficients, size_t taps)
+{
+    return activeVectorKernels().interpolatedPeak(src, count, coefficients, taps);
+}
+
+//! NOTE Stereo goes through the kernels, any other layout is converted sample by sample
+inline void interleave(float* dst, const float* const* channels, audioch_t channelsCount, samples_t frames)
+{
+    if (channelsCount == 2) {
+        activeVectorKernels().interleaveStereo(dst, channels[0], channels[1], frames);
+        return;
+    }
+
+    for (audioch_t ch = 0; ch < channelsCount; ++ch) {
+        const float* src = channels[ch];
+
+        for (samples_t i = 0; i < frames; ++i) {
+            dst[i * channelsCount + ch] = src[i];
+        }
+    }
+}
+
+inline void deinterleave(float* const* channels, const float* src, audioch_t channelsCount, samples_t frames)
+{
+    if (channelsCount == 2) {
+        activeVectorKernels().deinterleaveStereo(channels[0], channels[1], src, frames);
+        return;
+    }
+
+    for (audioch_t ch = 0; ch < channelsCount; ++ch) {
+        float* dst = channels[ch];
+
+        for (samples_t i = 0; i < frames; ++i) {
+            dst[i] = src[i * channelsCount + ch];
+        }
+    }
+}
+}
+
+#endif // MUSE_AUDIO_VECTORKERNELS_H
@@ -0,0 +1,254 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "vectorkernels_p.h"
+#include "cpufeatures.h"
+
+//! NOTE Only the kernels below are built with AVX2 enabled (see cpufeatures.h),
+//! they are only used after the CPU support has been checked at runtime
+#ifdef MUSE_AUDIO_ARCH_X86_64
+
+#include <immintrin.h>
+
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+static constexpr size_t AVX2_WIDTH = 8;
+
+MUSE_AUDIO_BEGIN_AVX2_CODE
+
+//! NOTE Not std::max() and std::abs(): their shared inline copies must not be built with AVX2
+static inline float maxAvx2(float a, float b)
+{
+    return a < b ? b : a;
+}
+
+static inline float absAvx2(float v)
+{
+    return v < 0.f ? -v : v;
+}
+
+static inline float horizontalSumAvx2(__m256 v)
+{
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x1));
+    return _mm_cvtss_f32(sum);
+}
+
+static void accumulateAvx2(float* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + AVX2_WIDTH <= count; i += AVX2_WIDTH) {
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+    }
+
+    for (; i < count; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+static void accumulateScaledAvx2(float* dst, const float* src, float gain, size_t count)
+{
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+
+    for (; i + AVX2_WIDTH <= count; i += AVX2_WIDTH) {
+        __m256 scaled = _mm256_mul_ps(_mm256_loadu_ps(src + i), g);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), scaled));
+    }
+
+    for (; i < count; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+static void applyGainsAvx2(float* buffer, samples_t samplesPerChannel, audioch_t channels, const gain_t* gains, float* squaredSums)
+{
+    for (audioch_t ch = 0; ch < channels; ++ch) {
+        squaredSums[ch] = 0.f;
+    }
+
+    const size_t count = samplesPerChannel * channels;
+    size_t i = 0;
+
+    //! NOTE Interleaved frames map onto the vector lanes only if the channels count divides the vector width
+    if (channels != 0 && AVX2_WIDTH % channels == 0) {
+        const __m256 g = _mm256_setr_ps(gains[0], gains[1 % channels], gains[2 % channels], gains[3 % channels],
+                                        gains[4 % channels], gains[5 % channels], gains[6 % channels], gains[7 % channels]);
+        __m256 acc = _mm256_setzero_ps();
+
+        for (; i + AVX2_WIDTH <= count; i += AVX2_WIDTH) {
+            __m256 v = _mm256_mul_ps(_mm256_loadu_ps(buffer + i), g);
+            _mm256_storeu_ps(buffer + i, v);
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(v, v));
+        }
+
+        alignas(32) float lanes[AVX2_WIDTH];
+        _mm256_store_ps(lanes, acc);
+
+        for (size_t lane = 0; lane < AVX2_WIDTH; ++lane) {
+            squaredSums[lane % channels] += lanes[lane];
+        }
+    }
+
+    kernels::applyGainsScalarTail(buffer, i, count, channels, gains, squaredSums);
+}
+
+static float sumOfSquaresAvx2(const float* src, size_t count)
+{
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; i + AVX2_WIDTH <= count; i += AVX2_WIDTH) {
+        __m256 v = _mm256_loadu_ps(src + i);
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(v, v));
+    }
+
+    float sum = horizontalSumAvx2(acc);
+
+    for (; i < count; ++i) {
+        sum += src[i] * src[i];
+    }
+
+    return sum;
+}
+
+static float dotProductAvx2(const float* a, const float* b, size_t count)
+{
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+
+    for (; i + AVX2_WIDTH <= count; i += AVX2_WIDTH) {
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+
+    float sum = horizontalSumAvx2(acc);
+
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+static float interpolatedPeakAvx2(const float* src, size_t count, const float* coefficients, size_t taps)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.f);
+    __m256 peak = _mm256_setzero_ps();
+    size_t i = 0;
+
+    //! NOTE The 4 phases of two consecutive frames fill the vector lanes
+    for (; i + 2 <= count; i += 2) {
+        __m256 acc = _mm256_setzero_ps();
+
+        for (size_t j = 0; j < taps; ++j) {
+            __m256 c = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(coefficients + j * 4));
+            __m256 x = _mm256_set_m128(_mm_set1_ps(src[i + j + 1]), _mm_set1_ps(src[i + j]));
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(c, x));
+        }
+
+        peak = _mm256_max_ps(peak, _mm256_andnot_ps(signMask, acc));
+    }
+
+    alignas(32) float lanes[AVX2_WIDTH];
+    _mm256_store_ps(lanes, peak);
+
+    float result = 0.f;
+    for (float lane : lanes) {
+        result = maxAvx2(result, lane);
+    }
+
+    for (; i < count; ++i) {
+        for (size_t p = 0; p < 4; ++p) {
+            float acc = 0.f;
+            for (size_t j = 0; j < taps; ++j) {
+                acc += coefficients[j * 4 + p] * src[i + j];
+            }
+            result = maxAvx2(result, absAvx2(acc));
+        }
+    }
+
+    return result;
+}
+
+static void interleaveStereoAvx2(float* dst, const float* left, const float* right, samples_t frames)
+{
+    samples_t i = 0;
+
+    for (; i + AVX2_WIDTH <= frames; i += AVX2_WIDTH) {
+        __m256 l = _mm256_loadu_ps(left + i);
+        __m256 r = _mm256_loadu_ps(right + i);
+
+        //! NOTE unpack works within the 128-bit lanes, the halves are put in order afterwards
+        __m256 lo = _mm256_unpacklo_ps(l, r);
+        __m256 hi = _mm256_unpackhi_ps(l, r);
+        _mm256_storeu_ps(dst + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(dst + i * 2 + AVX2_WIDTH, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+
+    kernels::interleaveStereoScalarTail(dst, left, right, i, frames);
+}
+
+static void deinterleaveStereoAvx2(float* left, float* right, const float* src, samples_t frames)
+{
+    samples_t i = 0;
+
+    for (; i + AVX2_WIDTH <= frames; i += AVX2_WIDTH) {
+        __m256 a = _mm256_loadu_ps(src + i * 2);
+        __m256 b = _mm256_loadu_ps(src + i * 2 + AVX2_WIDTH);
+
+        __m256 lo = _mm256_permute2f128_ps(a, b, 0x20);
+        __m256 hi = _mm256_permute2f128_ps(a, b, 0x31);
+        _mm256_storeu_ps(left + i, _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm256_storeu_ps(right + i, _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+
+    kernels::deinterleaveStereoScalarTail(left, right, src, i, frames);
+}
+
+MUSE_AUDIO_END_ISA_CODE
+
+const VectorKernels* kernels::avx2Kernels()
+{
+    static const VectorKernels kernels {
+        accumulateAvx2,
+        accumulateScaledAvx2,
+        applyGainsAvx2,
+        sumOfSquaresAvx2,
+        dotProductAvx2,
+        interpolatedPeakAvx2,
+        interleaveStereoAvx2,
+        deinterleaveStereoAvx2
+    };
+
+    return &kernels;
+}
+
+#else
+
+const muse::audio::dsp::VectorKernels* muse::audio::dsp::kernels::avx2Kernels()
+{
+    return nullptr;
+}
+
+#endif
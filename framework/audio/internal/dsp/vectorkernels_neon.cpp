@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "vectorkernels_p.h"
+
+#include <algorithm>
+
+#if defined(__arm64__) || defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+static constexpr size_t NEON_WIDTH = 4;
+
+static void accumulateNeon(float* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + NEON_WIDTH <= count; i += NEON_WIDTH) {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+    }
+
+    for (; i < count; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+static void accumulateScaledNeon(float* dst, const float* src, float gain, size_t count)
+{
+    const float32x4_t g = vdupq_n_f32(gain);
+    size_t i = 0;
+
+    for (; i + NEON_WIDTH <= count; i += NEON_WIDTH) {
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g));
+    }
+
+    for (; i < count; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+static void applyGainsNeon(float* buffer, samples_t samplesPerChannel, audioch_t channels, const gain_t* gains, float* squaredSums)
+{
+    for (audioch_t ch = 0; ch < channels; ++ch) {
+        squaredSums[ch] = 0.f;
+    }
+
+    const size_t count = samplesPerChannel * channels;
+    size_t i = 0;
+
+    //! NOTE Interleaved frames map onto the vector lanes only if the channels count divides the vector width
+    if (channels != 0 && NEON_WIDTH % channels == 0) {
+        const float laneGains[NEON_WIDTH] = { gains[0], gains[1 % channels], gains[2 % channels], gains[3 % channels] };
+        const float32x4_t g = vld1q_f32(laneGains);
+        float32x4_t acc = vdupq_n_f32(0.f);
+
+        for (; i + NEON_WIDTH <= count; i += NEON_WIDTH) {
+            float32x4_t v = vmulq_f32(vld1q_f32(buffer + i), g);
+            vst1q_f32(buffer + i, v);
+            acc = vmlaq_f32(acc, v, v);
+        }
+
+        float lanes[NEON_WIDTH];
+        vst1q_f32(lanes, acc);
+
+        for (size_t lane = 0; lane < NEON_WIDTH; ++lane) {
+            squaredSums[lane % channels] += lanes[lane];
+        }
+    }
+
+    kernels::applyGainsScalarTail(buffer, i, count, channels, gains, squaredSums);
+}
+
+static float sumOfSquaresNeon(const float* src, size_t count)
+{
+    float32x4_t acc = vdupq_n_f32(0.f);
+    size_t i = 0;
+
+    for (; i + NEON_WIDTH <= count; i += NEON_WIDTH) {
+        float32x4_t v = vld1q_f32(src + i);
+        acc = vmlaq_f32(acc, v, v);
+    }
+
+    float sum = vaddvq_f32(acc);
+
+    for (; i < count; ++i) {
+        sum += src[i] * src[i];
+    }
+
+    return sum;
+}
+
+static float dotProductNeon(const float* a, const float* b, size_t count)
+{
+    float32x4_t acc = vdupq_n_f32(0.f);
+    size_t i = 0;
+
+    for (; i + NEON_WIDTH <= count; i += NEON_WIDTH) {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+
+    float sum = vaddvq_f32(acc);
+
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+static float interpolatedPeakNeon(const float* src, size_t count, const float* coefficients, size_t taps)
+{
+    float32x4_t peak = vdupq_n_f32(0.f);
+
+    //! NOTE The 4 phases of one frame fill the vector lanes
+    for (size_t i = 0; i < count; ++i) {
+        float32x4_t acc = vdupq_n_f32(0.f);
+
+        for (size_t j = 0; j < taps; ++j) {
+            acc = vmlaq_n_f32(acc, vld1q_f32(coefficients + j * 4), src[i + j]);
+        }
+
+        peak = vmaxq_f32(peak, vabsq_f32(acc));
+    }
+
+    return vmaxvq_f32(peak);
+}
+
+static void interleaveStereoNeon(float* dst, const float* left, const float* right, samples_t frames)
+{
+    samples_t i = 0;
+
+    for (; i + NEON_WIDTH <= frames; i += NEON_WIDTH) {
+        float32x4x2_t frame;
+        frame.val[0] = vld1q_f32(left + i);
+        frame.val[1] = vld1q_f32(right + i);
+        vst2q_f32(dst + i * 2, frame);
+    }
+
+    kernels::interleaveStereoScalarTail(dst, left, right, i, frames);
+}
+
+static void deinterleaveStereoNeon(float* left, float* right, const float* src, samples_t frames)
+{
+    samples_t i = 0;
+
+    for (; i + NEON_WIDTH <= frames; i += NEON_WIDTH) {
+        float32x4x2_t frame = vld2q_f32(src + i * 2);
+        vst1q_f32(left + i, frame.val[0]);
+        vst1q_f32(right + i, frame.val[1]);
+    }
+
+    kernels::deinterleaveStereoScalarTail(left, right, src, i, frames);
+}
+
+const VectorKernels* kernels::neonKernels()
+{
+    static const VectorKernels kernels {
+        accumulateNeon,
+        accumulateScaledNeon,
+        applyGainsNeon,
+        sumOfSquaresNeon,
+        dotProductNeon,
+        interpolatedPeakNeon,
+        interleaveStereoNeon,
+        deinterleaveStereoNeon
+    };
+
+    return &kernels;
+}
+
+#else
+
+const muse::audio::dsp::VectorKernels* muse::audio::dsp::kernels::neonKernels()
+{
+    return nullptr;
+}
+
+#endif
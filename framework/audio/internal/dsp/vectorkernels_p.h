@@ -0,0 +1,41 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_VECTORKERNELS_P_H
+#define MUSE_AUDIO_VECTORKERNELS_P_H
+
+#include "vectorkernels.h"
+
+//! NOTE Each backend lives in its own translation unit, the wider instruction sets are enabled only for its
+//! functions, between MUSE_AUDIO_BEGIN_*_CODE and MUSE_AUDIO_END_ISA_CODE. A backend which is not compiled in returns nullptr
+
+namespace muse::audio::dsp::kernels {
+const VectorKernels* scalarKernels();
+const VectorKernels* sse2Kernels();
+const VectorKernels* avx2Kernels();
+const VectorKernels* neonKernels();
+
+void applyGainsScalarTail(float* buffer, size_t begin, size_t end, audioch_t channels, const gain_t* gains, float* squaredSums);
+void interleaveStereoScalarTail(float* dst, const float* left, const float* right, samples_t begin, samples_t end);
+void deinterleaveStereoScalarTail(float* left, float* right, const float* src, samples_t begin, samples_t end);
+}
+
+#endif // MUSE_AUDIO_VECTORKERNELS_P_H
@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "vectorkernels_p.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_AMD64) || defined(_M_X64)
+#define MUSE_AUDIO_KERNELS_SSE2
+#endif
+
+#ifdef MUSE_AUDIO_KERNELS_SSE2
+
+#include <emmintrin.h>
+
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+static constexpr size_t SSE2_WIDTH = 4;
+
+static inline float horizontalSumSse2(__m128 v)
+{
+    alignas(16) float lanes[SSE2_WIDTH];
+    _mm_store_ps(lanes, v);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+static void accumulateSse2(float* dst, const float* src, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + SSE2_WIDTH <= count; i += SSE2_WIDTH) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    }
+
+    for (; i < count; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+static void accumulateScaledSse2(float* dst, const float* src, float gain, size_t count)
+{
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+
+    for (; i + SSE2_WIDTH <= count; i += SSE2_WIDTH) {
+        __m128 scaled = _mm_mul_ps(_mm_loadu_ps(src + i), g);
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), scaled));
+    }
+
+    for (; i < count; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+static void applyGainsSse2(float* buffer, samples_t samplesPerChannel, audioch_t channels, const gain_t* gains, float* squaredSums)
+{
+    for (audioch_t ch = 0; ch < channels; ++ch) {
+        squaredSums[ch] = 0.f;
+    }
+
+    const size_t count = samplesPerChannel * channels;
+    size_t i = 0;
+
+    //! NOTE Interleaved frames map onto the vector lanes only if the channels count divides the vector width
+    if (channels != 0 && SSE2_WIDTH % channels == 0) {
+        const __m128 g = _mm_setr_ps(gains[0], gains[1 % channels], gains[2 % channels], gains[3 % channels]);
+        __m128 acc = _mm_setzero_ps();
+
+        for (; i + SSE2_WIDTH <= count; i += SSE2_WIDTH) {
+            __m128 v = _mm_mul_ps(_mm_loadu_ps(buffer + i), g);
+            _mm_storeu_ps(buffer + i, v);
+            acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
+        }
+
+        alignas(16) float lanes[SSE2_WIDTH];
+        _mm_store_ps(lanes, acc);
+
+        for (size_t lane = 0; lane < SSE2_WIDTH; ++lane) {
+            squaredSums[lane % channels] += lanes[lane];
+        }
+    }
+
+    kernels::applyGainsScalarTail(buffer, i, count, channels, gains, squaredSums);
+}
+
+static float sumOfSquaresSse2(const float* src, size_t count)
+{
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+
+    for (; i + SSE2_WIDTH <= count; i += SSE2_WIDTH) {
+        __m128 v = _mm_loadu_ps(src + i);
+        acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
+    }
+
+    float sum = horizontalSumSse2(acc);
+
+    for (; i < count; ++i) {
+        sum += src[i] * src[i];
+    }
+
+    return sum;
+}
+
+static float dotProductSse2(const float* a, const float* b, size_t count)
+{
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+
+    for (; i + SSE2_WIDTH <= count; i += SSE2_WIDTH) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+
+    float sum = horizontalSumSse2(acc);
+
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
+static float interpolatedPeakSse2(const float* src, size_t count, const float* coefficients, size_t taps)
+{
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    __m128 peak = _mm_setzero_ps();
+
+    //! NOTE The 4 phases of one frame fill the vector lanes
+    for (size_t i = 0; i < count; ++i) {
+        __m128 acc = _mm_setzero_ps();
+
+        for (size_t j = 0; j < taps; ++j) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(coefficients + j * 4), _mm_set1_ps(src[i + j])));
+        }
+
+        peak = _mm_max_ps(peak, _mm_andnot_ps(signMask, acc));
+    }
+
+    alignas(16) float lanes[SSE2_WIDTH];
+    _mm_store_ps(lanes, peak);
+
+    return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+}
+
+static void interleaveStereoSse2(float* dst, const float* left, const float* right, samples_t frames)
+{
+    samples_t i = 0;
+
+    for (; i + SSE2_WIDTH <= frames; i += SSE2_WIDTH) {
+        __m128 l = _mm_loadu_ps(left + i);
+        __m128 r = _mm_loadu_ps(right + i);
+        _mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(l, r));
+        _mm_storeu_ps(dst + i * 2 + SSE2_WIDTH, _mm_unpackhi_ps(l, r));
+    }
+
+    kernels::interleaveStereoScalarTail(dst, left, right, i, frames);
+}
+
+static void deinterleaveStereoSse2(float* left, float* right, const float* src, samples_t frames)
+{
+    samples_t i = 0;
+
+    for (; i + SSE2_WIDTH <= frames; i += SSE2_WIDTH) {
+        __m128 a = _mm_loadu_ps(src + i * 2);
+        __m128 b = _mm_loadu_ps(src + i * 2 + SSE2_WIDTH);
+        _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+
+    kernels::deinterleaveStereoScalarTail(left, right, src, i, frames);
+}
+
+const VectorKernels* kernels::sse2Kernels()
+{
+    static const VectorKernels kernels {
+        accumulateSse2,
+        accumulateScaledSse2,
+        applyGainsSse2,
+        sumOfSquaresSse2,
+        dotProductSse2,
+        interpolatedPeakSse2,
+        interleaveStereoSse2,
+        deinterleaveStereoSse2
+    };
+
+    return &kernels;
+}
+
+#else
+
+const muse::audio::dsp::VectorKernels* muse::audio::dsp::kernels::sse2Kernels()
+{
+    return nullptr;
+}
+
+#endif
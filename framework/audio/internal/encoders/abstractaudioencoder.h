@@ -23,6 +23,7 @@
 #ifndef MUSE_AUDIO_ABSTRACTAUDIOENCODER_H
 #define MUSE_AUDIO_ABSTRACTAUDIOENCODER_H
 
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 #include <memory>
@@ -47,12 +48,13 @@ public:
         }
 
         m_format = format;
+        m_totalSamplesNumber = totalSamplesNumber;
 
         if (!openDestination(path)) {
             return false;
         }
 
-        prepareOutputBuffer(totalSamplesNumber);
+        prepareOutputBuffer(format.samplesPerChannel);
 
         return true;
     }
@@ -67,8 +69,31 @@ public:
         return m_format;
     }
 
-    virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
-    virtual size_t flush() = 0;
+    //! NOTE Called repeatedly with consecutive interleaved blocks of any size. Larger blocks are split,
+    //! so that the encoders only ever see blocks of at most format().samplesPerChannel frames
+    //! and their buffers don't depend on the length of the stream
+    size_t encode(samples_t samplesPerChannel, const float* input)
+    {
+        size_t result = 0;
+
+        while (samplesPerChannel > 0) {
+            const samples_t blockSize = std::min(samplesPerChannel, m_format.samplesPerChannel);
+            const size_t encoded = encodeBlock(blockSize, input);
+            if (encoded == 0) {
+                return 0;
+            }
+
+            result += encoded;
+            samplesPerChannel -= blockSize;
+            input += blockSize * m_format.audioChannelsNumber;
+        }
+
+        return result;
+    }
+
+    //! NOTE Writes whatever the encoder still buffers and completes the file headers with the actual stream length.
+    //! Returns false if the file couldn't be finalized, or didn't pass the verification of the encoder
+    virtual bool flush() = 0;
 
     Progress progress()
     {
@@ -76,7 +101,10 @@ public:
     }
 
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    virtual size_t encodeBlock(samples_t samplesPerChannel, const float* input) = 0;
+
+    //! NOTE The size of the buffer needed to encode one block
+    virtual size_t requiredOutputBufferSize(samples_t samplesPerChannel) const = 0;
 
     virtual void prepareWriting()
     {
@@ -107,9 +135,15 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    virtual void prepareOutputBuffer(const samples_t samplesPerChannel)
+    {
+        m_outputBuffer.resize(requiredOutputBufferSize(samplesPerChannel));
+    }
+
+    void onSamplesEncoded(samples_t samplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        m_encodedSamplesNumber += samplesPerChannel;
+        m_progress.progress(m_encodedSamplesNumber, std::max(m_totalSamplesNumber, m_encodedSamplesNumber), "");
     }
 
     virtual void closeDestination()
@@ -125,6 +159,8 @@ protected:
     std::vector<unsigned char> m_outputBuffer;
 
     SoundTrackFormat m_format;
+    samples_t m_totalSamplesNumber = 0; // per channel
+    samples_t m_encodedSamplesNumber = 0; // per channel
     Progress m_progress;
 
     std::string m_locale;
@@ -22,6 +22,9 @@
 
 #include "flacencoder.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "FLAC++/encoder.h"
 
 #include "internal/dsp/audiomathutils.h"
@@ -31,29 +34,51 @@
 using namespace muse::audio;
 using namespace muse::audio::encode;
 
-struct FlacHandler : public FLAC::Encoder::File
-{
-    using ProgressCallBack = std::function<void (int64_t /*current*/, int64_t /*total*/)>;
+//! NOTE libFLAC 1.5 encodes frames on several threads, which lets long exports keep up with the disk
+#if FLAC_API_VERSION_CURRENT >= 14
+#define MUSE_FLAC_MULTITHREADED
+#endif
+
+static constexpr uint32_t FLAC_MAX_THREADS = 8;
 
-    FlacHandler(const ProgressCallBack& progressCallBack)
-        : FLAC::Encoder::File(), m_callBack(progressCallBack) {}
+//! NOTE The fastest level keeps a single-threaded encoder ahead of the renderer,
+//! with more threads the default level is affordable
+static constexpr uint32_t FLAC_SINGLE_THREAD_COMPRESSION_LEVEL = 0;
+static constexpr uint32_t FLAC_MULTI_THREAD_COMPRESSION_LEVEL = 5;
 
-    void progress_callback(FLAC__uint64 bytes_written,
-                           FLAC__uint64 samples_written,
-                           uint32_t frames_written,
-                           uint32_t total_frames_estimate) override
+struct FlacHandler : public FLAC::Encoder::File
+{
+    ~FlacHandler() override
     {
-        LOGI() << "wrote " << bytes_written << " bytes, "
-               << samples_written << " samples, "
-               << frames_written << " frames\n"
-               << "TOTAL FRAMES: " << total_frames_estimate;
+        for (FLAC__StreamMetadata* object : metadata) {
+            if (object) {
+                FLAC__metadata_object_delete(object);
+            }
+        }
+    }
 
-        m_callBack(frames_written * 4, total_frames_estimate);
+    //! NOTE Returns the number of encoding threads, 1 if libFLAC has no multithreading
+    uint32_t setupThreads()
+    {
+#ifdef MUSE_FLAC_MULTITHREADED
+        const uint32_t threads = std::clamp<uint32_t>(std::thread::hardware_concurrency(), 1, FLAC_MAX_THREADS);
+        if (threads > 1 && set_num_threads(threads) == FLAC__STREAM_ENCODER_SET_NUM_THREADS_OK) {
+            return threads;
+        }
+#endif
+        return 1;
     }
 
-    ProgressCallBack m_callBack;
+    //! NOTE Must stay alive until the encoder is finished
+    FLAC__StreamMetadata* metadata[2] = { nullptr, nullptr };
 };
 
+static FLAC__int32 convertTo24Bit(float value)
+{
+    constexpr float MAX_24_BIT = 8388607.f;
+    return static_cast<FLAC__int32>(std::clamp(value, -1.f, 1.f) * MAX_24_BIT);
+}
+
 bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
 {
     if (!format.isValid()) {
@@ -61,22 +86,28 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
     }
 
     m_format = format;
+    m_totalSamplesNumber = totalSamplesNumber;
+    m_bitsPerSample = format.bitDepth == 24 ? 24 : 16;
+
+    m_flac = new FlacHandler();
 
-    m_flac = new FlacHandler([this](int64_t current, int64_t total){
-        m_progress.progress(current, total, "");
-    });
+    const uint32_t threads = m_flac->setupThreads();
+    const uint32_t compressionLevel = threads > 1 ? FLAC_MULTI_THREAD_COMPRESSION_LEVEL : FLAC_SINGLE_THREAD_COMPRESSION_LEVEL;
 
     if (!m_flac->set_verify(true)
-        || !m_flac->set_compression_level(0)
+        || !m_flac->set_compression_level(compressionLevel)
         || !m_flac->set_channels(m_format.audioChannelsNumber)
         || !m_flac->set_sample_rate(m_format.sampleRate)
-        || !m_flac->set_bits_per_sample(16)
+        || !m_flac->set_bits_per_sample(m_bitsPerSample)
         || !m_flac->set_total_samples_estimate(totalSamplesNumber)) {
         return false;
     }
 
+    LOGD() << "FLAC encoder: " << threads << " thread(s), compression level " << compressionLevel
+           << ", " << m_bitsPerSample << " bit";
+
     FLAC__StreamMetadata_VorbisComment_Entry entry;
-    FLAC__StreamMetadata* metadata[2];
+    FLAC__StreamMetadata** metadata = m_flac->metadata;
     metadata[0] = FLAC__metadata_object_new(FLAC__METADATA_TYPE_VORBIS_COMMENT);
     metadata[1] = FLAC__metadata_object_new(FLAC__METADATA_TYPE_PADDING);
     FLAC__metadata_object_vorbiscomment_entry_from_name_value_pair(&entry, "ARTIST", "Some Artist");
@@ -91,52 +122,62 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
         return false;
     }
 
-    prepareOutputBuffer(totalSamplesNumber);
+    prepareOutputBuffer(format.samplesPerChannel);
 
     return true;
 }
 
-size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
+size_t FlacEncoder::encodeBlock(samples_t samplesPerChannel, const float* input)
 {
     IF_ASSERT_FAILED(m_flac) {
         return 0;
     }
 
-    size_t result = 0;
-    size_t totalSamplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
-    uint32_t frameSize = 1024;
-    size_t stepSize = frameSize * m_format.audioChannelsNumber;
+    const size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
+    if (m_intermBuffer.size() < samplesNumber) {
+        m_intermBuffer.resize(samplesNumber);
+    }
 
-    std::vector<FLAC__int32> buff(samplesPerChannel * sizeof(float));
+    if (m_bitsPerSample == 24) {
+        for (size_t i = 0; i < samplesNumber; ++i) {
+            m_intermBuffer[i] = convertTo24Bit(input[i]);
+        }
+    } else {
+        for (size_t i = 0; i < samplesNumber; ++i) {
+            m_intermBuffer[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+        }
+    }
 
-    for (size_t i = 0; i < buff.size(); ++i) {
-        buff[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    if (!m_flac->process_interleaved(m_intermBuffer.data(), samplesPerChannel)) {
+        LOGE() << "FLAC encoder error: " << m_flac->get_state().as_cstring();
+        return 0;
     }
 
-    std::vector<FLAC__int32> intermBuff(stepSize);
+    onSamplesEncoded(samplesPerChannel);
 
-    for (size_t i = 0; i < totalSamplesNumber; i += stepSize) {
-        std::copy(buff.data() + i, buff.data() + i + stepSize, intermBuff.data());
+    return samplesNumber;
+}
 
-        if (m_flac->process_interleaved(intermBuff.data(), frameSize)) {
-            result += stepSize;
-        } else {
-            break;
-        }
+bool FlacEncoder::flush()
+{
+    IF_ASSERT_FAILED(m_flac) {
+        return false;
     }
 
-    return result;
-}
+    //! NOTE Encodes the buffered frames and, since the file is seekable,
+    //! rewrites STREAMINFO with the actual number of samples and the MD5 signature
+    if (!m_flac->finish()) {
+        LOGE() << "FLAC encoder error: " << m_flac->get_state().as_cstring();
+        return false;
+    }
 
-size_t FlacEncoder::flush()
-{
-    m_flac->finish();
-    return 0;
+    return true;
 }
 
-size_t FlacEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t FlacEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    //! NOTE libFLAC writes to the file itself
+    return 0;
 }
 
 bool FlacEncoder::openDestination(const io::path_t& path)
@@ -155,4 +196,5 @@ bool FlacEncoder::openDestination(const io::path_t& path)
 void FlacEncoder::closeDestination()
 {
     delete m_flac;
+    m_flac = nullptr;
 }
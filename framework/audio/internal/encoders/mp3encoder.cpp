@@ -80,35 +80,47 @@ bool Mp3Encoder::init(const io::path_t& path, const SoundTrackFormat& format, co
     return true;
 }
 
-size_t Mp3Encoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t Mp3Encoder::requiredOutputBufferSize(samples_t samplesPerChannel) const
 {
-    //!Note See thirdparty/lame/API
+    //!Note See thirdparty/lame/API, the worst case for a single encode() call:
+    //!     mp3buf_size in bytes = 1.25 * num_samples + 7200
 
-    return totalSamplesNumber;
+    return samplesPerChannel * 5 / 4 + 7200;
 }
 
-size_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
+size_t Mp3Encoder::encodeBlock(samples_t samplesPerChannel, const float* input)
 {
-    m_progress.progress(0, 100, "");
-
     int encodedBytes = lame_encode_buffer_interleaved_ieee_float(m_handler->flags, input, samplesPerChannel,
                                                                  m_outputBuffer.data(),
                                                                  static_cast<int>(m_outputBuffer.size()));
 
-    m_progress.progress(50, 100, "");
-    size_t result = std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
-    m_progress.progress(100, 100, "");
+    if (encodedBytes < 0) {
+        LOGE() << "lame error: " << encodedBytes;
+        return 0;
+    }
+
+    //! NOTE lame buffers its input, so a block may produce no output yet
+    std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+
+    onSamplesEncoded(samplesPerChannel);
 
-    return result;
+    return samplesPerChannel * m_format.audioChannelsNumber;
 }
 
-size_t Mp3Encoder::flush()
+bool Mp3Encoder::flush()
 {
     int encodedBytes = lame_encode_flush(m_handler->flags,
                                          m_outputBuffer.data(),
                                          static_cast<int>(m_outputBuffer.size()));
 
-    return std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+    if (encodedBytes < 0) {
+        LOGE() << "lame error: " << encodedBytes;
+        return false;
+    }
+
+    const size_t writtenBytes = std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+
+    return writtenBytes == static_cast<size_t>(encodedBytes) && std::fflush(m_fileStream) == 0;
 }
 
 void Mp3Encoder::closeDestination()
@@ -33,18 +33,22 @@
 using namespace muse::audio;
 using namespace muse::audio::encode;
 
-size_t OggEncoder::encode(samples_t samplesPerChannel, const float* input)
+size_t OggEncoder::encodeBlock(samples_t samplesPerChannel, const float* input)
 {
-    m_progress.progress(0, 100, "");
-    int code = ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel + m_format.sampleRate * 2);
-    m_progress.progress(100, 100, "");
+    int code = ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel);
+    if (code != OPE_OK) {
+        return 0;
+    }
+
+    onSamplesEncoded(samplesPerChannel);
 
-    return code == OPE_OK ? samplesPerChannel : 0;
+    return samplesPerChannel;
 }
 
-size_t OggEncoder::flush()
+bool OggEncoder::flush()
 {
-    return ope_encoder_flush_header(m_opusEncoder);
+    //! NOTE Encodes the buffered tail of the stream and finalizes the file
+    return ope_encoder_drain(m_opusEncoder) == OPE_OK;
 }
 
 size_t OggEncoder::requiredOutputBufferSize(samples_t /*totalSamplesNumber*/) const
@@ -31,10 +31,10 @@ namespace muse::audio::encode {
 class OggEncoder : public AbstractAudioEncoder
 {
 public:
-    size_t encode(samples_t samplesPerChannel, const float* input) override;
-    size_t flush() override;
+    bool flush() override;
 
 protected:
+    size_t encodeBlock(samples_t samplesPerChannel, const float* input) override;
     size_t requiredOutputBufferSize(samples_t) const override;
     bool openDestination(const io::path_t& path) override;
     void closeDestination() override;
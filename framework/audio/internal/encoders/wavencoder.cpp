@@ -22,6 +22,8 @@
 
 #include "wavencoder.h"
 
+#include <limits>
+
 #include "log.h"
 
 using namespace muse::audio;
@@ -36,29 +38,25 @@ struct WavHeader {
     uint32_t chunkSize = 0;
     uint16_t audioChannelsNumber = 0;
     uint16_t bitsPerSample = 0;
-    uint32_t samplesPerChannel = 0;
+    uint64_t samplesPerChannel = 0;
     uint16_t code = 0;
     uint32_t sampleRate = 0;
 
     void write(std::ofstream& stream)
     {
         const uint32_t bytesPerSample = 4;
-        const uint32_t sampleDataLength = audioChannelsNumber * samplesPerChannel * bytesPerSample;
-        const uint32_t headerLength = 20 + chunkSize + 8;
-        const uint32_t file_length = headerLength + sampleDataLength;
-        const uint32_t overallSize = file_length - 8;
         const uint32_t bytesPerFrame = audioChannelsNumber * bytesPerSample;
         const uint32_t bytesPerSec = audioChannelsNumber * sampleRate * bytesPerSample;
 
         stream.write("RIFF", 4); // chunk ID
 
-        writeTagData<uint32_t>(stream, overallSize);
+        writeTagData<uint32_t>(stream, overallSize());
         stream.write("WAVE", 4); // WAVEID
         stream.write("fmt ", 4); // chunk ID
 
         writeTagData<uint32_t>(stream, chunkSize);
         writeTagData<uint16_t>(stream, code);
-        writeTagData<uint16_t>(stream, 2);
+        writeTagData<uint16_t>(stream, audioChannelsNumber);
         writeTagData<uint32_t>(stream, sampleRate);
         writeTagData<uint32_t>(stream, bytesPerSec);
         writeTagData<uint16_t>(stream, bytesPerFrame);
@@ -70,10 +68,46 @@ struct WavHeader {
         }
         stream.write("data", 4); // chunk ID
 
-        writeTagData<uint32_t>(stream, sampleDataLength);
+        writeTagData<uint32_t>(stream, sampleDataLength());
+    }
+
+    //! NOTE Rewrites the lengths of the RIFF and data chunks in an already written header,
+    //! the stream position is restored afterwards
+    void updateLengths(std::ofstream& stream)
+    {
+        const std::ofstream::pos_type position = stream.tellp();
+
+        stream.seekp(4);
+        writeTagData<uint32_t>(stream, overallSize());
+
+        stream.seekp(headerLength() - 4);
+        writeTagData<uint32_t>(stream, sampleDataLength());
+
+        stream.seekp(position);
     }
 
 private:
+    uint32_t headerLength() const
+    {
+        return 20 + chunkSize + 8;
+    }
+
+    //! NOTE The 32-bit RIFF lengths can't describe more than 4 GB, longer streams get the largest
+    //! length that fits, most readers then read the data up to the end of the file
+    uint32_t sampleDataLength() const
+    {
+        const uint64_t bytesPerSample = 4;
+        const uint64_t maxLength = std::numeric_limits<uint32_t>::max() - headerLength();
+
+        return static_cast<uint32_t>(std::min<uint64_t>(audioChannelsNumber * samplesPerChannel * bytesPerSample, maxLength));
+    }
+
+    uint32_t overallSize() const
+    {
+        const uint32_t file_length = headerLength() + sampleDataLength();
+        return file_length - 8;
+    }
+
     template<typename T>
     void writeTagData(std::ofstream& stream, const T value)
     {
@@ -81,54 +115,54 @@ private:
     }
 };
 
-size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
+static WavHeader makeWavHeader(const SoundTrackFormat& format, samples_t samplesPerChannel)
 {
-    if (!m_fileStream.is_open()) {
-        return 0;
-    }
-
     WavHeader header;
     header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
     header.bitsPerSample = 32;
     header.code = 3; // IEEE_FLOAT = 3, PCM = 1
-    header.audioChannelsNumber = m_format.audioChannelsNumber;
-    header.sampleRate = m_format.sampleRate;
+    header.audioChannelsNumber = format.audioChannelsNumber;
+    header.sampleRate = format.sampleRate;
     header.samplesPerChannel = samplesPerChannel;
 
-    header.write(m_fileStream);
+    return header;
+}
 
-    int total = header.samplesPerChannel;
-    int progressStep = (total * 5) / 100; // every 5%
-    QVector<samples_t> progressValues;
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel;) {
-        progressValues << sampleIdx;
-        sampleIdx += progressStep;
+size_t WavEncoder::encodeBlock(samples_t samplesPerChannel, const float* input)
+{
+    if (!m_fileStream.is_open()) {
+        return 0;
     }
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
+    const size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesNumber * sizeof(float));
 
-        if (progressValues.contains(sampleIdx)) {
-            m_progress.progress(sampleIdx, total, "");
-        }
+    if (!m_fileStream.good()) {
+        return 0;
     }
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    onSamplesEncoded(samplesPerChannel);
+
+    return samplesNumber;
 }
 
-size_t WavEncoder::flush()
+bool WavEncoder::flush()
 {
-    NOT_SUPPORTED;
+    if (!m_fileStream.is_open()) {
+        return false;
+    }
 
-    return 0;
+    //! NOTE The header was written with the expected length, the stream may have turned out shorter or longer
+    makeWavHeader(m_format, m_encodedSamplesNumber).updateLengths(m_fileStream);
+    m_fileStream.flush();
+
+    return m_fileStream.good();
 }
 
-size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t WavEncoder::requiredOutputBufferSize(samples_t /*samplesPerChannel*/) const
 {
-    return totalSamplesNumber;
+    //! NOTE The samples are written as they are
+    return 0;
 }
 
 bool WavEncoder::openDestination(const io::path_t& path)
@@ -136,7 +170,13 @@ bool WavEncoder::openDestination(const io::path_t& path)
     prepareWriting();
     m_fileStream.open(path.toStdString(), std::ios_base::binary);
 
-    return m_fileStream.is_open();
+    if (!m_fileStream.is_open()) {
+        return false;
+    }
+
+    makeWavHeader(m_format, m_totalSamplesNumber).write(m_fileStream);
+
+    return m_fileStream.good();
 }
 
 void WavEncoder::closeDestination()
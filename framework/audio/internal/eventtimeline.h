@@ -0,0 +1,205 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_EVENTTIMELINE_H
+#define MUSE_AUDIO_EVENTTIMELINE_H
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "../audiotypes.h"
+
+namespace muse::audio {
+template<typename EventT>
+struct TimedEvent {
+    msecs_t timestamp = 0;
+    msecs_t origin = 0; // timestamp of the source event (e.g. the chord) this event was generated from
+    EventT event;
+
+    bool operator<(const TimedEvent& other) const
+    {
+        if (timestamp != other.timestamp) {
+            return timestamp < other.timestamp;
+        }
+
+        //! NOTE Some sequencers specialize std::less for their event type
+        std::less<EventT> less;
+        if (less(event, other.event)) {
+            return true;
+        }
+
+        if (less(other.event, event)) {
+            return false;
+        }
+
+        return origin < other.origin;
+    }
+};
+
+//! NOTE Contiguous, time-sorted storage of the sequencer events.
+//! The events are appended in any order, then sort() must be called before reading
+template<typename EventT>
+class EventTimeline
+{
+public:
+    using Entry = TimedEvent<EventT>;
+
+    //! NOTE The events added after this call are attributed to the given origin, see removeOrigins()
+    void setOrigin(const msecs_t origin)
+    {
+        m_origin = origin;
+    }
+
+    void add(const msecs_t timestamp, EventT event)
+    {
+        m_entries.push_back(Entry { timestamp, m_origin, std::move(event) });
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_sortedCount = 0;
+    }
+
+    //! NOTE Removes the events generated from the source events within [from; to), the order is kept
+    void removeOrigins(const msecs_t from, const msecs_t to)
+    {
+        auto isInRange = [from, to](const Entry& entry) {
+            return entry.origin >= from && entry.origin < to;
+        };
+
+        m_sortedCount -= std::count_if(m_entries.begin(), m_entries.begin() + m_sortedCount, isInRange);
+
+        auto last = std::remove_if(m_entries.begin(), m_entries.end(), isInRange);
+        m_entries.erase(last, m_entries.end());
+    }
+
+    bool empty() const
+    {
+        return m_entries.empty();
+    }
+
+    size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    const Entry* data() const
+    {
+        return m_entries.data();
+    }
+
+    //! NOTE Sorts the events by time and removes the duplicates generated from the same origin.
+    //! Only the events added since the last call are sorted, then merged into the sorted ones
+    void sort()
+    {
+        if (m_sortedCount == m_entries.size()) {
+            return;
+        }
+
+        auto sortedEnd = m_entries.begin() + m_sortedCount;
+        std::sort(sortedEnd, m_entries.end());
+        std::inplace_merge(m_entries.begin(), sortedEnd, m_entries.end());
+
+        auto last = std::unique(m_entries.begin(), m_entries.end(), [](const Entry& left, const Entry& right) {
+            return !(left < right) && !(right < left);
+        });
+
+        m_entries.erase(last, m_entries.end());
+        m_sortedCount = m_entries.size();
+    }
+
+    //! NOTE Index of the first event at or after the timestamp
+    size_t lowerBound(const msecs_t timestamp) const
+    {
+        auto it = std::lower_bound(m_entries.cbegin(), m_entries.cend(), timestamp, [](const Entry& entry, const msecs_t value) {
+            return entry.timestamp < value;
+        });
+
+        return static_cast<size_t>(std::distance(m_entries.cbegin(), it));
+    }
+
+    //! NOTE Index of the first event after the timestamp, starting the search from the given index
+    size_t upperBound(const size_t from, const msecs_t timestamp) const
+    {
+        size_t idx = from;
+        while (idx < m_entries.size() && m_entries[idx].timestamp <= timestamp) {
+            ++idx;
+        }
+
+        return idx;
+    }
+
+private:
+    std::vector<Entry> m_entries;
+    size_t m_sortedCount = 0;
+    msecs_t m_origin = 0;
+};
+
+//! NOTE The events of one render block, points into an EventTimeline
+template<typename EventT>
+struct EventSpan {
+    using Entry = TimedEvent<EventT>;
+
+    msecs_t from = 0; // playback position at the start of the block
+    msecs_t to = 0; // playback position at the end of the block
+
+    const Entry* first = nullptr;
+    const Entry* last = nullptr;
+
+    const Entry* begin() const { return first; }
+    const Entry* end() const { return last; }
+    bool empty() const { return first == last; }
+
+    //! NOTE Calls func(begin, end, durationMsecs, isLast) for every group of simultaneous events.
+    //! The first group starts at the block start and may be empty, it means to continue the previous sequence.
+    //! The last group lasts until the end of the block. Stops if func returns false
+    template<typename Func>
+    void forEachGroup(Func func) const
+    {
+        const Entry* groupBegin = first;
+        msecs_t timestamp = from;
+
+        while (true) {
+            const Entry* groupEnd = groupBegin;
+            while (groupEnd != last && groupEnd->timestamp <= timestamp) {
+                ++groupEnd;
+            }
+
+            if (groupEnd == last) {
+                func(groupBegin, groupEnd, to - timestamp, true);
+                return;
+            }
+
+            if (!func(groupBegin, groupEnd, groupEnd->timestamp - timestamp, false)) {
+                return;
+            }
+
+            groupBegin = groupEnd;
+            timestamp = groupEnd->timestamp;
+        }
+    }
+};
+}
+
+#endif // MUSE_AUDIO_EVENTTIMELINE_H
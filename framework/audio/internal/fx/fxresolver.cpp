@@ -117,6 +117,17 @@ void FxResolver::registerResolver(const AudioFxType type, IResolverPtr resolver)
     m_resolvers.insert_or_assign(type, std::move(resolver));
 }
 
+void FxResolver::clearFx(const TrackId trackId)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    std::lock_guard lock(m_mutex);
+
+    for (auto it = m_resolvers.begin(); it != m_resolvers.end(); ++it) {
+        it->second->clearFx(trackId);
+    }
+}
+
 void FxResolver::clearAllFx()
 {
     ONLY_AUDIO_MAIN_THREAD;
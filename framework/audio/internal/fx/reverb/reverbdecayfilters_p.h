@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_REVERBDECAYFILTERS_P_H
+#define MUSE_AUDIO_REVERBDECAYFILTERS_P_H
+
+#include "reverbkernels.h"
+
+namespace muse::audio::fx::kernels {
+//! NOTE Shared by all vector backends, VecT provides load(), store() and the arithmetic operators.
+//! Internal linkage, every backend translation unit gets its own copy. The AVX ones include this header
+//! between MUSE_AUDIO_BEGIN_*_CODE and MUSE_AUDIO_END_ISA_CODE, so that their copy is built for that instruction set
+template<typename VecT, int lanes>
+static void processDecayFiltersT(ReverbDecayFilterBank& bank, float* lines, int numLines)
+{
+    ReverbDecayFilterBank::OnePoleLanes& gain = bank.gain;
+
+    for (int i = 0; i < numLines; i += lanes) {
+        const VecT x = VecT::load(lines + i);
+
+        VecT y = VecT::load(gain.b0 + i) * x + VecT::load(gain.b1 + i) * VecT::load(gain.x1 + i)
+                 - VecT::load(gain.a1 + i) * VecT::load(gain.y1 + i);
+        x.store(gain.x1 + i);
+        y.store(gain.y1 + i);
+
+        for (ReverbDecayFilterBank::BiquadLanes& bq : bank.damping) {
+            const VecT out = y * VecT::load(bq.b0 + i) + VecT::load(bq.w1 + i);
+            const VecT w1 = y * VecT::load(bq.b1 + i) - out * VecT::load(bq.a1 + i) + VecT::load(bq.w2 + i);
+            const VecT w2 = y * VecT::load(bq.b2 + i) - out * VecT::load(bq.a2 + i);
+            w1.store(bq.w1 + i);
+            w2.store(bq.w2 + i);
+            y = out;
+        }
+
+        y.store(lines + i);
+    }
+}
+}
+
+#endif // MUSE_AUDIO_REVERBDECAYFILTERS_P_H
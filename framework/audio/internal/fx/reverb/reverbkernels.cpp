@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reverbkernels.h"
+
+#include <algorithm>
+
+#include "reverbkernels_p.h"
+#include "simdtypes.h"
+#include "reverbdecayfilters_p.h"
+
+#include "../../dsp/cpufeatures.h"
+
+#include "log.h"
+
+using namespace muse::audio;
+using namespace muse::audio::fx;
+
+ReverbDecayFilterBank::ReverbDecayFilterBank()
+{
+    std::fill(std::begin(gain.b0), std::end(gain.b0), 0.f);
+    std::fill(std::begin(gain.b1), std::end(gain.b1), 0.f);
+    std::fill(std::begin(gain.a1), std::end(gain.a1), 0.f);
+
+    for (BiquadLanes& bq : damping) {
+        std::fill(std::begin(bq.b0), std::end(bq.b0), 1.f);
+        std::fill(std::begin(bq.b1), std::end(bq.b1), 0.f);
+        std::fill(std::begin(bq.b2), std::end(bq.b2), 0.f);
+        std::fill(std::begin(bq.a1), std::end(bq.a1), 0.f);
+        std::fill(std::begin(bq.a2), std::end(bq.a2), 0.f);
+    }
+
+    reset();
+}
+
+void ReverbDecayFilterBank::reset()
+{
+    std::fill(std::begin(gain.x1), std::end(gain.x1), 0.f);
+    std::fill(std::begin(gain.y1), std::end(gain.y1), 0.f);
+
+    for (BiquadLanes& bq : damping) {
+        std::fill(std::begin(bq.w1), std::end(bq.w1), 0.f);
+        std::fill(std::begin(bq.w2), std::end(bq.w2), 0.f);
+    }
+}
+
+static void processDecayFiltersScalar(ReverbDecayFilterBank& bank, float* lines, int numLines)
+{
+    ReverbDecayFilterBank::OnePoleLanes& gain = bank.gain;
+
+    for (int i = 0; i < numLines; ++i) {
+        const float x = lines[i];
+
+        float y = gain.b0[i] * x + gain.b1[i] * gain.x1[i] - gain.a1[i] * gain.y1[i];
+        gain.x1[i] = x;
+        gain.y1[i] = y;
+
+        for (ReverbDecayFilterBank::BiquadLanes& bq : bank.damping) {
+            const float out = y * bq.b0[i] + bq.w1[i];
+            bq.w1[i] = y * bq.b1[i] - out * bq.a1[i] + bq.w2[i];
+            bq.w2[i] = y * bq.b2[i] - out * bq.a2[i];
+            y = out;
+        }
+
+        lines[i] = y;
+    }
+}
+
+const ReverbKernels* kernels::scalarKernels()
+{
+    static const ReverbKernels kernels {
+        processDecayFiltersScalar,
+        1
+    };
+
+    return &kernels;
+}
+
+//! NOTE simd::float_x4 is SSE2 or NEON, whichever the baseline of the target provides
+const ReverbKernels* kernels::float4Kernels()
+{
+    static const ReverbKernels kernels {
+        processDecayFiltersT<simd::float_x4, 4>,
+        4
+    };
+
+    return &kernels;
+}
+
+const ReverbKernels* fx::reverbKernels(ReverbKernelBackend backend)
+{
+    switch (backend) {
+    case ReverbKernelBackend::Scalar: return kernels::scalarKernels();
+#if defined(__SSE2__) || (defined(_M_AMD64) || defined(_M_X64))
+    case ReverbKernelBackend::SSE2: return kernels::float4Kernels();
+    case ReverbKernelBackend::NEON: return nullptr;
+#elif defined(__arm64__) || defined(__aarch64__) || defined(_M_ARM64)
+    case ReverbKernelBackend::SSE2: return nullptr;
+    case ReverbKernelBackend::NEON: return kernels::float4Kernels();
+#else
+    case ReverbKernelBackend::SSE2: return nullptr;
+    case ReverbKernelBackend::NEON: return nullptr;
+#endif
+    case ReverbKernelBackend::AVX2: return dsp::cpuSupportsAvx2() ? kernels::avx2Kernels() : nullptr;
+    case ReverbKernelBackend::AVX512: return dsp::cpuSupportsAvx512() ? kernels::avx512Kernels() : nullptr;
+    }
+
+    return nullptr;
+}
+
+bool fx::isReverbKernelBackendAvailable(ReverbKernelBackend backend)
+{
+    return reverbKernels(backend) != nullptr;
+}
+
+ReverbKernelBackend fx::bestAvailableReverbKernelBackend()
+{
+    static const ReverbKernelBackend best = []() {
+        for (ReverbKernelBackend backend : { ReverbKernelBackend::AVX512, ReverbKernelBackend::AVX2,
+                                             ReverbKernelBackend::SSE2, ReverbKernelBackend::NEON }) {
+            if (isReverbKernelBackendAvailable(backend)) {
+                return backend;
+            }
+        }
+
+        return ReverbKernelBackend::Scalar;
+    }();
+
+    return best;
+}
+
+const char* fx::reverbKernelBackendName(ReverbKernelBackend backend)
+{
+    switch (backend) {
+    case ReverbKernelBackend::Scalar: return "Scalar";
+    case ReverbKernelBackend::SSE2: return "SSE2";
+    case ReverbKernelBackend::NEON: return "NEON";
+    case ReverbKernelBackend::AVX2: return "AVX2";
+    case ReverbKernelBackend::AVX512: return "AVX-512";
+    }
+
+    return "Unknown";
+}
+
+const ReverbKernels& fx::activeReverbKernels()
+{
+    static const ReverbKernels* kernels = []() {
+        ReverbKernelBackend backend = bestAvailableReverbKernelBackend();
+        LOGI() << "Reverb kernels: " << reverbKernelBackendName(backend);
+        return reverbKernels(backend);
+    }();
+
+    return *kernels;
+}
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_REVERBKERNELS_H
+#define MUSE_AUDIO_REVERBKERNELS_H
+
+namespace muse::audio::fx {
+enum class ReverbKernelBackend {
+    Scalar = 0,
+    SSE2,
+    NEON,
+    AVX2,
+    AVX512
+};
+
+//! NOTE The decay filters of the feedback delay lines, one lane per line: a one-pole gain filter
+//! followed by two DF2 biquads (the 3-band tone control). The lanes are stored as plain arrays,
+//! so that every backend can process as many lines at once as its vectors hold.
+//! The number of lanes is padded to a multiple of the widest vector, unused lanes are processed too
+//! and stay silent as long as their input is zero
+struct ReverbDecayFilterBank {
+    static constexpr int MAX_LINES = 32;
+
+    struct OnePoleLanes {
+        alignas(64) float b0[MAX_LINES];
+        alignas(64) float b1[MAX_LINES];
+        alignas(64) float a1[MAX_LINES];
+        alignas(64) float x1[MAX_LINES];
+        alignas(64) float y1[MAX_LINES];
+    };
+
+    struct BiquadLanes {
+        alignas(64) float b0[MAX_LINES];
+        alignas(64) float b1[MAX_LINES];
+        alignas(64) float b2[MAX_LINES];
+        alignas(64) float a1[MAX_LINES];
+        alignas(64) float a2[MAX_LINES];
+        alignas(64) float w1[MAX_LINES];
+        alignas(64) float w2[MAX_LINES];
+    };
+
+    OnePoleLanes gain;
+    BiquadLanes damping[2];
+
+    //! NOTE Starts with pass-through biquads and a silent gain filter
+    ReverbDecayFilterBank();
+
+    void reset();
+};
+
+struct ReverbKernels {
+    //! lines[i] is replaced by the output of the decay filters of line i.
+    //! numLines is rounded up to a multiple of lanes, lines must hold ReverbDecayFilterBank::MAX_LINES values
+    void (*processDecayFilters)(ReverbDecayFilterBank& bank, float* lines, int numLines) = nullptr;
+
+    int lanes = 1;
+};
+
+//! NOTE Returns nullptr if the backend is not compiled in or not supported by the CPU
+const ReverbKernels* reverbKernels(ReverbKernelBackend backend);
+bool isReverbKernelBackendAvailable(ReverbKernelBackend backend);
+ReverbKernelBackend bestAvailableReverbKernelBackend();
+const char* reverbKernelBackendName(ReverbKernelBackend backend);
+
+//! NOTE The kernels of the best available backend, resolved once
+const ReverbKernels& activeReverbKernels();
+}
+
+#endif // MUSE_AUDIO_REVERBKERNELS_H
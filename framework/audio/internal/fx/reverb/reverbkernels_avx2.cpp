@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reverbkernels_p.h"
+#include "../../dsp/cpufeatures.h"
+
+//! NOTE Only the kernel is built with AVX2 enabled (see cpufeatures.h),
+//! it is only used after the CPU support has been checked at runtime
+#ifdef MUSE_AUDIO_ARCH_X86_64
+
+#include <immintrin.h>
+
+MUSE_AUDIO_BEGIN_AVX2_CODE
+
+#include "simdtypes_avx2.h"
+#include "reverbdecayfilters_p.h"
+
+MUSE_AUDIO_END_ISA_CODE
+
+using namespace muse::audio::fx;
+
+const ReverbKernels* kernels::avx2Kernels()
+{
+    static const ReverbKernels kernels {
+        processDecayFiltersT<simd::float_x8, 8>,
+        8
+    };
+
+    return &kernels;
+}
+
+#else
+
+const muse::audio::fx::ReverbKernels* muse::audio::fx::kernels::avx2Kernels()
+{
+    return nullptr;
+}
+
+#endif
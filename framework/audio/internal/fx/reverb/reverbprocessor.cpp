@@ -27,11 +27,14 @@
 #include <complex>
 #include <vector>
 
+#include "../../dsp/vectorkernels.h"
+
 #include "allpassdispersion.h"
 #include "allpassmodulateddelay.h"
 #include "iirbiquadfilter.h"
 #include "ivndecorrelation.h"
 #include "reverbfilters.h"
+#include "reverbkernels.h"
 #include "reverbmatrices.h"
 #include "sampledelay.h"
 #include "simdtypes.h"
@@ -199,11 +202,7 @@ static inline float _sqrt_sign(float x)
 struct ReverbProcessor::impl
 {
     // members requiring alignment first
-    IirBiquadFilter::Coeffs<simd::float_x4> damping_cf1_x4[max_num_delays / 4];
-    IirBiquadFilter::Coeffs<simd::float_x4> damping_cf2_x4[max_num_delays / 4];
-    IirBiquadFilter::DF2State<simd::float_x4> damping_state1_x4[max_num_delays / 4];
-    IirBiquadFilter::DF2State<simd::float_x4> damping_state2_x4[max_num_delays / 4];
-    reverbfilters::OnePoleFilter<simd::float_x4> ag_filter_x4[max_num_delays / 4];
+    ReverbDecayFilterBank decay_filters;
 
     AllPassModulatedDelay modDelay[max_num_delays];
     AllPassDispersion disp_ap;
@@ -228,6 +227,8 @@ struct ReverbProcessor::impl
     SparseFirFilter er_fir[2];
     SampleDelay<float, 2> pre_delay;
 
+    const ReverbKernels* kernels = &activeReverbKernels();
+
     int modStep = 32;
     int modCounter = 0;
 };
@@ -336,32 +337,48 @@ void ReverbProcessor::process(float* buffer, unsigned int sampleCount)
         setFormat(m_processor._audioChannelsCount, m_processor._sampleRate, sampleCount);
     }
 
-    for (samples_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex) {
-        size_t offset = sampleIndex * m_processor._audioChannelsCount;
+    dsp::deinterleave(m_signalBuffers, buffer, m_processor._audioChannelsCount, sampleCount);
+    processSignal(m_signalBuffers, sampleCount);
+    dsp::interleave(buffer, m_signalBuffers, m_processor._audioChannelsCount, sampleCount);
+}
 
-        for (audioch_t audioChannelIndex = 0; audioChannelIndex < m_processor._audioChannelsCount; ++audioChannelIndex) {
-            m_signalBuffers[audioChannelIndex][sampleIndex] = buffer[offset + audioChannelIndex];
-        }
+bool ReverbProcessor::supportsPlanarProcessing() const
+{
+    return true;
+}
+
+void ReverbProcessor::processPlanar(float* const* buffers, unsigned int sampleCount)
+{
+    if (m_processor._blockSize != static_cast<int>(sampleCount)) {
+        setFormat(m_processor._audioChannelsCount, m_processor._sampleRate, sampleCount);
     }
 
+    processSignal(buffers, sampleCount);
+}
+
+void ReverbProcessor::processSignal(float* const* signalPtr, unsigned int sampleCount)
+{
     switch (m_delays) {
-    case 24: _processLines<24>(m_signalBuffers, sampleCount);
+    case 24: _processLines<24>(signalPtr, sampleCount);
         break;
-    case 16: _processLines<16>(m_signalBuffers, sampleCount);
+    case 16: _processLines<16>(signalPtr, sampleCount);
         break;
-    case 12: _processLines<12>(m_signalBuffers, sampleCount);
+    case 12: _processLines<12>(signalPtr, sampleCount);
         break;
-    default: _processLines<8>(m_signalBuffers, sampleCount);
+    default: _processLines<8>(signalPtr, sampleCount);
         break;
     }
+}
 
-    for (samples_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex) {
-        size_t offset = sampleIndex * m_processor._audioChannelsCount;
-
-        for (audioch_t audioChannelIndex = 0; audioChannelIndex < m_processor._audioChannelsCount; ++audioChannelIndex) {
-            buffer[offset + audioChannelIndex] = m_signalBuffers[audioChannelIndex][sampleIndex];
-        }
+bool ReverbProcessor::setKernelBackend(ReverbKernelBackend backend)
+{
+    const ReverbKernels* kernels = reverbKernels(backend);
+    if (!kernels) {
+        return false;
     }
+
+    d->kernels = kernels;
+    return true;
 }
 
 void ReverbProcessor::getParameterInfo(int32_t index, ParameterInfo& info)
@@ -409,23 +426,20 @@ void ReverbProcessor::calculateTailParams()
         auto ag_cf = reverbfilters::onePoleCoeffsLowpass1Point<float>(getParameter(FeedbackTop), ag_gain,
                                                                       m_processor._sampleRate);
 
-        // copy coefficients to simd-friendly structures
-        int x = i >> 2, y = i & 3;
-        d->damping_cf1_x4[x].a1[y] = cf1.a1;
-        d->damping_cf1_x4[x].a2[y] = cf1.a2;
-        d->damping_cf1_x4[x].b0[y] = cf1.b0;
-        d->damping_cf1_x4[x].b1[y] = cf1.b1;
-        d->damping_cf1_x4[x].b2[y] = cf1.b2;
-
-        d->damping_cf2_x4[x].a1[y] = cf2.a1;
-        d->damping_cf2_x4[x].a2[y] = cf2.a2;
-        d->damping_cf2_x4[x].b0[y] = cf2.b0;
-        d->damping_cf2_x4[x].b1[y] = cf2.b1;
-        d->damping_cf2_x4[x].b2[y] = cf2.b2;
-
-        d->ag_filter_x4[x].cf.b0[y] = ag_cf.b0;
-        d->ag_filter_x4[x].cf.b1[y] = ag_cf.b1;
-        d->ag_filter_x4[x].cf.a1[y] = ag_cf.a1;
+        // copy coefficients to the lanes of the decay filter bank
+        ReverbDecayFilterBank& bank = d->decay_filters;
+        bank.gain.b0[i] = ag_cf.b0;
+        bank.gain.b1[i] = ag_cf.b1;
+        bank.gain.a1[i] = ag_cf.a1;
+
+        const IirBiquadFilter::Coeffs<float>* damping_cf[] = { &cf1, &cf2 };
+        for (int j = 0; j < 2; ++j) {
+            bank.damping[j].a1[i] = damping_cf[j]->a1;
+            bank.damping[j].a2[i] = damping_cf[j]->a2;
+            bank.damping[j].b0[i] = damping_cf[j]->b0;
+            bank.damping[j].b1[i] = damping_cf[j]->b1;
+            bank.damping[j].b2[i] = damping_cf[j]->b2;
+        }
     }
 }
 
@@ -622,11 +636,7 @@ void ReverbProcessor::reset()
         d->ivnd_out[i].reset();
         d->modDelay[i].reset();
     }
-    for (int j = 0; j < (m_delays >> 2); ++j) {
-        IirBiquadFilter::resetState(d->damping_state1_x4[j]);
-        IirBiquadFilter::resetState(d->damping_state2_x4[j]);
-        d->ag_filter_x4[j].reset();
-    }
+    d->decay_filters.reset();
     d->loCutFilter.reset();
     d->hiCutFilter.reset();
     d->peakFilter.reset();
@@ -637,7 +647,7 @@ void ReverbProcessor::reset()
 }
 
 template<int num_lines>
-void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
+void ReverbProcessor::_processLines(float* const* signalPtr, int32_t numSamples)
 {
     static_assert(num_lines == 8 || num_lines == 12 || num_lines == 16 || num_lines == 24);
 
@@ -694,6 +704,10 @@ void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
         }
         auto delay_out_ptr = d->delay_out_buffer.getPtrs();
 
+        // the lanes beyond num_lines are processed by the wider kernels and have to stay silent
+        alignas(64) float mat_in[ReverbDecayFilterBank::MAX_LINES] = {};
+        const ReverbKernels& kernels = *d->kernels;
+
         // feedback loop
         for (int cnt = 0; cnt < numSamples; ++cnt) {
             // update delay modulation offsets
@@ -719,20 +733,14 @@ void ReverbProcessor::_processLines(float** signalPtr, int32_t numSamples)
             }
 
             // delay line outputs / decay filters
-            float mat_in[num_lines];
-            for (int i = 0; i < num_lines; i += 4) {
-                int j = i >> 2;
-                simd::float_x4 s = { d->modDelay[i].readSample(), d->modDelay[i + 1].readSample(),
-                                     d->modDelay[i + 2].readSample(), d->modDelay[i + 3].readSample() };
-
-                s = d->ag_filter_x4[j].processSample(s);
-                s = IirBiquadFilter::processSampleDF2(s, d->damping_cf1_x4[j], d->damping_state1_x4[j]);
-                s = IirBiquadFilter::processSampleDF2(s, d->damping_cf2_x4[j], d->damping_state2_x4[j]);
-
-                mat_in[i] = delay_out_ptr[i][cnt] = s[0];
-                mat_in[i + 1] = delay_out_ptr[i + 1][cnt] = s[1];
-                mat_in[i + 2] = delay_out_ptr[i + 2][cnt] = s[2];
-                mat_in[i + 3] = delay_out_ptr[i + 3][cnt] = s[3];
+            for (int i = 0; i < num_lines; ++i) {
+                mat_in[i] = d->modDelay[i].readSample();
+            }
+
+            kernels.processDecayFilters(d->decay_filters, mat_in, num_lines);
+
+            for (int i = 0; i < num_lines; ++i) {
+                delay_out_ptr[i][cnt] = mat_in[i];
             }
             // Applying the Matrix
             float mat_res[num_lines];
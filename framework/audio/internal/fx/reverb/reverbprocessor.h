@@ -30,6 +30,8 @@
 
 #include "ifxprocessor.h"
 
+#include "reverbkernels.h"
+
 namespace muse::audio::fx {
 class ReverbProcessor : public IFxProcessor
 {
@@ -46,6 +48,11 @@ public:
     void setActive(bool active) override;
 
     void process(float* buffer, unsigned int sampleCount) override;
+    bool supportsPlanarProcessing() const override;
+    void processPlanar(float* const* buffers, unsigned int sampleCount) override;
+
+    //! NOTE The best available backend is used by default, returns false if the backend is not available
+    bool setKernelBackend(ReverbKernelBackend backend);
 
 private:
     enum Params
@@ -124,8 +131,10 @@ private:
     Processor m_processor;
 
     // Specific effect data
+    void processSignal(float* const* signalPtr, unsigned int sampleCount);
+
     template<int num_lines>
-    void _processLines(float** signalPtr, int32_t numSamples);
+    void _processLines(float* const* signalPtr, int32_t numSamples);
     static constexpr int max_num_delays = 24;
 
     void calculateTailParams();
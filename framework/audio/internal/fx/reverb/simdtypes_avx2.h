@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_SIMDTYPES_AVX2_H
+#define MUSE_AUDIO_SIMDTYPES_AVX2_H
+
+#if _MSC_VER
+#define __finl __forceinline
+#define __vecc __vectorcall
+#else
+#define __finl inline __attribute__((always_inline))
+#define __vecc
+#endif
+
+#include <immintrin.h>
+
+/*
+AVX2 simd types, 8 floats wide.
+Only to be included from translation units built with AVX2 enabled,
+which are called after checking the CPU support at runtime.
+*/
+
+namespace muse::audio::fx::simd {
+struct float_x8
+{
+    __m256 s;
+    __finl float_x8()
+    {
+    }
+
+    __finl float_x8(float val)
+    {
+        s = _mm256_set1_ps(val);
+    }
+
+    __finl float_x8(const __m256& val)
+        : s(val)
+    {
+    }
+
+    /// loads 8 consecutive values, no alignment required
+    static __finl float_x8 load(const float* p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+
+    __finl void store(float* p) const
+    {
+        _mm256_storeu_ps(p, s);
+    }
+};
+
+__finl float_x8 __vecc operator+(float_x8 a, float_x8 b)
+{
+    return _mm256_add_ps(a.s, b.s);
+}
+
+__finl float_x8 __vecc operator-(float_x8 a, float_x8 b)
+{
+    return _mm256_sub_ps(a.s, b.s);
+}
+
+__finl float_x8 __vecc operator*(float_x8 a, float_x8 b)
+{
+    return _mm256_mul_ps(a.s, b.s);
+}
+} // namespace muse::audio::fx
+
+#endif // MUSE_AUDIO_SIMDTYPES_AVX2_H
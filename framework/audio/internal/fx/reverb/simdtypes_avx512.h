@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_SIMDTYPES_AVX512_H
+#define MUSE_AUDIO_SIMDTYPES_AVX512_H
+
+#if _MSC_VER
+#define __finl __forceinline
+#define __vecc __vectorcall
+#else
+#define __finl inline __attribute__((always_inline))
+#define __vecc
+#endif
+
+#include <immintrin.h>
+
+/*
+AVX-512F simd types, 16 floats wide.
+Only to be included from translation units built with AVX-512F enabled,
+which are called after checking the CPU support at runtime.
+*/
+
+namespace muse::audio::fx::simd {
+struct float_x16
+{
+    __m512 s;
+    __finl float_x16()
+    {
+    }
+
+    __finl float_x16(float val)
+    {
+        s = _mm512_set1_ps(val);
+    }
+
+    __finl float_x16(const __m512& val)
+        : s(val)
+    {
+    }
+
+    /// loads 16 consecutive values, no alignment required
+    static __finl float_x16 load(const float* p)
+    {
+        return _mm512_loadu_ps(p);
+    }
+
+    __finl void store(float* p) const
+    {
+        _mm512_storeu_ps(p, s);
+    }
+};
+
+__finl float_x16 __vecc operator+(float_x16 a, float_x16 b)
+{
+    return _mm512_add_ps(a.s, b.s);
+}
+
+__finl float_x16 __vecc operator-(float_x16 a, float_x16 b)
+{
+    return _mm512_sub_ps(a.s, b.s);
+}
+
+__finl float_x16 __vecc operator*(float_x16 a, float_x16 b)
+{
+    return _mm512_mul_ps(a.s, b.s);
+}
+} // namespace muse::audio::fx
+
+#endif // MUSE_AUDIO_SIMDTYPES_AVX512_H
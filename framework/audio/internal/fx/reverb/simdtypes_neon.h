@@ -73,6 +73,17 @@ struct float_x4
 #endif
     }
 
+    /// loads 4 consecutive values, no alignment required
+    static __finl float_x4 load(const float* p)
+    {
+        return vld1q_f32(p);
+    }
+
+    __finl void store(float* p) const
+    {
+        vst1q_f32(p, s);
+    }
+
 #if defined(__clang__) || defined(__GNUC__)
 private:
     // this helper class allows writing to the single registers for clang
@@ -58,6 +58,20 @@ struct float_x4
         v[3] = v3;
     }
 
+    /// loads 4 consecutive values, no alignment required
+    static __finl float_x4 load(const float* p)
+    {
+        return { p[0], p[1], p[2], p[3] };
+    }
+
+    __finl void store(float* p) const
+    {
+        p[0] = v[0];
+        p[1] = v[1];
+        p[2] = v[2];
+        p[3] = v[3];
+    }
+
     __finl float& operator[](int n)
     {
         return v[n];
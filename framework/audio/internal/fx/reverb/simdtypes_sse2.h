@@ -68,6 +68,17 @@ struct float_x4
         s = _mm_setr_ps(v0, v1, v2, v3);
     }
 
+    /// loads 4 consecutive values, no alignment required
+    static __finl float_x4 load(const float* p)
+    {
+        return _mm_loadu_ps(p);
+    }
+
+    __finl void store(float* p) const
+    {
+        _mm_storeu_ps(p, s);
+    }
+
 #if defined(__clang__) || defined(__GNUC__)
 private:
     // this helper class allows writing to the single registers for clang
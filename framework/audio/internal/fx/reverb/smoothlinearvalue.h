@@ -23,6 +23,9 @@
 #ifndef MUSE_AUDIO_SMOOTHLINEARVALUE_H
 #define MUSE_AUDIO_SMOOTHLINEARVALUE_H
 
+#include <algorithm>
+#include <type_traits>
+
 #include "vectorops.h"
 
 namespace muse::audio::fx {
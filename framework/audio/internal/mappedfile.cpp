@@ -0,0 +1,196 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mappedfile.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "log.h"
+
+using namespace muse::audio;
+
+static size_t memoryPageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+MappedFilePtr MappedFile::open(const std::string& path)
+{
+    MappedFilePtr file(new MappedFile());
+
+#ifdef _WIN32
+    int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(length, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), length);
+
+    HANDLE handle = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    file->m_file = handle;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0) {
+        return nullptr;
+    }
+
+    file->m_mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!file->m_mapping) {
+        return nullptr;
+    }
+
+    void* data = MapViewOfFile(file->m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        return nullptr;
+    }
+
+    file->m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+
+    file->m_size = static_cast<size_t>(st.st_size);
+#endif
+
+    file->m_data = static_cast<const uint8_t*>(data);
+
+    return file;
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+
+    if (m_file) {
+        CloseHandle(m_file);
+    }
+#else
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+}
+
+const uint8_t* MappedFile::data() const
+{
+    return m_data;
+}
+
+size_t MappedFile::size() const
+{
+    return m_size;
+}
+
+void MappedFile::willNeed(uint64_t offset, uint64_t size) const
+{
+    if (offset >= m_size) {
+        return;
+    }
+
+#ifdef _WIN32
+    UNUSED(size);
+#else
+    const size_t pageSize = memoryPageSize();
+    const size_t begin = static_cast<size_t>(offset) / pageSize * pageSize;
+    const size_t end = std::min(static_cast<size_t>(offset + size), m_size);
+
+    madvise(const_cast<uint8_t*>(m_data) + begin, end - begin, MADV_WILLNEED);
+#endif
+}
+
+void MappedFile::touch(uint64_t offset, uint64_t size) const
+{
+    const size_t pageSize = memoryPageSize();
+    const size_t end = std::min(static_cast<size_t>(offset + size), m_size);
+    volatile uint8_t sink = 0;
+
+    for (size_t i = static_cast<size_t>(offset) / pageSize * pageSize; i < end; i += pageSize) {
+        sink = sink + m_data[i];
+    }
+}
+
+size_t MappedFile::residentBytes(size_t fallback) const
+{
+#ifdef _WIN32
+    //! NOTE Windows can only tell this per page of the working set
+    return fallback;
+#else
+    const size_t pageSize = memoryPageSize();
+    const size_t pagesCount = (m_size + pageSize - 1) / pageSize;
+
+#ifdef __APPLE__
+    std::vector<char> pages(pagesCount);
+#else
+    std::vector<unsigned char> pages(pagesCount);
+#endif
+
+    if (mincore(const_cast<uint8_t*>(m_data), m_size, pages.data()) != 0) {
+        return fallback;
+    }
+
+    const size_t residentPages = std::count_if(pages.cbegin(), pages.cend(), [](auto page) {
+        return (page & 1) != 0;
+    });
+
+    return std::min(residentPages * pageSize, m_size);
+#endif
+}
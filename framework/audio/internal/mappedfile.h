@@ -0,0 +1,70 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_MAPPEDFILE_H
+#define MUSE_AUDIO_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace muse::audio {
+class MappedFile;
+using MappedFilePtr = std::shared_ptr<MappedFile>;
+
+//! NOTE A read-only mapping of a whole file. The OS reads the pages on first access
+//! and may drop them again under memory pressure, so large files cost address space rather than memory
+class MappedFile
+{
+public:
+    //! NOTE Returns nullptr if the file can't be opened or is empty
+    static MappedFilePtr open(const std::string& path);
+
+    ~MappedFile();
+
+    const uint8_t* data() const;
+    size_t size() const;
+
+    //! NOTE Asks the OS to start reading the range in the background
+    void willNeed(uint64_t offset, uint64_t size) const;
+
+    //! NOTE Reads a byte of every page of the range, so that it is in physical memory when it returns
+    void touch(uint64_t offset, uint64_t size) const;
+
+    //! NOTE The bytes of the file which are currently in physical memory, fallback if the OS can't tell
+    size_t residentBytes(size_t fallback) const;
+
+private:
+    MappedFile() = default;
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+}
+
+#endif // MUSE_AUDIO_MAPPEDFILE_H
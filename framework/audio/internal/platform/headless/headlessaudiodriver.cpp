@@ -0,0 +1,455 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "headlessaudiodriver.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "translation.h"
+#include "log.h"
+#include "runtime.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+static constexpr char HEADLESS_DEVICE_ID[] = "headless";
+static constexpr size_t WAV_HEADER_SIZE = 44;
+static constexpr uint16_t WAV_FORMAT_IEEE_FLOAT = 3;
+
+static void writeLittleEndian(std::FILE* file, uint32_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; ++i) {
+        std::fputc(static_cast<int>((value >> (i * 8)) & 0xFF), file);
+    }
+}
+
+static void writeWavHeader(std::FILE* file, unsigned int sampleRate, uint16_t channels, uint64_t dataBytes)
+{
+    const uint32_t dataSize = static_cast<uint32_t>(std::min<uint64_t>(dataBytes, UINT32_MAX - WAV_HEADER_SIZE));
+    const uint16_t bytesPerSample = sizeof(float);
+
+    std::fputs("RIFF", file);
+    writeLittleEndian(file, dataSize + WAV_HEADER_SIZE - 8, 4);
+    std::fputs("WAVEfmt ", file);
+    writeLittleEndian(file, 16, 4);
+    writeLittleEndian(file, WAV_FORMAT_IEEE_FLOAT, 2);
+    writeLittleEndian(file, channels, 2);
+    writeLittleEndian(file, sampleRate, 4);
+    writeLittleEndian(file, sampleRate * channels * bytesPerSample, 4);
+    writeLittleEndian(file, channels * bytesPerSample, 2);
+    writeLittleEndian(file, bytesPerSample * 8, 2);
+    std::fputs("data", file);
+    writeLittleEndian(file, dataSize, 4);
+}
+
+static double percentile(std::vector<float>& values, double fraction)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+
+    return values[index];
+}
+
+HeadlessAudioDriver::HeadlessAudioDriver(const Options& options)
+    : m_options(options)
+{
+}
+
+HeadlessAudioDriver::~HeadlessAudioDriver()
+{
+    close();
+}
+
+void HeadlessAudioDriver::init()
+{
+}
+
+std::string HeadlessAudioDriver::name() const
+{
+    return "MUAUDIO(HEADLESS)";
+}
+
+bool HeadlessAudioDriver::open(const Spec& spec, Spec* activeSpec)
+{
+    IF_ASSERT_FAILED(!m_opened) {
+        return false;
+    }
+
+    IF_ASSERT_FAILED(spec.sampleRate > 0 && spec.samples > 0 && spec.channels > 0) {
+        return false;
+    }
+
+    m_spec = spec;
+    m_spec.format = Format::AudioF32;
+
+    if (activeSpec) {
+        *activeSpec = m_spec;
+    }
+
+    m_buffer.assign(static_cast<size_t>(m_spec.samples) * m_spec.channels, 0.f);
+    m_pulledFrames = 0;
+    resetStats();
+
+    if (!m_options.outputFilePath.empty() && !openOutputFile()) {
+        return false;
+    }
+
+    m_opened = true;
+    m_stopRequested = false;
+
+    if (!m_options.manualClock) {
+        m_thread = std::thread([this]() {
+            run();
+        });
+    }
+
+    LOGI() << "Opened with bufferSize " << m_spec.samples
+           << ", sampleRate " << m_spec.sampleRate
+           << ", channels: " << m_spec.channels
+           << ", speed: " << m_options.speed;
+
+    return true;
+}
+
+void HeadlessAudioDriver::close()
+{
+    if (!m_opened) {
+        return;
+    }
+
+    m_stopRequested = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    closeOutputFile();
+    m_opened = false;
+}
+
+bool HeadlessAudioDriver::isOpened() const
+{
+    return m_opened;
+}
+
+const HeadlessAudioDriver::Spec& HeadlessAudioDriver::activeSpec() const
+{
+    return m_spec;
+}
+
+AudioDeviceID HeadlessAudioDriver::outputDevice() const
+{
+    return HEADLESS_DEVICE_ID;
+}
+
+bool HeadlessAudioDriver::selectOutputDevice(const AudioDeviceID& deviceId)
+{
+    return deviceId == HEADLESS_DEVICE_ID;
+}
+
+bool HeadlessAudioDriver::resetToDefaultOutputDevice()
+{
+    return true;
+}
+
+async::Notification HeadlessAudioDriver::outputDeviceChanged() const
+{
+    return m_outputDeviceChanged;
+}
+
+AudioDeviceList HeadlessAudioDriver::availableOutputDevices() const
+{
+    AudioDeviceList devices;
+    devices.push_back({ HEADLESS_DEVICE_ID, muse::trc("audio", "No audio device") });
+
+    return devices;
+}
+
+async::Notification HeadlessAudioDriver::availableOutputDevicesChanged() const
+{
+    return m_availableOutputDevicesChanged;
+}
+
+unsigned int HeadlessAudioDriver::outputDeviceBufferSize() const
+{
+    return m_spec.samples;
+}
+
+bool HeadlessAudioDriver::setOutputDeviceBufferSize(unsigned int bufferSize)
+{
+    if (m_spec.samples == bufferSize) {
+        return true;
+    }
+
+    bool reopen = isOpened();
+    close();
+    m_spec.samples = bufferSize;
+
+    bool ok = true;
+    if (reopen) {
+        ok = open(m_spec, &m_spec);
+    }
+
+    if (ok) {
+        m_bufferSizeChanged.notify();
+    }
+
+    return ok;
+}
+
+async::Notification HeadlessAudioDriver::outputDeviceBufferSizeChanged() const
+{
+    return m_bufferSizeChanged;
+}
+
+std::vector<unsigned int> HeadlessAudioDriver::availableOutputDeviceBufferSizes() const
+{
+    std::vector<unsigned int> result;
+
+    for (unsigned int n = MINIMUM_BUFFER_SIZE; n <= MAXIMUM_BUFFER_SIZE; n *= 2) {
+        result.push_back(n);
+    }
+
+    return result;
+}
+
+unsigned int HeadlessAudioDriver::outputDeviceSampleRate() const
+{
+    return m_spec.sampleRate;
+}
+
+bool HeadlessAudioDriver::setOutputDeviceSampleRate(unsigned int sampleRate)
+{
+    if (m_spec.sampleRate == sampleRate) {
+        return true;
+    }
+
+    bool reopen = isOpened();
+    close();
+    m_spec.sampleRate = sampleRate;
+
+    bool ok = true;
+    if (reopen) {
+        ok = open(m_spec, &m_spec);
+    }
+
+    if (ok) {
+        m_sampleRateChanged.notify();
+    }
+
+    return ok;
+}
+
+async::Notification HeadlessAudioDriver::outputDeviceSampleRateChanged() const
+{
+    return m_sampleRateChanged;
+}
+
+std::vector<unsigned int> HeadlessAudioDriver::availableOutputDeviceSampleRates() const
+{
+    return {
+        44100,
+        48000,
+        88200,
+        96000,
+    };
+}
+
+void HeadlessAudioDriver::resume()
+{
+    m_suspended = false;
+}
+
+void HeadlessAudioDriver::suspend()
+{
+    m_suspended = true;
+}
+
+size_t HeadlessAudioDriver::advance(size_t blocksCount)
+{
+    IF_ASSERT_FAILED(m_opened && m_options.manualClock) {
+        return 0;
+    }
+
+    if (m_suspended) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < blocksCount; ++i) {
+        pullBlock();
+    }
+
+    return blocksCount;
+}
+
+msecs_t HeadlessAudioDriver::virtualTime() const
+{
+    if (m_spec.sampleRate == 0) {
+        return 0;
+    }
+
+    return static_cast<msecs_t>(m_pulledFrames.load(std::memory_order_relaxed) * 1000000 / m_spec.sampleRate);
+}
+
+HeadlessAudioDriver::Stats HeadlessAudioDriver::stats() const
+{
+    std::vector<float> times;
+    Stats result;
+
+    {
+        std::lock_guard lock(m_statsMutex);
+        times.assign(m_callbackTimesUs.begin(), m_callbackTimesUs.begin() + std::min<uint64_t>(m_blocksCount, m_callbackTimesUs.size()));
+
+        result.blocksCount = m_blocksCount;
+        result.xrunsCount = m_xrunsCount;
+        result.meanCallbackUs = m_blocksCount > 0 ? m_callbackTimeSumUs / m_blocksCount : 0.0;
+        result.maxCallbackUs = m_maxCallbackUs;
+    }
+
+    if (m_spec.sampleRate > 0) {
+        result.blockDurationUs = m_spec.samples * 1000000.0 / m_spec.sampleRate;
+        if (m_options.speed > 0.0) {
+            result.blockDurationUs /= m_options.speed;
+        }
+    }
+
+    result.p50CallbackUs = percentile(times, 0.5);
+    result.p90CallbackUs = percentile(times, 0.9);
+    result.p99CallbackUs = percentile(times, 0.99);
+
+    return result;
+}
+
+void HeadlessAudioDriver::resetStats()
+{
+    std::lock_guard lock(m_statsMutex);
+
+    m_callbackTimesUs.assign(std::max<size_t>(m_options.statsCapacity, 1), 0.f);
+    m_blocksCount = 0;
+    m_xrunsCount = 0;
+    m_callbackTimeSumUs = 0.0;
+    m_maxCallbackUs = 0.0;
+}
+
+void HeadlessAudioDriver::run()
+{
+    runtime::setThreadName("audio_driver");
+
+    using clock = std::chrono::steady_clock;
+
+    //! NOTE The deadlines are absolute, so the sleep jitter doesn't accumulate into a drift of the clock
+    const bool paced = m_options.speed > 0.0;
+    const std::chrono::duration<double> blockPeriod(paced ? m_spec.samples / (m_spec.sampleRate * m_options.speed) : 0.0);
+    const clock::duration period = std::chrono::duration_cast<clock::duration>(blockPeriod);
+
+    clock::time_point deadline = clock::now();
+
+    while (!m_stopRequested.load(std::memory_order_acquire)) {
+        if (m_suspended.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            deadline = clock::now();
+            continue;
+        }
+
+        pullBlock();
+
+        if (!paced) {
+            continue;
+        }
+
+        deadline += period;
+
+        //! NOTE Like a device, the clock doesn't wait for a late block, the missed time is lost
+        const clock::time_point now = clock::now();
+        if (now < deadline) {
+            std::this_thread::sleep_until(deadline);
+        } else {
+            deadline = now;
+        }
+    }
+}
+
+void HeadlessAudioDriver::pullBlock()
+{
+    using clock = std::chrono::steady_clock;
+
+    const clock::time_point start = clock::now();
+
+    if (m_spec.callback) {
+        m_spec.callback(m_spec.userdata, reinterpret_cast<uint8_t*>(m_buffer.data()), static_cast<int>(m_buffer.size() * sizeof(float)));
+    }
+
+    const double elapsedUs = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    m_pulledFrames.fetch_add(m_spec.samples, std::memory_order_relaxed);
+
+    if (m_outputFile) {
+        m_outputDataBytes += std::fwrite(m_buffer.data(), sizeof(float), m_buffer.size(), m_outputFile) * sizeof(float);
+    }
+
+    double budgetUs = m_spec.samples * 1000000.0 / m_spec.sampleRate;
+    if (m_options.speed > 0.0) {
+        budgetUs /= m_options.speed;
+    }
+
+    std::lock_guard lock(m_statsMutex);
+
+    m_callbackTimesUs[m_blocksCount % m_callbackTimesUs.size()] = static_cast<float>(elapsedUs);
+    m_blocksCount++;
+    m_callbackTimeSumUs += elapsedUs;
+    m_maxCallbackUs = std::max(m_maxCallbackUs, elapsedUs);
+
+    if (elapsedUs > budgetUs) {
+        m_xrunsCount++;
+    }
+}
+
+bool HeadlessAudioDriver::openOutputFile()
+{
+    m_outputFile = std::fopen(m_options.outputFilePath.c_str(), "wb");
+    if (!m_outputFile) {
+        LOGE() << "Unable to open the output file: " << m_options.outputFilePath;
+        return false;
+    }
+
+    //! NOTE The sizes are written for real on close
+    m_outputDataBytes = 0;
+    writeWavHeader(m_outputFile, m_spec.sampleRate, m_spec.channels, 0);
+
+    return true;
+}
+
+void HeadlessAudioDriver::closeOutputFile()
+{
+    if (!m_outputFile) {
+        return;
+    }
+
+    std::fseek(m_outputFile, 0, SEEK_SET);
+    writeWavHeader(m_outputFile, m_spec.sampleRate, m_spec.channels, m_outputDataBytes);
+
+    std::fclose(m_outputFile);
+    m_outputFile = nullptr;
+}
@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_HEADLESSAUDIODRIVER_H
+#define MUSE_AUDIO_HEADLESSAUDIODRIVER_H
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "global/io/path.h"
+
+#include "iaudiodriver.h"
+
+namespace muse::audio {
+//! NOTE Plays into nowhere, or into a WAV file, on a virtual clock instead of an audio device.
+//! So the whole engine can run without audio hardware or a sound server: in tests, benchmarks and on CI
+class HeadlessAudioDriver : public IAudioDriver
+{
+public:
+    struct Options
+    {
+        //! NOTE How fast the virtual clock runs compared to the real time, 0 means as fast as the engine can render
+        double speed = 1.0;
+
+        //! NOTE If set, open() doesn't start the driver thread, the blocks are pulled by advance() on the calling thread
+        bool manualClock = false;
+
+        //! NOTE If not empty, the output is written there as a 32-bit float WAV file
+        io::path_t outputFilePath;
+
+        //! NOTE The callback times of this many latest blocks are kept for the percentiles
+        size_t statsCapacity = 1 << 16;
+    };
+
+    struct Stats
+    {
+        uint64_t blocksCount = 0;
+        uint64_t xrunsCount = 0;            // the callback took longer than the block lasts on the virtual clock
+        double blockDurationUs = 0.0;       // the budget of one callback
+        double meanCallbackUs = 0.0;
+        double p50CallbackUs = 0.0;
+        double p90CallbackUs = 0.0;
+        double p99CallbackUs = 0.0;
+        double maxCallbackUs = 0.0;
+    };
+
+    HeadlessAudioDriver() = default;
+    explicit HeadlessAudioDriver(const Options& options);
+    ~HeadlessAudioDriver() override;
+
+    void init() override;
+
+    std::string name() const override;
+    bool open(const Spec& spec, Spec* activeSpec) override;
+    void close() override;
+    bool isOpened() const override;
+
+    const Spec& activeSpec() const override;
+
+    AudioDeviceID outputDevice() const override;
+    bool selectOutputDevice(const AudioDeviceID& deviceId) override;
+    bool resetToDefaultOutputDevice() override;
+    async::Notification outputDeviceChanged() const override;
+
+    AudioDeviceList availableOutputDevices() const override;
+    async::Notification availableOutputDevicesChanged() const override;
+
+    unsigned int outputDeviceBufferSize() const override;
+    bool setOutputDeviceBufferSize(unsigned int bufferSize) override;
+    async::Notification outputDeviceBufferSizeChanged() const override;
+
+    std::vector<unsigned int> availableOutputDeviceBufferSizes() const override;
+
+    unsigned int outputDeviceSampleRate() const override;
+    bool setOutputDeviceSampleRate(unsigned int sampleRate) override;
+    async::Notification outputDeviceSampleRateChanged() const override;
+
+    std::vector<unsigned int> availableOutputDeviceSampleRates() const override;
+
+    void resume() override;
+    void suspend() override;
+
+    //! NOTE Only with the manual clock: pulls the given number of blocks, returns the number of pulled blocks
+    size_t advance(size_t blocksCount);
+
+    //! NOTE The position of the virtual clock: the duration of the audio pulled since open()
+    msecs_t virtualTime() const;
+
+    Stats stats() const;
+    void resetStats();
+
+private:
+    void run();
+    void pullBlock();
+
+    bool openOutputFile();
+    void closeOutputFile();
+
+    Options m_options;
+    Spec m_spec = {};
+    bool m_opened = false;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopRequested = false;
+    std::atomic<bool> m_suspended = false;
+
+    std::vector<float> m_buffer;
+    std::atomic<uint64_t> m_pulledFrames = 0;
+
+    std::FILE* m_outputFile = nullptr;
+    uint64_t m_outputDataBytes = 0;
+
+    mutable std::mutex m_statsMutex;
+    std::vector<float> m_callbackTimesUs;
+    uint64_t m_blocksCount = 0;
+    uint64_t m_xrunsCount = 0;
+    double m_callbackTimeSumUs = 0.0;
+    double m_maxCallbackUs = 0.0;
+
+    async::Notification m_outputDeviceChanged;
+    async::Notification m_availableOutputDevicesChanged;
+    async::Notification m_bufferSizeChanged;
+    async::Notification m_sampleRateChanged;
+};
+}
+
+#endif // MUSE_AUDIO_HEADLESSAUDIODRIVER_H
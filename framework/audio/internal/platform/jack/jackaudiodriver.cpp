@@ -43,6 +43,7 @@ struct JackData
     int channels = 0;
     std::vector<jack_port_t*> outputPorts;
     IAudioDriver::Callback callback;
+    IAudioDriver::PlanarCallback planarCallback;
     void* userdata = nullptr;
 };
 
@@ -56,6 +57,13 @@ int muse::audio::jack_process_callback(jack_nframes_t nframes, void*)
     jack_default_audio_sample_t* l = (float*)jack_port_get_buffer(data->outputPorts[0], nframes);
     jack_default_audio_sample_t* r = (float*)jack_port_get_buffer(data->outputPorts[1], nframes);
 
+    //! NOTE The ports are planar, so they are filled directly when the engine provides planar audio
+    if (data->planarCallback && data->channels == 2) {
+        float* channels[] = { l, r };
+        data->planarCallback(data->userdata, channels, nframes);
+        return 0;
+    }
+
     uint8_t* stream = (uint8_t*)data->buffer;
     data->callback(data->userdata, stream, nframes * data->channels * sizeof(float));
     float* sp = data->buffer;
@@ -124,6 +132,7 @@ bool JackAudioDriver::open(const Spec& spec, Spec* activeSpec)
     // s_jackData->samples  = spec.samples; // client doesn't set sample-rate
     s_jackData->channels = spec.channels;
     s_jackData->callback = spec.callback;
+    s_jackData->planarCallback = spec.planarCallback;
     s_jackData->userdata = spec.userdata;
     // FIX: "default" is not a good name for jack-clients
     //  const char *clientName =
@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "soundfontindex.h"
+
+#include <cstdlib>
+#include <set>
+
+#include "global/serialization/json.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::audio::synth;
+
+//! NOTE Bump when the format or the parsing changes, to rebuild the index
+static constexpr int SOUNDFONT_INDEX_VERSION = 1;
+
+const SoundFontMeta* SoundFontIndex::find(const SoundFontPath& path, const SoundFontFileStamp& stamp) const
+{
+    auto it = m_entries.find(path);
+    if (it == m_entries.cend() || it->second.stamp != stamp) {
+        return nullptr;
+    }
+
+    return &it->second.meta;
+}
+
+void SoundFontIndex::insert(const SoundFontFileStamp& stamp, const SoundFontMeta& meta)
+{
+    m_entries.insert_or_assign(meta.path, Entry { stamp, meta });
+    m_changed = true;
+}
+
+void SoundFontIndex::retain(const SoundFontPaths& paths)
+{
+    std::set<SoundFontPath> installed(paths.cbegin(), paths.cend());
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (installed.find(it->first) == installed.cend()) {
+            it = m_entries.erase(it);
+            m_changed = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t SoundFontIndex::size() const
+{
+    return m_entries.size();
+}
+
+bool SoundFontIndex::isChanged() const
+{
+    return m_changed;
+}
+
+ByteArray SoundFontIndex::toJson()
+{
+    JsonArray soundFonts;
+
+    for (const auto& pair : m_entries) {
+        const Entry& entry = pair.second;
+
+        JsonArray presets;
+        for (const SoundFontPreset& preset : entry.meta.presets) {
+            JsonObject presetObj;
+            presetObj.set("bank", static_cast<int>(preset.program.bank));
+            presetObj.set("program", static_cast<int>(preset.program.program));
+            presetObj.set("name", preset.name);
+            presets.append(presetObj);
+        }
+
+        JsonObject obj;
+        obj.set("path", pair.first.toStdString());
+        //! NOTE Json numbers are written as int, which is too small for big files
+        obj.set("size", std::to_string(entry.stamp.size));
+        obj.set("lastModified", entry.stamp.lastModified.toString());
+        obj.set("presets", presets);
+        soundFonts.append(obj);
+    }
+
+    JsonObject root;
+    root.set("version", SOUNDFONT_INDEX_VERSION);
+    root.set("soundFonts", soundFonts);
+
+    m_changed = false;
+
+    return JsonDocument(root).toJson(JsonDocument::Format::Compact);
+}
+
+Ret SoundFontIndex::fromJson(const ByteArray& data)
+{
+    m_entries.clear();
+    m_changed = false;
+
+    std::string err;
+    JsonDocument doc = JsonDocument::fromJson(data, &err);
+    if (!err.empty()) {
+        LOGE() << "failed parse SoundFont index, err: " << err;
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    if (!doc.isObject()) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    JsonObject root = doc.rootObject();
+    if (root.value("version").toInt() != SOUNDFONT_INDEX_VERSION) {
+        LOGD() << "outdated SoundFont index, it will be rebuilt";
+        m_changed = true;
+        return make_ret(Ret::Code::Ok);
+    }
+
+    JsonArray soundFonts = root.value("soundFonts").toArray();
+    for (size_t i = 0; i < soundFonts.size(); ++i) {
+        JsonObject obj = soundFonts.at(i).toObject();
+
+        Entry entry;
+        entry.meta.path = SoundFontPath(obj.value("path").toStdString());
+        entry.stamp.size = std::strtoull(obj.value("size").toStdString().c_str(), nullptr, 10);
+        entry.stamp.lastModified = DateTime::fromStringISOFormat(obj.value("lastModified").toString());
+
+        JsonArray presets = obj.value("presets").toArray();
+        entry.meta.presets.reserve(presets.size());
+
+        for (size_t p = 0; p < presets.size(); ++p) {
+            JsonObject presetObj = presets.at(p).toObject();
+
+            SoundFontPreset preset;
+            preset.program = midi::Program(static_cast<midi::bank_t>(presetObj.value("bank").toInt()),
+                                           static_cast<midi::program_t>(presetObj.value("program").toInt()));
+            preset.name = presetObj.value("name").toStdString();
+            entry.meta.presets.push_back(std::move(preset));
+        }
+
+        SoundFontPath path = entry.meta.path;
+        m_entries.insert_or_assign(path, std::move(entry));
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
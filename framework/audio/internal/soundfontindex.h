@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_SOUNDFONTINDEX_H
+#define MUSE_AUDIO_SOUNDFONTINDEX_H
+
+#include <map>
+
+#include "global/types/datetime.h"
+#include "global/types/ret.h"
+
+#include "../soundfonttypes.h"
+
+namespace muse::audio::synth {
+//! NOTE Identifies the version of a SoundFont file on disk
+struct SoundFontFileStamp
+{
+    uint64_t size = 0;
+    DateTime lastModified;
+
+    bool operator==(const SoundFontFileStamp& other) const
+    {
+        return size == other.size && lastModified == other.lastModified;
+    }
+
+    bool operator!=(const SoundFontFileStamp& other) const
+    {
+        return !operator==(other);
+    }
+};
+
+//! NOTE Persistent cache of the presets of the installed SoundFonts,
+//! so that only new or changed files have to be parsed on startup
+class SoundFontIndex
+{
+public:
+    SoundFontIndex() = default;
+
+    //! NOTE Returns nullptr if the file is not indexed or has changed since
+    const SoundFontMeta* find(const SoundFontPath& path, const SoundFontFileStamp& stamp) const;
+
+    void insert(const SoundFontFileStamp& stamp, const SoundFontMeta& meta);
+
+    //! NOTE Drops the entries of the files that are not installed anymore
+    void retain(const SoundFontPaths& paths);
+
+    size_t size() const;
+
+    //! NOTE Whether there are changes since the last serialization
+    bool isChanged() const;
+
+    ByteArray toJson();
+    Ret fromJson(const ByteArray& data);
+
+private:
+    struct Entry
+    {
+        SoundFontFileStamp stamp;
+        SoundFontMeta meta;
+    };
+
+    std::map<SoundFontPath, Entry> m_entries;
+    bool m_changed = false;
+};
+}
+
+#endif // MUSE_AUDIO_SOUNDFONTINDEX_H
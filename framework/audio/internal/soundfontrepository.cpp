@@ -21,6 +21,8 @@
  */
 #include "soundfontrepository.h"
 
+#include <algorithm>
+
 #include "global/translation.h"
 
 #include "synthesizers/fluidsynth/fluidsoundfontparser.h"
@@ -45,13 +47,19 @@ void SoundFontRepository::loadSoundFonts()
     TRACEFUNC;
 
     m_soundFontPaths.clear();
+    m_soundFonts.clear();
 
-    SoundFontsMap oldSoundFonts;
-    m_soundFonts.swap(oldSoundFonts);
+    if (!m_indexLoaded) {
+        loadIndex();
+        m_indexLoaded = true;
+    }
 
     static const std::vector<std::string> filters = { "*.sf2",  "*.sf3" };
     io::paths_t dirs = configuration()->soundFontDirectories();
 
+    SoundFontPaths changedPaths;
+    std::vector<SoundFontFileStamp> changedStamps;
+
     for (const io::path_t& dir : dirs) {
         RetVal<io::paths_t> soundFonts = fileSystem()->scanFiles(dir, filters);
         if (!soundFonts.ret) {
@@ -60,21 +68,44 @@ void SoundFontRepository::loadSoundFonts()
         }
 
         for (const SoundFontPath& soundFont : soundFonts.val) {
-            loadSoundFont(soundFont, oldSoundFonts);
+            m_soundFontPaths.push_back(soundFont);
+
+            SoundFontFileStamp stamp = fileStamp(soundFont);
+            const SoundFontMeta* meta = m_index.find(soundFont, stamp);
+            if (meta) {
+                m_soundFonts.insert_or_assign(soundFont, *meta);
+                continue;
+            }
+
+            changedPaths.push_back(soundFont);
+            changedStamps.push_back(stamp);
+        }
+    }
+
+    //! NOTE Only new or changed files are parsed, all of them at once
+    std::vector<RetVal<SoundFontMeta> > metas = FluidSoundFontParser::parseSoundFonts(changedPaths);
+
+    for (size_t i = 0; i < metas.size(); ++i) {
+        if (!metas[i].ret) {
+            LOGE() << "Failed parse SoundFont presets for " << changedPaths[i] << ": " << metas[i].ret.toString();
+            continue;
         }
+
+        m_index.insert(changedStamps[i], metas[i].val);
+        m_soundFonts.insert_or_assign(changedPaths[i], std::move(metas[i].val));
     }
+
+    m_index.retain(m_soundFontPaths);
+    saveIndex();
 }
 
-void SoundFontRepository::loadSoundFont(const SoundFontPath& path, const SoundFontsMap& oldSoundFonts)
+void SoundFontRepository::loadSoundFont(const SoundFontPath& path)
 {
-    m_soundFontPaths.push_back(path);
-
-    auto it = oldSoundFonts.find(path);
-    if (it != oldSoundFonts.cend()) {
-        m_soundFonts.insert(*it);
-        return;
+    if (std::find(m_soundFontPaths.cbegin(), m_soundFontPaths.cend(), path) == m_soundFontPaths.cend()) {
+        m_soundFontPaths.push_back(path);
     }
 
+    SoundFontFileStamp stamp = fileStamp(path);
     RetVal<SoundFontMeta> meta = FluidSoundFontParser::parseSoundFont(path);
 
     if (!meta.ret) {
@@ -82,7 +113,50 @@ void SoundFontRepository::loadSoundFont(const SoundFontPath& path, const SoundFo
         return;
     }
 
+    m_index.insert(stamp, meta.val);
     m_soundFonts.insert_or_assign(path, std::move(meta.val));
+
+    saveIndex();
+}
+
+io::path_t SoundFontRepository::indexPath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/soundfonts_index.json";
+}
+
+SoundFontFileStamp SoundFontRepository::fileStamp(const SoundFontPath& path) const
+{
+    SoundFontFileStamp stamp;
+    stamp.size = fileSystem()->fileSize(path).val;
+    stamp.lastModified = fileSystem()->lastModified(path);
+
+    return stamp;
+}
+
+void SoundFontRepository::loadIndex()
+{
+    io::path_t path = indexPath();
+    if (!fileSystem()->exists(path)) {
+        return;
+    }
+
+    RetVal<ByteArray> data = fileSystem()->readFile(path);
+    Ret ret = data.ret ? m_index.fromJson(data.val) : data.ret;
+    if (!ret) {
+        LOGE() << "failed load SoundFont index, err: " << ret.toString();
+    }
+}
+
+void SoundFontRepository::saveIndex()
+{
+    if (!m_index.isChanged()) {
+        return;
+    }
+
+    Ret ret = fileSystem()->writeFile(indexPath(), m_index.toJson());
+    if (!ret) {
+        LOGE() << "failed save SoundFont index, err: " << ret.toString();
+    }
 }
 
 const SoundFontPaths& SoundFontRepository::soundFontPaths() const
@@ -24,11 +24,13 @@
 
 #include "global/modularity/ioc.h"
 #include "global/iinteractive.h"
+#include "global/iglobalconfiguration.h"
 #include "global/io/ifilesystem.h"
 #include "global/async/asyncable.h"
 
 #include "isoundfontrepository.h"
 #include "iaudioconfiguration.h"
+#include "soundfontindex.h"
 
 namespace muse::audio {
 class SoundFontRepository : public ISoundFontRepository, public Injectable, public async::Asyncable
@@ -36,6 +38,7 @@ class SoundFontRepository : public ISoundFontRepository, public Injectable, publ
     Inject<IInteractive> interactive = { this };
     Inject<IAudioConfiguration> configuration = { this };
     Inject<io::IFileSystem> fileSystem = { this };
+    Inject<IGlobalConfiguration> globalConfiguration = { this };
 
 public:
     SoundFontRepository(const modularity::ContextPtr& iocCtx)
@@ -54,12 +57,19 @@ private:
     Ret doAddSoundFont(const synth::SoundFontPath& src, const synth::SoundFontPath& dst);
 
     void loadSoundFonts();
-    void loadSoundFont(const synth::SoundFontPath& path, const synth::SoundFontsMap& oldSoundFonts = {});
+    void loadSoundFont(const synth::SoundFontPath& path);
+
+    io::path_t indexPath() const;
+    synth::SoundFontFileStamp fileStamp(const synth::SoundFontPath& path) const;
+    void loadIndex();
+    void saveIndex();
 
     RetVal<synth::SoundFontPath> resolveInstallationPath(const synth::SoundFontPath& path) const;
 
     synth::SoundFontPaths m_soundFontPaths;
     synth::SoundFontsMap m_soundFonts;
+    synth::SoundFontIndex m_index;
+    bool m_indexLoaded = false;
     async::Notification m_soundFontsChanged;
 };
 }
@@ -0,0 +1,248 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "offlinerenderer.h"
+
+#include <atomic>
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/audiofilesource.h"
+#include "internal/worker/eventaudiosource.h"
+#include "soundtrackwriter.h"
+
+#include "audioerrors.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::soundtrack;
+
+//! NOTE The ids of the live tracks are small and consecutive (see TrackSequence::newTrackId),
+//! the offline ones are taken from the upper range, so the fx and plugin registers never mix them up
+static constexpr TrackId FIRST_OFFLINE_TRACK_ID = 1 << 30;
+
+static constexpr std::chrono::milliseconds DEFAULT_LOADING_TIMEOUT = std::chrono::seconds(30);
+static constexpr std::chrono::milliseconds LOADING_POLL_INTERVAL = std::chrono::milliseconds(5);
+
+static TrackId newOfflineTrackId()
+{
+    static std::atomic<TrackId> lastId = FIRST_OFFLINE_TRACK_ID;
+    return lastId++;
+}
+
+OfflineRenderer::OfflineRenderer(const modularity::ContextPtr& iocCtx)
+    : muse::Injectable(iocCtx), m_loadingTimeout(DEFAULT_LOADING_TIMEOUT)
+{
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_renderThread.joinable()) {
+        abort();
+        m_renderThread.join();
+    }
+
+    m_writer = nullptr;
+    m_mixer = nullptr;
+
+    for (const TrackId trackId : m_trackIds) {
+        fxResolver()->clearFx(trackId);
+    }
+}
+
+Ret OfflineRenderer::init(const IGetTracks* tracks, const Mixer& liveMixer)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(tracks && !m_mixer) {
+        return make_ret(Err::Undefined);
+    }
+
+    const TrackId masterFxTrackId = newOfflineTrackId();
+    m_trackIds.push_back(masterFxTrackId);
+
+    m_mixer = std::make_shared<Mixer>(iocContext(), Mixer::OfflineParams { masterFxTrackId });
+    m_mixer->setAudioChannelsCount(liveMixer.audioChannelsCount());
+
+    //! NOTE The aux sends of the tracks refer to the aux channels by their index, so the order is kept
+    for (const AudioOutputParams& auxParams : liveMixer.auxChannelsOutputParams()) {
+        const TrackId auxId = newOfflineTrackId();
+        m_trackIds.push_back(auxId);
+
+        RetVal<MixerChannelPtr> aux = m_mixer->addAuxChannel(auxId);
+        if (!aux.ret) {
+            return aux.ret;
+        }
+
+        aux.val->applyOutputParams(auxParams);
+    }
+
+    for (const auto& pair : tracks->allTracks()) {
+        Ret ret = addTrack(pair.second);
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    m_mixer->setMasterOutputParams(liveMixer.masterOutputParams());
+
+    return make_ok();
+}
+
+Ret OfflineRenderer::addTrack(const TrackPtr& track)
+{
+    //! NOTE Aux tracks have no input, they are cloned from the mixer
+    if (!track->inputHandler) {
+        return make_ok();
+    }
+
+    const TrackId trackId = newOfflineTrackId();
+    m_trackIds.push_back(trackId);
+
+    ITrackAudioInputPtr source;
+
+    if (auto liveSource = std::dynamic_pointer_cast<EventAudioSource>(track->inputHandler)) {
+        source = cloneEventSource(trackId, *liveSource);
+    } else if (std::dynamic_pointer_cast<AudioFileSource>(track->inputHandler)) {
+        source = cloneSoundSource(*track);
+    }
+
+    if (!source) {
+        LOGE() << "Unable to clone the track for the export: " << track->id;
+        return make_ret(Err::InvalidAudioSource);
+    }
+
+    RetVal<MixerChannelPtr> channel = m_mixer->addChannel(trackId, source);
+    if (!channel.ret) {
+        return channel.ret;
+    }
+
+    source->applyInputParams(track->inputParams());
+    source->seek(0);
+    channel.val->applyOutputParams(track->outputParams());
+
+    return make_ok();
+}
+
+ITrackAudioInputPtr OfflineRenderer::cloneEventSource(const TrackId trackId, const EventAudioSource& liveSource)
+{
+    //! NOTE The edits made during the export don't reach the offline synths
+    mpe::PlaybackData playbackData = liveSource.playbackData();
+    playbackData.mainStream = mpe::MainStreamChanges();
+    playbackData.mainStreamDelta = mpe::MainStreamDeltaChanges();
+    playbackData.offStream = mpe::OffStreamChanges();
+
+    auto source = std::make_shared<EventAudioSource>(trackId, playbackData, [](const TrackId) {}, iocContext());
+    source->setFixedRenderMode(RenderMode::OfflineMode);
+
+    return source;
+}
+
+ITrackAudioInputPtr OfflineRenderer::cloneSoundSource(const Track& track)
+{
+    //! NOTE The data of the device is only read, so both sources decode it independently
+    const PlaybackData playbackData = track.playbackData();
+    io::IODevice* const* device = std::get_if<io::IODevice*>(&playbackData);
+    if (!device) {
+        return nullptr;
+    }
+
+    AudioFileSourcePtr source = AudioFileSource::open(*device);
+    if (!source) {
+        return nullptr;
+    }
+
+    source->setIsOffline(true);
+
+    return source;
+}
+
+void OfflineRenderer::setLoadingTimeout(std::chrono::milliseconds timeout)
+{
+    m_loadingTimeout = timeout;
+}
+
+void OfflineRenderer::start(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration,
+                            Progress progress, OnFinished onFinished)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_mixer && !m_writer) {
+        return;
+    }
+
+    m_writer = std::make_unique<SoundTrackWriter>(destination, format, totalDuration, m_mixer, iocContext());
+    m_writer->progress().progressChanged().onReceive(this, [progress](int64_t current, int64_t total, std::string title) mutable {
+        progress.progress(current, total, title);
+    });
+
+    m_renderThread = std::thread([this, onFinished]() {
+        //! NOTE The offline mixer and its synths are only touched by this thread until it's finished
+        const std::set<std::thread::id> threadIdSet { std::this_thread::get_id() };
+        AudioSanitizer::registerWorkerThreads(threadIdSet);
+
+        Ret ret = waitUntilLoaded();
+        if (ret) {
+            ret = m_writer->write();
+        }
+
+        AudioSanitizer::unregisterWorkerThreads(threadIdSet);
+
+        if (onFinished) {
+            onFinished(ret);
+        }
+    });
+}
+
+Ret OfflineRenderer::waitUntilLoaded() const
+{
+    //! NOTE The plugins notify the end of the loading on the audio worker thread, where they finish their setup.
+    //! Nothing is rendered until then, so the export neither starts silent nor races with the setup
+    const auto deadline = std::chrono::steady_clock::now() + m_loadingTimeout;
+
+    while (!m_mixer->isReady()) {
+        if (m_isAborted) {
+            return make_ret(Ret::Code::Cancel);
+        }
+
+        if (std::chrono::steady_clock::now() > deadline) {
+            LOGE() << "The plugins of the export haven't been loaded in " << m_loadingTimeout.count() << " ms";
+            return make_ret(Err::PluginLoadingTimeout);
+        }
+
+        std::this_thread::sleep_for(LOADING_POLL_INTERVAL);
+    }
+
+    return make_ok();
+}
+
+void OfflineRenderer::abort()
+{
+    m_isAborted = true;
+
+    if (m_writer) {
+        m_writer->abort();
+    }
+}
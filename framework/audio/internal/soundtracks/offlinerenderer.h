@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_OFFLINERENDERER_H
+#define MUSE_AUDIO_OFFLINERENDERER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <functional>
+
+#include "global/async/asyncable.h"
+#include "global/modularity/ioc.h"
+#include "global/progress.h"
+
+#include "audiotypes.h"
+#include "ifxresolver.h"
+#include "../worker/igettracks.h"
+#include "../worker/mixer.h"
+
+namespace muse::audio {
+class EventAudioSource;
+}
+
+namespace muse::audio::soundtrack {
+class SoundTrackWriter;
+
+//! NOTE Exports a snapshot of a sequence without interrupting the live playback:
+//! the tracks are cloned into a mixer of its own, which is rendered faster than real time on a separate thread.
+//! Several renderers may run at the same time (e.g. one per part)
+class OfflineRenderer : public muse::Injectable, public async::Asyncable
+{
+    muse::Inject<fx::IFxResolver> fxResolver = { this };
+
+public:
+    //! NOTE Called on the rendering thread
+    using OnFinished = std::function<void (const Ret& ret)>;
+
+    explicit OfflineRenderer(const muse::modularity::ContextPtr& iocCtx);
+    ~OfflineRenderer() override;
+
+    Ret init(const IGetTracks* tracks, const Mixer& liveMixer);
+
+    //! NOTE The cloned plugins are loaded on the main thread, the rendering waits for them at most this long
+    void setLoadingTimeout(std::chrono::milliseconds timeout);
+
+    void start(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, Progress progress,
+               OnFinished onFinished);
+    void abort();
+
+private:
+    Ret addTrack(const TrackPtr& track);
+    ITrackAudioInputPtr cloneEventSource(const TrackId trackId, const EventAudioSource& liveSource);
+    ITrackAudioInputPtr cloneSoundSource(const Track& track);
+    Ret waitUntilLoaded() const;
+
+    MixerPtr m_mixer = nullptr;
+    std::vector<TrackId> m_trackIds; // the offline ids, including the one of the master fx
+
+    std::unique_ptr<SoundTrackWriter> m_writer;
+    std::thread m_renderThread;
+    std::atomic<bool> m_isAborted = false;
+    std::chrono::milliseconds m_loadingTimeout;
+};
+
+using OfflineRendererPtr = std::shared_ptr<OfflineRenderer>;
+}
+
+#endif // MUSE_AUDIO_OFFLINERENDERER_H
@@ -22,9 +22,10 @@
 
 #include "soundtrackwriter.h"
 
+#include <cmath>
+
 #include "global/defer.h"
 
-#include "internal/worker/audioengine.h"
 #include "internal/encoders/mp3encoder.h"
 #include "internal/encoders/oggencoder.h"
 #include "internal/encoders/flacencoder.h"
@@ -38,8 +39,8 @@ using namespace muse;
 using namespace muse::audio;
 using namespace muse::audio::soundtrack;
 
-static constexpr int PREPARE_STEP = 0;
-static constexpr int ENCODE_STEP = 1;
+//! NOTE The number of rendered blocks which may wait for the encoder
+static constexpr size_t ENCODE_QUEUE_CAPACITY = 16;
 
 static encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType type)
 {
@@ -58,34 +59,45 @@ static encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType type)
 SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format,
                                    const msecs_t totalDuration, IAudioSourcePtr source,
                                    const modularity::ContextPtr& iocCtx)
-    : muse::Injectable(iocCtx), m_source(std::move(source))
+    : muse::Injectable(iocCtx), m_source(std::move(source)),
+    m_normalization(format.normalization),
+    m_loudnessMeter(std::make_unique<dsp::LoudnessMeter>(format.sampleRate, format.audioChannelsNumber))
 {
     if (!m_source) {
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(format.samplesPerChannel * format.audioChannelsNumber);
+    m_totalSamplesNumber = static_cast<samples_t>((totalDuration / 1000000.0) * format.sampleRate);
     m_renderStep = format.samplesPerChannel;
 
+    m_blocks.resize(ENCODE_QUEUE_CAPACITY);
+    for (Block& block : m_blocks) {
+        block.samples.resize(m_renderStep * format.audioChannelsNumber);
+    }
+
     m_encoderPtr = createEncoder(format.type);
 
     if (!m_encoderPtr) {
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
-    m_encoderPtr->progress().progressChanged().onReceive(this, [this](int64_t current, int64_t total, std::string) {
-        sendStepProgress(ENCODE_STEP, current, total);
-    });
+    m_encoderPtr->init(destination, format, m_totalSamplesNumber);
 }
 
 SoundTrackWriter::~SoundTrackWriter()
 {
+    if (m_encoderThread.joinable()) {
+        abort();
+        m_encoderThread.join();
+    }
+
     if (m_encoderPtr) {
         m_encoderPtr->deinit();
     }
+
+    if (m_spoolFile) {
+        std::fclose(m_spoolFile);
+    }
 }
 
 Ret SoundTrackWriter::write()
@@ -96,43 +108,94 @@ Ret SoundTrackWriter::write()
         return false;
     }
 
-    audioEngine()->setMode(RenderMode::OfflineMode);
-
     m_source->setSampleRate(m_encoderPtr->format().sampleRate);
     m_source->setIsActive(true);
 
-    DEFER {
-        m_encoderPtr->flush();
+    m_writeIndex = 0;
+    m_readIndex = 0;
+    m_filledBlocksCount = 0;
+    m_renderingFinished = false;
+    m_encodedSamplesNumber = 0;
+    m_encodingFailed = false;
+    m_normalizationGain = 1.f;
+    m_loudnessMeter->reset();
+
+    //! NOTE The normalized export is rendered, then encoded, each half of the progress
+    m_progressTotal = m_normalization.enabled ? m_totalSamplesNumber * 2 : m_totalSamplesNumber;
+
+    if (m_normalization.enabled) {
+        if (m_spoolFile) {
+            std::fclose(m_spoolFile);
+        }
+
+        m_spoolFile = std::tmpfile();
+
+        if (!m_spoolFile) {
+            LOGE() << "Unable to create a temporary file for the normalization";
+            return make_ret(Err::ErrorEncode);
+        }
+    }
+
+    //! NOTE Blocks are encoded and written to disk while the next ones are rendered
+    m_encoderThread = std::thread([this]() {
+        encodeLoop();
+    });
+
+    //! NOTE The file is finalized on any outcome, but only a finalized complete export is a success
+    bool flushed = false;
 
-        audioEngine()->setMode(RenderMode::IdleMode);
+    DEFER {
+        if (!flushed) {
+            m_encoderPtr->flush();
+        }
 
-        m_source->setSampleRate(audioEngine()->sampleRate());
         m_source->setIsActive(false);
 
         m_isAborted = false;
     };
 
     Ret ret = generateAudioData();
+
+    //! NOTE Wait until the queued blocks are encoded
+    finishRendering();
+    m_encoderThread.join();
+
+    if (m_isAborted) {
+        return make_ret(Ret::Code::Cancel);
+    }
+
     if (!ret) {
         return ret;
     }
 
-    size_t bytes = m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data());
+    if (m_encodingFailed) {
+        return make_ret(Err::ErrorEncode);
+    }
 
-    if (m_isAborted) {
-        return make_ret(Ret::Code::Cancel);
+    if (m_spoolFile) {
+        ret = encodeSpooledAudio();
+        if (!ret) {
+            return ret;
+        }
     }
 
-    if (bytes == 0) {
+    flushed = true;
+    if (!m_encoderPtr->flush()) {
+        LOGE() << "Unable to finalize the encoded file";
         return make_ret(Err::ErrorEncode);
     }
 
+    sendProgress(m_progressTotal, m_progressTotal);
+
     return muse::make_ok();
 }
 
 void SoundTrackWriter::abort()
 {
     m_isAborted = true;
+
+    std::lock_guard lock(m_blocksMutex);
+    m_blocksChanged.notify_all();
 }
 
 Progress SoundTrackWriter::progress()
@@ -140,33 +203,51 @@ Progress SoundTrackWriter::progress()
     return m_progress;
 }
 
+AudioLoudnessValue SoundTrackWriter::loudness() const
+{
+    AudioLoudnessValue result;
+    result.momentaryLufs = m_loudnessMeter->momentaryLoudness();
+    result.shortTermLufs = m_loudnessMeter->shortTermLoudness();
+    result.integratedLufs = m_loudnessMeter->integratedLoudness();
+    result.truePeakDbtp = AudioMeter::toDbfs(m_loudnessMeter->truePeak());
+
+    return result;
+}
+
+gain_t SoundTrackWriter::normalizationGain() const
+{
+    return m_normalizationGain;
+}
+
 Ret SoundTrackWriter::generateAudioData()
 {
     TRACEFUNC;
 
-    const size_t inputBufferMaxOffset = m_inputBuffer.size();
-    size_t inputBufferOffset = 0;
+    samples_t renderedSamplesNumber = 0;
+
+    sendProgress(0, m_progressTotal);
 
-    sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+    while (renderedSamplesNumber < m_totalSamplesNumber) {
+        Block* block = acquireFreeBlock();
+        if (!block) {
+            break;
+        }
 
-    while (inputBufferOffset < inputBufferMaxOffset && !m_isAborted) {
-        m_source->process(m_intermBuffer.data(), m_renderStep);
+        m_source->process(block->samples.data(), m_renderStep);
 
-        size_t samplesToCopy = std::min(m_intermBuffer.size(), inputBufferMaxOffset - inputBufferOffset);
+        block->samplesPerChannel = std::min(m_renderStep, m_totalSamplesNumber - renderedSamplesNumber);
+        renderedSamplesNumber += block->samplesPerChannel;
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        submitBlock();
 
-        inputBufferOffset += samplesToCopy;
-        sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        sendProgress(m_encodedSamplesNumber, m_progressTotal);
     }
 
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (inputBufferOffset == 0) {
+    if (renderedSamplesNumber == 0) {
         LOGI() << "No audio to export";
         return make_ret(Err::NoAudioToExport);
     }
@@ -174,10 +255,177 @@ Ret SoundTrackWriter::generateAudioData()
     return muse::make_ok();
 }
 
-void SoundTrackWriter::sendStepProgress(int step, int64_t current, int64_t total)
+SoundTrackWriter::Block* SoundTrackWriter::acquireFreeBlock()
+{
+    std::unique_lock lock(m_blocksMutex);
+
+    m_blocksChanged.wait(lock, [this]() {
+        return m_filledBlocksCount < m_blocks.size() || m_isAborted || m_encodingFailed;
+    });
+
+    if (m_isAborted || m_encodingFailed) {
+        return nullptr;
+    }
+
+    //! NOTE The encoder doesn't read this block until it is submitted
+    return &m_blocks[m_writeIndex];
+}
+
+void SoundTrackWriter::submitBlock()
+{
+    {
+        std::lock_guard lock(m_blocksMutex);
+        m_writeIndex = (m_writeIndex + 1) % m_blocks.size();
+        ++m_filledBlocksCount;
+    }
+
+    m_blocksChanged.notify_all();
+}
+
+void SoundTrackWriter::finishRendering()
+{
+    {
+        std::lock_guard lock(m_blocksMutex);
+        m_renderingFinished = true;
+    }
+
+    m_blocksChanged.notify_all();
+}
+
+void SoundTrackWriter::encodeLoop()
 {
-    int stepRange = step == PREPARE_STEP ? 80 : 20;
-    int stepProgressStart = step == PREPARE_STEP ? 0 : 80;
-    int stepCurrentProgress = stepProgressStart + ((current * 100 / total) * stepRange) / 100;
-    m_progress.progress(stepCurrentProgress, 100, "");
+    while (true) {
+        const Block* block = nullptr;
+
+        {
+            std::unique_lock lock(m_blocksMutex);
+
+            m_blocksChanged.wait(lock, [this]() {
+                return m_filledBlocksCount > 0 || m_renderingFinished || m_isAborted;
+            });
+
+            if (m_isAborted || m_filledBlocksCount == 0) {
+                return;
+            }
+
+            block = &m_blocks[m_readIndex];
+        }
+
+        if (!consumeBlock(*block)) {
+            {
+                std::lock_guard lock(m_blocksMutex);
+                m_encodingFailed = true;
+            }
+
+            m_blocksChanged.notify_all();
+            return;
+        }
+
+        m_encodedSamplesNumber += block->samplesPerChannel;
+
+        {
+            std::lock_guard lock(m_blocksMutex);
+            m_readIndex = (m_readIndex + 1) % m_blocks.size();
+            --m_filledBlocksCount;
+        }
+
+        m_blocksChanged.notify_all();
+    }
+}
+
+bool SoundTrackWriter::consumeBlock(const Block& block)
+{
+    if (block.samplesPerChannel == 0) {
+        return true;
+    }
+
+    m_loudnessMeter->process(block.samples.data(), block.samplesPerChannel);
+
+    if (m_spoolFile) {
+        const size_t count = block.samplesPerChannel * m_encoderPtr->format().audioChannelsNumber;
+
+        if (std::fwrite(block.samples.data(), sizeof(float), count, m_spoolFile) != count) {
+            LOGE() << "Failed to write a block of " << block.samplesPerChannel << " samples to the temporary file";
+            return false;
+        }
+
+        return true;
+    }
+
+    if (m_encoderPtr->encode(block.samplesPerChannel, block.samples.data()) == 0) {
+        LOGE() << "Failed to encode a block of " << block.samplesPerChannel << " samples";
+        return false;
+    }
+
+    return true;
+}
+
+Ret SoundTrackWriter::encodeSpooledAudio()
+{
+    TRACEFUNC;
+
+    m_normalizationGain = calculateNormalizationGain();
+
+    const audioch_t channels = m_encoderPtr->format().audioChannelsNumber;
+    std::vector<float>& samples = m_blocks.front().samples;
+
+    std::rewind(m_spoolFile);
+
+    samples_t encodedSamplesNumber = 0;
+
+    while (!m_isAborted) {
+        const size_t frames = std::fread(samples.data(), sizeof(float) * channels, m_renderStep, m_spoolFile);
+        if (frames == 0) {
+            break;
+        }
+
+        for (size_t i = 0; i < frames * channels; ++i) {
+            samples[i] *= m_normalizationGain;
+        }
+
+        if (m_encoderPtr->encode(frames, samples.data()) == 0) {
+            LOGE() << "Failed to encode a block of " << frames << " samples";
+            return make_ret(Err::ErrorEncode);
+        }
+
+        encodedSamplesNumber += frames;
+        sendProgress(m_totalSamplesNumber + encodedSamplesNumber, m_progressTotal);
+    }
+
+    std::fclose(m_spoolFile);
+    m_spoolFile = nullptr;
+
+    if (m_isAborted) {
+        return make_ret(Ret::Code::Cancel);
+    }
+
+    return muse::make_ok();
+}
+
+gain_t SoundTrackWriter::calculateNormalizationGain() const
+{
+    const float integrated = m_loudnessMeter->integratedLoudness();
+
+    //! NOTE Nothing above the absolute gate, e.g. silence
+    if (integrated <= MINIMUM_OPERABLE_DBFS_LEVEL) {
+        return 1.f;
+    }
+
+    float gainDb = m_normalization.targetLufs - integrated;
+
+    const float truePeak = m_loudnessMeter->truePeak();
+    if (truePeak > 0.f) {
+        gainDb = std::min(gainDb, m_normalization.truePeakCeilingDbtp - muse::linear_to_db(truePeak));
+    }
+
+    return muse::db_to_linear(gainDb);
+}
+
+void SoundTrackWriter::sendProgress(int64_t current, int64_t total)
+{
+    if (total <= 0) {
+        return;
+    }
+
+    m_progress.progress(current * 100 / total, 100, "");
 }
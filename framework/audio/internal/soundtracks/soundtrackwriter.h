@@ -24,20 +24,28 @@
 #define MUSE_AUDIO_SOUNDTRACKWRITER_H
 
 #include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
 
 #include "global/async/asyncable.h"
 #include "global/modularity/ioc.h"
 
 #include "audiotypes.h"
+#include "audiometer.h"
 #include "iaudiosource.h"
-#include "../worker/iaudioengine.h"
+#include "../dsp/loudnessmeter.h"
 #include "../encoders/abstractaudioencoder.h"
 
 namespace muse::audio::soundtrack {
+//! NOTE Renders the source on the calling thread and encodes it on its own thread.
+//! The source must not be processed by anyone else meanwhile (see OfflineRenderer).
+//! The loudness of the rendered audio is measured on the way; with the normalization enabled
+//! the source is still rendered once, into a temporary file, which is encoded with the resulting gain
 class SoundTrackWriter : public muse::Injectable, public async::Asyncable
 {
-    muse::Inject<IAudioEngine> audioEngine = { this };
-
 public:
     SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, IAudioSourcePtr source,
                      const muse::modularity::ContextPtr& iocCtx);
@@ -48,19 +56,58 @@ public:
 
     Progress progress();
 
+    //! NOTE The loudness of the rendered audio before the normalization, available after write()
+    AudioLoudnessValue loudness() const;
+    gain_t normalizationGain() const;
+
 private:
+    //! NOTE A fixed number of blocks circulates between the rendering thread and the encoding thread,
+    //! so the memory usage doesn't depend on the duration
+    struct Block {
+        std::vector<float> samples;
+        samples_t samplesPerChannel = 0;
+    };
+
     Ret generateAudioData();
 
-    void sendStepProgress(int step, int64_t current, int64_t total);
+    Block* acquireFreeBlock();
+    void submitBlock();
+    void finishRendering();
+
+    void encodeLoop();
+    bool consumeBlock(const Block& block);
+
+    Ret encodeSpooledAudio();
+    gain_t calculateNormalizationGain() const;
+
+    void sendProgress(int64_t current, int64_t total);
 
     IAudioSourcePtr m_source = nullptr;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    samples_t m_totalSamplesNumber = 0; // per channel
     samples_t m_renderStep = 0;
 
+    std::vector<Block> m_blocks;
+    size_t m_writeIndex = 0;
+    size_t m_readIndex = 0;
+    size_t m_filledBlocksCount = 0;
+    bool m_renderingFinished = false;
+
+    std::mutex m_blocksMutex;
+    std::condition_variable m_blocksChanged;
+    std::thread m_encoderThread;
+
+    std::atomic<samples_t> m_encodedSamplesNumber = 0;
+    std::atomic<bool> m_encodingFailed = false;
+
     encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
 
+    SoundTrackNormalization m_normalization;
+    dsp::LoudnessMeterPtr m_loudnessMeter = nullptr;
+    std::FILE* m_spoolFile = nullptr; // the rendered audio waiting for the normalization gain
+    gain_t m_normalizationGain = 1.f;
+    int64_t m_progressTotal = 0;
+
     Progress m_progress;
     std::atomic<bool> m_isAborted = false;
 };
@@ -37,6 +37,25 @@ static constexpr note_idx_t MAX_SUPPORTED_NOTE = 108; // MIDI equivalent for C8
 static constexpr uint32_t CTRL_ON = 127;
 static constexpr uint32_t CTRL_OFF = 0;
 
+static bool hasFluidSostenutoPedal(const mpe::PlaybackEventsMap& events, const timestamp_t from, const timestamp_t to)
+{
+    for (auto it = events.lower_bound(from); it != events.end() && it->first < to; ++it) {
+        for (const mpe::PlaybackEvent& event : it->second) {
+            if (!std::holds_alternative<mpe::NoteEvent>(event)) {
+                continue;
+            }
+
+            for (const auto& artPair : std::get<mpe::NoteEvent>(event).expressionCtx().articulations) {
+                if (muse::contains(SOSTENUTO_PEDAL_CC_SUPPORTED_TYPES, artPair.second.meta.type)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
 void FluidSequencer::init(const PlaybackSetupData& setupData, const std::optional<midi::Program>& programOverride,
                           bool useDynamicEvents)
 {
@@ -63,26 +82,48 @@ void FluidSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& events,
 {
     flushOffstream();
     updatePlaybackEvents(m_offStreamEvents, events);
-    updateOffSequenceIterator();
+    updateOffStreamCursor();
 }
 
 void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                             const mpe::PlaybackParamLayers&)
 {
     m_mainStreamEvents.clear();
-    m_dynamicEvents.clear();
 
     if (m_onMainStreamFlushed) {
         m_onMainStreamFlushed();
     }
 
     updatePlaybackEvents(m_mainStreamEvents, events);
-    updateMainSequenceIterator();
 
     if (m_useDynamicEvents) {
-        updateDynamicEvents(m_dynamicEvents, dynamics);
-        updateDynamicChangesIterator();
+        updateDynamicEvents(m_mainStreamEvents, dynamics);
+    }
+
+    updateMainStreamCursor();
+}
+
+bool FluidSequencer::canUpdateMainStreamRange(const mpe::MainStreamDelta& delta) const
+{
+    //! NOTE The sostenuto pedal events depend on the neighbouring pedals, so they are only built by the full update
+    return !hasFluidSostenutoPedal(playbackData().originEvents, delta.from, delta.to)
+           && !hasFluidSostenutoPedal(delta.events, delta.from, delta.to);
+}
+
+void FluidSequencer::updateMainStreamRange(const mpe::MainStreamDelta& delta)
+{
+    if (m_onMainStreamFlushed) {
+        m_onMainStreamFlushed();
+    }
+
+    m_mainStreamEvents.removeOrigins(delta.from, delta.to);
+    updatePlaybackEvents(m_mainStreamEvents, delta.events);
+
+    if (m_useDynamicEvents) {
+        updateDynamicEvents(m_mainStreamEvents, delta.dynamics);
     }
+
+    updateMainStreamCursor();
 }
 
 muse::async::Channel<channel_t, Program> FluidSequencer::channelAdded() const
@@ -100,11 +141,13 @@ int FluidSequencer::lastStaff() const
     return m_lastStaff;
 }
 
-void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes)
+void FluidSequencer::updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& changes)
 {
     SostenutoTimeAndDurations sostenutoTimeAndDurations;
 
     for (const auto& pair : changes) {
+        destination.setOrigin(pair.first);
+
         for (const mpe::PlaybackEvent& event : pair.second) {
             if (!std::holds_alternative<mpe::NoteEvent>(event)) {
                 continue;
@@ -129,14 +172,14 @@ void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const m
             noteOn.setVelocity16(velocity);
             noteOn.setPitchNote(noteIdx, tuning);
 
-            destination[timestampFrom].emplace(std::move(noteOn));
+            destination.add(timestampFrom, std::move(noteOn));
 
             midi::Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice20);
             noteOff.setChannel(channelIdx);
             noteOff.setNote(noteIdx);
             noteOff.setPitchNote(noteIdx, tuning);
 
-            destination[timestampTo].emplace(std::move(noteOff));
+            destination.add(timestampTo, std::move(noteOff));
 
             for (const auto& artPair : noteEvent.expressionCtx().articulations) {
                 const mpe::ArticulationMeta& meta = artPair.second.meta;
@@ -155,7 +198,7 @@ void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const m
 
                 if (muse::contains(SOSTENUTO_PEDAL_CC_SUPPORTED_TYPES, meta.type)) {
                     const mpe::timestamp_t timestamp = timestampFrom + noteEvent.arrangementCtx().actualDuration * 0.1; // add offset for Sostenuto to take effect
-                    sostenutoTimeAndDurations[channelIdx].push_back(TimestampAndDuration { timestamp, meta.overallDuration });
+                    sostenutoTimeAndDurations[channelIdx].push_back(SostenutoPedal { pair.first, { timestamp, meta.overallDuration } });
                     continue;
                 }
             }
@@ -165,20 +208,22 @@ void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const m
     appendSostenutoEvents(destination, sostenutoTimeAndDurations);
 }
 
-void FluidSequencer::updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& changes)
+void FluidSequencer::updateDynamicEvents(EventTimeline& destination, const mpe::DynamicLevelLayers& changes)
 {
     for (const auto& layer : changes) {
         for (const auto& dynamic : layer.second) {
+            destination.setOrigin(dynamic.first);
+
             midi::Event event(muse::midi::Event::Opcode::ControlChange, Event::MessageType::ChannelVoice10);
             event.setIndex(midi::EXPRESSION_CONTROLLER);
             event.setData(expressionLevel(dynamic.second));
 
-            destination[dynamic.first].emplace(std::move(event));
+            destination.add(dynamic.first, std::move(event));
         }
     }
 }
 
-void FluidSequencer::appendControlChange(EventSequenceMap& destination, const mpe::timestamp_t timestamp,
+void FluidSequencer::appendControlChange(EventTimeline& destination, const mpe::timestamp_t timestamp,
                                          const int midiControlIdx, const channel_t channelIdx, const uint32_t value)
 {
     midi::Event cc(Event::Opcode::ControlChange, Event::MessageType::ChannelVoice10);
@@ -186,10 +231,10 @@ void FluidSequencer::appendControlChange(EventSequenceMap& destination, const mp
     cc.setChannel(channelIdx);
     cc.setData(value);
 
-    destination[timestamp].emplace(std::move(cc));
+    destination.add(timestamp, std::move(cc));
 }
 
-void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent,
+void FluidSequencer::appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent,
                                      const mpe::ArticulationMeta& artMeta, const channel_t channelIdx)
 {
     if (noteEvent.pitchCtx().pitchCurve.empty()) {
@@ -202,7 +247,7 @@ void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::N
     midi::Event event(Event::Opcode::PitchBend, Event::MessageType::ChannelVoice10);
     event.setChannel(channelIdx);
     event.setData(8192);
-    destination[pitchBendTimestampTo].insert(event);
+    destination.add(pitchBendTimestampTo, event);
 
     auto currIt = noteEvent.pitchCtx().pitchCurve.cbegin();
     auto nextIt = std::next(currIt);
@@ -236,17 +281,19 @@ void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::N
 
             if (time < pitchBendTimestampTo) {
                 event.setData(bendValue);
-                destination[time].insert(event);
+                destination.add(time, event);
             }
         }
     }
 }
 
-void FluidSequencer::appendSostenutoEvents(EventSequenceMap& destination, const SostenutoTimeAndDurations& sostenutoTimeAndDurations)
+void FluidSequencer::appendSostenutoEvents(EventTimeline& destination, const SostenutoTimeAndDurations& sostenutoTimeAndDurations)
 {
     for (const auto& channelPair : sostenutoTimeAndDurations) {
         for (size_t i = 0; i < channelPair.second.size(); ++i) {
-            const TimestampAndDuration& currentTnD = channelPair.second.at(i);
+            const TimestampAndDuration& currentTnD = channelPair.second.at(i).timeAndDuration;
+            destination.setOrigin(channelPair.second.at(i).origin);
+
             const timestamp_t timestampTo = currentTnD.timestamp + currentTnD.duration;
 
             appendControlChange(destination, currentTnD.timestamp, midi::SOSTENUTO_PEDAL_CONTROLLER, channelPair.first, CTRL_ON);
@@ -256,7 +303,7 @@ void FluidSequencer::appendSostenutoEvents(EventSequenceMap& destination, const
                 continue;
             }
 
-            const TimestampAndDuration& nextTnD = channelPair.second.at(i + 1);
+            const TimestampAndDuration& nextTnD = channelPair.second.at(i + 1).timeAndDuration;
             if (timestampTo <= nextTnD.timestamp) { // handle potential overlap
                 appendControlChange(destination, timestampTo, midi::SOSTENUTO_PEDAL_CONTROLLER, channelPair.first, CTRL_OFF);
             }
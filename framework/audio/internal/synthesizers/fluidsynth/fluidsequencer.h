@@ -23,6 +23,8 @@
 #ifndef MUSE_AUDIO_FLUIDSEQUENCER_H
 #define MUSE_AUDIO_FLUIDSEQUENCER_H
 
+#include <map>
+
 #include "global/async/channel.h"
 #include "midi/midievent.h"
 #include "mpe/events.h"
@@ -48,18 +50,25 @@ private:
     void updateOffStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) override;
     void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                 const mpe::PlaybackParamLayers& params) override;
+    bool canUpdateMainStreamRange(const mpe::MainStreamDelta& delta) const override;
+    void updateMainStreamRange(const mpe::MainStreamDelta& delta) override;
 
-    void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes);
-    void updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& changes);
+    void updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& changes);
+    void updateDynamicEvents(EventTimeline& destination, const mpe::DynamicLevelLayers& changes);
 
-    void appendControlChange(EventSequenceMap& destination, const mpe::timestamp_t timestamp, const int midiControlIdx,
+    void appendControlChange(EventTimeline& destination, const mpe::timestamp_t timestamp, const int midiControlIdx,
                              const midi::channel_t channelIdx, const uint32_t value);
 
-    void appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationMeta& artMeta,
+    void appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationMeta& artMeta,
                          const midi::channel_t channelIdx);
 
-    using SostenutoTimeAndDurations = std::map<midi::channel_t, std::vector<mpe::TimestampAndDuration> >;
-    void appendSostenutoEvents(EventSequenceMap& destination, const SostenutoTimeAndDurations& sostenutoTimeAndDurations);
+    struct SostenutoPedal {
+        mpe::timestamp_t origin = 0;
+        mpe::TimestampAndDuration timeAndDuration;
+    };
+
+    using SostenutoTimeAndDurations = std::map<midi::channel_t, std::vector<SostenutoPedal> >;
+    void appendSostenutoEvents(EventTimeline& destination, const SostenutoTimeAndDurations& sostenutoTimeAndDurations);
 
     midi::channel_t channel(const mpe::NoteEvent& noteEvent) const;
     midi::note_idx_t noteIndex(const mpe::pitch_level_t pitchLevel) const;
@@ -26,6 +26,7 @@
 #include <sfloader/fluid_sfont.h>
 #include <sfloader/fluid_defsfont.h>
 
+#include "global/concurrency/taskscheduler.h"
 #include "defer.h"
 
 using namespace muse;
@@ -85,3 +86,37 @@ RetVal<SoundFontMeta> FluidSoundFontParser::parseSoundFont(const SoundFontPath&
 
     return RetVal<SoundFontMeta>::make_ok(meta);
 }
+
+std::vector<RetVal<SoundFontMeta> > FluidSoundFontParser::parseSoundFonts(const SoundFontPaths& paths)
+{
+    std::vector<RetVal<SoundFontMeta> > result;
+    result.reserve(paths.size());
+
+    if (paths.size() <= 1) {
+        for (const SoundFontPath& path : paths) {
+            result.push_back(parseSoundFont(path));
+        }
+
+        return result;
+    }
+
+    //! NOTE Parsing is mostly reading and decoding the preset headers,
+    //! so every file gets its own loader and the files are spread over all cores
+    thread_pool_size_t threadCount = std::max<thread_pool_size_t>(std::thread::hardware_concurrency(), 1);
+    threadCount = std::min<thread_pool_size_t>(threadCount, static_cast<thread_pool_size_t>(paths.size()));
+
+    TaskScheduler scheduler(threadCount);
+
+    std::vector<std::future<RetVal<SoundFontMeta> > > futures;
+    futures.reserve(paths.size());
+
+    for (const SoundFontPath& path : paths) {
+        futures.push_back(scheduler.submit(&FluidSoundFontParser::parseSoundFont, path));
+    }
+
+    for (std::future<RetVal<SoundFontMeta> >& future : futures) {
+        result.push_back(future.get());
+    }
+
+    return result;
+}
@@ -23,6 +23,8 @@
 #ifndef MUSE_AUDIO_FLUIDSOUNDFONTPARSER_H
 #define MUSE_AUDIO_FLUIDSOUNDFONTPARSER_H
 
+#include <vector>
+
 #include "global/types/retval.h"
 
 #include "soundfonttypes.h"
@@ -32,6 +34,9 @@ class FluidSoundFontParser
 {
 public:
     static RetVal<SoundFontMeta> parseSoundFont(const SoundFontPath& path);
+
+    //! NOTE Parses the files concurrently on a worker pool, the results are in the order of the paths
+    static std::vector<RetVal<SoundFontMeta> > parseSoundFonts(const SoundFontPaths& paths);
 };
 }
 
@@ -25,6 +25,7 @@
 #include <fluidsynth.h>
 
 #include "sfcachedloader.h"
+#include "soundfontsamplepool.h"
 #include "audioerrors.h"
 #include "audiotypes.h"
 
@@ -131,6 +132,8 @@ Ret FluidSynth::init()
 
     createFluidInstance();
 
+    updateVoiceBudgetClient(currentRenderMode());
+
     m_sequencer.setOnOffStreamFlushed([this]() {
         m_allNotesOffRequested = true;
     });
@@ -143,7 +146,12 @@ void FluidSynth::createFluidInstance()
 {
     m_fluid->synth = new_fluid_synth(m_fluid->settings);
 
-    fluid_sfloader_t* sfloader = new_fluid_sfloader(loadSoundFont, delete_fluid_sfloader);
+    //! NOTE The synths of an export select their presets on the rendering thread,
+    //! so they can't share the cached SoundFonts with the live ones
+    m_hasOwnSoundFonts = m_fixedRenderMode == RenderMode::OfflineMode;
+
+    fluid_sfloader_t* sfloader = new_fluid_sfloader(m_hasOwnSoundFonts ? loadPrivateSoundFont : loadSoundFont,
+                                                    delete_fluid_sfloader);
 
     fluid_sfloader_set_data(sfloader, m_fluid->settings);
     fluid_synth_add_sfloader(m_fluid->synth, sfloader);
@@ -265,6 +273,11 @@ void FluidSynth::setSampleRate(unsigned int sampleRate)
         fluid_settings_setnum(m_fluid->settings, "synth.sample-rate", static_cast<double>(m_sampleRate));
     }
 
+    recreateFluidInstance();
+}
+
+void FluidSynth::recreateFluidInstance()
+{
     if (m_fluid->synth) {
         delete_fluid_synth(m_fluid->synth);
     }
@@ -343,6 +356,17 @@ void FluidSynth::setupSound(const PlaybackSetupData& setupData)
             setupChannel(channelMapping.first, channelMapping.second);
         }
     }
+
+    //! NOTE The program changes above have mapped the samples of the presets used by the score,
+    //! read them now rather than on the first notes
+    SoundFontSamplePool* samplePool = SoundFontSamplePool::instance();
+    samplePool->prefetchMappedSamples();
+
+    for (const io::path_t& sfont : m_sfontPaths) {
+        SoundFontMemoryUsage usage = samplePool->memoryUsage(sfont.toStdString());
+        LOGD() << sfont << ": " << usage.sampleBytes << " bytes of samples used, "
+               << usage.residentBytes << " of " << usage.fileBytes << " bytes resident";
+    }
 }
 
 void FluidSynth::setupEvents(const mpe::PlaybackData& playbackData)
@@ -405,6 +429,21 @@ unsigned int FluidSynth::audioChannelsCount() const
 }
 
 samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
+{
+    return render(buffer, buffer + 1, FLUID_AUDIO_CHANNELS_COUNT, samplesPerChannel);
+}
+
+bool FluidSynth::supportsPlanarProcessing() const
+{
+    return true;
+}
+
+samples_t FluidSynth::processPlanar(float* const* buffers, samples_t samplesPerChannel)
+{
+    return render(buffers[0], buffers[1], 1, samplesPerChannel);
+}
+
+samples_t FluidSynth::render(float* left, float* right, int stride, samples_t samplesPerChannel)
 {
     IF_ASSERT_FAILED(samplesPerChannel > 0) {
         return 0;
@@ -415,40 +454,47 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
     }
 
     const msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
-    const FluidSequencer::EventSequenceMap sequences = m_sequencer.movePlaybackForward(nextMsecs);
+    const FluidSequencer::EventSpan events = m_sequencer.movePlaybackForward(nextMsecs);
     samples_t sampleOffset = 0;
+    bool ok = true;
 
-    for (auto it = sequences.cbegin(); it != sequences.cend(); ++it) {
+    events.forEachGroup([&](const FluidSequencer::TimedEvent* begin, const FluidSequencer::TimedEvent* end, msecs_t duration, bool isLast) {
         samples_t durationInSamples = samplesPerChannel - sampleOffset;
 
-        auto nextIt = std::next(it);
-        if (nextIt != sequences.cend()) {
-            msecs_t duration = nextIt->first - it->first;
+        if (!isLast) {
             durationInSamples = microSecsToSamples(duration, m_sampleRate);
         }
 
         IF_ASSERT_FAILED(sampleOffset + durationInSamples <= samplesPerChannel) {
-            break;
+            return false;
         }
 
-        if (!processSequence(it->second, durationInSamples, buffer + sampleOffset * FLUID_AUDIO_CHANNELS_COUNT)) {
-            return 0;
+        const size_t offset = sampleOffset * stride;
+        if (!processSequence(begin, end, durationInSamples, left + offset, right + offset, stride)) {
+            ok = false;
+            return false;
         }
 
         sampleOffset += durationInSamples;
+        return true;
+    });
+
+    if (!ok) {
+        return 0;
     }
 
     return samplesPerChannel;
 }
 
-bool FluidSynth::processSequence(const FluidSequencer::EventSequence& sequence, const samples_t samples, float* buffer)
+bool FluidSynth::processSequence(const FluidSequencer::TimedEvent* begin, const FluidSequencer::TimedEvent* end, const samples_t samples,
+                                 float* left, float* right, int stride)
 {
-    if (!sequence.empty()) {
+    if (begin != end) {
         m_tuning.reset();
     }
 
-    for (const FluidSequencer::EventType& event : sequence) {
-        handleEvent(std::get<midi::Event>(event));
+    for (const FluidSequencer::TimedEvent* it = begin; it != end; ++it) {
+        handleEvent(std::get<midi::Event>(it->event));
     }
 
     fluid_synth_tune_notes(m_fluid->synth, 0, 0, m_tuning.size(), m_tuning.keys.data(), m_tuning.pitches.data(), true);
@@ -457,13 +503,64 @@ bool FluidSynth::processSequence(const FluidSequencer::EventSequence& sequence,
         return true;
     }
 
+    applyVoiceBudget();
+
     int result = fluid_synth_write_float(m_fluid->synth, samples,
-                                         buffer, 0, FLUID_AUDIO_CHANNELS_COUNT,
-                                         buffer, 1, FLUID_AUDIO_CHANNELS_COUNT);
+                                         left, 0, stride,
+                                         right, 0, stride);
 
     return result == FLUID_OK;
 }
 
+void FluidSynth::updateRenderingMode(const RenderMode mode)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    //! NOTE The resolver loads the shared SoundFonts before the mode of an export synth is fixed
+    if (m_hasOwnSoundFonts != (m_fixedRenderMode == RenderMode::OfflineMode)) {
+        recreateFluidInstance();
+    }
+
+    updateVoiceBudgetClient(mode);
+}
+
+void FluidSynth::updateVoiceBudgetClient(const RenderMode mode)
+{
+    //! NOTE An export isn't bound to real time, its synths play all of their voices
+    //! and mustn't take a share of the budget of the live mixer
+    if (mode == RenderMode::OfflineMode) {
+        m_voiceBudget = nullptr;
+        return;
+    }
+
+    if (m_voiceBudget) {
+        return;
+    }
+
+    if (MixerPtr mixer = audioEngine()->mixer()) {
+        m_voiceBudget = mixer->voiceBudget()->registerClient();
+    }
+}
+
+void FluidSynth::applyVoiceBudget()
+{
+    if (!m_voiceBudget) {
+        return;
+    }
+
+    int active = fluid_synth_get_active_voice_count(m_fluid->synth);
+    int stolen = 0;
+
+    //! NOTE The new notes have been started, drop the least important voices before they are rendered
+    int allowed = m_voiceBudget->allowed();
+    if (active > allowed) {
+        stolen = fluid_synth_steal_voices(m_fluid->synth, allowed);
+        active -= stolen;
+    }
+
+    m_voiceBudget->report(active, stolen);
+}
+
 async::Channel<unsigned int> FluidSynth::audioChannelsCountChanged() const
 {
     return m_streamsCountChanged;
@@ -31,6 +31,7 @@
 #include "midi/imidioutport.h"
 
 #include "../../abstractsynthesizer.h"
+#include "../../worker/voicebudget.h"
 #include "fluidsequencer.h"
 
 namespace muse::audio::synth {
@@ -64,11 +65,16 @@ public:
 
     unsigned int audioChannelsCount() const override;
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
+    bool supportsPlanarProcessing() const override;
+    samples_t processPlanar(float* const* buffers, samples_t samplesPerChannel) override;
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     void setSampleRate(unsigned int sampleRate) override;
 
     bool isValid() const override;
 
+protected:
+    void updateRenderingMode(const RenderMode mode) override;
+
 private:
     struct KeyTuning {
         std::vector<int> keys;
@@ -99,11 +105,17 @@ private:
 
     Ret init();
     void createFluidInstance();
+    void recreateFluidInstance();
 
     void allNotesOff();
 
-    bool processSequence(const FluidSequencer::EventSequence& sequence, const samples_t samples, float* buffer);
+    //! NOTE Both layouts are rendered by fluidsynth directly: the channels are written with the given stride
+    samples_t render(float* left, float* right, int stride, samples_t samplesPerChannel);
+    bool processSequence(const FluidSequencer::TimedEvent* begin, const FluidSequencer::TimedEvent* end, const samples_t samples,
+                         float* left, float* right, int stride);
     bool handleEvent(const midi::Event& event);
+    void updateVoiceBudgetClient(const RenderMode mode);
+    void applyVoiceBudget();
 
     void toggleExpressionController();
 
@@ -112,11 +124,13 @@ private:
     int setPitchBend(int channel, int pitchBend);
 
     std::shared_ptr<Fluid> m_fluid = nullptr;
+    VoiceBudget::ClientPtr m_voiceBudget = nullptr;
 
     async::Channel<unsigned int> m_streamsCountChanged;
 
     FluidSequencer m_sequencer;
     std::set<io::path_t> m_sfontPaths;
+    bool m_hasOwnSoundFonts = false;
     std::optional<midi::Program> m_preset;
 
     KeyTuning m_tuning;
@@ -24,15 +24,20 @@
 #define MUSE_AUDIO_SFCACHEDLOADER_H
 
 #include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
 
 #include <sfloader/fluid_sfont.h>
 #include <sfloader/fluid_defsfont.h>
+#include <sfloader/fluid_samplecache.h>
+
+#include "soundfontsamplepool.h"
 
 namespace muse::audio::synth {
 struct SoundFontData
 {
     fluid_sfont_t* soundFontPtr = nullptr;
-    std::FILE* fileStream = nullptr;
 };
 
 struct SoundFontCache : public std::map<std::string, SoundFontData> {
@@ -43,7 +48,12 @@ struct SoundFontCache : public std::map<std::string, SoundFontData> {
     }
 
 private:
-    SoundFontCache() = default;
+    SoundFontCache()
+    {
+        //! NOTE The sample data is unmapped from the pool in the destructor, so the pool must outlive the cache
+        SoundFontSamplePool::instance();
+    }
+
     ~SoundFontCache()
     {
         for (const auto& pair : *this) {
@@ -54,55 +64,83 @@ private:
             }
 
             delete_fluid_sfont(pair.second.soundFontPtr);
-
-            if (pair.second.fileStream) {
-                std::fclose(pair.second.fileStream);
-            }
         }
     }
 };
 
+//! NOTE Fluid reads the SoundFont files through these callbacks, every opened file
+//! is a cursor in the mapping of SoundFontSamplePool, so it is read from disk only once
+struct SoundFontFile
+{
+    std::string path;
+    const uint8_t* data = nullptr;
+    fluid_long_long_t size = 0;
+    fluid_long_long_t position = 0;
+};
+
 void* openSoundFont(const char* filename)
 {
-    auto search = SoundFontCache::instance()->find(filename);
+    SoundFontSamplePool* pool = SoundFontSamplePool::instance();
 
-    if (search != SoundFontCache::instance()->cend()
-        && search->second.fileStream) {
-        return search->second.fileStream;
+    if (!pool->acquire(filename)) {
+        return nullptr;
     }
 
-    std::FILE* stream = std::fopen(filename, "rb");
-
-    SoundFontData sfData;
-    sfData.fileStream = stream;
-
-    SoundFontCache::instance()->emplace(filename, std::move(sfData));
+    SoundFontFile* file = new SoundFontFile();
+    file->path = filename;
+    file->data = pool->data(filename);
+    file->size = static_cast<fluid_long_long_t>(pool->size(filename));
 
-    return stream;
+    return file;
 }
 
 int readSoundFont(void* buf, fluid_long_long_t count, void* handle)
 {
-    return static_cast<int>(std::fread(buf, count, 1, static_cast<std::FILE*>(handle)));
+    SoundFontFile* file = static_cast<SoundFontFile*>(handle);
+
+    if (count < 0 || file->position + count > file->size) {
+        return FLUID_FAILED;
+    }
+
+    std::memcpy(buf, file->data + file->position, static_cast<size_t>(count));
+    file->position += count;
+
+    return FLUID_OK;
 }
 
 int seekSoundFont(void* handle, fluid_long_long_t offset, int origin)
 {
-    return std::fseek(static_cast<std::FILE*>(handle), offset, origin);
+    SoundFontFile* file = static_cast<SoundFontFile*>(handle);
+    fluid_long_long_t position = offset;
+
+    if (origin == SEEK_CUR) {
+        position += file->position;
+    } else if (origin == SEEK_END) {
+        position += file->size;
+    }
+
+    if (position < 0 || position > file->size) {
+        return FLUID_FAILED;
+    }
+
+    file->position = position;
+
+    return FLUID_OK;
 }
 
-int closeSoundFont(void* /*handle*/)
+int closeSoundFont(void* handle)
 {
-    //!Note Prevent closing of sound-font files by Fluid instances,
-    //!     instead the actual closing of cached sound-font files will happen in SoundFontCache.
-    //!     However, we still need to provide "some" callback for Fluid's API
+    SoundFontFile* file = static_cast<SoundFontFile*>(handle);
+
+    SoundFontSamplePool::instance()->release(file->path);
+    delete file;
 
     return FLUID_OK;
 }
 
 fluid_long_long_t tellSoundFont(void* handle)
 {
-    return std::ftell(static_cast<std::FILE*>(handle));
+    return static_cast<SoundFontFile*>(handle)->position;
 }
 
 int deleteSoundFont(fluid_sfont_t* /*sfont*/)
@@ -122,12 +160,53 @@ static fluid_file_callbacks_t FILE_CALLBACKS {
     tellSoundFont
 };
 
-fluid_sfont_t* loadSoundFont(fluid_sfloader_t* loader, const char* filename)
+//! NOTE The sample cache of fluid is process-wide too: the samples of a preset are loaded once,
+//! when any instance selects it, and with the mapper they point into the mapped file
+const void* mapSampleData(void* /*data*/, const char* filename, fluid_long_long_t offset, fluid_long_long_t size)
 {
-    auto search = SoundFontCache::instance()->find(filename);
-    if (search != SoundFontCache::instance()->cend()) {
-        return search->second.soundFontPtr;
-    }
+    return SoundFontSamplePool::instance()->mapSampleData(filename, static_cast<uint64_t>(offset), static_cast<uint64_t>(size));
+}
+
+void unmapSampleData(void* /*data*/, const char* filename, const void* /*ptr*/, fluid_long_long_t size)
+{
+    SoundFontSamplePool::instance()->unmapSampleData(filename, static_cast<uint64_t>(size));
+}
+
+static fluid_samplecache_mapper_t SAMPLE_DATA_MAPPER {
+    nullptr,
+    mapSampleData,
+    unmapSampleData
+};
+
+//! NOTE The cached SoundFonts keep the state of their samples unguarded, so they are only used on the audio worker thread,
+//! the synths of the exports load SoundFonts of their own. All of them still share the sample cache of fluid, guarded by this lock
+void lockSampleCache(void* data)
+{
+    static_cast<std::mutex*>(data)->lock();
+}
+
+void unlockSampleCache(void* data)
+{
+    static_cast<std::mutex*>(data)->unlock();
+}
+
+static std::mutex SAMPLE_CACHE_MUTEX;
+
+static fluid_samplecache_lock_t SAMPLE_CACHE_LOCK {
+    &SAMPLE_CACHE_MUTEX,
+    lockSampleCache,
+    unlockSampleCache
+};
+
+fluid_sfont_t* createSoundFont(fluid_sfloader_t* loader, const char* filename, fluid_sfont_free_t deleteSoundFontFunc)
+{
+    static const bool sampleCacheLocked = []() {
+        fluid_samplecache_set_lock(&SAMPLE_CACHE_LOCK);
+        return true;
+    }();
+    (void)sampleCacheLocked;
+
+    fluid_samplecache_set_mapper(&SAMPLE_DATA_MAPPER);
 
     fluid_defsfont_t* defsfont = nullptr;
     fluid_sfont_t* result = nullptr;
@@ -142,7 +221,7 @@ fluid_sfont_t* loadSoundFont(fluid_sfloader_t* loader, const char* filename)
                              fluid_defsfont_sfont_get_preset,
                              fluid_defsfont_sfont_iteration_start,
                              fluid_defsfont_sfont_iteration_next,
-                             deleteSoundFont);
+                             deleteSoundFontFunc);
 
     if (!result) {
         return result;
@@ -157,11 +236,34 @@ fluid_sfont_t* loadSoundFont(fluid_sfloader_t* loader, const char* filename)
         return nullptr;
     }
 
+    return result;
+}
+
+fluid_sfont_t* loadSoundFont(fluid_sfloader_t* loader, const char* filename)
+{
+    auto search = SoundFontCache::instance()->find(filename);
+    if (search != SoundFontCache::instance()->cend()) {
+        return search->second.soundFontPtr;
+    }
+
+    fluid_sfont_t* result = createSoundFont(loader, filename, deleteSoundFont);
+
+    if (!result) {
+        return nullptr;
+    }
+
     SoundFontData& sfData = SoundFontCache::instance()->operator[](filename);
     sfData.soundFontPtr = result;
 
     return result;
 }
+
+//! NOTE Loads a SoundFont owned by the Fluid instance, it is deleted together with the instance.
+//! Only the sample data is still shared with the other instances, through the sample cache
+fluid_sfont_t* loadPrivateSoundFont(fluid_sfloader_t* loader, const char* filename)
+{
+    return createSoundFont(loader, filename, fluid_defsfont_sfont_delete);
+}
 }
 
 #endif // MUSE_AUDIO_SFCACHEDLOADER_H
@@ -0,0 +1,189 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "soundfontsamplepool.h"
+
+#include <algorithm>
+
+#include "log.h"
+
+using namespace muse::audio;
+using namespace muse::audio::synth;
+
+SoundFontSamplePool* SoundFontSamplePool::instance()
+{
+    static SoundFontSamplePool s;
+    return &s;
+}
+
+bool SoundFontSamplePool::acquire(const std::string& path)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto it = m_entries.find(path);
+
+    if (it == m_entries.end()) {
+        MappedFilePtr file = MappedFile::open(path);
+        if (!file) {
+            LOGE() << "Unable to map the SoundFont: " << path;
+            return false;
+        }
+
+        it = m_entries.emplace(path, Entry { std::move(file), 0, 0 }).first;
+    }
+
+    ++it->second.references;
+
+    return true;
+}
+
+void SoundFontSamplePool::release(const std::string& path)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto it = m_entries.find(path);
+    IF_ASSERT_FAILED(it != m_entries.end() && it->second.references > 0) {
+        return;
+    }
+
+    if (--it->second.references == 0) {
+        m_entries.erase(it);
+    }
+}
+
+const uint8_t* SoundFontSamplePool::data(const std::string& path) const
+{
+    std::lock_guard lock(m_mutex);
+
+    auto it = m_entries.find(path);
+    return it != m_entries.end() ? it->second.file->data() : nullptr;
+}
+
+size_t SoundFontSamplePool::size(const std::string& path) const
+{
+    std::lock_guard lock(m_mutex);
+
+    auto it = m_entries.find(path);
+    return it != m_entries.end() ? it->second.file->size() : 0;
+}
+
+const void* SoundFontSamplePool::mapSampleData(const std::string& path, uint64_t offset, uint64_t size)
+{
+    if (!acquire(path)) {
+        return nullptr;
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    Entry& entry = m_entries.at(path);
+
+    if (offset + size > entry.file->size()) {
+        LOGE() << "Sample data exceeds the SoundFont: " << path;
+
+        if (--entry.references == 0) {
+            m_entries.erase(path);
+        }
+
+        return nullptr;
+    }
+
+    entry.sampleBytes += static_cast<size_t>(size);
+    entry.file->willNeed(offset, size);
+
+    m_pendingPrefetches.push_back({ entry.file, offset, size });
+
+    return entry.file->data() + offset;
+}
+
+void SoundFontSamplePool::unmapSampleData(const std::string& path, uint64_t size)
+{
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto it = m_entries.find(path);
+        IF_ASSERT_FAILED(it != m_entries.end()) {
+            return;
+        }
+
+        it->second.sampleBytes -= std::min(it->second.sampleBytes, static_cast<size_t>(size));
+    }
+
+    release(path);
+}
+
+void SoundFontSamplePool::prefetchMappedSamples()
+{
+    std::vector<PendingPrefetch> prefetches;
+
+    {
+        std::lock_guard lock(m_mutex);
+        prefetches.swap(m_pendingPrefetches);
+    }
+
+    //! NOTE The pending ranges hold their files, so the pages are read without the lock
+    for (const PendingPrefetch& prefetch : prefetches) {
+        prefetch.file->touch(prefetch.offset, prefetch.size);
+    }
+}
+
+SoundFontMemoryUsage SoundFontSamplePool::memoryUsage(const std::string& path) const
+{
+    MappedFilePtr file;
+    SoundFontMemoryUsage result;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        auto it = m_entries.find(path);
+        if (it == m_entries.end()) {
+            return result;
+        }
+
+        file = it->second.file;
+        result.sampleBytes = it->second.sampleBytes;
+    }
+
+    result.fileBytes = file->size();
+    result.residentBytes = file->residentBytes(result.sampleBytes);
+
+    return result;
+}
+
+std::map<std::string, SoundFontMemoryUsage> SoundFontSamplePool::memoryUsage() const
+{
+    std::vector<std::string> paths;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        for (const auto& pair : m_entries) {
+            paths.push_back(pair.first);
+        }
+    }
+
+    std::map<std::string, SoundFontMemoryUsage> result;
+
+    for (const std::string& path : paths) {
+        result.emplace(path, memoryUsage(path));
+    }
+
+    return result;
+}
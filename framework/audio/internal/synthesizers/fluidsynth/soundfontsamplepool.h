@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_SOUNDFONTSAMPLEPOOL_H
+#define MUSE_AUDIO_SOUNDFONTSAMPLEPOOL_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../mappedfile.h"
+
+namespace muse::audio::synth {
+struct SoundFontMemoryUsage {
+    size_t fileBytes = 0;     // the size of the mapped file
+    size_t sampleBytes = 0;   // the sample data used by the selected presets
+    size_t residentBytes = 0; // the part of the file, which is in physical memory now
+};
+
+//! NOTE Process-wide store of the SoundFont files, shared by all the FluidSynth instances.
+//! Every file is mapped into memory once and stays mapped while it is used: the fluid file callbacks
+//! read the SoundFont structure from the mapping, and the fluid sample cache points into it
+//! instead of copying the samples of the selected presets to the heap.
+//! So the OS reads the sample data on demand, and all the instances (and processes) share its pages
+class SoundFontSamplePool
+{
+public:
+    static SoundFontSamplePool* instance();
+
+    //! NOTE Maps the file on the first call, every successful call must be paired with release()
+    bool acquire(const std::string& path);
+    void release(const std::string& path);
+
+    const uint8_t* data(const std::string& path) const;
+    size_t size(const std::string& path) const;
+
+    //! NOTE The sample data of a selected preset; the mapping is kept while the range is used
+    const void* mapSampleData(const std::string& path, uint64_t offset, uint64_t size);
+    void unmapSampleData(const std::string& path, uint64_t size);
+
+    //! NOTE Reads the pages of the sample data mapped since the last call, so that
+    //! the first notes of the selected presets don't wait for the disk in the audio thread
+    void prefetchMappedSamples();
+
+    SoundFontMemoryUsage memoryUsage(const std::string& path) const;
+    std::map<std::string, SoundFontMemoryUsage> memoryUsage() const;
+
+private:
+    struct Entry {
+        MappedFilePtr file;
+        size_t references = 0;
+        size_t sampleBytes = 0;
+    };
+
+    struct PendingPrefetch {
+        MappedFilePtr file;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    SoundFontSamplePool() = default;
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Entry> m_entries;
+    std::vector<PendingPrefetch> m_pendingPrefetches;
+};
+}
+
+#endif // MUSE_AUDIO_SOUNDFONTSAMPLEPOOL_H
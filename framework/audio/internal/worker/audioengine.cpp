@@ -30,6 +30,9 @@
 using namespace muse;
 using namespace muse::audio;
 
+static constexpr samples_t ADAPTIVE_RESERVE_MAX_FACTOR = 4;
+static constexpr samples_t ADAPTIVE_RESERVE_STABLE_PERIOD_SECS = 10;
+
 AudioEngine::~AudioEngine()
 {
     ONLY_AUDIO_MAIN_OR_WORKER_THREAD;
@@ -104,6 +107,7 @@ void AudioEngine::setSampleRate(const sample_rate_t sampleRate)
 
     m_sampleRate = sampleRate;
     m_mixer->mixedSource()->setSampleRate(sampleRate);
+    updateBufferConstraints();
 
     if (m_onReadBufferChanged) {
         m_onReadBufferChanged(m_readBufferSize, m_sampleRate);
@@ -214,4 +218,12 @@ void AudioEngine::updateBufferConstraints()
 
     m_buffer->setMinSamplesPerChannelToReserve(minSamplesToReserve);
     m_buffer->setRenderStep(minSamplesToReserve);
+
+    //! NOTE During the playback the reserve adapts to the machine: it grows after underruns and shrinks back when stable
+    AudioBuffer::AdaptiveReserve adaptiveReserve;
+    adaptiveReserve.enabled = m_currentMode == RenderMode::RealTimeMode && m_sampleRate > 0;
+    adaptiveReserve.maxSamplesPerChannel = minSamplesToReserve * ADAPTIVE_RESERVE_MAX_FACTOR;
+    adaptiveReserve.stablePeriodSamplesPerChannel = m_sampleRate * ADAPTIVE_RESERVE_STABLE_PERIOD_SECS;
+
+    m_buffer->setAdaptiveReserve(adaptiveReserve);
 }
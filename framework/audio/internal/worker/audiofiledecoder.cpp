@@ -0,0 +1,298 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiofiledecoder.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "log.h"
+
+#define DR_WAV_IMPLEMENTATION
+#define DR_MP3_IMPLEMENTATION
+#define DR_MP3_FLOAT_OUTPUT
+#include "thirdparty/dr_libs/dr_wav.h"
+#include "thirdparty/dr_libs/dr_mp3.h"
+
+/* open if you want to add flac
+#define DR_FLAC_IMPLEMENTATION
+#include "thirdparty/dr_libs/dr_flac.h"
+*/
+
+#if (defined (_MSCVER) || defined (_MSC_VER))
+#pragma warning(push)
+#pragma warning(disable: 4456) // declaration hides previous local declaration
+#endif
+#include "thirdparty/stb/stb_vorbis.c"
+#if (defined (_MSCVER) || defined (_MSC_VER))
+#pragma warning(pop)
+#endif
+
+using namespace muse::audio;
+
+//! NOTE About one seek point per second of a song, the search for the seek points reads the whole file anyway
+static constexpr drmp3_uint32 MAX_MP3_SEEK_POINTS = 1024;
+
+struct AudioFileDecoder::Impl
+{
+    enum class Format {
+        Undefined,
+        Wav,
+        Mp3,
+        Ogg
+    };
+
+    Format format = Format::Undefined;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    audioch_t audioChannelsCount = 0;
+    sample_rate_t sampleRate = 0;
+    uint64_t framesCount = 0;
+
+    drwav wav;
+    drmp3 mp3;
+    std::vector<drmp3_seek_point> mp3SeekPoints;
+    stb_vorbis* vorbis = nullptr;
+
+    bool openWav()
+    {
+        if (!drwav_init_memory(&wav, data, size, nullptr)) {
+            return false;
+        }
+
+        format = Format::Wav;
+        audioChannelsCount = static_cast<audioch_t>(wav.channels);
+        sampleRate = wav.sampleRate;
+        framesCount = wav.totalPCMFrameCount;
+
+        return true;
+    }
+
+    bool openMp3()
+    {
+        if (!drmp3_init_memory(&mp3, data, size, nullptr)) {
+            return false;
+        }
+
+        format = Format::Mp3;
+        audioChannelsCount = static_cast<audioch_t>(mp3.channels);
+        sampleRate = mp3.sampleRate;
+
+        drmp3_uint64 mp3FramesCount = 0;
+        drmp3_uint64 pcmFramesCount = 0;
+        drmp3_get_mp3_and_pcm_frame_count(&mp3, &mp3FramesCount, &pcmFramesCount);
+        framesCount = pcmFramesCount;
+
+        //! NOTE Without a seek table, every seek decodes the file from the beginning
+        drmp3_uint32 seekPointsCount = static_cast<drmp3_uint32>(std::clamp<uint64_t>(framesCount / std::max<sample_rate_t>(sampleRate, 1),
+                                                                                      1, MAX_MP3_SEEK_POINTS));
+        mp3SeekPoints.resize(seekPointsCount);
+
+        if (drmp3_calculate_seek_points(&mp3, &seekPointsCount, mp3SeekPoints.data())) {
+            mp3SeekPoints.resize(seekPointsCount);
+            drmp3_bind_seek_table(&mp3, seekPointsCount, mp3SeekPoints.data());
+        } else {
+            mp3SeekPoints.clear();
+        }
+
+        return true;
+    }
+
+    bool openOgg()
+    {
+        int error = 0;
+        vorbis = stb_vorbis_open_memory(data, static_cast<int>(std::min<size_t>(size, INT32_MAX)), &error, nullptr);
+        if (!vorbis) {
+            return false;
+        }
+
+        format = Format::Ogg;
+        audioChannelsCount = static_cast<audioch_t>(vorbis->channels);
+        sampleRate = vorbis->sample_rate;
+        framesCount = stb_vorbis_stream_length_in_samples(vorbis);
+
+        return true;
+    }
+
+    void close()
+    {
+        switch (format) {
+        case Format::Wav:
+            drwav_uninit(&wav);
+            break;
+        case Format::Mp3:
+            drmp3_uninit(&mp3);
+            mp3SeekPoints.clear();
+            break;
+        case Format::Ogg:
+            stb_vorbis_close(vorbis);
+            vorbis = nullptr;
+            break;
+        case Format::Undefined:
+            break;
+        }
+
+        format = Format::Undefined;
+        audioChannelsCount = 0;
+        sampleRate = 0;
+        framesCount = 0;
+    }
+};
+
+AudioFileDecoder::AudioFileDecoder()
+    : m_impl(std::make_unique<Impl>())
+{
+}
+
+AudioFileDecoder::~AudioFileDecoder()
+{
+    close();
+}
+
+bool AudioFileDecoder::open(const uint8_t* data, size_t size)
+{
+    close();
+
+    if (!data || size == 0) {
+        return false;
+    }
+
+    m_impl->data = data;
+    m_impl->size = size;
+
+    if (m_impl->openWav() || m_impl->openMp3() || m_impl->openOgg()) {
+        if (m_impl->audioChannelsCount > 0 && m_impl->sampleRate > 0) {
+            return true;
+        }
+
+        LOGE() << "Unsupported audio format, channels: " << m_impl->audioChannelsCount << ", sample rate: " << m_impl->sampleRate;
+        close();
+    }
+
+    return false;
+}
+
+void AudioFileDecoder::close()
+{
+    m_impl->close();
+    m_impl->data = nullptr;
+    m_impl->size = 0;
+}
+
+bool AudioFileDecoder::isOpen() const
+{
+    return m_impl->format != Impl::Format::Undefined;
+}
+
+audioch_t AudioFileDecoder::audioChannelsCount() const
+{
+    return m_impl->audioChannelsCount;
+}
+
+sample_rate_t AudioFileDecoder::sampleRate() const
+{
+    return m_impl->sampleRate;
+}
+
+uint64_t AudioFileDecoder::framesCount() const
+{
+    return m_impl->framesCount;
+}
+
+bool AudioFileDecoder::seek(uint64_t frame)
+{
+    frame = std::min(frame, m_impl->framesCount);
+
+    switch (m_impl->format) {
+    case Impl::Format::Wav:
+        return drwav_seek_to_pcm_frame(&m_impl->wav, frame);
+    case Impl::Format::Mp3:
+        return drmp3_seek_to_pcm_frame(&m_impl->mp3, frame);
+    case Impl::Format::Ogg:
+        return stb_vorbis_seek(m_impl->vorbis, static_cast<unsigned int>(frame)) != 0;
+    case Impl::Format::Undefined:
+        break;
+    }
+
+    return false;
+}
+
+samples_t AudioFileDecoder::read(float* buffer, samples_t frames)
+{
+    switch (m_impl->format) {
+    case Impl::Format::Wav:
+        return drwav_read_pcm_frames_f32(&m_impl->wav, frames, buffer);
+    case Impl::Format::Mp3:
+        return drmp3_read_pcm_frames_f32(&m_impl->mp3, frames, buffer);
+    case Impl::Format::Ogg: {
+        const int channels = m_impl->audioChannelsCount;
+        samples_t readFrames = 0;
+
+        //! NOTE stb_vorbis returns at most one vorbis frame per call
+        while (readFrames < frames) {
+            const int maxFloats = static_cast<int>(std::min<samples_t>(frames - readFrames, INT32_MAX / channels) * channels);
+            const int count = stb_vorbis_get_samples_float_interleaved(m_impl->vorbis, channels, buffer + readFrames * channels,
+                                                                       maxFloats);
+            if (count <= 0) {
+                break;
+            }
+
+            readFrames += count;
+        }
+
+        return readFrames;
+    }
+    case Impl::Format::Undefined:
+        break;
+    }
+
+    return 0;
+}
+
+uint64_t AudioFileDecoder::byteOffset(uint64_t frame) const
+{
+    const uint64_t framesCount = std::max<uint64_t>(m_impl->framesCount, 1);
+    frame = std::min(frame, framesCount);
+
+    switch (m_impl->format) {
+    case Impl::Format::Wav:
+        return m_impl->wav.dataChunkDataPos + m_impl->wav.dataChunkDataSize * frame / framesCount;
+    case Impl::Format::Mp3: {
+        const std::vector<drmp3_seek_point>& points = m_impl->mp3SeekPoints;
+        auto it = std::upper_bound(points.cbegin(), points.cend(), frame, [](uint64_t f, const drmp3_seek_point& point) {
+            return f < point.pcmFrameIndex;
+        });
+
+        if (it != points.cbegin()) {
+            return std::prev(it)->seekPosInBytes;
+        }
+
+        break;
+    }
+    case Impl::Format::Ogg:
+    case Impl::Format::Undefined:
+        break;
+    }
+
+    return static_cast<uint64_t>(static_cast<double>(m_impl->size) * frame / framesCount);
+}
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_AUDIOFILEDECODER_H
+#define MUSE_AUDIO_AUDIOFILEDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "../../audiotypes.h"
+
+namespace muse::audio {
+//! NOTE Incremental decoding of a wav, mp3 or ogg file which is already in memory (a mapped file or a buffer).
+//! The memory must outlive the decoder. The output is interleaved float with the channels of the file
+class AudioFileDecoder
+{
+public:
+    AudioFileDecoder();
+    ~AudioFileDecoder();
+
+    AudioFileDecoder(const AudioFileDecoder&) = delete;
+    AudioFileDecoder& operator=(const AudioFileDecoder&) = delete;
+
+    //! NOTE The format is automatically checked
+    bool open(const uint8_t* data, size_t size);
+    void close();
+
+    bool isOpen() const;
+
+    audioch_t audioChannelsCount() const;
+    sample_rate_t sampleRate() const;
+    uint64_t framesCount() const;
+
+    bool seek(uint64_t frame);
+
+    //! NOTE Returns the number of the read frames, less than requested only at the end of the file
+    samples_t read(float* buffer, samples_t frames);
+
+    //! NOTE The approximate position of the frame in the file, to prefetch the data around it
+    uint64_t byteOffset(uint64_t frame) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+}
+
+#endif // MUSE_AUDIO_AUDIOFILEDECODER_H
@@ -0,0 +1,594 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiofilesource.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "global/io/file.h"
+
+#include "../dsp/polyphaseresampler.h"
+#include "audiofiledecoder.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+static constexpr audioch_t FILE_SOURCE_CHANNELS = 2;
+
+//! NOTE About 1.4 seconds at 48 kHz. A power of two, so that the ring index is a mask
+static constexpr samples_t READ_AHEAD_FRAMES = 1 << 16;
+static constexpr samples_t DECODE_BLOCK_FRAMES = 4096;
+
+//! NOTE The mapped pages which are requested from the OS ahead of the decoder
+static constexpr uint64_t PREFETCH_BYTES = 1 << 20;
+
+//! NOTE A lost wake up (see AudioFileStreamThread::wake) delays the decoder by this interval at most
+static constexpr std::chrono::milliseconds STREAM_THREAD_POLL_INTERVAL(10);
+
+//! NOTE How often the offline mode checks whether the decoder has caught up
+static constexpr std::chrono::microseconds OFFLINE_WAIT_INTERVAL(100);
+
+struct AudioFileSource::Stream
+{
+    MappedFilePtr file;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    //! NOTE Written by the audio thread. The generation is incremented after the position and the sample rate are set
+    std::atomic<uint64_t> requestedGeneration = 0;
+    std::atomic<uint64_t> requestedFrame = 0;
+    std::atomic<sample_rate_t> requestedSampleRate = 0;
+
+    //! NOTE Written by the decoder thread. The ring frames from generationStart on belong to the published generation
+    std::atomic<uint64_t> generation = 0;
+    std::atomic<uint64_t> generationStart = 0;
+    std::atomic<bool> isEnded = false;
+    std::atomic<bool> isFailed = false; // nothing will ever be decoded
+
+    //! NOTE Single producer, single consumer: the frames [readFrame, writeFrame) are ready
+    std::vector<float> ring = std::vector<float>(READ_AHEAD_FRAMES * FILE_SOURCE_CHANNELS, 0.f);
+    std::atomic<uint64_t> writeFrame = 0;
+    std::atomic<uint64_t> readFrame = 0;
+
+    //! NOTE The decoder state, only used by the decoder thread while the mutex is locked
+    std::mutex decodeMutex;
+    bool isClosed = false;
+    bool isOpened = false;
+    AudioFileDecoder decoder;
+    std::unique_ptr<dsp::PolyphaseResampler> resampler;
+    sample_rate_t outputSampleRate = 0;
+    samples_t framesToSkip = 0;
+    uint64_t outputFrame = 0;
+    uint64_t outputFramesCount = 0;
+    bool isDecoderEnded = false;
+    uint64_t prefetchedUntil = 0;
+    std::vector<float> decoded;
+    std::vector<float> stereo;
+    std::vector<float> resampled;
+
+    void close()
+    {
+        std::lock_guard lock(decodeMutex);
+
+        isClosed = true;
+        decoder.close();
+        file.reset();
+        data = nullptr;
+        size = 0;
+    }
+
+    //! NOTE Decodes one block, returns false if there is nothing to do until the audio thread reads or seeks
+    bool decodeNext()
+    {
+        std::lock_guard lock(decodeMutex);
+
+        if (isClosed) {
+            return false;
+        }
+
+        if (!isOpened) {
+            isOpened = true;
+
+            prefetch(0);
+
+            if (!decoder.open(data, size)) {
+                LOGE() << "Unable to decode the audio file";
+                isClosed = true;
+                isFailed.store(true, std::memory_order_release);
+                return false;
+            }
+        }
+
+        const uint64_t requested = requestedGeneration.load(std::memory_order_acquire);
+        if (requested != generation.load(std::memory_order_relaxed)) {
+            const sample_rate_t sampleRate = requestedSampleRate.load(std::memory_order_relaxed);
+            if (sampleRate == 0) {
+                return false;
+            }
+
+            restart(requestedFrame.load(std::memory_order_relaxed), sampleRate);
+
+            generationStart.store(writeFrame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            isEnded.store(false, std::memory_order_relaxed);
+            generation.store(requested, std::memory_order_release);
+        }
+
+        if (isEnded.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        const uint64_t write = writeFrame.load(std::memory_order_relaxed);
+        const samples_t space = READ_AHEAD_FRAMES - static_cast<samples_t>(write - readFrame.load(std::memory_order_acquire));
+        const samples_t maxOutputFrames = resampler ? resampler->maxOutputFrames(DECODE_BLOCK_FRAMES) : DECODE_BLOCK_FRAMES;
+        if (space < maxOutputFrames) {
+            return false;
+        }
+
+        decodeBlock(write);
+
+        return true;
+    }
+
+    void restart(uint64_t frame, sample_rate_t sampleRate)
+    {
+        const sample_rate_t fileSampleRate = decoder.sampleRate();
+
+        if (fileSampleRate == sampleRate) {
+            resampler.reset();
+        } else if (!resampler || resampler->sampleRateOut() != sampleRate) {
+            resampler = std::make_unique<dsp::PolyphaseResampler>(fileSampleRate, sampleRate, FILE_SOURCE_CHANNELS,
+                                                                  dsp::PolyphaseResampler::Quality::Medium, DECODE_BLOCK_FRAMES);
+        } else {
+            resampler->reset();
+        }
+
+        outputSampleRate = sampleRate;
+        outputFramesCount = decoder.framesCount() * sampleRate / fileSampleRate;
+        outputFrame = std::min(frame, outputFramesCount);
+
+        const uint64_t inputFrame = outputFrame * fileSampleRate / sampleRate;
+        decoder.seek(inputFrame);
+        isDecoderEnded = false;
+
+        //! NOTE Skip the delay of the filter, so that the output frames are aligned with the requested position
+        framesToSkip = resampler ? resampler->latency() : 0;
+
+        prefetchedUntil = 0;
+        prefetch(decoder.byteOffset(inputFrame));
+    }
+
+    void decodeBlock(uint64_t write)
+    {
+        const audioch_t fileChannels = decoder.audioChannelsCount();
+
+        decoded.resize(DECODE_BLOCK_FRAMES * fileChannels);
+        stereo.resize(DECODE_BLOCK_FRAMES * FILE_SOURCE_CHANNELS);
+
+        samples_t frames = isDecoderEnded ? 0 : decoder.read(decoded.data(), DECODE_BLOCK_FRAMES);
+        isDecoderEnded = frames < DECODE_BLOCK_FRAMES;
+
+        for (samples_t i = 0; i < frames; ++i) {
+            const float* in = decoded.data() + i * fileChannels;
+            stereo[i * 2] = in[0];
+            stereo[i * 2 + 1] = fileChannels > 1 ? in[1] : in[0];
+        }
+
+        const float* output = stereo.data();
+        samples_t outputFrames = frames;
+
+        if (resampler) {
+            //! NOTE Flush the tail of the filter with silence after the end of the file
+            std::fill(stereo.begin() + frames * FILE_SOURCE_CHANNELS, stereo.end(), 0.f);
+
+            resampled.resize(resampler->maxOutputFrames(DECODE_BLOCK_FRAMES) * FILE_SOURCE_CHANNELS);
+            outputFrames = resampler->process(stereo.data(), DECODE_BLOCK_FRAMES, resampled.data());
+            output = resampled.data();
+
+            const samples_t skippedFrames = std::min(outputFrames, framesToSkip);
+            framesToSkip -= skippedFrames;
+            output += skippedFrames * FILE_SOURCE_CHANNELS;
+            outputFrames -= skippedFrames;
+        }
+
+        outputFrames = static_cast<samples_t>(std::min<uint64_t>(outputFrames, outputFramesCount - outputFrame));
+
+        for (samples_t copied = 0; copied < outputFrames;) {
+            const uint64_t index = (write + copied) & (READ_AHEAD_FRAMES - 1);
+            const samples_t count = static_cast<samples_t>(std::min<uint64_t>(outputFrames - copied, READ_AHEAD_FRAMES - index));
+
+            std::memcpy(ring.data() + index * FILE_SOURCE_CHANNELS, output + copied * FILE_SOURCE_CHANNELS,
+                        count * FILE_SOURCE_CHANNELS * sizeof(float));
+            copied += count;
+        }
+
+        outputFrame += outputFrames;
+        writeFrame.store(write + outputFrames, std::memory_order_release);
+
+        if (outputFrame >= outputFramesCount || (isDecoderEnded && !resampler)) {
+            isEnded.store(true, std::memory_order_release);
+            return;
+        }
+
+        const uint64_t offset = decoder.byteOffset(outputFrame * decoder.sampleRate() / outputSampleRate);
+        if (offset + PREFETCH_BYTES / 2 > prefetchedUntil) {
+            prefetch(offset);
+        }
+    }
+
+    void prefetch(uint64_t offset)
+    {
+        if (!file) {
+            return;
+        }
+
+        file->willNeed(offset, PREFETCH_BYTES);
+        prefetchedUntil = offset + PREFETCH_BYTES;
+    }
+};
+
+namespace muse::audio {
+//! NOTE One thread decodes all the file sources, so that the number of threads doesn't grow with the number of tracks
+class AudioFileStreamThread
+{
+public:
+    static AudioFileStreamThread* instance()
+    {
+        static AudioFileStreamThread s;
+        return &s;
+    }
+
+    void addStream(const std::shared_ptr<AudioFileSource::Stream>& stream)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+
+            m_streams.push_back(stream);
+
+            if (!m_thread.joinable()) {
+                m_thread = std::thread(&AudioFileStreamThread::th_run, this);
+            }
+        }
+
+        wake();
+    }
+
+    //! NOTE Called by the audio thread, so the mutex isn't locked: if the thread is just about to wait, it is woken by the timeout
+    void wake()
+    {
+        m_wakeRequested.store(true, std::memory_order_release);
+        m_wakeCv.notify_one();
+    }
+
+private:
+    ~AudioFileStreamThread()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_isRunning = false;
+        }
+
+        m_wakeCv.notify_one();
+
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void th_run()
+    {
+        std::vector<std::shared_ptr<AudioFileSource::Stream> > streams;
+
+        while (true) {
+            {
+                std::unique_lock lock(m_mutex);
+
+                m_wakeCv.wait_for(lock, STREAM_THREAD_POLL_INTERVAL, [this]() {
+                    return m_wakeRequested.load(std::memory_order_acquire) || !m_isRunning;
+                });
+
+                if (!m_isRunning) {
+                    return;
+                }
+
+                m_wakeRequested.store(false, std::memory_order_relaxed);
+
+                for (auto it = m_streams.begin(); it != m_streams.end();) {
+                    if (std::shared_ptr<AudioFileSource::Stream> stream = it->lock()) {
+                        streams.push_back(std::move(stream));
+                        ++it;
+                    } else {
+                        it = m_streams.erase(it);
+                    }
+                }
+            }
+
+            //! NOTE One block of each stream in turn, until all the rings are full
+            bool hasDecoded = true;
+            while (hasDecoded && !m_wakeRequested.load(std::memory_order_acquire)) {
+                hasDecoded = false;
+
+                for (const auto& stream : streams) {
+                    hasDecoded |= stream->decodeNext();
+                }
+            }
+
+            streams.clear();
+        }
+    }
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCv;
+    std::atomic<bool> m_wakeRequested = false;
+    bool m_isRunning = true;
+
+    std::vector<std::weak_ptr<AudioFileSource::Stream> > m_streams;
+};
+}
+
+AudioFileSourcePtr AudioFileSource::open(io::IODevice* device)
+{
+    if (!device) {
+        return nullptr;
+    }
+
+    if (const io::File* file = dynamic_cast<const io::File*>(device); file && !file->filePath().empty()) {
+        MappedFilePtr mappedFile = MappedFile::open(file->filePath().toStdString());
+        if (mappedFile) {
+            return std::make_shared<AudioFileSource>(std::move(mappedFile));
+        }
+
+        LOGW() << "Unable to map the audio file, reading it into memory: " << file->filePath();
+    }
+
+    if (!device->isOpen() && !device->open(io::IODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    return std::make_shared<AudioFileSource>(device);
+}
+
+AudioFileSource::AudioFileSource(const std::string& filePath)
+    : AudioFileSource(MappedFile::open(filePath))
+{
+    if (m_stream->isFailed) {
+        LOGE() << "Unable to open the audio file: " << filePath;
+    }
+}
+
+AudioFileSource::AudioFileSource(MappedFilePtr file)
+    : m_stream(std::make_shared<Stream>())
+{
+    m_stream->file = std::move(file);
+
+    if (!m_stream->file) {
+        m_stream->isFailed = true;
+        return;
+    }
+
+    m_stream->data = m_stream->file->data();
+    m_stream->size = m_stream->file->size();
+
+    AudioFileStreamThread::instance()->addStream(m_stream);
+}
+
+AudioFileSource::AudioFileSource(io::IODevice* device)
+    : m_stream(std::make_shared<Stream>())
+{
+    IF_ASSERT_FAILED(device && device->isOpen()) {
+        m_stream->isFailed = true;
+        return;
+    }
+
+    m_stream->data = device->readData();
+    m_stream->size = device->size();
+
+    AudioFileStreamThread::instance()->addStream(m_stream);
+}
+
+AudioFileSource::~AudioFileSource()
+{
+    //! NOTE Waits for the block which is being decoded, the data must not be used after the source is destroyed
+    m_stream->close();
+}
+
+bool AudioFileSource::isActive() const
+{
+    return m_isActive;
+}
+
+void AudioFileSource::setIsActive(bool active)
+{
+    m_isActive = active;
+}
+
+void AudioFileSource::setSampleRate(unsigned int sampleRate)
+{
+    if (m_sampleRate == sampleRate) {
+        return;
+    }
+
+    //! NOTE Keep the position in time
+    const uint64_t position = m_sampleRate == 0 ? 0 : m_position * sampleRate / m_sampleRate;
+
+    m_sampleRate = sampleRate;
+    m_stream->requestedSampleRate.store(sampleRate, std::memory_order_relaxed);
+
+    requestPosition(position);
+}
+
+unsigned int AudioFileSource::audioChannelsCount() const
+{
+    return FILE_SOURCE_CHANNELS;
+}
+
+async::Channel<unsigned int> AudioFileSource::audioChannelsCountChanged() const
+{
+    return m_audioChannelsCountChanged;
+}
+
+samples_t AudioFileSource::process(float* buffer, samples_t samplesPerChannel)
+{
+    if (!m_isActive) {
+        return 0;
+    }
+
+    if (m_isOffline) {
+        waitUntilReady(samplesPerChannel);
+    }
+
+    Stream& stream = *m_stream;
+    samples_t copiedFrames = 0;
+    bool isEnded = false;
+
+    if (stream.generation.load(std::memory_order_acquire) == m_generation) {
+        isEnded = stream.isEnded.load(std::memory_order_acquire);
+
+        const uint64_t write = stream.writeFrame.load(std::memory_order_acquire);
+        uint64_t read = std::max(stream.readFrame.load(std::memory_order_relaxed), stream.generationStart.load(std::memory_order_relaxed));
+
+        //! NOTE The frames which were late are dropped, so that the output stays in time
+        const samples_t droppedFrames = static_cast<samples_t>(std::min<uint64_t>(m_lateFrames, write - read));
+        m_lateFrames -= droppedFrames;
+        read += droppedFrames;
+
+        copiedFrames = static_cast<samples_t>(std::min<uint64_t>(samplesPerChannel, write - read));
+
+        for (samples_t copied = 0; copied < copiedFrames;) {
+            const uint64_t index = (read + copied) & (READ_AHEAD_FRAMES - 1);
+            const samples_t count = static_cast<samples_t>(std::min<uint64_t>(copiedFrames - copied, READ_AHEAD_FRAMES - index));
+
+            std::memcpy(buffer + copied * FILE_SOURCE_CHANNELS, stream.ring.data() + index * FILE_SOURCE_CHANNELS,
+                        count * FILE_SOURCE_CHANNELS * sizeof(float));
+            copied += count;
+        }
+
+        read += copiedFrames;
+        stream.readFrame.store(read, std::memory_order_release);
+
+        if (write - read < READ_AHEAD_FRAMES / 2) {
+            AudioFileStreamThread::instance()->wake();
+        }
+    }
+
+    std::fill(buffer + copiedFrames * FILE_SOURCE_CHANNELS, buffer + samplesPerChannel * FILE_SOURCE_CHANNELS, 0.f);
+
+    m_position += samplesPerChannel;
+
+    if (copiedFrames < samplesPerChannel && !isEnded) {
+        m_lateFrames += samplesPerChannel - copiedFrames;
+        ++m_underruns;
+    }
+
+    return copiedFrames;
+}
+
+void AudioFileSource::seek(const msecs_t newPositionMsecs)
+{
+    //! NOTE msecs_t is in microseconds
+    const uint64_t frame = static_cast<uint64_t>(std::max<msecs_t>(newPositionMsecs, 0)) * m_sampleRate / 1000000;
+
+    if (frame == m_position) {
+        return;
+    }
+
+    requestPosition(frame);
+}
+
+void AudioFileSource::flush()
+{
+}
+
+const AudioInputParams& AudioFileSource::inputParams() const
+{
+    return m_params;
+}
+
+void AudioFileSource::applyInputParams(const AudioInputParams& requiredParams)
+{
+    if (m_params == requiredParams) {
+        return;
+    }
+
+    m_params = requiredParams;
+    m_paramsChanges.send(m_params);
+}
+
+async::Channel<AudioInputParams> AudioFileSource::inputParamsChanged() const
+{
+    return m_paramsChanges;
+}
+
+void AudioFileSource::setIsOffline(bool offline)
+{
+    m_isOffline = offline;
+}
+
+bool AudioFileSource::isReady(samples_t samplesPerChannel) const
+{
+    if (m_stream->generation.load(std::memory_order_acquire) != m_generation) {
+        return false;
+    }
+
+    const uint64_t read = std::max(m_stream->readFrame.load(std::memory_order_relaxed),
+                                   m_stream->generationStart.load(std::memory_order_relaxed));
+
+    const bool isEnded = m_stream->isEnded.load(std::memory_order_acquire);
+
+    return m_stream->writeFrame.load(std::memory_order_acquire) >= read + m_lateFrames + samplesPerChannel || isEnded;
+}
+
+uint64_t AudioFileSource::underrunsCount() const
+{
+    return m_underruns;
+}
+
+void AudioFileSource::waitUntilReady(samples_t samplesPerChannel) const
+{
+    //! NOTE Without the sample rate the decoder doesn't start
+    if (m_sampleRate == 0) {
+        return;
+    }
+
+    while (!isReady(samplesPerChannel) && !m_stream->isFailed.load(std::memory_order_acquire)) {
+        AudioFileStreamThread::instance()->wake();
+        std::this_thread::sleep_for(OFFLINE_WAIT_INTERVAL);
+    }
+}
+
+void AudioFileSource::requestPosition(uint64_t frame)
+{
+    m_position = frame;
+    m_lateFrames = 0;
+
+    m_stream->requestedFrame.store(frame, std::memory_order_relaxed);
+    m_stream->requestedGeneration.store(++m_generation, std::memory_order_release);
+
+    AudioFileStreamThread::instance()->wake();
+}
@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_AUDIOFILESOURCE_H
+#define MUSE_AUDIO_AUDIOFILESOURCE_H
+
+#include <memory>
+#include <string>
+
+#include "global/io/iodevice.h"
+
+#include "../mappedfile.h"
+#include "track.h"
+
+namespace muse::audio {
+//! NOTE Plays a wav, mp3 or ogg file without decoding it in advance.
+//! A background thread decodes the file on demand into a read-ahead ring and converts it to the output sample rate,
+//! so process() only copies the ready samples and never waits for the decoder: it outputs silence until they are ready.
+//! The output is always stereo, mono files are duplicated to both channels
+class AudioFileSource;
+using AudioFileSourcePtr = std::shared_ptr<AudioFileSource>;
+
+class AudioFileSource : public ITrackAudioInput
+{
+public:
+    //! NOTE Opening an io::File reads the whole file into memory, so a file device is mapped by its path instead.
+    //! Other devices are opened, if needed, and read as they are. Returns nullptr if the device can't be read
+    static AudioFileSourcePtr open(io::IODevice* device);
+
+    //! NOTE The file is memory-mapped, its pages are prefetched ahead of the decoder
+    explicit AudioFileSource(const std::string& filePath);
+    explicit AudioFileSource(MappedFilePtr file);
+
+    //! NOTE The device must stay open while the source exists
+    explicit AudioFileSource(io::IODevice* device);
+
+    ~AudioFileSource() override;
+
+    bool isActive() const override;
+    void setIsActive(bool active) override;
+
+    void setSampleRate(unsigned int sampleRate) override;
+    unsigned int audioChannelsCount() const override;
+    async::Channel<unsigned int> audioChannelsCountChanged() const override;
+    samples_t process(float* buffer, samples_t samplesPerChannel) override;
+
+    void seek(const msecs_t newPositionMsecs) override;
+    void flush() override;
+
+    const AudioInputParams& inputParams() const override;
+    void applyInputParams(const AudioInputParams& requiredParams) override;
+    async::Channel<AudioInputParams> inputParamsChanged() const override;
+
+    //! NOTE In the offline mode process() waits for the decoder instead of outputting silence,
+    //! so that an export has no gaps however fast it's rendered
+    void setIsOffline(bool offline);
+
+    //! NOTE Whether the next samples are decoded, or the file ends before
+    bool isReady(samples_t samplesPerChannel) const;
+
+    //! NOTE The number of process() calls which had to output silence because the decoder was behind
+    uint64_t underrunsCount() const;
+
+private:
+    struct Stream;
+    friend class AudioFileStreamThread;
+
+    void requestPosition(uint64_t frame);
+    void waitUntilReady(samples_t samplesPerChannel) const;
+
+    std::shared_ptr<Stream> m_stream;
+
+    bool m_isActive = false;
+    bool m_isOffline = false;
+    sample_rate_t m_sampleRate = 0;
+
+    uint64_t m_position = 0;   // the output frame of the next process() call
+    uint64_t m_generation = 0; // the last requested position
+    samples_t m_lateFrames = 0; // the frames which were replaced with silence, to be dropped once decoded
+    uint64_t m_underruns = 0;
+
+    AudioInputParams m_params;
+    async::Channel<AudioInputParams> m_paramsChanges;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+};
+}
+
+#endif // MUSE_AUDIO_AUDIOFILESOURCE_H
@@ -32,7 +32,7 @@
 
 #include "muse_framework_config.h"
 #ifdef MUSE_MODULE_AUDIO_EXPORT
-#include "internal/soundtracks/soundtrackwriter.h"
+#include "internal/soundtracks/offlinerenderer.h"
 #endif
 
 #include "log.h"
@@ -45,13 +45,17 @@ using namespace muse::async;
 using namespace muse::audio::soundtrack;
 #endif
 
+//! NOTE Enough for a few blocks of fader automation on all the tracks
+static constexpr size_t PARAM_QUEUE_CAPACITY = 1024;
+
 AudioOutputHandler::AudioOutputHandler(IGetTrackSequence* getSequence, const modularity::ContextPtr& iocCtx)
-    : Injectable(iocCtx), m_getSequence(getSequence)
+    : Injectable(iocCtx), m_getSequence(getSequence), m_paramQueue(std::make_shared<MixerParamQueue>(PARAM_QUEUE_CAPACITY))
 {
     ONLY_AUDIO_MAIN_OR_WORKER_THREAD;
 
     Async::call(this, [this]() {
         ensureMixerSubscriptions();
+        connectParamQueue();
     }, AudioThread::ID);
 }
 
@@ -78,14 +82,38 @@ Promise<AudioOutputParams> AudioOutputHandler::outputParams(const TrackSequenceI
 
 void AudioOutputHandler::setOutputParams(const TrackSequenceId sequenceId, const TrackId trackId, const AudioOutputParams& params)
 {
+    const uint64_t tracksGeneration = m_tracksGeneration.load(std::memory_order_acquire);
+    if (tracksGeneration != m_lastSentTracksGeneration) {
+        //! NOTE A removed track id can be reused, the params sent to it are not the params of the new track
+        m_lastSentOutputParams.clear();
+        m_lastSentTracksGeneration = tracksGeneration;
+    }
+
+    const auto key = std::make_pair(sequenceId, trackId);
+    auto lastSentIt = m_lastSentOutputParams.find(key);
+    const AudioOutputParams* lastSent = lastSentIt != m_lastSentOutputParams.end() ? &lastSentIt->second : nullptr;
+
+    if (sendParamCommands(lastSent, params, false, trackId)) {
+        m_lastSentOutputParams[key] = params;
+        m_outputParamsChanged.send(sequenceId, trackId, params);
+        return;
+    }
+
+    m_lastSentOutputParams[key] = params;
+    m_pendingFullParamUpdates.fetch_add(1, std::memory_order_acq_rel);
+
     Async::call(this, [this, sequenceId, trackId, params]() {
         ONLY_AUDIO_WORKER_THREAD;
 
+        applyPendingParamCommands();
+
         ITrackSequencePtr s = sequence(sequenceId);
 
         if (s) {
             s->audioIO()->setOutputParams(trackId, params);
         }
+
+        m_pendingFullParamUpdates.fetch_sub(1, std::memory_order_acq_rel);
     }, AudioThread::ID);
 }
 
@@ -111,27 +139,49 @@ Promise<AudioOutputParams> AudioOutputHandler::masterOutputParams() const
 
 void AudioOutputHandler::setMasterOutputParams(const AudioOutputParams& params)
 {
+    const AudioOutputParams* lastSent = m_lastSentMasterOutputParams ? &m_lastSentMasterOutputParams.value() : nullptr;
+
+    if (sendParamCommands(lastSent, params, true, -1)) {
+        m_lastSentMasterOutputParams = params;
+        m_masterOutputParamsChanged.send(params);
+        return;
+    }
+
+    m_lastSentMasterOutputParams = params;
+    m_pendingFullParamUpdates.fetch_add(1, std::memory_order_acq_rel);
+
     Async::call(this, [this, params]() {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
+            m_pendingFullParamUpdates.fetch_sub(1, std::memory_order_acq_rel);
             return;
         }
 
+        applyPendingParamCommands();
         mixer()->setMasterOutputParams(params);
+
+        m_pendingFullParamUpdates.fetch_sub(1, std::memory_order_acq_rel);
     }, AudioThread::ID);
 }
 
 void AudioOutputHandler::clearMasterOutputParams()
 {
+    m_lastSentMasterOutputParams = AudioOutputParams();
+    m_pendingFullParamUpdates.fetch_add(1, std::memory_order_acq_rel);
+
     Async::call(this, [this]() {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
+            m_pendingFullParamUpdates.fetch_sub(1, std::memory_order_acq_rel);
             return;
         }
 
+        applyPendingParamCommands();
         mixer()->clearMasterOutputParams();
+
+        m_pendingFullParamUpdates.fetch_sub(1, std::memory_order_acq_rel);
     }, AudioThread::ID);
 }
 
@@ -151,9 +201,9 @@ Promise<AudioResourceMetaList> AudioOutputHandler::availableOutputResources() co
     }, AudioThread::ID);
 }
 
-Promise<AudioSignalChanges> AudioOutputHandler::signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const
+Promise<AudioMeterPtr> AudioOutputHandler::audioMeter(const TrackSequenceId sequenceId, const TrackId trackId) const
 {
-    return Promise<AudioSignalChanges>([this, sequenceId, trackId](auto resolve, auto reject) {
+    return Promise<AudioMeterPtr>([this, sequenceId, trackId](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         ITrackSequencePtr s = sequence(sequenceId);
@@ -166,20 +216,46 @@ Promise<AudioSignalChanges> AudioOutputHandler::signalChanges(const TrackSequenc
             return reject(static_cast<int>(Err::InvalidTrackId), "no track");
         }
 
-        return resolve(s->audioIO()->audioSignalChanges(trackId));
+        return resolve(s->audioIO()->audioMeter(trackId));
     }, AudioThread::ID);
 }
 
-Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
+Promise<AudioMeterPtr> AudioOutputHandler::masterAudioMeter() const
 {
-    return Promise<AudioSignalChanges>([this](auto resolve, auto reject) {
+    return Promise<AudioMeterPtr>([this](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
             return reject(static_cast<int>(Err::Undefined), "undefined reference to a mixer");
         }
 
-        return resolve(mixer()->masterAudioSignalChanges());
+        return resolve(mixer()->masterAudioMeter());
+    }, AudioThread::ID);
+}
+
+void AudioOutputHandler::setLoudnessAnalysisEnabled(const TrackSequenceId sequenceId, const TrackId trackId, bool enabled)
+{
+    Async::call(this, [this, sequenceId, trackId, enabled]() {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        ITrackSequencePtr s = sequence(sequenceId);
+
+        if (s && s->audioIO()->isHasTrack(trackId)) {
+            s->audioIO()->setLoudnessAnalysisEnabled(trackId, enabled);
+        }
+    }, AudioThread::ID);
+}
+
+void AudioOutputHandler::setMasterLoudnessAnalysisEnabled(bool enabled)
+{
+    Async::call(this, [this, enabled]() {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        IF_ASSERT_FAILED(mixer()) {
+            return;
+        }
+
+        mixer()->setMasterLoudnessAnalysisEnabled(enabled);
     }, AudioThread::ID);
 }
 
@@ -199,28 +275,36 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
         }
 
 #ifdef MUSE_MODULE_AUDIO_EXPORT
-        s->player()->stop();
-        s->player()->seek(0);
-        msecs_t totalDuration = s->player()->duration();
-
-        SoundTrackWriterPtr writer = std::make_shared<SoundTrackWriter>(destination, format, totalDuration, mixer(), iocContext());
-        m_saveSoundTracksWritersMap[sequenceId] = writer;
-
-        Progress progress = saveSoundTrackProgress(sequenceId);
-        writer->progress().progressChanged().onReceive(this, [&progress](int64_t current, int64_t total, std::string title) {
-            progress.progress(current, total, title);
-        });
-
-        Ret ret = writer->write();
-        s->player()->seek(0);
+        if (muse::contains(m_offlineRenderers, sequenceId)) {
+            return reject(static_cast<int>(Err::Undefined), "the sequence is already being exported");
+        }
 
-        m_saveSoundTracksWritersMap.erase(sequenceId);
+        //! NOTE The export renders a copy of the sequence, the live playback isn't interrupted
+        OfflineRendererPtr renderer = std::make_shared<OfflineRenderer>(iocContext());
 
+        Ret ret = renderer->init(s.get(), *mixer());
         if (!ret) {
             return reject(ret.code(), ret.text());
         }
 
-        return resolve(ret);
+        m_offlineRenderers[sequenceId] = renderer;
+
+        msecs_t totalDuration = s->player()->duration();
+        Progress progress = saveSoundTrackProgress(sequenceId);
+
+        renderer->start(destination, format, totalDuration, progress, [this, sequenceId, resolve, reject](const Ret& result) {
+            Async::call(this, [this, sequenceId, resolve, reject, result]() {
+                m_offlineRenderers.erase(sequenceId);
+
+                if (!result) {
+                    (void)reject(result.code(), result.text());
+                } else {
+                    (void)resolve(true);
+                }
+            }, AudioThread::ID);
+        });
+
+        return Promise<bool>::Result::unchecked();
 #else
         return reject(static_cast<int>(Err::DisabledAudioExport), "audio export is disabled");
 #endif
@@ -230,9 +314,11 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
 void AudioOutputHandler::abortSavingAllSoundTracks()
 {
 #ifdef MUSE_MODULE_AUDIO_EXPORT
-    for (auto writer : m_saveSoundTracksWritersMap) {
-        writer.second->abort();
-    }
+    Async::call(this, [this]() {
+        for (auto& pair : m_offlineRenderers) {
+            pair.second->abort();
+        }
+    }, AudioThread::ID);
 #endif
 }
 
@@ -283,7 +369,64 @@ void AudioOutputHandler::ensureSeqSubscriptions(const ITrackSequencePtr s) const
         s->audioIO()->outputParamsChanged().onReceive(this, [this, sequenceId](const TrackId trackId, const AudioOutputParams& params) {
             m_outputParamsChanged.send(sequenceId, trackId, params);
         });
+
+        s->trackRemoved().onReceive(this, [this](const TrackId) {
+            m_tracksGeneration.fetch_add(1, std::memory_order_acq_rel);
+        });
+    }
+}
+
+void AudioOutputHandler::connectParamQueue()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (!mixer()) {
+        return;
     }
+
+    mixer()->setParamQueue(m_paramQueue);
+    m_paramQueueConnected.store(true, std::memory_order_release);
+}
+
+void AudioOutputHandler::applyPendingParamCommands()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    //! NOTE The commands pushed before a full update must not be applied after it
+    if (m_paramQueueConnected.load(std::memory_order_acquire) && mixer()) {
+        mixer()->applyParamCommands();
+    }
+}
+
+bool AudioOutputHandler::sendParamCommands(const AudioOutputParams* lastSentParams, const AudioOutputParams& params, bool master,
+                                           TrackId trackId)
+{
+    //! NOTE The queue has a single producer, the main thread.
+    //! While a full update is on its way, the commands could overtake it and then be overwritten by it
+    if (!lastSentParams
+        || !AudioSanitizer::isMainThread()
+        || !m_paramQueueConnected.load(std::memory_order_acquire)
+        || m_pendingFullParamUpdates.load(std::memory_order_acquire) > 0) {
+        return false;
+    }
+
+    m_paramCommands.clear();
+
+    if (!makeMixerParamCommands(*lastSentParams, params, m_paramCommands) || m_paramCommands.empty()) {
+        return false;
+    }
+
+    if (m_paramQueue->freeSpace() < m_paramCommands.size()) {
+        return false;
+    }
+
+    for (MixerParamCommand& command : m_paramCommands) {
+        command.master = master;
+        command.trackId = trackId;
+        m_paramQueue->push(command);
+    }
+
+    return true;
 }
 
 void AudioOutputHandler::ensureMixerSubscriptions() const
@@ -23,6 +23,10 @@
 #ifndef MUSE_AUDIO_AUDIOIOHANDLER_H
 #define MUSE_AUDIO_AUDIOIOHANDLER_H
 
+#include <atomic>
+#include <map>
+#include <optional>
+
 #include "global/modularity/ioc.h"
 #include "global/async/asyncable.h"
 
@@ -30,13 +34,14 @@
 #include "iaudiooutput.h"
 #include "igettracksequence.h"
 #include "iaudioengine.h"
+#include "mixerparamcommand.h"
 
 namespace muse::audio {
 class Mixer;
 
 namespace soundtrack {
-class SoundTrackWriter;
-using SoundTrackWriterPtr = std::shared_ptr<SoundTrackWriter>;
+class OfflineRenderer;
+using OfflineRendererPtr = std::shared_ptr<OfflineRenderer>;
 }
 
 class AudioOutputHandler : public IAudioOutput, public Injectable, public async::Asyncable
@@ -58,8 +63,11 @@ public:
 
     async::Promise<AudioResourceMetaList> availableOutputResources() const override;
 
-    async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const override;
-    async::Promise<AudioSignalChanges> masterSignalChanges() const override;
+    async::Promise<AudioMeterPtr> audioMeter(const TrackSequenceId sequenceId, const TrackId trackId) const override;
+    async::Promise<AudioMeterPtr> masterAudioMeter() const override;
+
+    void setLoudnessAnalysisEnabled(const TrackSequenceId sequenceId, const TrackId trackId, bool enabled) override;
+    void setMasterLoudnessAnalysisEnabled(bool enabled) override;
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
@@ -74,14 +82,31 @@ private:
     ITrackSequencePtr sequence(const TrackSequenceId id) const;
     void ensureSeqSubscriptions(const ITrackSequencePtr s) const;
     void ensureMixerSubscriptions() const;
+    void connectParamQueue();
+    void applyPendingParamCommands();
+
+    //! NOTE Main thread: pushes the difference from the last sent params as real-time commands.
+    //! Returns false if the params have to be applied on the worker as a whole
+    bool sendParamCommands(const AudioOutputParams* lastSentParams, const AudioOutputParams& params, bool master, TrackId trackId);
 
     IGetTrackSequence* m_getSequence = nullptr;
 
+    MixerParamQueuePtr m_paramQueue;
+    std::atomic<bool> m_paramQueueConnected = false;
+    std::atomic<int> m_pendingFullParamUpdates = 0; // sent to the worker, but not applied yet
+    mutable std::atomic<uint64_t> m_tracksGeneration = 0; // changes when a track is removed
+
+    // main thread
+    std::map<std::pair<TrackSequenceId, TrackId>, AudioOutputParams> m_lastSentOutputParams;
+    std::optional<AudioOutputParams> m_lastSentMasterOutputParams;
+    uint64_t m_lastSentTracksGeneration = 0;
+    std::vector<MixerParamCommand> m_paramCommands;
+
     mutable async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     mutable async::Channel<TrackSequenceId, TrackId, AudioOutputParams> m_outputParamsChanged;
 
     std::unordered_map<TrackSequenceId, Progress> m_saveSoundTracksProgressMap;
-    std::unordered_map<TrackSequenceId, soundtrack::SoundTrackWriterPtr> m_saveSoundTracksWritersMap;
+    std::unordered_map<TrackSequenceId, soundtrack::OfflineRendererPtr> m_offlineRenderers;
 };
 }
 
@@ -20,52 +20,52 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "audiostream.h"
+
+#include <algorithm>
+
 #include "log.h"
 
-#define DR_WAV_IMPLEMENTATION
-#define DR_MP3_IMPLEMENTATION
-#define DR_MP3_FLOAT_OUTPUT
-#include "thirdparty/dr_libs/dr_wav.h"
-#include "thirdparty/dr_libs/dr_mp3.h"
-
-/* open if you want to add flac
-#define DR_FLAC_IMPLEMENTATION
-#include "thirdparty/dr_libs/dr_flac.h"
-*/
-
-#if (defined (_MSCVER) || defined (_MSC_VER))
-#pragma warning(push)
-#pragma warning(disable: 4456) // declaration hides previous local declaration
-#endif
-#include "thirdparty/stb/stb_vorbis.c"
-#if (defined (_MSCVER) || defined (_MSC_VER))
-#pragma warning(pop)
-#endif
+#include "../mappedfile.h"
+#include "audiofiledecoder.h"
 
 using namespace muse::audio;
 
+static constexpr samples_t RESAMPLING_BLOCK_FRAMES = 512;
+
 AudioStream::AudioStream()
-    : m_src(m_data, 0, 1, 1)
 {
 }
 
 bool AudioStream::loadFile(const io::path_t& path)
 {
-    bool loaded = loadWAV(path) || loadMP3(path) || loadOGG(path);
-    if (loaded) {
-        m_src.setChannelCount(m_channels);
-        m_src.setSampleRateIn(m_sampleRate);
+    m_resampler.reset();
+
+    //! NOTE The file is mapped only while it is decoded, the samples are kept in memory
+    MappedFilePtr file = MappedFile::open(path.toStdString());
+    if (!file) {
+        return false;
     }
-    return loaded;
+
+    return loadFromMemory(file->data(), file->size());
 }
 
 void AudioStream::convertSampleRate(unsigned int sampleRate)
 {
-    if (sampleRate != m_sampleRate) {
-        auto src = new SampleRateConvertor(m_data, m_channels, m_sampleRate, sampleRate);
-        m_data = src->convert();
-        m_sampleRate = sampleRate;
+    if (sampleRate == m_sampleRate) {
+        return;
     }
+
+    //! NOTE The full source is converted once, so the best quality is affordable here
+    m_resampler = std::make_unique<dsp::PolyphaseResampler>(m_sampleRate, sampleRate, m_channels,
+                                                            dsp::PolyphaseResampler::Quality::High, RESAMPLING_BLOCK_FRAMES);
+
+    const uint64_t frames = resampledFramesCount(sampleRate);
+    std::vector<float> data(frames * m_channels);
+    copyResampledToBuffer(data.data(), 0, static_cast<unsigned int>(frames), sampleRate);
+
+    m_data = std::move(data);
+    m_sampleRate = sampleRate;
+    m_resampler.reset();
 }
 
 unsigned int AudioStream::channelsCount() const
@@ -81,9 +81,7 @@ unsigned int AudioStream::sampleRate() const
 unsigned int AudioStream::copySamplesToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount, unsigned int sampleRate)
 {
     if (m_sampleRate != sampleRate) {
-        m_src.setSampleRateOut(sampleRate);
-
-        return m_src.convert(buffer, fromSample, sampleCount);
+        return copyResampledToBuffer(buffer, fromSample, sampleCount, sampleRate);
     }
 
     auto from = fromSample * m_channels;
@@ -105,84 +103,113 @@ unsigned int AudioStream::copySamplesToBuffer(float* buffer, unsigned int fromSa
     return count / m_channels;
 }
 
-bool AudioStream::loadWAV(io::path_t path)
+uint64_t AudioStream::framesCount() const
 {
-    drwav wav;
-    if (!drwav_init_file(&wav, path.c_str(), NULL)) {
-        return false;
+    return m_data.size() / m_channels;
+}
+
+uint64_t AudioStream::resampledFramesCount(unsigned int sampleRate) const
+{
+    return framesCount() * sampleRate / m_sampleRate;
+}
+
+unsigned int AudioStream::copyResampledToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount, unsigned int sampleRate)
+{
+    if (!m_resampler || m_resampler->sampleRateOut() != sampleRate || m_resampledPosition != fromSample) {
+        seekResampler(fromSample, sampleRate);
     }
 
-    m_channels = wav.channels;
-    m_sampleRate = wav.sampleRate;
+    const uint64_t totalFrames = resampledFramesCount(sampleRate);
+    unsigned int copiedFrames = 0;
 
-    m_data.resize(wav.totalPCMFrameCount * wav.channels);
-    drwav_read_pcm_frames_f32(&wav, wav.totalPCMFrameCount, m_data.data());
+    while (copiedFrames < sampleCount && m_resampledPosition < totalFrames) {
+        if (m_resampledBegin == m_resampledEnd) {
+            resampleNextBlock();
+            continue;
+        }
 
-    drwav_uninit(&wav);
+        const samples_t frames = static_cast<samples_t>(std::min<uint64_t>({ sampleCount - copiedFrames,
+                                                                             m_resampledEnd - m_resampledBegin,
+                                                                             totalFrames - m_resampledPosition }));
 
-    return true;
+        std::copy_n(m_resampledData.data() + m_resampledBegin * m_channels, frames * m_channels, buffer + copiedFrames * m_channels);
+
+        copiedFrames += frames;
+        m_resampledBegin += frames;
+        m_resampledPosition += frames;
+    }
+
+    return copiedFrames;
 }
 
-bool AudioStream::loadMP3(io::path_t path)
+void AudioStream::seekResampler(unsigned int fromSample, unsigned int sampleRate)
 {
-    drmp3 mp3;
-
-    if (!drmp3_init_file(&mp3, path.c_str(), NULL)) {
-        return false;
+    if (!m_resampler || m_resampler->sampleRateIn() != m_sampleRate || m_resampler->sampleRateOut() != sampleRate
+        || m_resampler->audioChannelsCount() != m_channels) {
+        m_resampler = std::make_unique<dsp::PolyphaseResampler>(m_sampleRate, sampleRate, m_channels,
+                                                                dsp::PolyphaseResampler::Quality::Medium, RESAMPLING_BLOCK_FRAMES);
+    } else {
+        m_resampler->reset();
     }
 
-    m_channels = mp3.channels;
-    m_sampleRate = mp3.sampleRate;
+    m_resamplerInputPosition = static_cast<uint64_t>(fromSample) * m_sampleRate / sampleRate;
 
-    auto frames = drmp3_get_pcm_frame_count(&mp3);
-    m_data.resize(frames * m_channels);
-    drmp3_read_pcm_frames_f32(&mp3, frames, m_data.data());
-    drmp3_uninit(&mp3);
+    //! NOTE Skip the delay of the filter, so that the output frames are aligned with the requested position
+    m_resamplerFramesToSkip = m_resampler->latency();
 
-    return true;
+    m_resampledBegin = 0;
+    m_resampledEnd = 0;
+    m_resampledPosition = fromSample;
 }
 
-bool AudioStream::loadMP3FromMemory(const void* pData, size_t dataSize)
+void AudioStream::resampleNextBlock()
 {
-    drmp3 mp3;
-
-    if (!drmp3_init_memory(&mp3, pData, dataSize, NULL)) {
-        return false;
+    const uint64_t inputFrames = framesCount();
+
+    const float* input = nullptr;
+    samples_t frames = RESAMPLING_BLOCK_FRAMES;
+
+    if (m_resamplerInputPosition < inputFrames) {
+        frames = static_cast<samples_t>(std::min<uint64_t>(frames, inputFrames - m_resamplerInputPosition));
+        input = m_data.data() + m_resamplerInputPosition * m_channels;
+    } else {
+        //! NOTE Flush the tail of the filter with silence
+        m_silence.resize(RESAMPLING_BLOCK_FRAMES * m_channels, 0.f);
+        input = m_silence.data();
     }
 
-    m_channels = mp3.channels;
-    m_sampleRate = mp3.sampleRate;
+    m_resamplerInputPosition += frames;
 
-    auto frames = drmp3_get_pcm_frame_count(&mp3);
-    m_data.resize(frames * m_channels);
-    drmp3_read_pcm_frames_f32(&mp3, frames, m_data.data());
-    drmp3_uninit(&mp3);
+    m_resampledData.resize(m_resampler->maxOutputFrames(frames) * m_channels);
+    const samples_t writtenFrames = m_resampler->process(input, frames, m_resampledData.data());
 
-    return true;
+    const samples_t skippedFrames = std::min(writtenFrames, m_resamplerFramesToSkip);
+    m_resamplerFramesToSkip -= skippedFrames;
+
+    m_resampledBegin = skippedFrames;
+    m_resampledEnd = writtenFrames;
 }
 
-bool AudioStream::loadOGG(io::path_t path)
+bool AudioStream::loadMP3FromMemory(const void* pData, size_t dataSize)
 {
-    int vorbis_error;
-    stb_vorbis* vorbisData = stb_vorbis_open_filename(path.c_str(), &vorbis_error, NULL);
+    m_resampler.reset();
+
+    return loadFromMemory(static_cast<const uint8_t*>(pData), dataSize);
+}
 
-    if (!vorbisData) {
+bool AudioStream::loadFromMemory(const uint8_t* data, size_t size)
+{
+    AudioFileDecoder decoder;
+    if (!decoder.open(data, size)) {
         return false;
     }
 
-    float predata[1000];
-    int total = 0;
-    m_channels = vorbisData->channels;
-    m_sampleRate = vorbisData->sample_rate;
-
-    while (auto readed = stb_vorbis_get_samples_float_interleaved(vorbisData, m_channels, predata, 1000)) {
-        m_data.resize(total + readed, 0.f);
-        auto start = m_data.begin() + total;
-        std::copy_n(predata, readed, start);
+    m_channels = decoder.audioChannelsCount();
+    m_sampleRate = static_cast<unsigned int>(decoder.sampleRate());
 
-        total += readed;
-    }
+    m_data.resize(decoder.framesCount() * m_channels);
+    const samples_t frames = decoder.read(m_data.data(), decoder.framesCount());
+    m_data.resize(frames * m_channels);
 
-    stb_vorbis_close(vorbisData);
     return true;
 }
@@ -22,10 +22,11 @@
 #ifndef MUSE_AUDIO_AUDIOSTREAM_H
 #define MUSE_AUDIO_AUDIOSTREAM_H
 
+#include <memory>
 #include <vector>
 
 #include "iaudiostream.h"
-#include "samplerateconvertor.h"
+#include "../dsp/polyphaseresampler.h"
 
 namespace muse::audio {
 class AudioStream : public IAudioStream
@@ -50,14 +51,27 @@ public:
     unsigned int copySamplesToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount, unsigned int sampleRate) override;
 
 private:
-    bool loadWAV(io::path_t path);
-    bool loadMP3(io::path_t path);
-    bool loadOGG(io::path_t path);
+    bool loadFromMemory(const uint8_t* data, size_t size);
+
+    uint64_t framesCount() const;
+    uint64_t resampledFramesCount(unsigned int sampleRate) const;
+
+    unsigned int copyResampledToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount, unsigned int sampleRate);
+    void seekResampler(unsigned int fromSample, unsigned int sampleRate);
+    void resampleNextBlock();
 
     unsigned int m_channels = 1;
     unsigned int m_sampleRate = 1;
     std::vector<float> m_data = {};
-    SampleRateConvertor m_src;
+
+    std::unique_ptr<dsp::PolyphaseResampler> m_resampler;
+    std::vector<float> m_resampledData;
+    std::vector<float> m_silence;
+    samples_t m_resampledBegin = 0;
+    samples_t m_resampledEnd = 0;
+    uint64_t m_resampledPosition = 0; // the output frame at m_resampledBegin
+    uint64_t m_resamplerInputPosition = 0;
+    samples_t m_resamplerFramesToSkip = 0;
 };
 }
 
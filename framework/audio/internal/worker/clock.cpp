@@ -69,6 +69,11 @@ void Clock::forward(const msecs_t nextMsecs)
     setCurrentTime(newTime);
 }
 
+void Clock::setOutputLatency(const msecs_t latency)
+{
+    m_outputLatency = latency;
+}
+
 void Clock::setCurrentTime(msecs_t time)
 {
     if (m_currentTime == time) {
@@ -76,7 +81,17 @@ void Clock::setCurrentTime(msecs_t time)
     }
 
     m_currentTime = time;
-    m_timeChangedInSecs.send(microsecsToSecs(m_currentTime));
+    m_timeChangedInSecs.send(microsecsToSecs(audibleTime()));
+}
+
+msecs_t Clock::audibleTime() const
+{
+    //! NOTE Right after a seek the output is still being delayed, the position stays at the seek target meanwhile
+    if (m_currentTime < m_seekTime + m_outputLatency) {
+        return m_seekTime;
+    }
+
+    return m_currentTime - m_outputLatency;
 }
 
 void Clock::start()
@@ -115,6 +130,7 @@ void Clock::seek(const msecs_t msecs)
         return;
     }
 
+    m_seekTime = msecs;
     setCurrentTime(msecs);
     m_seekOccurred.notify();
 }
@@ -34,6 +34,7 @@ public:
     Clock();
 
     void forward(const msecs_t nextMsecs) override;
+    void setOutputLatency(const msecs_t latency) override;
 
     void start() override;
     void reset() override;
@@ -60,6 +61,7 @@ public:
 
 private:
     void setCurrentTime(msecs_t time);
+    msecs_t audibleTime() const;
 
     ValCh<PlaybackStatus> m_status;
     msecs_t m_currentTime = 0;
@@ -67,6 +69,8 @@ private:
     msecs_t m_timeLoopStart = 0;
     msecs_t m_timeLoopEnd = 0;
     msecs_t m_countDown = 0;
+    msecs_t m_outputLatency = 0;
+    msecs_t m_seekTime = 0;
 
     async::Channel<secs_t> m_timeChangedInSecs;
     async::Notification m_seekOccurred;
@@ -104,11 +104,7 @@ async::Channel<unsigned int> EventAudioSource::audioChannelsCountChanged() const
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    IF_ASSERT_FAILED(m_synth) {
-        return {};
-    }
-
-    return m_synth->audioChannelsCountChanged();
+    return m_audioChannelsCountChanged;
 }
 
 samples_t EventAudioSource::process(float* buffer, samples_t samplesPerChannel)
@@ -122,6 +118,27 @@ samples_t EventAudioSource::process(float* buffer, samples_t samplesPerChannel)
     return m_synth->process(buffer, samplesPerChannel);
 }
 
+bool EventAudioSource::isReady() const
+{
+    return !m_synth || m_synth->isReady();
+}
+
+bool EventAudioSource::supportsPlanarProcessing() const
+{
+    return m_synth && m_synth->supportsPlanarProcessing();
+}
+
+samples_t EventAudioSource::processPlanar(float* const* buffers, samples_t samplesPerChannel)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (!m_synth) {
+        return 0;
+    }
+
+    return m_synth->processPlanar(buffers, samplesPerChannel);
+}
+
 void EventAudioSource::seek(const msecs_t newPositionMsecs)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -161,6 +178,7 @@ void EventAudioSource::applyInputParams(const AudioInputParams& requiredParams)
     }
 
     SynthCtx ctx = currentSynthCtx();
+    const unsigned int oldAudioChannelsCount = audioChannelsCount();
 
     if (m_synth) {
         m_playbackData = m_synth->playbackData();
@@ -180,6 +198,14 @@ void EventAudioSource::applyInputParams(const AudioInputParams& requiredParams)
         m_paramsChanges.send(params);
     });
 
+    m_synth->audioChannelsCountChanged().onReceive(this, [this](unsigned int count) {
+        m_audioChannelsCountChanged.send(count);
+    });
+
+    if (m_fixedRenderMode) {
+        m_synth->setFixedRenderMode(m_fixedRenderMode.value());
+    }
+
     setupSource();
 
     if (ctx.isValid()) {
@@ -190,6 +216,11 @@ void EventAudioSource::applyInputParams(const AudioInputParams& requiredParams)
 
     m_params = m_synth->params();
     m_paramsChanges.send(m_params);
+
+    //! NOTE The subscribers keep this channel, whichever synth is behind it
+    if (audioChannelsCount() != oldAudioChannelsCount) {
+        m_audioChannelsCountChanged.send(audioChannelsCount());
+    }
 }
 
 async::Channel<AudioInputParams> EventAudioSource::inputParamsChanged() const
@@ -197,6 +228,28 @@ async::Channel<AudioInputParams> EventAudioSource::inputParamsChanged() const
     return m_paramsChanges;
 }
 
+const mpe::PlaybackData& EventAudioSource::playbackData() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_synth) {
+        return m_synth->playbackData();
+    }
+
+    return m_playbackData;
+}
+
+void EventAudioSource::setFixedRenderMode(const RenderMode mode)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_fixedRenderMode = mode;
+
+    if (m_synth) {
+        m_synth->setFixedRenderMode(mode);
+    }
+}
+
 EventAudioSource::SynthCtx EventAudioSource::currentSynthCtx() const
 {
     if (!m_synth) {
@@ -23,6 +23,8 @@
 #ifndef MUSE_AUDIO_EVENTAUDIOSOURCE_H
 #define MUSE_AUDIO_EVENTAUDIOSOURCE_H
 
+#include <optional>
+
 #include "global/async/asyncable.h"
 #include "global/modularity/ioc.h"
 #include "mpe/events.h"
@@ -51,6 +53,9 @@ public:
     unsigned int audioChannelsCount() const override;
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
+    bool isReady() const override;
+    bool supportsPlanarProcessing() const override;
+    samples_t processPlanar(float* const* buffers, samples_t samplesPerChannel) override;
 
     void seek(const msecs_t newPositionMsecs) override;
     void flush() override;
@@ -59,6 +64,11 @@ public:
     void applyInputParams(const AudioInputParams& requiredParams) override;
     async::Channel<AudioInputParams> inputParamsChanged() const override;
 
+    //! NOTE The data with all the changes received so far
+    const mpe::PlaybackData& playbackData() const;
+
+    void setFixedRenderMode(const RenderMode mode);
+
 private:
     struct SynthCtx
     {
@@ -80,8 +90,10 @@ private:
     synth::ISynthesizerPtr m_synth = nullptr;
     AudioInputParams m_params;
     async::Channel<AudioInputParams> m_paramsChanges;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
 
     samples_t m_sampleRate = 0;
+    std::optional<RenderMode> m_fixedRenderMode;
 };
 
 using EventAudioSourcePtr = std::shared_ptr<EventAudioSource>;
@@ -41,6 +41,9 @@ public:
 
     virtual void forward(const msecs_t nextMsecs) = 0;
 
+    //! NOTE The rendered audio is heard this much later, timeChanged() reports the time being heard
+    virtual void setOutputLatency(const msecs_t latency) = 0;
+
     virtual void start() = 0;
     virtual void reset() = 0;
     virtual void stop() = 0;
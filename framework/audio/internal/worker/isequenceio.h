@@ -28,6 +28,7 @@
 #include "global/types/retval.h"
 
 #include "audiotypes.h"
+#include "audiometer.h"
 
 namespace muse::audio {
 class ISequenceIO
@@ -46,7 +47,8 @@ public:
     virtual async::Channel<TrackId, AudioInputParams> inputParamsChanged() const = 0;
     virtual async::Channel<TrackId, AudioOutputParams> outputParamsChanged() const = 0;
 
-    virtual AudioSignalChanges audioSignalChanges(const TrackId id) const = 0;
+    virtual AudioMeterPtr audioMeter(const TrackId id) const = 0;
+    virtual void setLoudnessAnalysisEnabled(const TrackId id, bool enabled) = 0;
 };
 
 using ISequenceIOPtr = std::shared_ptr<ISequenceIO>;
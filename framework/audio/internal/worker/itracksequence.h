@@ -29,10 +29,11 @@
 
 #include "isequenceplayer.h"
 #include "isequenceio.h"
+#include "igettracks.h"
 #include "audiotypes.h"
 
 namespace muse::audio {
-class ITrackSequence
+class ITrackSequence : public IGetTracks
 {
 public:
     virtual ~ITrackSequence() = default;
@@ -22,9 +22,11 @@
 #include "mixer.h"
 
 #include "concurrency/taskscheduler.h"
+#include "concurrency/workstealingscheduler.h"
 
 #include "internal/audiosanitizer.h"
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/vectorkernels.h"
 #include "audioerrors.h"
 
 #include "log.h"
@@ -33,25 +35,72 @@ using namespace muse;
 using namespace muse::audio;
 using namespace muse::async;
 
+template<typename Scheduler>
+static std::unique_ptr<Scheduler> makeMixerScheduler(thread_pool_size_t threadCount, std::set<std::thread::id>& threadIdSet)
+{
+    std::unique_ptr<Scheduler> scheduler = std::make_unique<Scheduler>(threadCount);
+
+    if (!scheduler->setThreadsPriority(ThreadPriority::High)) {
+        LOGE() << "Unable to change audio threads priority";
+    }
+
+    //! NOTE Several mixers may exist at the same time (live playback and offline exports)
+    threadIdSet = scheduler->threadIdSet();
+    AudioSanitizer::registerWorkerThreads(threadIdSet);
+
+    return scheduler;
+}
+
 Mixer::Mixer(const modularity::ContextPtr& iocCtx)
     : muse::Injectable(iocCtx)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    m_taskScheduler = std::make_unique<TaskScheduler>(static_cast<thread_pool_size_t>(configuration()->desiredAudioThreadNumber()));
+    init();
 
-    if (!m_taskScheduler->setThreadsPriority(ThreadPriority::High)) {
-        LOGE() << "Unable to change audio threads priority";
-    }
+    configuration()->samplesToPreallocateChanged().onReceive(this, [this](samples_t samplesPerChannel) {
+        allocateTrackBuffers(samplesPerChannel);
+    });
 
-    AudioSanitizer::setMixerThreads(m_taskScheduler->threadIdSet());
+    setMasterLimiterEnabled(configuration()->masterLimiterEnabled());
+    configuration()->masterLimiterEnabledChanged().onReceive(this, [this](bool enabled) {
+        setMasterLimiterEnabled(enabled);
+    });
+}
 
-    m_minTrackCountForMultithreading = configuration()->minTrackCountForMultithreading();
+Mixer::Mixer(const modularity::ContextPtr& iocCtx, const OfflineParams& offlineParams)
+    : muse::Injectable(iocCtx), m_offlineParams(offlineParams)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    //! NOTE The buffers grow in process() if the export block is larger
+    init();
 }
 
 Mixer::~Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
+
+    AudioSanitizer::unregisterWorkerThreads(m_threadIdSet);
+}
+
+void Mixer::init()
+{
+    thread_pool_size_t threadCount = static_cast<thread_pool_size_t>(configuration()->desiredAudioThreadNumber());
+
+    switch (configuration()->audioThreadPoolType()) {
+    case AudioThreadPoolType::TaskQueue:
+        m_taskScheduler = makeMixerScheduler<TaskScheduler>(threadCount, m_threadIdSet);
+        break;
+    case AudioThreadPoolType::WorkStealing:
+        m_workStealingScheduler = makeMixerScheduler<WorkStealingScheduler>(threadCount, m_threadIdSet);
+        break;
+    }
+
+    m_minTrackCountForMultithreading = configuration()->minTrackCountForMultithreading();
+    m_masterTiming.type = NodeTiming::Type::Master;
+
+    m_trackBufferCapacity = configuration()->samplesToPreallocate();
 }
 
 IAudioSourcePtr Mixer::mixedSource()
@@ -103,9 +152,14 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, ITrackAudioInpu
         }
     });
 
-    m_trackChannels.emplace(trackId, channel);
+    TrackChannelInfo info;
+    info.channel = channel;
+    info.timing.trackId = trackId;
 
-    result.val = m_trackChannels[trackId];
+    m_trackChannels.emplace(trackId, std::move(info));
+    allocateTrackBuffers(m_trackBufferCapacity);
+
+    result.val = m_trackChannels.at(trackId).channel;
     result.ret = make_ret(Ret::Code::Ok);
 
     return result;
@@ -123,8 +177,10 @@ RetVal<MixerChannelPtr> Mixer::addAuxChannel(const TrackId trackId)
     AuxChannelInfo aux;
     aux.channel = channel;
     aux.buffer = std::vector<float>(samplesToPreallocate * audioChannelsCount, 0.f);
+    aux.timing.type = NodeTiming::Type::Aux;
 
     m_auxChannelInfoList.emplace_back(std::move(aux));
+    reserveGraphStorage();
 
     RetVal<MixerChannelPtr> result;
     result.val = channel;
@@ -139,12 +195,14 @@ Ret Mixer::removeChannel(const TrackId trackId)
 
     auto search = m_trackChannels.find(trackId);
 
-    if (search != m_trackChannels.end() && search->second) {
+    if (search != m_trackChannels.end() && search->second.channel) {
         if (m_nonMutedTrackCount != 0) {
             m_nonMutedTrackCount--;
         }
 
         m_trackChannels.erase(trackId);
+        allocateTrackBuffers(m_trackBufferCapacity);
+
         return make_ret(Ret::Code::Ok);
     }
 
@@ -155,23 +213,51 @@ Ret Mixer::removeChannel(const TrackId trackId)
     return removed ? make_ret(Ret::Code::Ok) : make_ret(Err::InvalidTrackId);
 }
 
+std::vector<AudioOutputParams> Mixer::auxChannelsOutputParams() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    std::vector<AudioOutputParams> result;
+    result.reserve(m_auxChannelInfoList.size());
+
+    for (const AuxChannelInfo& aux : m_auxChannelInfoList) {
+        result.push_back(aux.channel->outputParams());
+    }
+
+    return result;
+}
+
 void Mixer::setAudioChannelsCount(const audioch_t count)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
     m_audioChannelsCount = count;
+    allocateTrackBuffers(m_trackBufferCapacity);
+
+    if (m_limiter) {
+        createLimiter(m_limiter->sampleRate());
+    }
+
+    if (m_loudnessMeter) {
+        setMasterLoudnessAnalysisEnabled(true);
+    }
 }
 
 void Mixer::setSampleRate(unsigned int sampleRate)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    m_limiter = std::make_unique<dsp::Limiter>(sampleRate);
+    createLimiter(sampleRate);
+    m_audioMeter->setSampleRate(sampleRate);
+
+    if (m_loudnessMeter) {
+        setMasterLoudnessAnalysisEnabled(true);
+    }
 
     AbstractAudioSource::setSampleRate(sampleRate);
 
-    for (auto& channel : m_trackChannels) {
-        channel.second->setSampleRate(sampleRate);
+    for (auto& pair : m_trackChannels) {
+        pair.second.channel->setSampleRate(sampleRate);
     }
 
     for (AuxChannelInfo& aux : m_auxChannelInfoList) {
@@ -190,10 +276,37 @@ unsigned int Mixer::audioChannelsCount() const
     return m_audioChannelsCount;
 }
 
+bool Mixer::isReady() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    for (const auto& pair : m_trackChannels) {
+        if (!pair.second.channel->isReady()) {
+            return false;
+        }
+    }
+
+    for (const AuxChannelInfo& aux : m_auxChannelInfoList) {
+        if (!aux.channel->isReady()) {
+            return false;
+        }
+    }
+
+    for (const IFxProcessorPtr& fx : m_masterFxProcessors) {
+        if (!fx->isReady()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    applyParamCommands();
+
     for (const IClockPtr& clock : m_clocks) {
         clock->forward((samplesPerChannel * 1000000) / m_sampleRate);
     }
@@ -202,39 +315,42 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     std::fill(outBuffer, outBuffer + outBufferSize, 0.f);
 
     if (m_isIdle && m_tracksToProcessWhenIdle.empty() && m_isSilence) {
-        notifyNoAudioSignal();
+        resetAudioMeter();
+        analyseLoudness(outBuffer, samplesPerChannel);
         return 0;
     }
 
-    TracksData tracksData;
-    processTrackChannels(outBufferSize, samplesPerChannel, tracksData);
+    m_blockStartTime = std::chrono::steady_clock::now();
+
+    processTrackChannels(outBufferSize, samplesPerChannel);
 
-    prepareAuxBuffers(outBufferSize);
+    m_masterTiming.startNs = nanosecondsSinceBlockStart();
+    updateVoiceBudget(samplesPerChannel);
 
-    for (auto& pair : tracksData) {
-        auto channelIt = m_trackChannels.find(pair.first);
-        if (channelIt == m_trackChannels.cend()) {
+    for (const auto& pair : m_trackChannels) {
+        const TrackChannelInfo& info = pair.second;
+        if (!info.processed) {
             continue;
         }
 
-        const MixerChannelPtr& channel = channelIt->second;
+        const MixerChannelPtr& channel = info.channel;
         if (!channel->isSilent()) {
             m_isSilence = false;
         } else if (m_isSilence) {
             continue;
         }
 
-        const std::vector<float>& trackBuffer = pair.second;
-        mixOutputFromChannel(outBuffer, trackBuffer.data(), samplesPerChannel);
-        writeTrackToAuxBuffers(trackBuffer.data(), channel->outputParams().auxSends, samplesPerChannel);
+        mixOutputFromChannel(outBuffer, info.buffer, samplesPerChannel);
     }
 
     if (m_masterParams.muted || samplesPerChannel == 0 || m_isSilence) {
-        notifyNoAudioSignal();
+        m_masterTiming.endNs = nanosecondsSinceBlockStart();
+        resetAudioMeter();
+        analyseLoudness(outBuffer, samplesPerChannel);
         return 0;
     }
 
-    processAuxChannels(outBuffer, samplesPerChannel);
+    mixAuxChannels(outBuffer, samplesPerChannel);
     completeOutput(outBuffer, samplesPerChannel);
 
     for (IFxProcessorPtr& fxProcessor : m_masterFxProcessors) {
@@ -243,67 +359,136 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
         }
     }
 
+    //! NOTE The limiter goes after the master fx, so nothing can push the output over its ceiling
+    if (m_limiter && m_limiter->isActive()) {
+        m_limiter->process(outBuffer, samplesPerChannel);
+    }
+
+    analyseLoudness(outBuffer, samplesPerChannel);
+
+    m_masterTiming.endNs = nanosecondsSinceBlockStart();
+
     return samplesPerChannel;
 }
 
-void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData)
+void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel)
 {
-    auto processChannel = [outBufferSize, samplesPerChannel](MixerChannelPtr channel) -> std::vector<float> {
-        thread_local std::vector<float> buffer(outBufferSize, 0.f);
-        thread_local std::vector<float> silent_buffer(outBufferSize, 0.f);
+    if (samplesPerChannel > m_trackBufferCapacity) {
+        LOGW() << "Render step " << samplesPerChannel << " exceeds the preallocated track buffers, reallocating";
+        allocateTrackBuffers(samplesPerChannel);
+    }
+
+    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
+
+    m_tracksToProcess.clear();
 
-        if (buffer.size() < outBufferSize) {
-            buffer.resize(outBufferSize, 0.f);
-            silent_buffer.resize(outBufferSize, 0.f);
+    for (auto& pair : m_trackChannels) {
+        TrackChannelInfo& info = pair.second;
+        info.processed = false;
+
+        if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.first)) {
+            continue;
         }
 
-        buffer = silent_buffer;
+        if (info.channel->muted() && info.channel->isSilent()) {
+            info.channel->resetAudioMeter();
+            continue;
+        }
 
-        if (channel) {
-            channel->process(buffer.data(), samplesPerChannel);
+        info.processed = true;
+        m_tracksToProcess.push_back(&info);
+    }
+
+    prepareAuxChannels(outBufferSize);
+
+    if (!useMultithreading()) {
+        for (TrackChannelInfo* info : m_tracksToProcess) {
+            processTrackChannel(*info, outBufferSize, samplesPerChannel);
         }
 
-        return buffer;
-    };
+        return;
+    }
 
-    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
+    if (m_workStealingScheduler) {
+        auto processTask = [this, outBufferSize, samplesPerChannel](size_t index) {
+            processTrackChannel(*m_tracksToProcess[index], outBufferSize, samplesPerChannel);
+        };
 
-    if (useMultithreading()) {
-        std::map<TrackId, std::future<std::vector<float> > > futures;
+        m_workStealingScheduler->parallelFor(m_tracksToProcess.size(), processTask);
+        return;
+    }
 
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+    for (TrackChannelInfo* info : m_tracksToProcess) {
+        m_trackFutures.push_back(m_taskScheduler->submit([this, info, outBufferSize, samplesPerChannel]() {
+            processTrackChannel(*info, outBufferSize, samplesPerChannel);
+        }));
+    }
 
-            if (pair.second->muted() && pair.second->isSilent()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+    for (std::future<void>& future : m_trackFutures) {
+        future.get();
+    }
 
-            std::future<std::vector<float> > future = m_taskScheduler->submit(processChannel, pair.second);
-            futures.emplace(pair.first, std::move(future));
-        }
+    m_trackFutures.clear();
+}
 
-        for (auto& pair : futures) {
-            outTracksData.emplace(pair.first, pair.second.get());
-        }
-    } else {
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+void Mixer::processTrackChannel(TrackChannelInfo& info, size_t outBufferSize, size_t samplesPerChannel)
+{
+    info.timing.startNs = nanosecondsSinceBlockStart();
 
-            if (pair.second->muted() && pair.second->isSilent()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+    std::fill(info.buffer, info.buffer + outBufferSize, 0.f);
+    info.channel->process(info.buffer, samplesPerChannel);
+
+    info.timing.endNs = nanosecondsSinceBlockStart();
 
-            outTracksData.emplace(pair.first, processChannel(pair.second));
+    //! NOTE The last input to finish runs the aux bus, on the same thread.
+    //! So a bus starts as soon as its inputs are ready, and independent buses run concurrently
+    for (aux_channel_idx_t auxIdx : info.auxTargets) {
+        AuxChannelInfo& aux = m_auxChannelInfoList[auxIdx];
+
+        if (aux.pendingInputs->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            aux.lastInputTrackId = info.channel->trackId();
+            processAuxChannel(aux, samplesPerChannel);
         }
     }
 }
 
+void Mixer::allocateTrackBuffers(samples_t samplesPerChannel)
+{
+    //! NOTE Every track channel renders into its own slot of the pool,
+    //! so the pool must only be (re)allocated outside of process()
+    const size_t bufferSize = samplesPerChannel * m_audioChannelsCount;
+    const size_t poolSize = bufferSize * m_trackChannels.size();
+
+    if (m_trackBufferPool.size() != poolSize) {
+        m_trackBufferPool.assign(poolSize, 0.f);
+    }
+
+    m_trackBufferCapacity = samplesPerChannel;
+    m_tracksToProcess.reserve(m_trackChannels.size());
+    m_trackFutures.reserve(m_trackChannels.size());
+
+    float* slot = m_trackBufferPool.data();
+    for (auto& pair : m_trackChannels) {
+        pair.second.buffer = slot;
+        pair.second.channel->setMaxSamplesPerChannel(samplesPerChannel);
+        slot += bufferSize;
+    }
+
+    reserveGraphStorage();
+}
+
+void Mixer::reserveGraphStorage()
+{
+    //! NOTE The graph is rebuilt on every block, it must not allocate there
+    for (auto& pair : m_trackChannels) {
+        pair.second.auxTargets.reserve(m_auxChannelInfoList.size());
+    }
+
+    for (AuxChannelInfo& aux : m_auxChannelInfoList) {
+        aux.inputs.reserve(m_trackChannels.size());
+    }
+}
+
 bool Mixer::useMultithreading() const
 {
     if (m_nonMutedTrackCount < m_minTrackCountForMultithreading) {
@@ -325,9 +510,9 @@ void Mixer::setIsActive(bool arg)
 
     AbstractAudioSource::setIsActive(arg);
 
-    for (auto& channel : m_trackChannels) {
-        if (!channel.second->muted()) {
-            channel.second->setIsActive(arg);
+    for (auto& pair : m_trackChannels) {
+        if (!pair.second.channel->muted()) {
+            pair.second.channel->setIsActive(arg);
         }
     }
 
@@ -342,6 +527,7 @@ void Mixer::addClock(IClockPtr clock)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    clock->setOutputLatency(latencyMsecs());
     m_clocks.insert(std::move(clock));
 }
 
@@ -368,7 +554,13 @@ void Mixer::setMasterOutputParams(const AudioOutputParams& params)
     }
 
     m_masterFxProcessors.clear();
-    m_masterFxProcessors = fxResolver()->resolveMasterFxList(params.fxChain);
+
+    if (m_offlineParams) {
+        //! NOTE The master fx instances of the live mixer can't be shared with an offline one
+        m_masterFxProcessors = fxResolver()->resolveFxList(m_offlineParams->masterFxTrackId, params.fxChain);
+    } else {
+        m_masterFxProcessors = fxResolver()->resolveMasterFxList(params.fxChain);
+    }
 
     for (IFxProcessorPtr& fx : m_masterFxProcessors) {
         fx->setSampleRate(m_sampleRate);
@@ -417,9 +609,182 @@ Channel<AudioOutputParams> Mixer::masterOutputParamsChanged() const
     return m_masterOutputParamsChanged;
 }
 
-AudioSignalChanges Mixer::masterAudioSignalChanges() const
+AudioMeterPtr Mixer::masterAudioMeter() const
 {
-    return m_audioSignalNotifier.audioSignalChanges;
+    return m_audioMeter;
+}
+
+void Mixer::setMasterLoudnessAnalysisEnabled(bool enabled)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (enabled) {
+        m_loudnessMeter = std::make_unique<dsp::LoudnessMeter>(m_sampleRate, m_audioChannelsCount);
+    } else {
+        m_loudnessMeter = nullptr;
+    }
+
+    m_audioMeter->resetLoudness();
+}
+
+void Mixer::setMasterLimiterEnabled(bool enabled)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_isLimiterEnabled = enabled;
+
+    if (m_limiter) {
+        m_limiter->setIsActive(enabled);
+    }
+
+    updateClocksLatency();
+}
+
+samples_t Mixer::latency() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (!m_limiter || !m_limiter->isActive()) {
+        return 0;
+    }
+
+    return m_limiter->latency();
+}
+
+msecs_t Mixer::latencyMsecs() const
+{
+    if (!m_limiter || m_limiter->sampleRate() == 0) {
+        return 0;
+    }
+
+    return static_cast<msecs_t>(latency()) * 1000000 / m_limiter->sampleRate();
+}
+
+void Mixer::updateClocksLatency()
+{
+    const msecs_t latency = latencyMsecs();
+
+    for (const IClockPtr& clock : m_clocks) {
+        clock->setOutputLatency(latency);
+    }
+}
+
+void Mixer::createLimiter(sample_rate_t sampleRate)
+{
+    m_limiter = std::make_unique<dsp::LookAheadLimiter>(sampleRate, m_audioChannelsCount);
+    m_limiter->setIsActive(m_isLimiterEnabled);
+
+    updateClocksLatency();
+}
+
+VoiceBudgetPtr Mixer::voiceBudget() const
+{
+    return m_voiceBudget;
+}
+
+void Mixer::setParamQueue(MixerParamQueuePtr queue)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_paramQueue = std::move(queue);
+}
+
+void Mixer::applyParamCommands()
+{
+    if (!m_paramQueue) {
+        return;
+    }
+
+    MixerParamCommand command;
+
+    while (m_paramQueue->pop(command)) {
+        if (command.master) {
+            applyMasterParamCommand(command);
+            continue;
+        }
+
+        auto it = m_trackChannels.find(command.trackId);
+        if (it != m_trackChannels.end()) {
+            it->second.channel->applyParamCommand(command);
+            continue;
+        }
+
+        for (AuxChannelInfo& aux : m_auxChannelInfoList) {
+            if (aux.channel->trackId() == command.trackId) {
+                aux.channel->applyParamCommand(command);
+                break;
+            }
+        }
+    }
+}
+
+void Mixer::applyMasterParamCommand(const MixerParamCommand& command)
+{
+    if (!applyMixerParamCommand(command, m_masterParams)) {
+        return;
+    }
+
+    if (command.type != MixerParamCommand::Type::FxActive) {
+        return;
+    }
+
+    for (IFxProcessorPtr& fx : m_masterFxProcessors) {
+        if (fx->params().chainOrder == command.index) {
+            fx->setActive(command.value != 0.f);
+        }
+    }
+}
+
+Mixer::ProcessingGraphTimings Mixer::lastBlockTimings() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    ProcessingGraphTimings result;
+
+    const TrackChannelInfo* lastTrack = nullptr;
+    for (const auto& pair : m_trackChannels) {
+        const TrackChannelInfo& info = pair.second;
+        if (!info.processed) {
+            continue;
+        }
+
+        result.nodes.push_back(info.timing);
+
+        if (!lastTrack || info.timing.endNs > lastTrack->timing.endNs) {
+            lastTrack = &info;
+        }
+    }
+
+    const AuxChannelInfo* lastAux = nullptr;
+    for (const AuxChannelInfo& aux : m_auxChannelInfoList) {
+        if (!aux.receivedAudioSignal) {
+            continue;
+        }
+
+        result.nodes.push_back(aux.timing);
+
+        if (!lastAux || aux.timing.endNs > lastAux->timing.endNs) {
+            lastAux = &aux;
+        }
+    }
+
+    result.nodes.push_back(m_masterTiming);
+
+    //! NOTE The critical path goes back from the master through the inputs which finished last
+    if (lastAux && (!lastTrack || lastAux->timing.endNs >= lastTrack->timing.endNs)) {
+        auto it = m_trackChannels.find(lastAux->lastInputTrackId);
+        if (it != m_trackChannels.end()) {
+            result.criticalPath.push_back(it->second.timing);
+        }
+
+        result.criticalPath.push_back(lastAux->timing);
+    } else if (lastTrack) {
+        result.criticalPath.push_back(lastTrack->timing);
+    }
+
+    result.criticalPath.push_back(m_masterTiming);
+
+    return result;
 }
 
 void Mixer::setIsIdle(bool idle)
@@ -451,23 +816,48 @@ void Mixer::mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsign
         return;
     }
 
-    for (samples_t s = 0; s < samplesCount; ++s) {
-        size_t samplePos = s * m_audioChannelsCount;
-
-        for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-            size_t idx = samplePos + audioChNum;
-            float sample = inBuffer[idx];
-            outBuffer[idx] += sample;
-        }
-    }
+    dsp::accumulate(outBuffer, inBuffer, samplesCount * m_audioChannelsCount);
 }
 
-void Mixer::prepareAuxBuffers(size_t outBufferSize)
+void Mixer::prepareAuxChannels(size_t outBufferSize)
 {
     for (AuxChannelInfo& aux : m_auxChannelInfoList) {
         aux.receivedAudioSignal = false;
+        aux.inputs.clear();
+        aux.lastInputTrackId = -1;
+        aux.timing.trackId = aux.channel->trackId();
+        aux.timing.startNs = aux.timing.endNs = 0;
+    }
+
+    for (TrackChannelInfo* info : m_tracksToProcess) {
+        info->auxTargets.clear();
 
-        if (aux.channel->outputParams().fxChain.empty()) {
+        const AuxSendsParams& auxSends = info->channel->outputParams().auxSends;
+
+        for (aux_channel_idx_t auxIdx = 0; auxIdx < auxSends.size(); ++auxIdx) {
+            if (auxIdx >= m_auxChannelInfoList.size()) {
+                break;
+            }
+
+            AuxChannelInfo& aux = m_auxChannelInfoList.at(auxIdx);
+            if (aux.channel->outputParams().fxChain.empty()) {
+                continue;
+            }
+
+            const AuxSendParams& auxSend = auxSends.at(auxIdx);
+            if (!auxSend.active || RealIsNull(auxSend.signalAmount)) {
+                continue;
+            }
+
+            aux.inputs.push_back({ info, auxSend.signalAmount });
+            info->auxTargets.push_back(auxIdx);
+        }
+    }
+
+    for (AuxChannelInfo& aux : m_auxChannelInfoList) {
+        aux.pendingInputs->store(aux.inputs.size(), std::memory_order_relaxed);
+
+        if (aux.inputs.empty()) {
             continue;
         }
 
@@ -479,51 +869,43 @@ void Mixer::prepareAuxBuffers(size_t outBufferSize)
     }
 }
 
-void Mixer::writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParams& auxSends, samples_t samplesPerChannel)
+void Mixer::processAuxChannel(AuxChannelInfo& aux, samples_t samplesPerChannel)
 {
-    for (aux_channel_idx_t auxIdx = 0; auxIdx < auxSends.size(); ++auxIdx) {
-        if (auxIdx >= m_auxChannelInfoList.size()) {
-            break;
-        }
-
-        AuxChannelInfo& aux = m_auxChannelInfoList.at(auxIdx);
-        if (aux.channel->outputParams().fxChain.empty()) {
-            continue;
-        }
-
-        const AuxSendParams& auxSend = auxSends.at(auxIdx);
-        if (!auxSend.active || RealIsNull(auxSend.signalAmount)) {
-            continue;
-        }
+    if (m_masterParams.muted || samplesPerChannel == 0) {
+        return;
+    }
 
-        float* auxBuffer = aux.buffer.data();
-        float signalAmount = auxSend.signalAmount;
+    aux.timing.startNs = nanosecondsSinceBlockStart();
 
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            size_t samplePos = s * m_audioChannelsCount;
+    float* auxBuffer = aux.buffer.data();
+    const size_t bufferSize = samplesPerChannel * m_audioChannelsCount;
 
-            for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-                size_t idx = samplePos + audioChNum;
-                auxBuffer[idx] += trackBuffer[idx] * signalAmount;
-            }
+    for (const AuxSendInput& input : aux.inputs) {
+        //! NOTE m_isSilence is the state of the previous block here, it is only updated once all the tracks are done
+        if (input.track->channel->isSilent() && m_isSilence) {
+            continue;
         }
 
+        dsp::accumulateScaled(auxBuffer, input.track->buffer, input.signalAmount, bufferSize);
         aux.receivedAudioSignal = true;
     }
+
+    if (aux.receivedAudioSignal) {
+        aux.channel->process(auxBuffer, samplesPerChannel);
+    }
+
+    aux.timing.endNs = nanosecondsSinceBlockStart();
 }
 
-void Mixer::processAuxChannels(float* buffer, samples_t samplesPerChannel)
+void Mixer::mixAuxChannels(float* buffer, samples_t samplesPerChannel)
 {
     for (AuxChannelInfo& aux : m_auxChannelInfoList) {
         if (!aux.receivedAudioSignal) {
             continue;
         }
 
-        float* auxBuffer = aux.buffer.data();
-        aux.channel->process(auxBuffer, samplesPerChannel);
-
         if (!aux.channel->isSilent()) {
-            mixOutputFromChannel(buffer, auxBuffer, samplesPerChannel);
+            mixOutputFromChannel(buffer, aux.buffer.data(), samplesPerChannel);
         }
     }
 }
@@ -534,46 +916,69 @@ void Mixer::completeOutput(float* buffer, samples_t samplesPerChannel)
         return;
     }
 
-    float totalSquaredSum = 0.f;
+    if (m_channelGains.size() != m_audioChannelsCount) {
+        m_channelGains.resize(m_audioChannelsCount);
+        m_channelSquaredSums.resize(m_audioChannelsCount);
+        m_channelPeaks.resize(m_audioChannelsCount);
+        m_audioMeter->setChannelsCount(m_audioChannelsCount);
+    }
+
     float volume = muse::db_to_linear(m_masterParams.volume);
 
     for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
-        gain_t totalGain = dsp::balanceGain(m_masterParams.balance, audioChNum) * volume;
+        m_channelGains[audioChNum] = dsp::balanceGain(m_masterParams.balance, audioChNum) * volume;
+    }
 
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            int idx = s * m_audioChannelsCount + audioChNum;
+    dsp::applyGains(buffer, samplesPerChannel, m_audioChannelsCount, m_channelGains.data(), m_channelSquaredSums.data());
+    dsp::samplesPeaks(buffer, samplesPerChannel, m_audioChannelsCount, m_channelPeaks.data());
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    float totalSquaredSum = 0.f;
 
-            float squaredSample = resultSample * resultSample;
-            totalSquaredSum += squaredSample;
-            singleChannelSquaredSum += squaredSample;
-        }
+    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
+        float singleChannelSquaredSum = m_channelSquaredSums[audioChNum];
+        totalSquaredSum += singleChannelSquaredSum;
 
         float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesPerChannel);
-        m_audioSignalNotifier.updateSignalValues(audioChNum, rms);
+        m_audioMeter->update(audioChNum, m_channelPeaks[audioChNum], rms, samplesPerChannel);
     }
 
     m_isSilence = RealIsNull(totalSquaredSum);
-    m_audioSignalNotifier.notifyAboutChanges();
+}
+
+void Mixer::analyseLoudness(const float* buffer, samples_t samplesPerChannel)
+{
+    if (!m_loudnessMeter) {
+        return;
+    }
 
-    if (!m_limiter->isActive()) {
+    IF_ASSERT_FAILED(m_loudnessMeter->audioChannelsCount() == m_audioChannelsCount) {
         return;
     }
 
-    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesPerChannel * m_audioChannelsCount);
-    m_limiter->process(totalRms, buffer, m_audioChannelsCount, samplesPerChannel);
+    m_loudnessMeter->process(buffer, samplesPerChannel);
+    m_audioMeter->updateLoudness(m_loudnessMeter->momentaryLoudness(), m_loudnessMeter->shortTermLoudness(),
+                                 m_loudnessMeter->integratedLoudness(), m_loudnessMeter->truePeak());
 }
 
-void Mixer::notifyNoAudioSignal()
+void Mixer::updateVoiceBudget(samples_t samplesPerChannel)
 {
-    for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-        m_audioSignalNotifier.updateSignalValues(audioChNum, 0.f);
+    //! NOTE An export isn't bound to real time, its synths play all of their voices
+    if (m_offlineParams || m_sampleRate == 0 || samplesPerChannel == 0) {
+        return;
     }
 
-    m_audioSignalNotifier.notifyAboutChanges();
+    int64_t blockDurationNs = static_cast<int64_t>(samplesPerChannel) * 1000000000 / m_sampleRate;
+    m_voiceBudget->update(m_masterTiming.startNs, blockDurationNs);
+}
+
+void Mixer::resetAudioMeter()
+{
+    m_audioMeter->reset();
+}
+
+int64_t Mixer::nanosecondsSinceBlockStart() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_blockStartTime).count();
 }
 
 msecs_t Mixer::currentTime() const
@@ -24,6 +24,12 @@
 
 #include <memory>
 #include <map>
+#include <future>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <set>
+#include <thread>
 
 #include "global/modularity/ioc.h"
 #include "global/async/asyncable.h"
@@ -31,14 +37,18 @@
 
 #include "../../ifxresolver.h"
 #include "../../iaudioconfiguration.h"
-#include "../dsp/limiter.h"
+#include "../dsp/lookaheadlimiter.h"
+#include "../dsp/loudnessmeter.h"
 
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
+#include "mixerparamcommand.h"
+#include "voicebudget.h"
 #include "iclock.h"
 
 namespace muse {
 class TaskScheduler;
+class WorkStealingScheduler;
 }
 
 namespace muse::audio {
@@ -48,7 +58,36 @@ class Mixer : public AbstractAudioSource, public Injectable, public async::Async
     Inject<IAudioConfiguration> configuration = { this };
 
 public:
+    //! NOTE A block is processed as a graph: tracks -> aux buses -> master.
+    //! An aux bus starts as soon as the tracks sending to it are done
+    struct NodeTiming {
+        enum class Type {
+            Track,
+            Aux,
+            Master
+        };
+
+        Type type = Type::Track;
+        TrackId trackId = -1;
+
+        // nanoseconds since the start of the block
+        int64_t startNs = 0;
+        int64_t endNs = 0;
+    };
+
+    struct ProcessingGraphTimings {
+        std::vector<NodeTiming> nodes;
+        std::vector<NodeTiming> criticalPath; // ends with the master node
+    };
+
+    //! NOTE An offline mixer renders an export next to the live one.
+    //! It owns all of its fx and doesn't follow the buffer size of the live playback
+    struct OfflineParams {
+        TrackId masterFxTrackId = -1; // the master fx are resolved as the fx of this track
+    };
+
     Mixer(const modularity::ContextPtr& iocCtx);
+    Mixer(const modularity::ContextPtr& iocCtx, const OfflineParams& offlineParams);
     ~Mixer();
 
     IAudioSourcePtr mixedSource();
@@ -57,6 +96,8 @@ public:
     RetVal<MixerChannelPtr> addAuxChannel(const TrackId trackId);
     Ret removeChannel(const TrackId trackId);
 
+    std::vector<AudioOutputParams> auxChannelsOutputParams() const; // in the order of aux_channel_idx_t
+
     void setAudioChannelsCount(const audioch_t count);
 
     void addClock(IClockPtr clock);
@@ -67,7 +108,24 @@ public:
     void clearMasterOutputParams();
     async::Channel<AudioOutputParams> masterOutputParamsChanged() const;
 
-    AudioSignalChanges masterAudioSignalChanges() const;
+    AudioMeterPtr masterAudioMeter() const;
+
+    //! NOTE The loudness is measured after the master fx and published through the master meter
+    void setMasterLoudnessAnalysisEnabled(bool enabled);
+
+    //! NOTE The brick-wall limiter is the last stage of the master output, it delays the output by latency() frames.
+    //! The live mixer follows IAudioConfiguration::masterLimiterEnabled(), and its clocks report the delayed position
+    void setMasterLimiterEnabled(bool enabled);
+    samples_t latency() const;
+
+    //! NOTE The voice limit shared by the synths of all the tracks, adapted to the render time of every block
+    VoiceBudgetPtr voiceBudget() const;
+
+    //! NOTE The commands are applied at the start of every block, before any channel is processed
+    void setParamQueue(MixerParamQueuePtr queue);
+    void applyParamCommands();
+
+    ProcessingGraphTimings lastBlockTimings() const;
 
     void setIsIdle(bool idle);
     void setTracksToProcessWhenIdle(std::unordered_set<TrackId>&& trackIds);
@@ -78,23 +136,65 @@ public:
     samples_t process(float* outBuffer, samples_t samplesPerChannel) override;
     void setIsActive(bool arg) override;
 
+    //! NOTE Whether every channel and fx has been loaded
+    bool isReady() const override;
+
 private:
-    using TracksData = std::map<TrackId, std::vector<float> >;
+    struct TrackChannelInfo {
+        MixerChannelPtr channel;
+        float* buffer = nullptr; // a slot in m_trackBufferPool
+        bool processed = false;
+        std::vector<aux_channel_idx_t> auxTargets; // aux buses fed by this track in the current block
+        NodeTiming timing;
+    };
+
+    struct AuxSendInput {
+        const TrackChannelInfo* track = nullptr;
+        float signalAmount = 0.f;
+    };
+
+    struct AuxChannelInfo {
+        MixerChannelPtr channel;
+        std::vector<float> buffer;
+        bool receivedAudioSignal = false;
+        std::vector<AuxSendInput> inputs;
+        std::unique_ptr<std::atomic<size_t> > pendingInputs = std::make_unique<std::atomic<size_t> >(0);
+        TrackId lastInputTrackId = -1; // the input which finished last in the current block
+        NodeTiming timing;
+    };
 
-    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData);
+    void init();
+
+    void applyMasterParamCommand(const MixerParamCommand& command);
+
+    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel);
+    void processTrackChannel(TrackChannelInfo& info, size_t outBufferSize, size_t samplesPerChannel);
+    void allocateTrackBuffers(samples_t samplesPerChannel);
+    void reserveGraphStorage();
     void mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount) const;
-    void prepareAuxBuffers(size_t outBufferSize);
-    void writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParams& auxSends, samples_t samplesPerChannel);
-    void processAuxChannels(float* buffer, samples_t samplesPerChannel);
+    void prepareAuxChannels(size_t outBufferSize);
+    void processAuxChannel(AuxChannelInfo& aux, samples_t samplesPerChannel);
+    void mixAuxChannels(float* buffer, samples_t samplesPerChannel);
     void completeOutput(float* buffer, samples_t samplesPerChannel);
+    void createLimiter(sample_rate_t sampleRate);
+    msecs_t latencyMsecs() const;
+    void updateClocksLatency();
+    void analyseLoudness(const float* buffer, samples_t samplesPerChannel);
+    void updateVoiceBudget(samples_t samplesPerChannel);
+
+    int64_t nanosecondsSinceBlockStart() const;
 
     bool useMultithreading() const;
 
-    void notifyNoAudioSignal();
+    void resetAudioMeter();
 
     msecs_t currentTime() const;
 
     std::unique_ptr<TaskScheduler> m_taskScheduler;
+    std::unique_ptr<WorkStealingScheduler> m_workStealingScheduler;
+    std::set<std::thread::id> m_threadIdSet;
+
+    std::optional<OfflineParams> m_offlineParams;
 
     size_t m_minTrackCountForMultithreading = 0;
     size_t m_nonMutedTrackCount = 0;
@@ -103,23 +203,33 @@ private:
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
     std::vector<IFxProcessorPtr> m_masterFxProcessors = {};
 
-    std::map<TrackId, MixerChannelPtr> m_trackChannels = {};
-    std::unordered_set<TrackId> m_tracksToProcessWhenIdle;
+    MixerParamQueuePtr m_paramQueue;
 
-    struct AuxChannelInfo {
-        MixerChannelPtr channel;
-        std::vector<float> buffer;
-        bool receivedAudioSignal = false;
-    };
+    std::map<TrackId, TrackChannelInfo> m_trackChannels = {};
+    std::vector<float> m_trackBufferPool;
+    samples_t m_trackBufferCapacity = 0; // samples per channel
+    std::vector<TrackChannelInfo*> m_tracksToProcess;
+    std::vector<std::future<void> > m_trackFutures;
+    std::unordered_set<TrackId> m_tracksToProcessWhenIdle;
 
     std::vector<AuxChannelInfo> m_auxChannelInfoList;
 
-    dsp::LimiterPtr m_limiter = nullptr;
+    std::chrono::steady_clock::time_point m_blockStartTime;
+    NodeTiming m_masterTiming;
+
+    dsp::LookAheadLimiterPtr m_limiter = nullptr;
+    bool m_isLimiterEnabled = false;
+
+    std::vector<gain_t> m_channelGains;
+    std::vector<float> m_channelSquaredSums;
+    std::vector<float> m_channelPeaks;
 
     std::set<IClockPtr> m_clocks;
     audioch_t m_audioChannelsCount = 0;
 
-    mutable AudioSignalsNotifier m_audioSignalNotifier;
+    AudioMeterPtr m_audioMeter = std::make_shared<AudioMeter>();
+    dsp::LoudnessMeterPtr m_loudnessMeter = nullptr;
+    VoiceBudgetPtr m_voiceBudget = std::make_shared<VoiceBudget>();
 
     bool m_isSilence = false;
     bool m_isIdle = false;
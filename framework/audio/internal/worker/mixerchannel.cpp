@@ -24,6 +24,7 @@
 #include <algorithm>
 
 #include "internal/dsp/audiomathutils.h"
+#include "internal/dsp/vectorkernels.h"
 #include "internal/audiosanitizer.h"
 
 #include "log.h"
@@ -32,16 +33,50 @@ using namespace muse;
 using namespace muse::audio;
 using namespace muse::async;
 
+//! NOTE Volume and balance changes are ramped over this time to avoid zipper noise
+static constexpr float CHANNEL_GAIN_RAMP_SECONDS = 0.01f;
+
+static int gainRampSteps(unsigned int sampleRate)
+{
+    return static_cast<int>(sampleRate * CHANNEL_GAIN_RAMP_SECONDS);
+}
+
+//! NOTE Whether both chains consist of the same fx at the same positions; params such as the bypass state may differ
+static bool isSameFxChainLayout(const AudioFxChain& left, const AudioFxChain& right)
+{
+    if (left.size() != right.size()) {
+        return false;
+    }
+
+    auto leftIt = left.cbegin();
+    auto rightIt = right.cbegin();
+
+    for (; leftIt != left.cend(); ++leftIt, ++rightIt) {
+        if (leftIt->first != rightIt->first || leftIt->second.resourceMeta != rightIt->second.resourceMeta) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 MixerChannel::MixerChannel(const TrackId trackId, IAudioSourcePtr source, const unsigned int sampleRate,
                            const modularity::ContextPtr& iocCtx)
     : Injectable(iocCtx), m_trackId(trackId),
     m_sampleRate(sampleRate),
     m_audioSource(std::move(source)),
-    m_compressor(std::make_unique<dsp::Compressor>(sampleRate))
+    m_compressor(std::make_unique<dsp::Compressor>(sampleRate)),
+    m_audioMeter(std::make_shared<AudioMeter>())
 {
     ONLY_AUDIO_WORKER_THREAD;
 
     setSampleRate(sampleRate);
+
+    if (m_audioSource) {
+        m_audioSource->audioChannelsCountChanged().onReceive(this, [this](unsigned int) {
+            onAudioChannelsCountChanged();
+        });
+    }
 }
 
 MixerChannel::MixerChannel(const TrackId trackId, const unsigned int sampleRate, unsigned int audioChannelsCount,
@@ -86,16 +121,9 @@ void MixerChannel::applyOutputParams(const AudioOutputParams& requiredParams)
         return;
     }
 
-    m_fxProcessors.clear();
-    m_fxProcessors = fxResolver()->resolveFxList(m_trackId, requiredParams.fxChain);
-
-    for (IFxProcessorPtr& fx : m_fxProcessors) {
-        fx->setSampleRate(m_sampleRate);
-
-        fx->paramsChanged().onReceive(this, [this](const AudioFxParams& fxParams) {
-            m_params.fxChain.insert_or_assign(fxParams.chainOrder, fxParams);
-            m_paramsChanges.send(m_params);
-        });
+    //! NOTE Volume, balance, mute or bypass changes don't touch the fx instances
+    if (!isSameFxChainLayout(m_resolvedFxChain, requiredParams.fxChain)) {
+        updateFxProcessors(requiredParams.fxChain);
     }
 
     AudioOutputParams resultParams = requiredParams;
@@ -133,14 +161,79 @@ void MixerChannel::applyOutputParams(const AudioOutputParams& requiredParams)
     }
 }
 
+void MixerChannel::updateFxProcessors(const AudioFxChain& fxChain)
+{
+    //! NOTE The resolver keeps the instances whose chain order and resource are unchanged,
+    //! so only the added processors need to be set up
+    std::vector<IFxProcessorPtr> fxProcessors = fxResolver()->resolveFxList(m_trackId, fxChain);
+
+    for (const IFxProcessorPtr& fx : m_fxProcessors) {
+        if (std::find(fxProcessors.cbegin(), fxProcessors.cend(), fx) == fxProcessors.cend()) {
+            fx->paramsChanged().resetOnReceive(this);
+        }
+    }
+
+    for (const IFxProcessorPtr& fx : fxProcessors) {
+        if (std::find(m_fxProcessors.cbegin(), m_fxProcessors.cend(), fx) != m_fxProcessors.cend()) {
+            continue;
+        }
+
+        fx->setSampleRate(m_sampleRate);
+
+        fx->paramsChanged().onReceive(this, [this](const AudioFxParams& fxParams) {
+            m_params.fxChain.insert_or_assign(fxParams.chainOrder, fxParams);
+            m_paramsChanges.send(m_params);
+        });
+    }
+
+    m_fxProcessors = std::move(fxProcessors);
+    m_resolvedFxChain = fxChain;
+}
+
+void MixerChannel::applyParamCommand(const MixerParamCommand& command)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    const bool wasMuted = m_params.muted;
+
+    if (!applyMixerParamCommand(command, m_params)) {
+        return;
+    }
+
+    if (command.type == MixerParamCommand::Type::FxActive) {
+        for (IFxProcessorPtr& fx : m_fxProcessors) {
+            if (fx->params().chainOrder == command.index) {
+                fx->setActive(command.value != 0.f);
+            }
+        }
+    }
+
+    if (wasMuted != m_params.muted) {
+        m_mutedChanged.notify();
+    }
+}
+
 async::Channel<AudioOutputParams> MixerChannel::outputParamsChanged() const
 {
     return m_paramsChanges;
 }
 
-AudioSignalChanges MixerChannel::audioSignalChanges() const
+AudioMeterPtr MixerChannel::audioMeter() const
 {
-    return m_audioSignalNotifier.audioSignalChanges;
+    return m_audioMeter;
+}
+
+void MixerChannel::setLoudnessAnalysisEnabled(bool enabled)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (enabled) {
+        m_loudnessMeter = std::make_unique<dsp::LoudnessMeter>(m_sampleRate, audioChannelsCount());
+    } else {
+        m_loudnessMeter = nullptr;
+    }
+
+    m_audioMeter->resetLoudness();
 }
 
 bool MixerChannel::isActive() const
@@ -163,6 +256,17 @@ void MixerChannel::setSampleRate(unsigned int sampleRate)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    m_sampleRate = sampleRate;
+    m_audioMeter->setSampleRate(sampleRate);
+
+    if (m_loudnessMeter) {
+        setLoudnessAnalysisEnabled(true);
+    }
+
+    for (fx::SmoothLinearValue<gain_t>& gain : m_smoothedChannelGains) {
+        gain.setSteps(gainRampSteps(sampleRate));
+    }
+
     if (m_audioSource) {
         m_audioSource->setSampleRate(sampleRate);
     }
@@ -172,6 +276,30 @@ void MixerChannel::setSampleRate(unsigned int sampleRate)
     }
 }
 
+void MixerChannel::onAudioChannelsCountChanged()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    //! NOTE The source has changed its layout, the measurement starts over
+    if (m_loudnessMeter) {
+        setLoudnessAnalysisEnabled(true);
+    }
+
+    allocatePlanarBuffers();
+}
+
+void MixerChannel::setMaxSamplesPerChannel(samples_t samplesPerChannel)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    if (m_maxSamplesPerChannel == samplesPerChannel) {
+        return;
+    }
+
+    m_maxSamplesPerChannel = samplesPerChannel;
+    allocatePlanarBuffers();
+}
+
 unsigned int MixerChannel::audioChannelsCount() const
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -179,6 +307,21 @@ unsigned int MixerChannel::audioChannelsCount() const
     return m_audioSource ? m_audioSource->audioChannelsCount() : m_audioChannelsCount;
 }
 
+bool MixerChannel::isReady() const
+{
+    if (m_audioSource && !m_audioSource->isReady()) {
+        return false;
+    }
+
+    for (const IFxProcessorPtr& fx : m_fxProcessors) {
+        if (!fx->isReady()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 async::Channel<unsigned int> MixerChannel::audioChannelsCountChanged() const
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -191,60 +334,180 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
     ONLY_AUDIO_WORKER_THREAD;
 
     samples_t processedSamplesCount = samplesPerChannel;
+    bool fxProcessed = false;
 
     if (m_audioSource) {
         if (!m_params.muted || !m_isSilent) {
-            processedSamplesCount = m_audioSource->process(buffer, samplesPerChannel);
+            if (canProcessPlanar()) {
+                processedSamplesCount = processChainPlanar(buffer, samplesPerChannel);
+                fxProcessed = true;
+            } else {
+                processedSamplesCount = m_audioSource->process(buffer, samplesPerChannel);
+            }
         }
     }
 
     if (processedSamplesCount == 0 || (m_params.muted && m_isSilent)) {
         std::fill(buffer, buffer + samplesPerChannel * audioChannelsCount(), 0.f);
-        notifyNoAudioSignal();
+        resetAudioMeter();
+        analyseLoudness(buffer, samplesPerChannel);
 
         return processedSamplesCount;
     }
 
+    if (!fxProcessed) {
+        for (IFxProcessorPtr& fx : m_fxProcessors) {
+            if (!fx->active()) {
+                continue;
+            }
+            fx->process(buffer, samplesPerChannel);
+        }
+    }
+
+    completeOutput(buffer, samplesPerChannel);
+    analyseLoudness(buffer, samplesPerChannel);
+
+    return processedSamplesCount;
+}
+
+bool MixerChannel::canProcessPlanar() const
+{
+    if (!m_audioSource || !m_audioSource->supportsPlanarProcessing()) {
+        return false;
+    }
+
+    for (const IFxProcessorPtr& fx : m_fxProcessors) {
+        if (fx->active() && !fx->supportsPlanarProcessing()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+samples_t MixerChannel::processChainPlanar(float* buffer, samples_t samplesPerChannel)
+{
+    const unsigned int channelsCount = audioChannelsCount();
+
+    //! NOTE The buffers are allocated by setMaxSamplesPerChannel() and onAudioChannelsCountChanged()
+    IF_ASSERT_FAILED(m_planarBuffers.size() == channelsCount && samplesPerChannel <= m_maxSamplesPerChannel) {
+        return 0;
+    }
+
+    for (unsigned int ch = 0; ch < channelsCount; ++ch) {
+        std::fill(m_planarBufferPtrs[ch], m_planarBufferPtrs[ch] + samplesPerChannel, 0.f);
+    }
+
+    const samples_t processedSamplesCount = m_audioSource->processPlanar(m_planarBufferPtrs.data(), samplesPerChannel);
+    if (processedSamplesCount == 0) {
+        return 0;
+    }
+
     for (IFxProcessorPtr& fx : m_fxProcessors) {
         if (!fx->active()) {
             continue;
         }
-        fx->process(buffer, samplesPerChannel);
+        fx->processPlanar(m_planarBufferPtrs.data(), samplesPerChannel);
     }
 
-    completeOutput(buffer, samplesPerChannel);
+    dsp::interleave(buffer, m_planarBufferPtrs.data(), channelsCount, samplesPerChannel);
 
     return processedSamplesCount;
 }
 
-void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount)
+void MixerChannel::allocatePlanarBuffers()
 {
-    unsigned int channelsCount = audioChannelsCount();
+    if (!m_audioSource) {
+        return;
+    }
+
+    const unsigned int channelsCount = audioChannelsCount();
+
+    m_planarBuffers.resize(channelsCount);
+    m_planarBufferPtrs.resize(channelsCount, nullptr);
+
+    for (unsigned int ch = 0; ch < channelsCount; ++ch) {
+        m_planarBuffers[ch].assign(m_maxSamplesPerChannel, 0.f);
+        m_planarBufferPtrs[ch] = m_planarBuffers[ch].data();
+    }
+}
+
+void MixerChannel::updateChannelGains(unsigned int channelsCount)
+{
+    const bool channelsCountChanged = m_smoothedChannelGains.size() != channelsCount;
+    if (channelsCountChanged) {
+        m_channelGains.resize(channelsCount);
+        m_channelSquaredSums.resize(channelsCount);
+        m_channelPeaks.resize(channelsCount);
+        m_smoothedChannelGains.resize(channelsCount);
+        m_audioMeter->setChannelsCount(channelsCount);
+    }
+
     float volume = muse::db_to_linear(m_params.volume);
-    float totalSquaredSum = 0.f;
 
     for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
+        gain_t gain = dsp::balanceGain(m_params.balance, audioChNum) * volume;
+        fx::SmoothLinearValue<gain_t>& smoothedGain = m_smoothedChannelGains[audioChNum];
+
+        if (channelsCountChanged) {
+            smoothedGain.setSteps(gainRampSteps(m_sampleRate));
+            smoothedGain.initWithValue(gain);
+        } else {
+            smoothedGain.setTargetValue(gain);
+        }
+
+        m_channelGains[audioChNum] = gain;
+    }
+}
+
+void MixerChannel::applyGainRamps(float* buffer, unsigned int samplesCount, unsigned int channelsCount)
+{
+    std::fill(m_channelSquaredSums.begin(), m_channelSquaredSums.end(), 0.f);
 
-        gain_t totalGain = dsp::balanceGain(m_params.balance, audioChNum) * volume;
+    for (unsigned int s = 0; s < samplesCount; ++s) {
+        float* frame = buffer + s * channelsCount;
 
-        for (unsigned int s = 0; s < samplesCount; ++s) {
-            int idx = s * channelsCount + audioChNum;
+        for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+            fx::SmoothLinearValue<gain_t>& gain = m_smoothedChannelGains[audioChNum];
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+            float sample = frame[audioChNum] * gain.getValue();
+            frame[audioChNum] = sample;
+            m_channelSquaredSums[audioChNum] += sample * sample;
 
-            float squaredSample = resultSample * resultSample;
-            singleChannelSquaredSum += squaredSample;
-            totalSquaredSum += squaredSample;
+            gain.tick();
         }
+    }
+}
+
+void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount)
+{
+    unsigned int channelsCount = audioChannelsCount();
+    updateChannelGains(channelsCount);
+
+    bool isRamping = std::any_of(m_smoothedChannelGains.cbegin(), m_smoothedChannelGains.cend(),
+                                 [](const fx::SmoothLinearValue<gain_t>& gain) {
+        return !gain.isAtTargetValue();
+    });
+
+    if (isRamping) {
+        applyGainRamps(buffer, samplesCount, channelsCount);
+    } else {
+        dsp::applyGains(buffer, samplesCount, channelsCount, m_channelGains.data(), m_channelSquaredSums.data());
+    }
+
+    dsp::samplesPeaks(buffer, samplesCount, channelsCount, m_channelPeaks.data());
+
+    float totalSquaredSum = 0.f;
+
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        float singleChannelSquaredSum = m_channelSquaredSums[audioChNum];
+        totalSquaredSum += singleChannelSquaredSum;
 
         float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
-        m_audioSignalNotifier.updateSignalValues(audioChNum, rms);
+        m_audioMeter->update(audioChNum, m_channelPeaks[audioChNum], rms, samplesCount);
     }
 
     m_isSilent = RealIsNull(totalSquaredSum);
-    m_audioSignalNotifier.notifyAboutChanges();
 
     if (!m_compressor->isActive()) {
         return;
@@ -254,18 +517,28 @@ void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount)
     m_compressor->process(totalRms, buffer, channelsCount, samplesCount);
 }
 
+void MixerChannel::analyseLoudness(const float* buffer, samples_t samplesPerChannel)
+{
+    if (!m_loudnessMeter) {
+        return;
+    }
+
+    //! NOTE The meter is recreated by onAudioChannelsCountChanged(), it is never allocated while processing
+    if (m_loudnessMeter->audioChannelsCount() != audioChannelsCount()) {
+        return;
+    }
+
+    m_loudnessMeter->process(buffer, samplesPerChannel);
+    m_audioMeter->updateLoudness(m_loudnessMeter->momentaryLoudness(), m_loudnessMeter->shortTermLoudness(),
+                                 m_loudnessMeter->integratedLoudness(), m_loudnessMeter->truePeak());
+}
+
 bool MixerChannel::isSilent() const
 {
     return m_isSilent;
 }
 
-void MixerChannel::notifyNoAudioSignal()
+void MixerChannel::resetAudioMeter()
 {
-    unsigned int channelsCount = audioChannelsCount();
-
-    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
-        m_audioSignalNotifier.updateSignalValues(audioChNum, 0.f);
-    }
-
-    m_audioSignalNotifier.notifyAboutChanges();
+    m_audioMeter->reset();
 }
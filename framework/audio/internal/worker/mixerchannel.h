@@ -29,6 +29,9 @@
 #include "../../ifxresolver.h"
 #include "../../ifxprocessor.h"
 #include "../dsp/compressor.h"
+#include "../dsp/loudnessmeter.h"
+#include "../fx/reverb/smoothlinearvalue.h"
+#include "mixerparamcommand.h"
 #include "track.h"
 
 namespace muse::audio {
@@ -50,24 +53,45 @@ public:
 
     bool isSilent() const;
 
-    void notifyNoAudioSignal();
+    void resetAudioMeter();
 
     const AudioOutputParams& outputParams() const override;
     void applyOutputParams(const AudioOutputParams& requiredParams) override;
     async::Channel<AudioOutputParams> outputParamsChanged() const override;
 
-    AudioSignalChanges audioSignalChanges() const override;
+    //! NOTE Real-time update of a single param, doesn't allocate and doesn't notify outputParamsChanged
+    void applyParamCommand(const MixerParamCommand& command);
+
+    AudioMeterPtr audioMeter() const override;
+
+    //! NOTE The loudness is measured on the output of the channel and published through its meter
+    void setLoudnessAnalysisEnabled(bool enabled) override;
 
     bool isActive() const override;
     void setIsActive(bool arg) override;
 
+    //! NOTE The largest render step, the planar buffers are allocated for it outside of process()
+    void setMaxSamplesPerChannel(samples_t samplesPerChannel);
+
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
+    bool isReady() const override;
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
 
 private:
+    void updateFxProcessors(const AudioFxChain& fxChain);
+
+    //! NOTE When the source and every active fx work on planar buffers, the chain runs without any transposes
+    //! and the result is interleaved only once, for the gains and the meters
+    bool canProcessPlanar() const;
+    samples_t processChainPlanar(float* buffer, samples_t samplesPerChannel);
+    void onAudioChannelsCountChanged();
+    void allocatePlanarBuffers();
+    void updateChannelGains(unsigned int channelsCount);
+    void applyGainRamps(float* buffer, unsigned int samplesCount, unsigned int channelsCount);
     void completeOutput(float* buffer, unsigned int samplesCount);
+    void analyseLoudness(const float* buffer, samples_t samplesPerChannel);
 
     TrackId m_trackId = -1;
 
@@ -77,14 +101,25 @@ private:
 
     IAudioSourcePtr m_audioSource = nullptr;
     std::vector<IFxProcessorPtr> m_fxProcessors = {};
+    AudioFxChain m_resolvedFxChain;
 
     dsp::CompressorPtr m_compressor = nullptr;
 
+    std::vector<gain_t> m_channelGains;
+    std::vector<fx::SmoothLinearValue<gain_t> > m_smoothedChannelGains;
+    std::vector<float> m_channelSquaredSums;
+    std::vector<float> m_channelPeaks;
+
+    std::vector<std::vector<float> > m_planarBuffers;
+    std::vector<float*> m_planarBufferPtrs;
+    samples_t m_maxSamplesPerChannel = 0;
+
     bool m_isSilent = true;
 
     async::Notification m_mutedChanged;
     mutable async::Channel<AudioOutputParams> m_paramsChanges;
-    mutable AudioSignalsNotifier m_audioSignalNotifier;
+    AudioMeterPtr m_audioMeter = nullptr;
+    dsp::LoudnessMeterPtr m_loudnessMeter = nullptr;
 };
 
 using MixerChannelPtr = std::shared_ptr<MixerChannel>;
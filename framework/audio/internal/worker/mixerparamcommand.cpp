@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mixerparamcommand.h"
+
+#include "global/realfn.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+bool muse::audio::makeMixerParamCommands(const AudioOutputParams& current, const AudioOutputParams& required,
+                                         std::vector<MixerParamCommand>& commands)
+{
+    if (current.solo != required.solo
+        || current.forceMute != required.forceMute
+        || current.auxSends.size() != required.auxSends.size()
+        || current.fxChain.size() != required.fxChain.size()) {
+        return false;
+    }
+
+    for (auto currentIt = current.fxChain.cbegin(), requiredIt = required.fxChain.cbegin(); currentIt != current.fxChain.cend();
+         ++currentIt, ++requiredIt) {
+        //! NOTE Only the bypass can be changed in real time, anything else needs the fx to be resolved again
+        AudioFxParams currentFx = currentIt->second;
+        currentFx.active = requiredIt->second.active;
+
+        if (currentIt->first != requiredIt->first || !(currentFx == requiredIt->second)) {
+            return false;
+        }
+    }
+
+    auto addCommand = [&commands](MixerParamCommand::Type type, int32_t index, float value) {
+        MixerParamCommand command;
+        command.type = type;
+        command.index = index;
+        command.value = value;
+        commands.push_back(command);
+    };
+
+    if (!RealIsEqual(current.volume, required.volume)) {
+        addCommand(MixerParamCommand::Type::Volume, 0, required.volume);
+    }
+
+    if (!RealIsEqual(current.balance, required.balance)) {
+        addCommand(MixerParamCommand::Type::Balance, 0, required.balance);
+    }
+
+    if (current.muted != required.muted) {
+        addCommand(MixerParamCommand::Type::Muted, 0, required.muted ? 1.f : 0.f);
+    }
+
+    for (size_t idx = 0; idx < required.auxSends.size(); ++idx) {
+        const AuxSendParams& currentSend = current.auxSends.at(idx);
+        const AuxSendParams& requiredSend = required.auxSends.at(idx);
+
+        if (!RealIsEqual(currentSend.signalAmount, requiredSend.signalAmount)) {
+            addCommand(MixerParamCommand::Type::AuxSendAmount, static_cast<int32_t>(idx), requiredSend.signalAmount);
+        }
+
+        if (currentSend.active != requiredSend.active) {
+            addCommand(MixerParamCommand::Type::AuxSendActive, static_cast<int32_t>(idx), requiredSend.active ? 1.f : 0.f);
+        }
+    }
+
+    for (const auto& pair : required.fxChain) {
+        if (current.fxChain.at(pair.first).active != pair.second.active) {
+            addCommand(MixerParamCommand::Type::FxActive, pair.first, pair.second.active ? 1.f : 0.f);
+        }
+    }
+
+    return true;
+}
+
+bool muse::audio::applyMixerParamCommand(const MixerParamCommand& command, AudioOutputParams& params)
+{
+    switch (command.type) {
+    case MixerParamCommand::Type::Volume:
+        params.volume = command.value;
+        return true;
+    case MixerParamCommand::Type::Balance:
+        params.balance = command.value;
+        return true;
+    case MixerParamCommand::Type::Muted:
+        params.muted = command.value != 0.f;
+        return true;
+    case MixerParamCommand::Type::AuxSendAmount:
+    case MixerParamCommand::Type::AuxSendActive: {
+        if (command.index < 0 || static_cast<size_t>(command.index) >= params.auxSends.size()) {
+            return false;
+        }
+
+        AuxSendParams& send = params.auxSends[command.index];
+        if (command.type == MixerParamCommand::Type::AuxSendAmount) {
+            send.signalAmount = command.value;
+        } else {
+            send.active = command.value != 0.f;
+        }
+
+        return true;
+    }
+    case MixerParamCommand::Type::FxActive: {
+        auto it = params.fxChain.find(static_cast<AudioFxChainOrder>(command.index));
+        if (it == params.fxChain.end()) {
+            return false;
+        }
+
+        it->second.active = command.value != 0.f;
+        return true;
+    }
+    }
+
+    return false;
+}
@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_MIXERPARAMCOMMAND_H
+#define MUSE_AUDIO_MIXERPARAMCOMMAND_H
+
+#include <vector>
+
+#include "global/concurrency/spscqueue.h"
+
+#include "../../audiotypes.h"
+
+namespace muse::audio {
+//! NOTE A real-time parameter update of a mixer channel or of the master.
+//! The commands are passed to the mixer through MixerParamQueue, which doesn't lock or allocate
+struct MixerParamCommand {
+    enum class Type : uint8_t {
+        Volume,
+        Balance,
+        Muted,
+        AuxSendAmount,
+        AuxSendActive,
+        FxActive
+    };
+
+    Type type = Type::Volume;
+    bool master = false;
+    TrackId trackId = -1;
+    int32_t index = 0; // aux_channel_idx_t for the aux sends, AudioFxChainOrder for the fx
+    float value = 0.f; // volume_db_t, balance_t or the signal amount; 0 or 1 for the flags
+};
+
+//! NOTE Single producer (the main thread), single consumer (the mixer)
+using MixerParamQueue = SpscQueue<MixerParamCommand>;
+using MixerParamQueuePtr = std::shared_ptr<MixerParamQueue>;
+
+//! NOTE Appends the commands which turn the current params into the required ones.
+//! Returns false if the difference can't be expressed by the commands, e.g. when the fx chain has changed
+bool makeMixerParamCommands(const AudioOutputParams& current, const AudioOutputParams& required, std::vector<MixerParamCommand>& commands);
+
+//! NOTE Applies the command to the params, returns false if it doesn't match them
+bool applyMixerParamCommand(const MixerParamCommand& command, AudioOutputParams& params);
+}
+
+#endif // MUSE_AUDIO_MIXERPARAMCOMMAND_H
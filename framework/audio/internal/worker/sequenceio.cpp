@@ -144,7 +144,7 @@ Channel<TrackId, AudioOutputParams> SequenceIO::outputParamsChanged() const
     return m_outputParamsChanged;
 }
 
-AudioSignalChanges SequenceIO::audioSignalChanges(const TrackId id) const
+AudioMeterPtr SequenceIO::audioMeter(const TrackId id) const
 {
     ONLY_AUDIO_WORKER_THREAD;
 
@@ -154,8 +154,24 @@ AudioSignalChanges SequenceIO::audioSignalChanges(const TrackId id) const
 
     TrackPtr track = m_getTracks->track(id);
     IF_ASSERT_FAILED(track) {
-        return AudioSignalChanges();
+        return nullptr;
     }
 
-    return track->outputHandler->audioSignalChanges();
+    return track->outputHandler->audioMeter();
+}
+
+void SequenceIO::setLoudnessAnalysisEnabled(const TrackId id, bool enabled)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    IF_ASSERT_FAILED(m_getTracks) {
+        return;
+    }
+
+    TrackPtr track = m_getTracks->track(id);
+    IF_ASSERT_FAILED(track) {
+        return;
+    }
+
+    track->outputHandler->setLoudnessAnalysisEnabled(enabled);
 }
@@ -46,7 +46,8 @@ public:
     async::Channel<TrackId, AudioInputParams> inputParamsChanged() const override;
     async::Channel<TrackId, AudioOutputParams> outputParamsChanged() const override;
 
-    AudioSignalChanges audioSignalChanges(const TrackId id) const override;
+    AudioMeterPtr audioMeter(const TrackId id) const override;
+    void setLoudnessAnalysisEnabled(const TrackId id, bool enabled) override;
 
 private:
     IGetTracks* m_getTracks = nullptr;
@@ -30,6 +30,7 @@
 
 #include "../../iaudiosource.h"
 #include "../../audiotypes.h"
+#include "../../audiometer.h"
 
 namespace muse::audio {
 enum TrackType {
@@ -60,7 +61,8 @@ public:
     virtual void applyOutputParams(const AudioOutputParams& requiredParams) = 0;
     virtual async::Channel<AudioOutputParams> outputParamsChanged() const = 0;
 
-    virtual AudioSignalChanges audioSignalChanges() const = 0;
+    virtual AudioMeterPtr audioMeter() const = 0;
+    virtual void setLoudnessAnalysisEnabled(bool enabled) = 0;
 };
 
 using ITrackAudioInputPtr = std::shared_ptr<ITrackAudioInput>;
@@ -199,7 +201,10 @@ struct SoundTrack : public Track
             return false;
         }
 
-        m_ioDevice->close();
+        if (m_ioDevice) {
+            m_ioDevice->close();
+        }
+
         m_ioDevice = newDevice;
         playbackDataChanged.send(std::move(newDevice));
 
@@ -23,6 +23,7 @@
 #include "tracksequence.h"
 
 #include "internal/audiosanitizer.h"
+#include "audiofilesource.h"
 #include "clock.h"
 #include "eventaudiosource.h"
 #include "sequenceplayer.h"
@@ -123,25 +124,31 @@ RetVal2<TrackId, AudioParams> TrackSequence::addTrack(const std::string& trackNa
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    NOT_IMPLEMENTED;
-
     RetVal2<TrackId, AudioParams> result;
+    result.val1 = -1;
+
+    IF_ASSERT_FAILED(mixer()) {
+        result.ret = make_ret(Err::Undefined);
+        return result;
+    }
 
-    if (!device) {
+    AudioFileSourcePtr source = AudioFileSource::open(device);
+    if (!source) {
         result.ret = make_ret(Err::InvalidAudioFilePath);
-        result.val1 = -1;
         return result;
     }
 
     TrackId newId = newTrackId();
 
     SoundTrackPtr trackPtr = std::make_shared<SoundTrack>();
+
     trackPtr->id = newId;
     trackPtr->name = trackName;
     trackPtr->setPlaybackData(device);
+    trackPtr->inputHandler = source;
+    trackPtr->outputHandler = mixer()->addChannel(newId, source).val;
     trackPtr->setInputParams(requiredParams.in);
     trackPtr->setOutputParams(requiredParams.out);
-    //TODO create AudioSource and MixerChannel
 
     m_trackAboutToBeAdded.send(trackPtr);
     m_tracks.emplace(newId, trackPtr);
@@ -35,7 +35,7 @@
 
 namespace muse::audio {
 class Mixer;
-class TrackSequence : public ITrackSequence, public IGetTracks, public muse::Injectable, public async::Asyncable
+class TrackSequence : public ITrackSequence, public muse::Injectable, public async::Asyncable
 {
     Inject<IAudioEngine> audioEngine = { this };
 
@@ -0,0 +1,185 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "voicebudget.h"
+
+#include <algorithm>
+
+using namespace muse;
+using namespace muse::audio;
+
+//! NOTE Above this share of the block duration the budget is cut, so that the load drops to the target.
+//! Below the low mark it grows back slowly
+static constexpr float VOICE_BUDGET_HIGH_LOAD = 0.75f;
+static constexpr float VOICE_BUDGET_TARGET_LOAD = 0.6f;
+static constexpr float VOICE_BUDGET_LOW_LOAD = 0.45f;
+
+//! NOTE The budget is cut on the load of the current block, but only grows back
+//! once the load has stayed low for a few dozens of blocks
+static constexpr float VOICE_BUDGET_LOAD_DECAY = 0.05f;
+
+VoiceBudget::VoiceBudget(int maxVoices)
+    : m_slots(std::make_shared<Slots>())
+{
+    setMaxVoices(maxVoices);
+}
+
+VoiceBudget::ClientPtr VoiceBudget::registerClient()
+{
+    Slots& slots = *m_slots;
+
+    for (size_t i = 0; i < MAX_CLIENTS; ++i) {
+        Slot& slot = slots[i];
+
+        SlotState expected = SlotState::Free;
+        if (!slot.state.compare_exchange_strong(expected, SlotState::Reserved, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        slot.client.activeVoices.store(0, std::memory_order_relaxed);
+        slot.client.stolenVoices.store(0, std::memory_order_relaxed);
+        slot.client.allowedVoices.store(budget(), std::memory_order_relaxed);
+        slot.state.store(SlotState::Used, std::memory_order_release);
+
+        size_t count = m_slotsCount.load(std::memory_order_acquire);
+        while (count < i + 1 && !m_slotsCount.compare_exchange_weak(count, i + 1, std::memory_order_acq_rel)) {
+        }
+
+        return ClientPtr(&slot.client, [slots = m_slots, i](Client*) {
+            (*slots)[i].state.store(SlotState::Free, std::memory_order_release);
+        });
+    }
+
+    return nullptr;
+}
+
+int VoiceBudget::maxVoices() const
+{
+    return m_maxVoices.load(std::memory_order_relaxed);
+}
+
+void VoiceBudget::setMaxVoices(int maxVoices)
+{
+    const int voices = std::max(maxVoices, MIN_VOICES);
+    m_maxVoices.store(voices, std::memory_order_relaxed);
+    m_budget.store(voices, std::memory_order_relaxed);
+}
+
+int VoiceBudget::budget() const
+{
+    return m_budget.load(std::memory_order_relaxed);
+}
+
+int VoiceBudget::activeVoices() const
+{
+    return m_activeVoices.load(std::memory_order_relaxed);
+}
+
+int VoiceBudget::stolenVoices() const
+{
+    return m_stolenVoices.load(std::memory_order_relaxed);
+}
+
+float VoiceBudget::load() const
+{
+    return m_load.load(std::memory_order_relaxed);
+}
+
+void VoiceBudget::update(int64_t renderTimeNs, int64_t blockDurationNs)
+{
+    Slots& slots = *m_slots;
+    const size_t slotsCount = m_slotsCount.load(std::memory_order_acquire);
+
+    int totalActive = 0;
+    int totalStolen = 0;
+    int totalDemand = 0;
+
+    //! NOTE A synth needs the voices it plays plus the ones it had to steal,
+    //! otherwise a synth cut down once could never get its share back
+    for (size_t i = 0; i < slotsCount; ++i) {
+        Slot& slot = slots[i];
+
+        if (slot.state.load(std::memory_order_acquire) != SlotState::Used) {
+            slot.demand = 0;
+            continue;
+        }
+
+        int active = slot.client.activeVoices.load(std::memory_order_relaxed);
+        int stolen = slot.client.stolenVoices.exchange(0, std::memory_order_relaxed);
+
+        slot.demand = active + stolen;
+        totalActive += active;
+        totalStolen += stolen;
+        totalDemand += slot.demand;
+    }
+
+    float load = blockDurationNs > 0 ? static_cast<float>(renderTimeNs) / static_cast<float>(blockDurationNs) : 0.f;
+    adaptBudget(load, totalActive);
+
+    const int budget = m_budget.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < slotsCount; ++i) {
+        Slot& slot = slots[i];
+
+        //! NOTE A slot taken meanwhile gets its share on the next update
+        if (slot.state.load(std::memory_order_acquire) != SlotState::Used) {
+            continue;
+        }
+
+        int allowed = 0;
+
+        if (totalDemand <= budget) {
+            //! NOTE Every synth may start as many voices as are free, the overshoot is shared out on the next update
+            allowed = slot.demand + (budget - totalDemand);
+        } else {
+            allowed = static_cast<int>(static_cast<int64_t>(budget) * slot.demand / totalDemand);
+        }
+
+        slot.client.allowedVoices.store(std::max(allowed, MIN_CLIENT_VOICES), std::memory_order_relaxed);
+    }
+
+    m_activeVoices.store(totalActive, std::memory_order_relaxed);
+    m_stolenVoices.store(totalStolen, std::memory_order_relaxed);
+}
+
+void VoiceBudget::adaptBudget(float load, int activeVoices)
+{
+    float smoothedLoad = m_load.load(std::memory_order_relaxed);
+    if (load > smoothedLoad) {
+        smoothedLoad = load;
+    } else {
+        smoothedLoad += (load - smoothedLoad) * VOICE_BUDGET_LOAD_DECAY;
+    }
+
+    m_load.store(smoothedLoad, std::memory_order_relaxed);
+
+    int budget = m_budget.load(std::memory_order_relaxed);
+
+    if (load > VOICE_BUDGET_HIGH_LOAD && activeVoices > 0) {
+        //! NOTE The render time is assumed to grow linearly with the voices
+        int affordable = static_cast<int>(activeVoices * VOICE_BUDGET_TARGET_LOAD / load);
+        budget = std::min(budget, affordable);
+    } else if (smoothedLoad < VOICE_BUDGET_LOW_LOAD) {
+        budget += std::max(budget / 32, 1);
+    }
+
+    m_budget.store(std::clamp(budget, MIN_VOICES, m_maxVoices.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+}
@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_VOICEBUDGET_H
+#define MUSE_AUDIO_VOICEBUDGET_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace muse::audio {
+//! NOTE Engine-wide limit on the voices of all the synths.
+//! The mixer adapts the limit to the measured render time of every block
+//! and shares it between the synths in proportion to the voices they need.
+//! A synth over its share steals its least important voices before rendering.
+//! The synths are kept in a fixed array of slots, so that update() neither locks nor allocates
+class VoiceBudget
+{
+public:
+    static constexpr int DEFAULT_MAX_VOICES = 1024;
+    static constexpr int MIN_VOICES = 64;
+    static constexpr int MIN_CLIENT_VOICES = 8;
+    static constexpr size_t MAX_CLIENTS = 1024;
+
+    //! NOTE The voices of one synth, it is written from the thread processing its track
+    struct Client {
+        std::atomic<int> activeVoices = 0;
+        std::atomic<int> stolenVoices = 0; // since the last update
+        std::atomic<int> allowedVoices = DEFAULT_MAX_VOICES;
+
+        //! NOTE To be called after the events of a block have been applied, returns how many voices may keep playing
+        int allowed() const
+        {
+            return allowedVoices.load(std::memory_order_relaxed);
+        }
+
+        void report(int active, int stolen)
+        {
+            activeVoices.store(active, std::memory_order_relaxed);
+            if (stolen > 0) {
+                stolenVoices.fetch_add(stolen, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    using ClientPtr = std::shared_ptr<Client>;
+
+    explicit VoiceBudget(int maxVoices = DEFAULT_MAX_VOICES);
+
+    //! NOTE Takes a free slot, which is given back when the returned client is deleted.
+    //! Returns nullptr if all the slots are taken, the synth then isn't limited
+    ClientPtr registerClient();
+
+    int maxVoices() const;
+    void setMaxVoices(int maxVoices);
+
+    //! NOTE The current limit, between MIN_VOICES and maxVoices()
+    int budget() const;
+    int activeVoices() const;
+    int stolenVoices() const; // in the last update
+    float load() const;
+
+    //! NOTE Called by the mixer after every block with the time spent rendering the tracks, from one thread only
+    void update(int64_t renderTimeNs, int64_t blockDurationNs);
+
+private:
+    enum class SlotState {
+        Free,
+        Reserved, // being set up by registerClient()
+        Used
+    };
+
+    struct Slot {
+        Client client;
+        std::atomic<SlotState> state = SlotState::Free;
+        int demand = 0; // only accessed by update()
+    };
+
+    using Slots = std::array<Slot, MAX_CLIENTS>;
+
+    void adaptBudget(float load, int activeVoices);
+
+    //! NOTE Shared with the deleters of the clients, which may outlive the budget
+    std::shared_ptr<Slots> m_slots;
+    std::atomic<size_t> m_slotsCount = 0; // all the slots after these have never been used
+
+    std::atomic<int> m_maxVoices = DEFAULT_MAX_VOICES;
+    std::atomic<int> m_budget = DEFAULT_MAX_VOICES;
+    std::atomic<int> m_activeVoices = 0;
+    std::atomic<int> m_stolenVoices = 0;
+    std::atomic<float> m_load = 0.f;
+};
+
+using VoiceBudgetPtr = std::shared_ptr<VoiceBudget>;
+}
+
+#endif // MUSE_AUDIO_VOICEBUDGET_H
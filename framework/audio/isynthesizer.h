@@ -47,6 +47,9 @@ public:
 
     virtual void revokePlayingNotes() = 0;
     virtual void flushSound() = 0;
+
+    //! NOTE A synth of an offline render doesn't follow the mode of the audio engine
+    virtual void setFixedRenderMode(const RenderMode mode) = 0;
 };
 
 using ISynthesizerPtr = std::shared_ptr<ISynthesizer>;
@@ -0,0 +1,268 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/audiobuffer.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+//! NOTE Every sample is its index in the whole rendered stream, so the order of the popped samples can be checked
+class RampAudioSource : public IAudioSource
+{
+public:
+    RampAudioSource(audioch_t audioChannelsCount)
+        : m_audioChannelsCount(audioChannelsCount) {}
+
+    bool isActive() const override { return true; }
+    void setIsActive(bool) override {}
+
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return m_audioChannelsCount; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        for (samples_t i = 0; i < samplesPerChannel * m_audioChannelsCount; ++i) {
+            buffer[i] = static_cast<float>(m_nextSample++);
+        }
+
+        return samplesPerChannel;
+    }
+
+private:
+    audioch_t m_audioChannelsCount = 0;
+    size_t m_nextSample = 0;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+};
+
+class Audio_AudioBufferTest : public ::testing::Test
+{
+protected:
+    static void expectRamp(const std::vector<float>& samples, size_t firstSample)
+    {
+        for (size_t i = 0; i < samples.size(); ++i) {
+            ASSERT_FLOAT_EQ(samples[i], static_cast<float>(firstSample + i)) << "sample " << i;
+        }
+    }
+};
+}
+
+TEST_F(Audio_AudioBufferTest, MultichannelRingKeepsOrderAcrossWraps)
+{
+    //! [GIVEN] A 6 channel buffer, much smaller than the default one
+    constexpr audioch_t CHANNELS = 6;
+
+    AudioBuffer buffer;
+    buffer.init(CHANNELS, 100);
+    buffer.setSource(std::make_shared<RampAudioSource>(CHANNELS));
+    buffer.setMinSamplesPerChannelToReserve(40);
+    buffer.setRenderStep(30);
+
+    EXPECT_EQ(buffer.capacityPerChannel(), 100);
+
+    //! [WHEN] Many times more samples than it can hold go through it
+    std::vector<float> dest(25 * CHANNELS);
+    for (size_t i = 0; i < 100; ++i) {
+        buffer.forward();
+        buffer.pop(dest.data(), 25);
+
+        //! [THEN] They come out in order, without underruns
+        expectRamp(dest, i * dest.size());
+    }
+
+    EXPECT_EQ(buffer.underrunsCount(), 0);
+}
+
+TEST_F(Audio_AudioBufferTest, RetuningReserveGrowsCapacityAndKeepsSamples)
+{
+    //! [GIVEN] A small stereo buffer with some samples rendered
+    AudioBuffer buffer;
+    buffer.init(2, 64);
+    buffer.setSource(std::make_shared<RampAudioSource>(2));
+    buffer.setMinSamplesPerChannelToReserve(16);
+    buffer.setRenderStep(16);
+    buffer.forward();
+
+    std::vector<float> dest(8 * 2);
+    buffer.pop(dest.data(), 8);
+    expectRamp(dest, 0);
+
+    //! [WHEN] The reserve is retuned beyond the capacity
+    buffer.setMinSamplesPerChannelToReserve(100);
+
+    //! [THEN] The capacity grows to hold the reserve and a render step
+    EXPECT_EQ(buffer.samplesPerChannelToReserve(), 100);
+    EXPECT_GE(buffer.capacityPerChannel(), 100 + 16 + 1);
+
+    //! [THEN] The samples which weren't played yet are still there, followed by the new ones
+    buffer.forward();
+
+    dest.resize(100 * 2);
+    buffer.pop(dest.data(), 100);
+    expectRamp(dest, 8 * 2);
+
+    EXPECT_EQ(buffer.underrunsCount(), 0);
+}
+
+TEST_F(Audio_AudioBufferTest, UnderrunIsFilledWithSilence)
+{
+    //! [GIVEN] A buffer with 16 samples per channel rendered
+    AudioBuffer buffer;
+    buffer.init(2, 64);
+    buffer.setSource(std::make_shared<RampAudioSource>(2));
+    buffer.setMinSamplesPerChannelToReserve(16);
+    buffer.setRenderStep(16);
+    buffer.forward();
+
+    //! [WHEN] The driver asks for more
+    std::vector<float> dest(24 * 2, -1.f);
+    buffer.pop(dest.data(), 24);
+
+    //! [THEN] It gets what is rendered, then silence, and the underrun is counted
+    expectRamp(std::vector<float>(dest.begin(), dest.begin() + 16 * 2), 0);
+    for (size_t i = 16 * 2; i < dest.size(); ++i) {
+        EXPECT_EQ(dest[i], 0.f);
+    }
+
+    EXPECT_EQ(buffer.underrunsCount(), 1);
+
+    //! [WHEN] A pop longer than any internal silence is made on the empty buffer
+    dest.assign(10000 * 2, -1.f);
+    buffer.pop(dest.data(), 10000);
+
+    //! [THEN] It's all silence
+    for (float sample : dest) {
+        ASSERT_EQ(sample, 0.f);
+    }
+
+    EXPECT_EQ(buffer.underrunsCount(), 2);
+}
+
+TEST_F(Audio_AudioBufferTest, AdaptiveReserveGrowsOnUnderrunsAndShrinksWhenStable)
+{
+    //! [GIVEN] A buffer in the adaptive mode
+    AudioBuffer buffer;
+    buffer.init(2);
+    buffer.setSource(std::make_shared<RampAudioSource>(2));
+    buffer.setMinSamplesPerChannelToReserve(128);
+    buffer.setRenderStep(128);
+
+    AudioBuffer::AdaptiveReserve adaptiveReserve;
+    adaptiveReserve.enabled = true;
+    adaptiveReserve.maxSamplesPerChannel = 384;
+    adaptiveReserve.stablePeriodSamplesPerChannel = 1024;
+    buffer.setAdaptiveReserve(adaptiveReserve);
+
+    std::vector<float> dest(512 * 2);
+
+    //! [WHEN] The driver keeps reading more than is reserved
+    for (int i = 0; i < 4; ++i) {
+        buffer.forward();
+        buffer.pop(dest.data(), 512);
+    }
+
+    //! [THEN] The reserve grows by a render step after each underrun, up to the maximum
+    EXPECT_EQ(buffer.underrunsCount(), 4);
+    buffer.forward();
+    EXPECT_EQ(buffer.samplesPerChannelToReserve(), 384);
+
+    //! [WHEN] The driver reads less than is reserved, long enough
+    size_t stableBlocks = 0;
+    while (buffer.samplesPerChannelToReserve() > 128 && stableBlocks < 1000) {
+        buffer.pop(dest.data(), 64);
+        buffer.forward();
+        ++stableBlocks;
+    }
+
+    //! [THEN] The reserve goes back down to the minimum, without underruns
+    EXPECT_EQ(buffer.samplesPerChannelToReserve(), 128);
+    EXPECT_EQ(buffer.underrunsCount(), 4);
+
+    //! [WHEN] The adaptive mode is turned off
+    buffer.forward();
+    buffer.pop(dest.data(), 512);
+    buffer.forward();
+    EXPECT_EQ(buffer.samplesPerChannelToReserve(), 256);
+
+    buffer.setAdaptiveReserve(AudioBuffer::AdaptiveReserve());
+
+    //! [THEN] The reserve is the minimum again
+    EXPECT_EQ(buffer.samplesPerChannelToReserve(), 128);
+}
+
+TEST_F(Audio_AudioBufferTest, ResizeWhileDriverPops)
+{
+    //! [GIVEN] A driver thread popping from the buffer
+    AudioBuffer buffer;
+    buffer.init(2, 256);
+    buffer.setSource(std::make_shared<RampAudioSource>(2));
+    buffer.setMinSamplesPerChannelToReserve(64);
+    buffer.setRenderStep(64);
+    buffer.forward();
+
+    std::atomic<bool> stopped = false;
+    std::atomic<bool> samplesInOrder = true;
+
+    std::thread driver([&]() {
+        std::vector<float> dest(32 * 2);
+        float lastSample = -1.f;
+
+        while (!stopped) {
+            buffer.pop(dest.data(), 32);
+
+            for (float sample : dest) {
+                //! NOTE Silence is allowed in between, but never an old or a torn sample
+                if (sample == 0.f) {
+                    continue;
+                }
+
+                if (sample <= lastSample) {
+                    samplesInOrder = false;
+                }
+
+                lastSample = sample;
+            }
+        }
+    });
+
+    //! [WHEN] The worker renders and resizes the storage back and forth
+    for (int i = 0; i < 2000; ++i) {
+        buffer.forward();
+
+        if (i % 100 == 0) {
+            buffer.resize(i % 200 == 0 ? 1024 : 256);
+        }
+    }
+
+    stopped = true;
+    driver.join();
+
+    //! [THEN] The driver has only seen the samples in order
+    EXPECT_TRUE(samplesInOrder);
+}
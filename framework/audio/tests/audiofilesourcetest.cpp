@@ -0,0 +1,247 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "global/io/buffer.h"
+#include "global/io/file.h"
+
+#include "audio/internal/worker/audiofilesource.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+static constexpr sample_rate_t FILE_SOURCE_TEST_SAMPLE_RATE = 48000;
+static constexpr samples_t FILE_SOURCE_TEST_FRAMES = 4 * FILE_SOURCE_TEST_SAMPLE_RATE;
+static constexpr samples_t FILE_SOURCE_TEST_BLOCK = 512;
+
+class Audio_AudioFileSourceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_path = (std::filesystem::temp_directory_path() / "muse_audio_audiofilesourcetest.wav").string();
+
+        //! NOTE Float samples, so that the output can be compared exactly
+        m_samples.resize(FILE_SOURCE_TEST_FRAMES * 2);
+        for (samples_t i = 0; i < FILE_SOURCE_TEST_FRAMES; ++i) {
+            m_samples[i * 2] = static_cast<float>(i) / FILE_SOURCE_TEST_FRAMES;
+            m_samples[i * 2 + 1] = -static_cast<float>(i) / FILE_SOURCE_TEST_FRAMES;
+        }
+
+        const uint32_t dataSize = static_cast<uint32_t>(m_samples.size() * sizeof(float));
+
+        std::vector<uint8_t> header(44, 0);
+        auto put = [&header](size_t offset, uint32_t value, size_t bytes) {
+            for (size_t i = 0; i < bytes; ++i) {
+                header[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+            }
+        };
+
+        std::memcpy(header.data(), "RIFF", 4);
+        put(4, 36 + dataSize, 4);
+        std::memcpy(header.data() + 8, "WAVEfmt ", 8);
+        put(16, 16, 4);
+        put(20, 3, 2); // IEEE float
+        put(22, 2, 2);
+        put(24, FILE_SOURCE_TEST_SAMPLE_RATE, 4);
+        put(28, FILE_SOURCE_TEST_SAMPLE_RATE * 2 * sizeof(float), 4);
+        put(32, 2 * sizeof(float), 2);
+        put(34, 32, 2);
+        std::memcpy(header.data() + 36, "data", 4);
+        put(40, dataSize, 4);
+
+        std::FILE* file = std::fopen(m_path.c_str(), "wb");
+        ASSERT_TRUE(file);
+        ASSERT_EQ(std::fwrite(header.data(), 1, header.size(), file), header.size());
+        ASSERT_EQ(std::fwrite(m_samples.data(), sizeof(float), m_samples.size(), file), m_samples.size());
+        std::fclose(file);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    static bool waitUntilReady(const AudioFileSource& source)
+    {
+        for (int i = 0; i < 500 && !source.isReady(FILE_SOURCE_TEST_BLOCK); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return source.isReady(FILE_SOURCE_TEST_BLOCK);
+    }
+
+    std::vector<float> expectedBlock(samples_t fromFrame) const
+    {
+        return std::vector<float>(m_samples.begin() + fromFrame * 2, m_samples.begin() + (fromFrame + FILE_SOURCE_TEST_BLOCK) * 2);
+    }
+
+    std::string m_path;
+    std::vector<float> m_samples;
+};
+}
+
+TEST_F(Audio_AudioFileSourceTest, StreamsFileFromPosition)
+{
+    //! [GIVEN] A source of a stereo file, played at the sample rate of the file
+    AudioFileSource source(m_path);
+    source.setSampleRate(FILE_SOURCE_TEST_SAMPLE_RATE);
+    source.setIsActive(true);
+    EXPECT_EQ(source.audioChannelsCount(), 2);
+
+    std::vector<float> buffer(FILE_SOURCE_TEST_BLOCK * 2);
+
+    //! [THEN] The blocks are the samples of the file, more than the read-ahead ring holds
+    for (samples_t frame = 0; frame < 3 * FILE_SOURCE_TEST_SAMPLE_RATE; frame += FILE_SOURCE_TEST_BLOCK) {
+        ASSERT_TRUE(waitUntilReady(source));
+        ASSERT_EQ(source.process(buffer.data(), FILE_SOURCE_TEST_BLOCK), FILE_SOURCE_TEST_BLOCK);
+        ASSERT_EQ(buffer, expectedBlock(frame)) << "frame: " << frame;
+    }
+
+    //! [WHEN] Seek to 2.5 seconds
+    const samples_t seekFrame = FILE_SOURCE_TEST_SAMPLE_RATE * 5 / 2;
+    source.seek(2500000);
+
+    //! [THEN] The next blocks start from there
+    ASSERT_TRUE(waitUntilReady(source));
+    source.process(buffer.data(), FILE_SOURCE_TEST_BLOCK);
+    EXPECT_EQ(buffer, expectedBlock(seekFrame));
+
+    ASSERT_TRUE(waitUntilReady(source));
+    source.process(buffer.data(), FILE_SOURCE_TEST_BLOCK);
+    EXPECT_EQ(buffer, expectedBlock(seekFrame + FILE_SOURCE_TEST_BLOCK));
+}
+
+TEST_F(Audio_AudioFileSourceTest, FileDeviceIsMappedByPath)
+{
+    //! [GIVEN] A file device which hasn't been opened
+    io::File file(m_path);
+
+    //! [WHEN] A source is opened from it
+    AudioFileSourcePtr source = AudioFileSource::open(&file);
+    ASSERT_TRUE(source);
+    source->setSampleRate(FILE_SOURCE_TEST_SAMPLE_RATE);
+    source->setIsActive(true);
+
+    //! [THEN] The device wasn't opened, which would read the whole file into memory, the file is played from its mapping
+    EXPECT_FALSE(file.isOpen());
+
+    std::vector<float> buffer(FILE_SOURCE_TEST_BLOCK * 2);
+    ASSERT_TRUE(waitUntilReady(*source));
+    ASSERT_EQ(source->process(buffer.data(), FILE_SOURCE_TEST_BLOCK), FILE_SOURCE_TEST_BLOCK);
+    EXPECT_EQ(buffer, expectedBlock(0));
+}
+
+TEST_F(Audio_AudioFileSourceTest, OtherDevicesAreReadAsTheyAre)
+{
+    //! [GIVEN] A device with the contents of the file in memory
+    std::FILE* file = std::fopen(m_path.c_str(), "rb");
+    ASSERT_TRUE(file);
+    std::vector<uint8_t> contents(std::filesystem::file_size(m_path));
+    ASSERT_EQ(std::fread(contents.data(), 1, contents.size(), file), contents.size());
+    std::fclose(file);
+
+    io::Buffer device(contents.data(), contents.size());
+
+    //! [WHEN] A source is opened from it
+    AudioFileSourcePtr source = AudioFileSource::open(&device);
+    ASSERT_TRUE(source);
+    source->setSampleRate(FILE_SOURCE_TEST_SAMPLE_RATE);
+    source->setIsActive(true);
+
+    //! [THEN] The device was opened and is decoded from memory
+    EXPECT_TRUE(device.isOpen());
+
+    std::vector<float> buffer(FILE_SOURCE_TEST_BLOCK * 2);
+    ASSERT_TRUE(waitUntilReady(*source));
+    ASSERT_EQ(source->process(buffer.data(), FILE_SOURCE_TEST_BLOCK), FILE_SOURCE_TEST_BLOCK);
+    EXPECT_EQ(buffer, expectedBlock(0));
+}
+
+TEST_F(Audio_AudioFileSourceTest, StaysInTimeWhenDecoderIsLate)
+{
+    //! [GIVEN] A source which has just been seeked, so the decoder may not have caught up yet
+    AudioFileSource source(m_path);
+    source.setSampleRate(FILE_SOURCE_TEST_SAMPLE_RATE);
+    source.setIsActive(true);
+    source.seek(1000000);
+
+    //! [WHEN] A block is processed right away
+    std::vector<float> buffer(FILE_SOURCE_TEST_BLOCK * 2);
+    source.process(buffer.data(), FILE_SOURCE_TEST_BLOCK);
+
+    //! [THEN] It is either silence or the file, the source doesn't wait for the decoder
+    const std::vector<float> silence(buffer.size(), 0.f);
+    const samples_t seekFrame = FILE_SOURCE_TEST_SAMPLE_RATE;
+    if (source.underrunsCount() > 0) {
+        EXPECT_EQ(buffer, silence);
+    } else {
+        EXPECT_EQ(buffer, expectedBlock(seekFrame));
+    }
+
+    //! [THEN] The next block continues from the time of the first one, in either case
+    ASSERT_TRUE(waitUntilReady(source));
+    source.process(buffer.data(), FILE_SOURCE_TEST_BLOCK);
+    EXPECT_EQ(buffer, expectedBlock(seekFrame + FILE_SOURCE_TEST_BLOCK));
+}
+
+TEST_F(Audio_AudioFileSourceTest, ResamplesToOutputSampleRate)
+{
+    //! [GIVEN] A source played at half the sample rate of the file
+    AudioFileSource source(m_path);
+    source.setSampleRate(FILE_SOURCE_TEST_SAMPLE_RATE / 2);
+    source.setIsActive(true);
+
+    //! [WHEN] The whole file is played
+    std::vector<float> buffer(FILE_SOURCE_TEST_BLOCK * 2);
+    samples_t frames = 0;
+    float lastLeft = 0.f;
+
+    while (true) {
+        ASSERT_TRUE(waitUntilReady(source));
+
+        const samples_t processed = source.process(buffer.data(), FILE_SOURCE_TEST_BLOCK);
+        if (processed == 0) {
+            break;
+        }
+
+        if (processed == FILE_SOURCE_TEST_BLOCK) {
+            lastLeft = buffer[(FILE_SOURCE_TEST_BLOCK - 1) * 2];
+        }
+
+        frames += processed;
+    }
+
+    //! [THEN] The file lasts as long, and follows the same ramp
+    EXPECT_EQ(frames, FILE_SOURCE_TEST_FRAMES / 2);
+    EXPECT_NEAR(lastLeft, 1.f, 0.01f);
+    EXPECT_EQ(source.underrunsCount(), 0);
+}
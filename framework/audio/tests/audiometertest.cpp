@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "audio/audiometer.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+static constexpr unsigned int METER_SAMPLE_RATE = 48000;
+static constexpr samples_t METER_BLOCK_SIZE = 480; // 10 ms
+
+class Audio_AudioMeterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_meter.setSampleRate(METER_SAMPLE_RATE);
+        m_meter.setChannelsCount(2);
+    }
+
+    AudioMeter m_meter;
+};
+}
+
+TEST_F(Audio_AudioMeterTest, PublishesPeakRmsAndPeakHold)
+{
+    //! [WHEN] A loud block is followed by a quiet one
+    m_meter.update(0, 0.8f, 0.5f, METER_BLOCK_SIZE);
+    m_meter.update(0, 0.2f, 0.1f, METER_BLOCK_SIZE);
+
+    //! [THEN] Peak and RMS follow the last block, the peak hold keeps the loud peak
+    AudioMeterValue value = m_meter.value(0);
+    EXPECT_FLOAT_EQ(value.peak, 0.2f);
+    EXPECT_FLOAT_EQ(value.rms, 0.1f);
+    EXPECT_FLOAT_EQ(value.peakHold, 0.8f);
+
+    //! [THEN] Other channels are untouched
+    AudioMeterValue other = m_meter.value(1);
+    EXPECT_FLOAT_EQ(other.peak, 0.f);
+    EXPECT_FLOAT_EQ(other.peakHold, 0.f);
+    EXPECT_EQ(m_meter.channelsCount(), 2);
+}
+
+TEST_F(Audio_AudioMeterTest, PeakHoldIsReleasedAfterHoldTime)
+{
+    //! [GIVEN] A loud peak
+    m_meter.update(0, 0.9f, 0.5f, METER_BLOCK_SIZE);
+
+    //! [WHEN] Quiet blocks are published for longer than the hold time
+    const size_t holdBlocks = static_cast<size_t>(METER_SAMPLE_RATE * AudioMeter::PEAK_HOLD_SECONDS) / METER_BLOCK_SIZE;
+
+    for (size_t i = 0; i < holdBlocks; ++i) {
+        m_meter.update(0, 0.1f, 0.05f, METER_BLOCK_SIZE);
+        EXPECT_FLOAT_EQ(m_meter.value(0).peakHold, 0.9f);
+    }
+
+    m_meter.update(0, 0.1f, 0.05f, METER_BLOCK_SIZE);
+
+    //! [THEN] The peak hold falls back to the current peak
+    EXPECT_FLOAT_EQ(m_meter.value(0).peakHold, 0.1f);
+}
+
+TEST_F(Audio_AudioMeterTest, ResetClearsAllChannels)
+{
+    //! [GIVEN] Both channels have a signal
+    m_meter.update(0, 0.5f, 0.3f, METER_BLOCK_SIZE);
+    m_meter.update(1, 0.4f, 0.2f, METER_BLOCK_SIZE);
+
+    //! [WHEN] The meter is reset
+    m_meter.reset();
+
+    //! [THEN] All values are zero and the level is at the minimum
+    for (audioch_t ch = 0; ch < 2; ++ch) {
+        AudioMeterValue value = m_meter.value(ch);
+        EXPECT_FLOAT_EQ(value.peak, 0.f);
+        EXPECT_FLOAT_EQ(value.rms, 0.f);
+        EXPECT_FLOAT_EQ(value.peakHold, 0.f);
+    }
+
+    EXPECT_EQ(AudioMeter::toDbfs(0.f), MINIMUM_OPERABLE_DBFS_LEVEL);
+    EXPECT_NEAR(AudioMeter::toDbfs(1.f), 0.f, 1e-5f);
+}
+
+TEST_F(Audio_AudioMeterTest, PublishesLoudness)
+{
+    //! [GIVEN] Nothing is measured yet
+    AudioLoudnessValue initial = m_meter.loudness();
+    EXPECT_EQ(initial.integratedLufs, MINIMUM_OPERABLE_DBFS_LEVEL);
+    EXPECT_EQ(initial.truePeakDbtp, MINIMUM_OPERABLE_DBFS_LEVEL);
+
+    //! [WHEN] The loudness is published
+    m_meter.updateLoudness(-18.f, -20.f, -23.f, 0.5f);
+
+    //! [THEN] The reader gets it, the true-peak in dBTP
+    AudioLoudnessValue value = m_meter.loudness();
+    EXPECT_FLOAT_EQ(value.momentaryLufs, -18.f);
+    EXPECT_FLOAT_EQ(value.shortTermLufs, -20.f);
+    EXPECT_FLOAT_EQ(value.integratedLufs, -23.f);
+    EXPECT_NEAR(value.truePeakDbtp, -6.02f, 0.01f);
+
+    //! [WHEN] The loudness is reset
+    m_meter.resetLoudness();
+
+    //! [THEN] Nothing is measured
+    EXPECT_EQ(m_meter.loudness().momentaryLufs, MINIMUM_OPERABLE_DBFS_LEVEL);
+}
+
+TEST_F(Audio_AudioMeterTest, ReaderNeverSeesTornValues)
+{
+    //! [GIVEN] A writer publishing values where peak == rms == peakHold
+    std::atomic<bool> stop = false;
+
+    std::thread writer([this, &stop]() {
+        float value = 0.f;
+        while (!stop) {
+            value = value >= 1.f ? 0.f : value + 0.001f;
+            m_meter.update(0, value, value, 0);
+        }
+    });
+
+    //! [WHEN] The values are polled concurrently
+    //! [THEN] Every read is consistent
+    for (int i = 0; i < 100000; ++i) {
+        AudioMeterValue value = m_meter.value(0);
+        ASSERT_EQ(value.peak, value.rms);
+    }
+
+    stop = true;
+    writer.join();
+}
@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/audiothread.h"
+#include "audio/internal/audiobuffer.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+static constexpr audioch_t WORKER_TEST_CHANNELS_COUNT = 2;
+
+//! NOTE Far longer than the test waits for, so only wake() can start an iteration in time
+static constexpr msecs_t LONG_WORKER_INTERVAL = 10000;
+
+class CountingAudioSource : public IAudioSource
+{
+public:
+    bool isActive() const override { return true; }
+    void setIsActive(bool) override {}
+
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return WORKER_TEST_CHANNELS_COUNT; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        std::fill(buffer, buffer + samplesPerChannel * WORKER_TEST_CHANNELS_COUNT, 0.f);
+        renderedSamples += samplesPerChannel;
+        return samplesPerChannel;
+    }
+
+    std::atomic<samples_t> renderedSamples = 0;
+
+private:
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+};
+
+class Audio_AudioThreadTest : public ::testing::Test
+{
+protected:
+    template<typename Predicate>
+    bool waitFor(Predicate&& predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000))
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return true;
+    }
+};
+}
+
+TEST_F(Audio_AudioThreadTest, WakeStartsIterationBeforeInterval)
+{
+    AudioThread thread;
+    std::atomic<int> iterations = 0;
+
+    thread.run(nullptr, [&iterations]() {
+        ++iterations;
+    }, LONG_WORKER_INTERVAL);
+
+    //! NOTE The first iteration doesn't wait
+    ASSERT_TRUE(waitFor([&]() { return iterations >= 1; }));
+
+    thread.wake();
+    EXPECT_TRUE(waitFor([&]() { return iterations >= 2; }));
+
+    thread.wake();
+    EXPECT_TRUE(waitFor([&]() { return iterations >= 3; }));
+
+    thread.stop();
+
+    const AudioThread::LatencyStats stats = thread.latencyStats();
+    EXPECT_EQ(stats.wakeCount, 2);
+    EXPECT_EQ(stats.timeoutCount, 1);
+    EXPECT_LE(stats.minMsecs, stats.avgMsecs);
+    EXPECT_LE(stats.avgMsecs, stats.maxMsecs);
+    EXPECT_GT(stats.maxMsecs, 0.0);
+
+    thread.resetLatencyStats();
+    EXPECT_EQ(thread.latencyStats().wakeCount, 0);
+}
+
+TEST_F(Audio_AudioThreadTest, StopDoesNotWaitForInterval)
+{
+    AudioThread thread;
+    std::atomic<int> iterations = 0;
+
+    thread.run(nullptr, [&iterations]() {
+        ++iterations;
+    }, LONG_WORKER_INTERVAL);
+
+    ASSERT_TRUE(waitFor([&]() { return iterations >= 1; }));
+
+    const auto start = std::chrono::steady_clock::now();
+    thread.stop();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(LONG_WORKER_INTERVAL / 2));
+}
+
+TEST_F(Audio_AudioThreadTest, BufferPopWakesWorker)
+{
+    auto source = std::make_shared<CountingAudioSource>();
+
+    AudioBuffer buffer;
+    buffer.init(WORKER_TEST_CHANNELS_COUNT);
+    buffer.setSource(source);
+    buffer.setMinSamplesPerChannelToReserve(256);
+    buffer.setRenderStep(256);
+
+    AudioThread thread;
+    buffer.setOnReserveLow([&thread]() {
+        thread.wake();
+    });
+
+    thread.run(nullptr, [&buffer]() {
+        buffer.forward();
+    }, LONG_WORKER_INTERVAL);
+
+    //! NOTE The first iteration fills the reserve
+    ASSERT_TRUE(waitFor([&]() { return source->renderedSamples >= 256; }));
+
+    //! NOTE Consuming a part of the reserve makes the worker refill it without waiting for the interval
+    std::vector<float> dest(128 * WORKER_TEST_CHANNELS_COUNT);
+    buffer.pop(dest.data(), 128);
+
+    EXPECT_TRUE(waitFor([&]() { return source->renderedSamples >= 512; }));
+
+    thread.stop();
+
+    EXPECT_GE(thread.latencyStats().wakeCount, 1);
+}
@@ -0,0 +1,78 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+namespace muse::audio::benchmarks {
+//! NOTE Returns the best average time per call over several rounds, in nanoseconds
+template<typename Func>
+double measureNanosecondsPerCall(Func&& func, size_t callsPerRound, size_t rounds = 5)
+{
+    using clock = std::chrono::steady_clock;
+
+    double best = std::numeric_limits<double>::max();
+
+    //! NOTE Warm up caches and branch predictors
+    for (size_t i = 0; i < callsPerRound; ++i) {
+        func();
+    }
+
+    for (size_t round = 0; round < rounds; ++round) {
+        clock::time_point start = clock::now();
+
+        for (size_t i = 0; i < callsPerRound; ++i) {
+            func();
+        }
+
+        std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+        best = std::min(best, elapsed.count() / callsPerRound);
+    }
+
+    return best;
+}
+
+inline void printBenchmarkResult(const std::string& name, double nanosecondsPerCall, double baselineNanosecondsPerCall = 0.0)
+{
+    if (baselineNanosecondsPerCall > 0.0) {
+        std::printf("  %-48s %12.1f ns  x%.2f\n", name.c_str(), nanosecondsPerCall, baselineNanosecondsPerCall / nanosecondsPerCall);
+    } else {
+        std::printf("  %-48s %12.1f ns\n", name.c_str(), nanosecondsPerCall);
+    }
+}
+
+//! NOTE Prevents the compiler from optimizing away a computed value
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile ("" : : "r,m" (value) : "memory");
+#else
+    static volatile T sink;
+    sink = value;
+#endif
+}
+}
@@ -0,0 +1,330 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/audiobuffer.h"
+#include "audio/internal/audiosanitizer.h"
+#include "audio/internal/fx/reverb/reverbprocessor.h"
+#include "audio/internal/platform/headless/headlessaudiodriver.h"
+#include "audio/internal/worker/mixer.h"
+
+#include "../mocks/audioconfigurationmock.h"
+#include "../mocks/fxresolvermock.h"
+#include "../utils/allocationcounter.h"
+
+#include "benchmarkutils.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::benchmarks;
+
+namespace muse::audio {
+static constexpr audioch_t ENGINE_BENCHMARK_CHANNELS = 2;
+static constexpr unsigned int ENGINE_BENCHMARK_SAMPLE_RATE = 48000;
+static constexpr uint16_t ENGINE_BENCHMARK_BLOCK_FRAMES = 512;
+static constexpr TrackId ENGINE_BENCHMARK_AUX_TRACK_ID = 10000;
+
+//! NOTE A synthetic instrument: a sine per track, at its own frequency, renders in both layouts
+class SineTrackSource : public ITrackAudioInput
+{
+public:
+    SineTrackSource(float frequency)
+        : m_phaseStep(2.0 * M_PI * frequency / ENGINE_BENCHMARK_SAMPLE_RATE) {}
+
+    bool isActive() const override { return m_isActive; }
+    void setIsActive(bool arg) override { m_isActive = arg; }
+
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return ENGINE_BENCHMARK_CHANNELS; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            const float sample = nextSample();
+            buffer[s * ENGINE_BENCHMARK_CHANNELS] = sample;
+            buffer[s * ENGINE_BENCHMARK_CHANNELS + 1] = sample;
+        }
+
+        return samplesPerChannel;
+    }
+
+    bool supportsPlanarProcessing() const override { return true; }
+
+    samples_t processPlanar(float* const* buffers, samples_t samplesPerChannel) override
+    {
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            buffers[0][s] = buffers[1][s] = nextSample();
+        }
+
+        return samplesPerChannel;
+    }
+
+    void seek(const msecs_t) override {}
+    void flush() override {}
+
+    const AudioInputParams& inputParams() const override { return m_params; }
+    void applyInputParams(const AudioInputParams& params) override { m_params = params; }
+    async::Channel<AudioInputParams> inputParamsChanged() const override { return m_paramsChanged; }
+
+private:
+    float nextSample()
+    {
+        m_phase += m_phaseStep;
+        if (m_phase > 2.0 * M_PI) {
+            m_phase -= 2.0 * M_PI;
+        }
+
+        return 0.05f * static_cast<float>(std::sin(m_phase));
+    }
+
+    double m_phase = 0.0;
+    double m_phaseStep = 0.0;
+    bool m_isActive = false;
+    AudioInputParams m_params;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+    async::Channel<AudioInputParams> m_paramsChanged;
+};
+
+//! NOTE The whole playback path: tracks -> aux reverb -> master -> AudioBuffer -> driver.
+//! The headless driver pulls the blocks, so the measurements are taken where a device would take them
+class Audio_EngineBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        ON_CALL(*m_configuration, audioChannelsCount()).WillByDefault(Return(ENGINE_BENCHMARK_CHANNELS));
+        ON_CALL(*m_configuration, samplesToPreallocate()).WillByDefault(Return(ENGINE_BENCHMARK_BLOCK_FRAMES));
+        ON_CALL(*m_configuration, desiredAudioThreadNumber()).WillByDefault(Return(2));
+        ON_CALL(*m_configuration, minTrackCountForMultithreading()).WillByDefault(Return(std::numeric_limits<size_t>::max()));
+        ON_CALL(*m_configuration, audioThreadPoolType()).WillByDefault(Return(AudioThreadPoolType::WorkStealing));
+
+        m_fxResolver = std::make_shared<NiceMock<fx::FxResolverMock> >();
+
+        modularity::globalIoc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+        modularity::globalIoc()->registerExport<fx::IFxResolver>("utests", m_fxResolver);
+    }
+
+    void TearDown() override
+    {
+        m_buffer = nullptr;
+        m_mixer = nullptr;
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+        modularity::globalIoc()->unregister<fx::IFxResolver>("utests");
+    }
+
+    //! NOTE Every track sends to one aux bus with the reverb
+    void setupSession(size_t tracksCount)
+    {
+        m_mixer = std::make_shared<Mixer>(modularity::globalCtx());
+        m_mixer->setAudioChannelsCount(ENGINE_BENCHMARK_CHANNELS);
+        m_mixer->setSampleRate(ENGINE_BENCHMARK_SAMPLE_RATE);
+        m_mixer->setIsIdle(false);
+        m_mixer->setIsActive(true);
+
+        AudioFxParams reverbParams;
+        reverbParams.chainOrder = 0;
+        reverbParams.active = true;
+        reverbParams.resourceMeta.id = "reverb";
+        reverbParams.resourceMeta.type = AudioResourceType::MusePlugin;
+
+        ON_CALL(*m_fxResolver, resolveFxList(ENGINE_BENCHMARK_AUX_TRACK_ID, _)).WillByDefault([reverbParams](const TrackId,
+                                                                                                              const AudioFxChain&) {
+            return std::vector<IFxProcessorPtr> { std::make_shared<fx::ReverbProcessor>(reverbParams, ENGINE_BENCHMARK_CHANNELS) };
+        });
+
+        MixerChannelPtr aux = m_mixer->addAuxChannel(ENGINE_BENCHMARK_AUX_TRACK_ID).val;
+        AudioOutputParams auxParams;
+        auxParams.fxChain.emplace(reverbParams.chainOrder, reverbParams);
+        aux->applyOutputParams(auxParams);
+
+        for (size_t i = 0; i < tracksCount; ++i) {
+            auto source = std::make_shared<SineTrackSource>(110.f + 7.f * i);
+            MixerChannelPtr channel = m_mixer->addChannel(static_cast<TrackId>(i), source).val;
+
+            AudioOutputParams params = channel->outputParams();
+            params.auxSends.resize(1);
+            params.auxSends[0] = AuxSendParams { 0.3f, true };
+            channel->applyOutputParams(params);
+        }
+
+        //! NOTE The buffer keeps exactly one block in reserve, so every callback makes the engine render one block
+        m_buffer = std::make_shared<AudioBuffer>();
+        m_buffer->init(ENGINE_BENCHMARK_CHANNELS);
+        m_buffer->setSource(m_mixer);
+        m_buffer->setMinSamplesPerChannelToReserve(ENGINE_BENCHMARK_BLOCK_FRAMES);
+        m_buffer->setRenderStep(ENGINE_BENCHMARK_BLOCK_FRAMES);
+        m_buffer->forward();
+    }
+
+    IAudioDriver::Spec driverSpec() const
+    {
+        IAudioDriver::Spec spec;
+        spec.sampleRate = ENGINE_BENCHMARK_SAMPLE_RATE;
+        spec.format = IAudioDriver::Format::AudioF32;
+        spec.channels = ENGINE_BENCHMARK_CHANNELS;
+        spec.samples = ENGINE_BENCHMARK_BLOCK_FRAMES;
+        spec.callback = [this](void* /*userdata*/, uint8_t* stream, int byteCount) {
+            m_buffer->pop(reinterpret_cast<float*>(stream), byteCount / (ENGINE_BENCHMARK_CHANNELS * sizeof(float)));
+        };
+        spec.userdata = nullptr;
+
+        return spec;
+    }
+
+    void printEngineResult(size_t tracksCount, const HeadlessAudioDriver::Stats& stats, uint64_t underruns, size_t allocations)
+    {
+        const double cpuPerTrack = tracksCount > 0 ? 100.0 * stats.meanCallbackUs / stats.blockDurationUs / tracksCount : 0.0;
+
+        std::printf("  %4zu tracks  p50 %8.1f us  p90 %8.1f us  p99 %8.1f us  max %8.1f us  "
+                    "xruns %4llu  underruns %4llu  cpu/track %6.3f %%  allocations %zu\n",
+                    tracksCount, stats.p50CallbackUs, stats.p90CallbackUs, stats.p99CallbackUs, stats.maxCallbackUs,
+                    static_cast<unsigned long long>(stats.xrunsCount), static_cast<unsigned long long>(underruns),
+                    cpuPerTrack, allocations);
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+    std::shared_ptr<NiceMock<fx::FxResolverMock> > m_fxResolver;
+    MixerPtr m_mixer;
+    AudioBufferPtr m_buffer;
+};
+}
+
+//! NOTE Deterministic: the driver is pulled on the calling thread, as fast as the engine renders.
+//! The xruns are the blocks which took longer than they last
+TEST_F(Audio_EngineBenchmark, RenderTimePerBlock)
+{
+    constexpr size_t WARM_UP_BLOCKS = 32;
+    constexpr size_t MEASURED_BLOCKS = 1000;
+
+    std::printf("Engine, sine tracks + aux reverb, %u frames per block, %u Hz, headless driver with the manual clock\n",
+                ENGINE_BENCHMARK_BLOCK_FRAMES, ENGINE_BENCHMARK_SAMPLE_RATE);
+
+    for (size_t tracksCount : { 1, 8, 32, 128 }) {
+        setupSession(tracksCount);
+
+        //! NOTE The rendering happens in the callback, like when the worker refills the buffer on demand
+        m_buffer->setOnReserveLow([this]() {
+            m_buffer->forward();
+        });
+
+        HeadlessAudioDriver::Options options;
+        options.speed = 0.0;
+        options.manualClock = true;
+
+        HeadlessAudioDriver driver(options);
+        ASSERT_TRUE(driver.open(driverSpec(), nullptr));
+
+        driver.advance(WARM_UP_BLOCKS);
+        driver.resetStats();
+        const uint64_t underrunsBefore = m_buffer->underrunsCount();
+
+        tests::AllocationCounter::start();
+        EXPECT_EQ(driver.advance(MEASURED_BLOCKS), MEASURED_BLOCKS);
+        const size_t allocations = tests::AllocationCounter::stop();
+
+        const HeadlessAudioDriver::Stats stats = driver.stats();
+        EXPECT_EQ(stats.blocksCount, MEASURED_BLOCKS);
+        EXPECT_EQ(driver.virtualTime(), static_cast<msecs_t>((WARM_UP_BLOCKS + MEASURED_BLOCKS) * ENGINE_BENCHMARK_BLOCK_FRAMES
+                                                             * 1000000ull / ENGINE_BENCHMARK_SAMPLE_RATE));
+
+        printEngineResult(tracksCount, stats, m_buffer->underrunsCount() - underrunsBefore, allocations);
+
+        driver.close();
+    }
+}
+
+//! NOTE The driver runs on its own thread, on the virtual clock 4 times faster than the real time,
+//! and the worker refills the buffer on another thread, like in the application
+TEST_F(Audio_EngineBenchmark, PacedPlayback)
+{
+    constexpr double SPEED = 4.0;
+    constexpr size_t TRACKS_COUNT = 32;
+    constexpr msecs_t PLAYBACK_DURATION = 2000000; // on the virtual clock
+
+    std::printf("Engine, %zu sine tracks + aux reverb, headless driver at x%.0f, separate worker thread\n", TRACKS_COUNT, SPEED);
+
+    setupSession(TRACKS_COUNT);
+
+    std::mutex mutex;
+    std::condition_variable refill;
+    bool refillRequested = false;
+    std::atomic<bool> stopped = false;
+
+    m_buffer->setOnReserveLow([&]() {
+        {
+            std::lock_guard lock(mutex);
+            refillRequested = true;
+        }
+        refill.notify_one();
+    });
+
+    std::thread worker([&]() {
+        AudioSanitizer::setupWorkerThread();
+
+        while (!stopped) {
+            std::unique_lock lock(mutex);
+            refill.wait_for(lock, std::chrono::milliseconds(1), [&]() { return refillRequested; });
+            refillRequested = false;
+            lock.unlock();
+
+            m_buffer->forward();
+        }
+    });
+
+    HeadlessAudioDriver::Options options;
+    options.speed = SPEED;
+
+    HeadlessAudioDriver driver(options);
+    ASSERT_TRUE(driver.open(driverSpec(), nullptr));
+
+    while (driver.virtualTime() < PLAYBACK_DURATION) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    driver.close();
+    stopped = true;
+    worker.join();
+
+    AudioSanitizer::setupWorkerThread();
+
+    const HeadlessAudioDriver::Stats stats = driver.stats();
+    EXPECT_GT(stats.blocksCount, 0);
+
+    printEngineResult(TRACKS_COUNT, stats, m_buffer->underrunsCount(), 0);
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "audio/internal/dsp/audiomathutils.h"
+#include "audio/internal/dsp/limiter.h"
+#include "audio/internal/dsp/lookaheadlimiter.h"
+
+#include "benchmarkutils.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+using namespace muse::audio::benchmarks;
+
+namespace muse::audio {
+static constexpr sample_rate_t LIMITER_BENCHMARK_SAMPLE_RATE = 48000;
+static constexpr audioch_t LIMITER_BENCHMARK_CHANNELS_COUNT = 2;
+static constexpr samples_t LIMITER_BENCHMARK_BLOCK_FRAMES = 512;
+
+class Audio_LimiterBenchmark : public ::testing::Test
+{
+protected:
+    //! NOTE One second of stereo noise-like signal with the given peak amplitude
+    std::vector<float> input(float amplitude) const
+    {
+        std::vector<float> result(LIMITER_BENCHMARK_SAMPLE_RATE * LIMITER_BENCHMARK_CHANNELS_COUNT);
+
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = amplitude * static_cast<float>(std::sin(0.37 * i) * std::cos(0.011 * i));
+        }
+
+        return result;
+    }
+
+    static float samplePeak(const std::vector<float>& buffer)
+    {
+        float peak = 0.f;
+
+        for (float sample : buffer) {
+            peak = std::max(peak, std::abs(sample));
+        }
+
+        return peak;
+    }
+
+    //! NOTE Limits one second of audio per call, in blocks of the size of a typical audio callback.
+    //! The peak of the output is printed as well, since the limiters differ in what they let through
+    void benchmark(float amplitude)
+    {
+        std::printf("Peak amplitude %.2f, %d channels, 1 s of audio per call\n", amplitude, int(LIMITER_BENCHMARK_CHANNELS_COUNT));
+
+        const std::vector<float> data = input(amplitude);
+        std::vector<float> buffer = data;
+
+        Limiter legacy(static_cast<unsigned int>(LIMITER_BENCHMARK_SAMPLE_RATE));
+        legacy.setIsActive(true);
+
+        const double legacyTime = measureNanosecondsPerCall([&]() {
+            buffer = data;
+
+            for (samples_t from = 0; from < LIMITER_BENCHMARK_SAMPLE_RATE; from += LIMITER_BENCHMARK_BLOCK_FRAMES) {
+                float* block = buffer.data() + from * LIMITER_BENCHMARK_CHANNELS_COUNT;
+                const samples_t frames = std::min(LIMITER_BENCHMARK_BLOCK_FRAMES, LIMITER_BENCHMARK_SAMPLE_RATE - from);
+
+                float squaredSum = 0.f;
+                for (size_t i = 0; i < frames * LIMITER_BENCHMARK_CHANNELS_COUNT; ++i) {
+                    squaredSum += block[i] * block[i];
+                }
+
+                const float rms = samplesRootMeanSquare(squaredSum, frames * LIMITER_BENCHMARK_CHANNELS_COUNT);
+                legacy.process(rms, block, LIMITER_BENCHMARK_CHANNELS_COUNT, frames);
+            }
+            doNotOptimize(buffer[0]);
+        }, 2, 3);
+
+        printBenchmarkResult("Limiter, block RMS (legacy)", legacyTime);
+        std::printf("    output peak %.3f\n", samplePeak(buffer));
+
+        for (float lookAheadMs : { LookAheadLimiter::MIN_LOOK_AHEAD_MS, LookAheadLimiter::MAX_LOOK_AHEAD_MS }) {
+            LookAheadLimiter limiter(LIMITER_BENCHMARK_SAMPLE_RATE, LIMITER_BENCHMARK_CHANNELS_COUNT, lookAheadMs);
+
+            const double time = measureNanosecondsPerCall([&]() {
+                buffer = data;
+
+                for (samples_t from = 0; from < LIMITER_BENCHMARK_SAMPLE_RATE; from += LIMITER_BENCHMARK_BLOCK_FRAMES) {
+                    limiter.process(buffer.data() + from * LIMITER_BENCHMARK_CHANNELS_COUNT,
+                                    std::min(LIMITER_BENCHMARK_BLOCK_FRAMES, LIMITER_BENCHMARK_SAMPLE_RATE - from));
+                }
+                doNotOptimize(buffer[0]);
+            }, 2, 3);
+
+            printBenchmarkResult("LookAheadLimiter, " + std::to_string(int(lookAheadMs)) + " ms look-ahead", time, legacyTime);
+            std::printf("    output peak %.3f, latency %d frames\n", samplePeak(buffer), int(limiter.latency()));
+        }
+    }
+};
+}
+
+TEST_F(Audio_LimiterBenchmark, BelowCeiling)
+{
+    benchmark(0.25f);
+}
+
+TEST_F(Audio_LimiterBenchmark, OverCeiling)
+{
+    benchmark(2.f);
+}
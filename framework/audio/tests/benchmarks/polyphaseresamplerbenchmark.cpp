@@ -0,0 +1,116 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "audio/internal/dsp/polyphaseresampler.h"
+
+#include "../utils/legacysamplerateconvertor.h"
+
+#include "benchmarkutils.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+using namespace muse::audio::benchmarks;
+
+namespace muse::audio {
+static constexpr audioch_t RESAMPLER_CHANNELS_COUNT = 2;
+static constexpr samples_t RESAMPLER_OUTPUT_BLOCK_FRAMES = 512;
+
+class Audio_PolyphaseResamplerBenchmark : public ::testing::Test
+{
+protected:
+    //! NOTE One second of stereo noise-like signal
+    std::vector<float> input(sample_rate_t sampleRate) const
+    {
+        std::vector<float> result(sampleRate * RESAMPLER_CHANNELS_COUNT);
+
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = 0.5f * static_cast<float>(std::sin(0.37 * i) * std::cos(0.011 * i));
+        }
+
+        return result;
+    }
+
+    //! NOTE Converts one second of audio per call, in blocks of the size of a typical audio callback
+    void benchmark(sample_rate_t rateIn, sample_rate_t rateOut)
+    {
+        std::printf("%d Hz -> %d Hz, %d channels, 1 s of audio per call\n", int(rateIn), int(rateOut), int(RESAMPLER_CHANNELS_COUNT));
+
+        const std::vector<float> data = input(rateIn);
+        std::vector<float> output(rateOut * RESAMPLER_CHANNELS_COUNT);
+
+        tests::LegacySampleRateConvertor legacy(data, RESAMPLER_CHANNELS_COUNT, static_cast<unsigned int>(rateIn),
+                                                static_cast<unsigned int>(rateOut));
+
+        const double legacyTime = measureNanosecondsPerCall([&]() {
+            for (unsigned int from = 0; from < rateOut; from += RESAMPLER_OUTPUT_BLOCK_FRAMES) {
+                legacy.convert(output.data(), from, RESAMPLER_OUTPUT_BLOCK_FRAMES);
+            }
+            doNotOptimize(output[0]);
+        }, 2, 3);
+
+        printBenchmarkResult("SampleRateConvertor (legacy)", legacyTime);
+
+        const std::pair<PolyphaseResampler::Quality, std::string> presets[] = {
+            { PolyphaseResampler::Quality::Low, "PolyphaseResampler, low" },
+            { PolyphaseResampler::Quality::Medium, "PolyphaseResampler, medium" },
+            { PolyphaseResampler::Quality::High, "PolyphaseResampler, high" },
+        };
+
+        const samples_t inputBlockFrames = RESAMPLER_OUTPUT_BLOCK_FRAMES * rateIn / rateOut;
+
+        for (const auto& [quality, name] : presets) {
+            PolyphaseResampler resampler(rateIn, rateOut, RESAMPLER_CHANNELS_COUNT, quality);
+            std::vector<float> block(resampler.maxOutputFrames(inputBlockFrames) * RESAMPLER_CHANNELS_COUNT);
+
+            const double time = measureNanosecondsPerCall([&]() {
+                for (samples_t from = 0; from + inputBlockFrames <= rateIn; from += inputBlockFrames) {
+                    resampler.process(data.data() + from * RESAMPLER_CHANNELS_COUNT, inputBlockFrames, block.data());
+                }
+                doNotOptimize(block[0]);
+            }, 2, 3);
+
+            printBenchmarkResult(name, time, legacyTime);
+        }
+    }
+};
+}
+
+TEST_F(Audio_PolyphaseResamplerBenchmark, Upsampling_44100_48000)
+{
+    benchmark(44100, 48000);
+}
+
+TEST_F(Audio_PolyphaseResamplerBenchmark, Downsampling_48000_44100)
+{
+    benchmark(48000, 44100);
+}
+
+TEST_F(Audio_PolyphaseResamplerBenchmark, Downsampling_96000_48000)
+{
+    benchmark(96000, 48000);
+}
@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "audio/internal/fx/reverb/reverbkernels.h"
+#include "audio/internal/fx/reverb/reverbprocessor.h"
+
+#include "benchmarkutils.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::fx;
+using namespace muse::audio::benchmarks;
+
+namespace muse::audio {
+static constexpr unsigned int REVERB_BENCHMARK_SAMPLE_RATE = 44100;
+static constexpr unsigned int REVERB_BENCHMARK_BLOCK_FRAMES = 512;
+
+class Audio_ReverbBenchmark : public ::testing::Test
+{
+protected:
+    std::vector<ReverbKernelBackend> availableBackends() const
+    {
+        std::vector<ReverbKernelBackend> result;
+
+        for (ReverbKernelBackend backend : { ReverbKernelBackend::Scalar, ReverbKernelBackend::SSE2, ReverbKernelBackend::NEON,
+                                             ReverbKernelBackend::AVX2, ReverbKernelBackend::AVX512 }) {
+            if (isReverbKernelBackendAvailable(backend)) {
+                result.push_back(backend);
+            }
+        }
+
+        return result;
+    }
+};
+}
+
+//! NOTE The decay filters of all delay lines for one second of audio, the scalar backend is the baseline
+TEST_F(Audio_ReverbBenchmark, DecayFilters)
+{
+    for (int linesCount : { 8, 12, 16, 24 }) {
+        std::printf("Decay filters, %d delay lines, 1 s of audio per call\n", linesCount);
+
+        double scalarTime = 0.0;
+
+        for (ReverbKernelBackend backend : availableBackends()) {
+            const ReverbKernels* kernels = reverbKernels(backend);
+
+            ReverbDecayFilterBank bank;
+            for (int i = 0; i < linesCount; ++i) {
+                bank.gain.b0[i] = 0.6f;
+                bank.gain.b1[i] = 0.1f;
+                bank.gain.a1[i] = -0.3f;
+            }
+
+            alignas(64) float lines[ReverbDecayFilterBank::MAX_LINES] = {};
+
+            const double time = measureNanosecondsPerCall([&]() {
+                for (unsigned int s = 0; s < REVERB_BENCHMARK_SAMPLE_RATE; ++s) {
+                    lines[s % linesCount] += 0.5f;
+                    kernels->processDecayFilters(bank, lines, linesCount);
+                }
+                doNotOptimize(lines[0]);
+            }, 5, 3);
+
+            if (backend == ReverbKernelBackend::Scalar) {
+                scalarTime = time;
+            }
+
+            printBenchmarkResult(reverbKernelBackendName(backend), time, scalarTime);
+        }
+    }
+}
+
+//! NOTE The whole reverb with its default settings (24 delay lines), stereo, in blocks of a typical audio callback
+TEST_F(Audio_ReverbBenchmark, ReverbProcessor)
+{
+    std::printf("ReverbProcessor, 2 channels, 1 s of audio per call\n");
+
+    std::vector<float> input(REVERB_BENCHMARK_SAMPLE_RATE * 2);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.5f * static_cast<float>(std::sin(0.37 * i) * std::cos(0.011 * i));
+    }
+
+    std::vector<float> buffer = input;
+    double scalarTime = 0.0;
+
+    for (ReverbKernelBackend backend : availableBackends()) {
+        ReverbProcessor reverb(AudioFxParams(), 2);
+        reverb.setKernelBackend(backend);
+
+        const double time = measureNanosecondsPerCall([&]() {
+            buffer = input;
+
+            for (unsigned int from = 0; from < REVERB_BENCHMARK_SAMPLE_RATE; from += REVERB_BENCHMARK_BLOCK_FRAMES) {
+                reverb.process(buffer.data() + from * 2, std::min(REVERB_BENCHMARK_BLOCK_FRAMES, REVERB_BENCHMARK_SAMPLE_RATE - from));
+            }
+            doNotOptimize(buffer[0]);
+        }, 2, 3);
+
+        if (backend == ReverbKernelBackend::Scalar) {
+            scalarTime = time;
+        }
+
+        printBenchmarkResult(reverbKernelBackendName(backend), time, scalarTime);
+    }
+}
@@ -0,0 +1,243 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "audio/internal/soundfontindex.h"
+#include "audio/internal/synthesizers/fluidsynth/fluidsoundfontparser.h"
+
+#include "benchmarkutils.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::synth;
+using namespace muse::audio::benchmarks;
+
+namespace muse::audio {
+static constexpr size_t SOUNDFONT_BENCHMARK_FILES_COUNT = 50;
+static constexpr size_t SOUNDFONT_BENCHMARK_PRESETS_COUNT = 256;
+static constexpr size_t SOUNDFONT_BENCHMARK_ZONES_COUNT = 8;
+static constexpr size_t SOUNDFONT_BENCHMARK_SAMPLES_COUNT = 64;
+static constexpr size_t SOUNDFONT_BENCHMARK_SAMPLE_FRAMES = 4096;
+
+//! NOTE Writes a minimal but valid SF2: every preset has its own instrument
+//! split over the keyboard into several zones, like a typical General MIDI bank
+class SyntheticSoundFontWriter
+{
+public:
+    std::vector<char> write(size_t presetsCount, size_t zonesCount, size_t samplesCount, size_t sampleFrames)
+    {
+        std::vector<char> info = list("INFO", {
+            chunk("ifil", u16(2) + u16(1)),
+            chunk("isng", std::string("EMU8000", 8)),
+            chunk("INAM", std::string("Synthetic", 10)),
+        });
+
+        std::string smpl(samplesCount * (sampleFrames + 46) * sizeof(int16_t), '\0');
+        for (size_t i = 0; i < smpl.size() / sizeof(int16_t); ++i) {
+            int16_t value = static_cast<int16_t>((i * 37) % 20000) - 10000;
+            std::memcpy(&smpl[i * sizeof(int16_t)], &value, sizeof(value));
+        }
+
+        std::vector<char> sdta = list("sdta", { chunk("smpl", smpl) });
+
+        std::string phdr, pbag, pgen, inst, ibag, igen, shdr;
+
+        for (size_t p = 0; p < presetsCount; ++p) {
+            phdr += name("Preset " + std::to_string(p)) + u16(p % 128) + u16(p / 128) + u16(p) + u32(0) + u32(0) + u32(0);
+            pbag += u16(p) + u16(0);
+            pgen += u16(GEN_INSTRUMENT) + u16(p);
+
+            inst += name("Instrument " + std::to_string(p)) + u16(p * zonesCount);
+
+            for (size_t z = 0; z < zonesCount; ++z) {
+                size_t bag = p * zonesCount + z;
+                size_t lowKey = z * 128 / zonesCount;
+                size_t highKey = (z + 1) * 128 / zonesCount - 1;
+
+                ibag += u16(bag * 2) + u16(0);
+                igen += u16(GEN_KEY_RANGE) + u16(lowKey | (highKey << 8));
+                igen += u16(GEN_SAMPLE_ID) + u16(bag % samplesCount);
+            }
+        }
+
+        phdr += name("EOP") + u16(0) + u16(0) + u16(presetsCount) + u32(0) + u32(0) + u32(0);
+        pbag += u16(presetsCount) + u16(0);
+        pgen += u16(0) + u16(0);
+        inst += name("EOI") + u16(presetsCount * zonesCount);
+        ibag += u16(presetsCount * zonesCount * 2) + u16(0);
+        igen += u16(0) + u16(0);
+
+        for (size_t s = 0; s < samplesCount; ++s) {
+            uint32_t start = static_cast<uint32_t>(s * (sampleFrames + 46));
+            uint32_t end = start + static_cast<uint32_t>(sampleFrames);
+            shdr += name("Sample " + std::to_string(s)) + u32(start) + u32(end) + u32(start + 8) + u32(end - 8) + u32(44100)
+                    + std::string(1, char(60)) + std::string(1, char(0)) + u16(0) + u16(1);
+        }
+        shdr += name("EOS") + std::string(46 - 20, '\0');
+
+        std::vector<char> pdta = list("pdta", {
+            chunk("phdr", phdr), chunk("pbag", pbag), chunk("pmod", std::string(10, '\0')), chunk("pgen", pgen),
+            chunk("inst", inst), chunk("ibag", ibag), chunk("imod", std::string(10, '\0')), chunk("igen", igen),
+            chunk("shdr", shdr),
+        });
+
+        std::string body = "sfbk";
+        body.append(info.data(), info.size());
+        body.append(sdta.data(), sdta.size());
+        body.append(pdta.data(), pdta.size());
+
+        return chunk("RIFF", body);
+    }
+
+private:
+    static constexpr uint16_t GEN_INSTRUMENT = 41;
+    static constexpr uint16_t GEN_KEY_RANGE = 43;
+    static constexpr uint16_t GEN_SAMPLE_ID = 53;
+
+    static std::string u16(size_t value)
+    {
+        return std::string { char(value & 0xff), char((value >> 8) & 0xff) };
+    }
+
+    static std::string u32(size_t value)
+    {
+        return u16(value & 0xffff) + u16((value >> 16) & 0xffff);
+    }
+
+    static std::string name(const std::string& str)
+    {
+        std::string result = str.substr(0, 19);
+        result.resize(20, '\0');
+        return result;
+    }
+
+    static std::vector<char> chunk(const std::string& id, std::string data)
+    {
+        if (data.size() % 2) {
+            data.push_back('\0');
+        }
+
+        std::string result = id + u32(data.size()) + data;
+        return std::vector<char>(result.begin(), result.end());
+    }
+
+    static std::vector<char> list(const std::string& id, const std::vector<std::vector<char> >& chunks)
+    {
+        std::string data = id;
+        for (const std::vector<char>& c : chunks) {
+            data.append(c.data(), c.size());
+        }
+
+        return chunk("LIST", data);
+    }
+};
+
+class Audio_SoundFontIndexBenchmark : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "muse_audio_soundfontindexbenchmark";
+        std::filesystem::create_directories(m_dir);
+
+        std::vector<char> data = SyntheticSoundFontWriter().write(SOUNDFONT_BENCHMARK_PRESETS_COUNT, SOUNDFONT_BENCHMARK_ZONES_COUNT,
+                                                                  SOUNDFONT_BENCHMARK_SAMPLES_COUNT, SOUNDFONT_BENCHMARK_SAMPLE_FRAMES);
+
+        for (size_t i = 0; i < SOUNDFONT_BENCHMARK_FILES_COUNT; ++i) {
+            std::filesystem::path path = m_dir / ("synthetic" + std::to_string(i) + ".sf2");
+            std::ofstream(path, std::ios::binary).write(data.data(), data.size());
+            m_paths.push_back(SoundFontPath(path.string()));
+        }
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_dir, ec);
+    }
+
+    SoundFontFileStamp fileStamp(const SoundFontPath& path) const
+    {
+        SoundFontFileStamp stamp;
+        stamp.size = std::filesystem::file_size(path.toStdString());
+        stamp.lastModified = DateTime(Date(2024, 3, 1), Time(12, 30, 0));
+        return stamp;
+    }
+
+    std::filesystem::path m_dir;
+    SoundFontPaths m_paths;
+};
+}
+
+//! NOTE Time to know the presets of all the installed SoundFonts on startup
+TEST_F(Audio_SoundFontIndexBenchmark, Startup)
+{
+    std::printf("%zu SoundFonts, %zu presets each\n", m_paths.size(), SOUNDFONT_BENCHMARK_PRESETS_COUNT);
+
+    //! NOTE Every file is parsed one after another
+    double serial = measureNanosecondsPerCall([this]() {
+        for (const SoundFontPath& path : m_paths) {
+            RetVal<SoundFontMeta> meta = FluidSoundFontParser::parseSoundFont(path);
+            ASSERT_EQ(meta.val.presets.size(), SOUNDFONT_BENCHMARK_PRESETS_COUNT);
+        }
+    }, 1, 3);
+
+    //! NOTE No index yet, every file is parsed on the worker pool
+    double parallel = measureNanosecondsPerCall([this]() {
+        std::vector<RetVal<SoundFontMeta> > metas = FluidSoundFontParser::parseSoundFonts(m_paths);
+        for (const RetVal<SoundFontMeta>& meta : metas) {
+            ASSERT_EQ(meta.val.presets.size(), SOUNDFONT_BENCHMARK_PRESETS_COUNT);
+        }
+    }, 1, 3);
+
+    SoundFontIndex index;
+    std::vector<RetVal<SoundFontMeta> > metas = FluidSoundFontParser::parseSoundFonts(m_paths);
+    for (size_t i = 0; i < m_paths.size(); ++i) {
+        index.insert(fileStamp(m_paths[i]), metas[i].val);
+    }
+
+    const ByteArray indexData = index.toJson();
+
+    //! NOTE Nothing has changed, the index is read and every file is only stat'ed
+    double indexed = measureNanosecondsPerCall([this, &indexData]() {
+        SoundFontIndex loaded;
+        loaded.fromJson(indexData);
+
+        for (const SoundFontPath& path : m_paths) {
+            const SoundFontMeta* meta = loaded.find(path, fileStamp(path));
+            ASSERT_TRUE(meta);
+            ASSERT_EQ(meta->presets.size(), SOUNDFONT_BENCHMARK_PRESETS_COUNT);
+        }
+    }, 1, 3);
+
+    printBenchmarkResult("Parse serially", serial);
+    printBenchmarkResult("Parse on worker pool", parallel, serial);
+    printBenchmarkResult("Load from index (" + std::to_string(indexData.size() / 1024) + " KiB)", indexed, serial);
+}
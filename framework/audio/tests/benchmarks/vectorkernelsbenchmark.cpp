@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "audio/internal/dsp/vectorkernels.h"
+
+#include "benchmarkutils.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+using namespace muse::audio::benchmarks;
+
+namespace muse::audio {
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+static const std::vector<samples_t> BLOCK_SIZES = { 64, 256, 1024 };
+
+//! NOTE Every block size processes the same amount of samples per round
+static constexpr size_t SAMPLES_PER_ROUND = 1 << 21;
+
+class Audio_VectorKernelsBenchmark : public ::testing::Test
+{
+protected:
+    std::vector<VectorBackend> availableBackends() const
+    {
+        std::vector<VectorBackend> result;
+
+        for (VectorBackend backend : { VectorBackend::Scalar, VectorBackend::SSE2, VectorBackend::AVX2, VectorBackend::NEON }) {
+            if (isVectorBackendAvailable(backend)) {
+                result.push_back(backend);
+            }
+        }
+
+        return result;
+    }
+
+    //! NOTE Runs the given kernel for every backend and block size, the scalar backend is the baseline
+    template<typename Func>
+    void benchmark(const std::string& kernelName, Func&& runKernel)
+    {
+        std::printf("%s, %d channels\n", kernelName.c_str(), int(AUDIO_CHANNELS_COUNT));
+
+        for (samples_t blockSize : BLOCK_SIZES) {
+            const size_t size = blockSize * AUDIO_CHANNELS_COUNT;
+            std::vector<float> dst(size, 0.25f);
+            std::vector<float> src(size, 0.5f);
+
+            double scalarTime = 0.0;
+
+            for (VectorBackend backend : availableBackends()) {
+                const VectorKernels* kernels = vectorKernels(backend);
+
+                double time = measureNanosecondsPerCall([&]() {
+                    runKernel(*kernels, dst.data(), src.data(), blockSize);
+                    doNotOptimize(dst[0]);
+                }, SAMPLES_PER_ROUND / size);
+
+                if (backend == VectorBackend::Scalar) {
+                    scalarTime = time;
+                }
+
+                printBenchmarkResult(std::to_string(blockSize) + " frames, " + vectorBackendName(backend), time, scalarTime);
+            }
+        }
+    }
+};
+}
+
+TEST_F(Audio_VectorKernelsBenchmark, Accumulate)
+{
+    benchmark("accumulate", [](const VectorKernels& kernels, float* dst, const float* src, samples_t frames) {
+        kernels.accumulate(dst, src, frames * AUDIO_CHANNELS_COUNT);
+    });
+}
+
+TEST_F(Audio_VectorKernelsBenchmark, AccumulateScaled)
+{
+    benchmark("accumulateScaled", [](const VectorKernels& kernels, float* dst, const float* src, samples_t frames) {
+        kernels.accumulateScaled(dst, src, 0.5f, frames * AUDIO_CHANNELS_COUNT);
+    });
+}
+
+TEST_F(Audio_VectorKernelsBenchmark, ApplyGains)
+{
+    const gain_t gains[AUDIO_CHANNELS_COUNT] = { 1.f, -1.f };
+    float squaredSums[AUDIO_CHANNELS_COUNT] = {};
+
+    //! NOTE Unit gains keep the buffer away from denormals and infinities over the whole run
+    benchmark("applyGains", [&](const VectorKernels& kernels, float* dst, const float*, samples_t frames) {
+        kernels.applyGains(dst, frames, AUDIO_CHANNELS_COUNT, gains, squaredSums);
+        doNotOptimize(squaredSums[0]);
+    });
+}
+
+TEST_F(Audio_VectorKernelsBenchmark, SumOfSquares)
+{
+    benchmark("sumOfSquares", [](const VectorKernels& kernels, float*, const float* src, samples_t frames) {
+        doNotOptimize(kernels.sumOfSquares(src, frames * AUDIO_CHANNELS_COUNT));
+    });
+}
+
+TEST_F(Audio_VectorKernelsBenchmark, DotProduct)
+{
+    benchmark("dotProduct", [](const VectorKernels& kernels, float* dst, const float* src, samples_t frames) {
+        doNotOptimize(kernels.dotProduct(dst, src, frames * AUDIO_CHANNELS_COUNT));
+    });
+}
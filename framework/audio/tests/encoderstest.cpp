@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "audio/internal/encoders/flacencoder.h"
+#include "audio/internal/encoders/wavencoder.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::encode;
+
+namespace muse::audio {
+static constexpr sample_rate_t ENCODERS_TEST_SAMPLE_RATE = 48000;
+static constexpr audioch_t ENCODERS_TEST_CHANNELS_COUNT = 2;
+static constexpr samples_t ENCODERS_TEST_BLOCK_SIZE = 256;
+
+//! NOTE Includes blocks larger than the block size of the format, which the encoders get split
+static const std::vector<samples_t> ENCODERS_TEST_BLOCKS = { 1, 255, 700, 44, 256, 3 };
+
+class Audio_EncodersTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_destination, ec);
+    }
+
+    SoundTrackFormat format(SoundTrackType type) const
+    {
+        SoundTrackFormat format;
+        format.type = type;
+        format.sampleRate = ENCODERS_TEST_SAMPLE_RATE;
+        format.samplesPerChannel = ENCODERS_TEST_BLOCK_SIZE;
+        format.audioChannelsNumber = ENCODERS_TEST_CHANNELS_COUNT;
+
+        return format;
+    }
+
+    std::vector<float> signal(samples_t samplesPerChannel) const
+    {
+        std::vector<float> result(samplesPerChannel * ENCODERS_TEST_CHANNELS_COUNT);
+
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = 0.5f * std::sin(0.01f * static_cast<float>(i));
+        }
+
+        return result;
+    }
+
+    //! NOTE Encodes the signal in blocks of varying sizes, returns the number of encoded frames
+    samples_t encode(AbstractAudioEncoder& encoder, const std::vector<float>& input)
+    {
+        samples_t encoded = 0;
+
+        for (size_t i = 0; encoded * ENCODERS_TEST_CHANNELS_COUNT < input.size(); ++i) {
+            const samples_t rest = input.size() / ENCODERS_TEST_CHANNELS_COUNT - encoded;
+            const samples_t block = std::min(ENCODERS_TEST_BLOCKS[i % ENCODERS_TEST_BLOCKS.size()], rest);
+
+            EXPECT_EQ(encoder.encode(block, input.data() + encoded * ENCODERS_TEST_CHANNELS_COUNT),
+                      block * ENCODERS_TEST_CHANNELS_COUNT);
+            encoded += block;
+        }
+
+        return encoded;
+    }
+
+    std::vector<char> readFile() const
+    {
+        std::ifstream file(m_destination, std::ios::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    template<typename T>
+    static T readValue(const std::vector<char>& data, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        return value;
+    }
+
+    static uint64_t readBigEndian64(const std::vector<char>& data, size_t offset)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            value = (value << 8) | static_cast<uint8_t>(data[offset + i]);
+        }
+
+        return value;
+    }
+
+    std::filesystem::path m_destination;
+};
+}
+
+TEST_F(Audio_EncodersTest, WavHeaderHasActualLength)
+{
+    constexpr size_t WAV_HEADER_SIZE = 46;
+
+    //! [GIVEN] A WAV encoder expecting a longer stream than it will get
+    m_destination = std::filesystem::temp_directory_path() / "muse_audio_encoderstest.wav";
+    const std::vector<float> input = signal(3000);
+
+    WavEncoder encoder;
+    ASSERT_TRUE(encoder.init(m_destination.string(), format(SoundTrackType::WAV), 10000));
+
+    //! [WHEN] The stream is encoded in blocks of any size and flushed
+    ASSERT_EQ(encode(encoder, input), 3000);
+    EXPECT_TRUE(encoder.flush());
+    encoder.deinit();
+
+    //! [THEN] The header describes the samples which were actually written
+    const std::vector<char> data = readFile();
+    ASSERT_EQ(data.size(), WAV_HEADER_SIZE + input.size() * sizeof(float));
+
+    EXPECT_EQ(readValue<uint32_t>(data, 4), data.size() - 8);
+    EXPECT_EQ(std::string(data.data() + WAV_HEADER_SIZE - 8, 4), "data");
+    EXPECT_EQ(readValue<uint32_t>(data, WAV_HEADER_SIZE - 4), input.size() * sizeof(float));
+
+    //! [THEN] The samples are written in order
+    for (size_t i = 0; i < input.size(); ++i) {
+        ASSERT_EQ(readValue<float>(data, WAV_HEADER_SIZE + i * sizeof(float)), input[i]);
+    }
+}
+
+TEST_F(Audio_EncodersTest, FlacStreamInfoHasActualLength)
+{
+    //! [GIVEN] A 24 bit FLAC encoder expecting a longer stream than it will get
+    m_destination = std::filesystem::temp_directory_path() / "muse_audio_encoderstest.flac";
+    const std::vector<float> input = signal(5000);
+
+    SoundTrackFormat flacFormat = format(SoundTrackType::FLAC);
+    flacFormat.bitDepth = 24;
+
+    FlacEncoder encoder;
+    ASSERT_TRUE(encoder.init(m_destination.string(), flacFormat, 20000));
+
+    //! [WHEN] The stream is encoded in blocks of any size and flushed
+    ASSERT_EQ(encode(encoder, input), 5000);
+    EXPECT_TRUE(encoder.flush());
+    encoder.deinit();
+
+    //! [THEN] STREAMINFO, the first metadata block, has the actual length.
+    //! The sample rate, channels, bits per sample and total samples are packed into 64 bits at offset 18
+    const std::vector<char> data = readFile();
+    ASSERT_GT(data.size(), 26);
+    ASSERT_EQ(std::string(data.data(), 4), "fLaC");
+
+    const uint64_t streamInfo = readBigEndian64(data, 18);
+    EXPECT_EQ(streamInfo >> 44, ENCODERS_TEST_SAMPLE_RATE);
+    EXPECT_EQ(((streamInfo >> 41) & 0x7) + 1, ENCODERS_TEST_CHANNELS_COUNT);
+    EXPECT_EQ(((streamInfo >> 36) & 0x1f) + 1, 24);
+    EXPECT_EQ(streamInfo & ((uint64_t(1) << 36) - 1), 5000);
+}
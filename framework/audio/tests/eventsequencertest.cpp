@@ -0,0 +1,319 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "audio/internal/abstracteventsequencer.h"
+#include "audio/internal/audiosanitizer.h"
+
+#include "utils/allocationcounter.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+class TestEventSequencer : public AbstractEventSequencer<int>
+{
+public:
+    void setMainStream(const std::vector<std::pair<msecs_t, int> >& events)
+    {
+        m_mainStreamEvents.clear();
+        for (const auto& pair : events) {
+            m_mainStreamEvents.add(pair.first, pair.second);
+        }
+        updateMainStreamCursor();
+    }
+
+    void setOffStream(const std::vector<std::pair<msecs_t, int> >& events)
+    {
+        flushOffstream();
+        for (const auto& pair : events) {
+            m_offStreamEvents.add(pair.first, pair.second);
+        }
+        updateOffStreamCursor();
+    }
+
+    bool supportsRangeUpdates = false;
+    int fullUpdateCount = 0;
+    int rangeUpdateCount = 0;
+
+protected:
+    void updateOffStreamEvents(const mpe::PlaybackEventsMap&, const mpe::PlaybackParamList&) override {}
+
+    void updateMainStreamEvents(const mpe::PlaybackEventsMap&, const mpe::DynamicLevelLayers&, const mpe::PlaybackParamLayers&) override
+    {
+        ++fullUpdateCount;
+    }
+
+    bool canUpdateMainStreamRange(const mpe::MainStreamDelta&) const override
+    {
+        return supportsRangeUpdates;
+    }
+
+    void updateMainStreamRange(const mpe::MainStreamDelta&) override
+    {
+        ++rangeUpdateCount;
+    }
+};
+
+struct EventGroup {
+    std::vector<int> events;
+    msecs_t duration = 0;
+    bool isLast = false;
+};
+
+static std::vector<EventGroup> eventGroups(const TestEventSequencer::EventSpan& span)
+{
+    std::vector<EventGroup> result;
+
+    span.forEachGroup([&result](const TestEventSequencer::TimedEvent* begin, const TestEventSequencer::TimedEvent* end,
+                                msecs_t duration, bool isLast) {
+        EventGroup group;
+        for (const TestEventSequencer::TimedEvent* it = begin; it != end; ++it) {
+            group.events.push_back(std::get<int>(it->event));
+        }
+        group.duration = duration;
+        group.isLast = isLast;
+        result.push_back(std::move(group));
+
+        return true;
+    });
+
+    return result;
+}
+
+class Audio_EventSequencerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    TestEventSequencer m_sequencer;
+};
+}
+
+TEST_F(Audio_EventSequencerTest, MainStreamIsSplitIntoGroups)
+{
+    //! [GIVEN] Events added out of order, one of them twice
+    m_sequencer.setMainStream({ { 25, 3 }, { 10, 2 }, { 0, 1 }, { 10, 2 }, { 40, 5 }, { 25, 4 } });
+    m_sequencer.setActive(true);
+
+    //! [WHEN] Move the playback to 20 ms
+    std::vector<EventGroup> groups = eventGroups(m_sequencer.movePlaybackForward(20));
+
+    //! [THEN] The events at the block start and the ones up to the new position are returned, without duplicates
+    ASSERT_EQ(groups.size(), 2);
+    EXPECT_EQ(groups[0].events, std::vector<int>({ 1 }));
+    EXPECT_EQ(groups[0].duration, 10);
+    EXPECT_FALSE(groups[0].isLast);
+    EXPECT_EQ(groups[1].events, std::vector<int>({ 2 }));
+    EXPECT_TRUE(groups[1].isLast);
+
+    //! [WHEN] Move the playback to 40 ms
+    groups = eventGroups(m_sequencer.movePlaybackForward(20));
+
+    //! [THEN] The block starts with an empty group, the simultaneous events are sorted
+    ASSERT_EQ(groups.size(), 3);
+    EXPECT_TRUE(groups[0].events.empty());
+    EXPECT_EQ(groups[0].duration, 5);
+    EXPECT_EQ(groups[1].events, std::vector<int>({ 3, 4 }));
+    EXPECT_EQ(groups[1].duration, 15);
+    EXPECT_EQ(groups[2].events, std::vector<int>({ 5 }));
+    EXPECT_EQ(groups[2].duration, 0);
+    EXPECT_TRUE(groups[2].isLast);
+
+    //! [WHEN] Move past the last event
+    TestEventSequencer::EventSpan span = m_sequencer.movePlaybackForward(20);
+
+    //! [THEN] The span is empty
+    EXPECT_TRUE(span.empty());
+    EXPECT_EQ(span.from, 40);
+    EXPECT_EQ(span.to, 60);
+}
+
+TEST_F(Audio_EventSequencerTest, SeekMovesCursor)
+{
+    //! [GIVEN] A few events
+    m_sequencer.setMainStream({ { 0, 1 }, { 10, 2 }, { 25, 3 } });
+    m_sequencer.setActive(true);
+
+    //! [WHEN] Seek to an event and move forward
+    m_sequencer.setPlaybackPosition(10);
+    std::vector<EventGroup> groups = eventGroups(m_sequencer.movePlaybackForward(10));
+
+    //! [THEN] Playback continues from that event
+    ASSERT_EQ(groups.size(), 1);
+    EXPECT_EQ(groups[0].events, std::vector<int>({ 2 }));
+
+    //! [WHEN] Seek back
+    m_sequencer.setPlaybackPosition(0);
+    groups = eventGroups(m_sequencer.movePlaybackForward(30));
+
+    //! [THEN] All the events are played again
+    ASSERT_EQ(groups.size(), 3);
+    EXPECT_EQ(groups[2].events, std::vector<int>({ 3 }));
+}
+
+TEST_F(Audio_EventSequencerTest, OffStreamIsPlayedOnce)
+{
+    //! [GIVEN] An inactive sequencer with off stream events
+    int flushedCount = 0;
+    m_sequencer.setOnOffStreamFlushed([&flushedCount]() {
+        ++flushedCount;
+    });
+
+    m_sequencer.setOffStream({ { 0, 1 }, { 15, 2 } });
+
+    //! [WHEN] Play all the events
+    TestEventSequencer::EventSpan span = m_sequencer.movePlaybackForward(10);
+    ASSERT_EQ(span.last - span.first, 1);
+
+    span = m_sequencer.movePlaybackForward(10);
+    ASSERT_EQ(span.last - span.first, 1);
+    EXPECT_EQ(std::get<int>(span.first->event), 2);
+
+    //! [THEN] Nothing is played any more, and flushing doesn't report pending events
+    EXPECT_TRUE(m_sequencer.movePlaybackForward(10).empty());
+
+    m_sequencer.flushOffstream();
+    EXPECT_EQ(flushedCount, 0);
+
+    //! [WHEN] New events are flushed before being played
+    m_sequencer.setOffStream({ { 5, 3 } });
+    m_sequencer.flushOffstream();
+
+    //! [THEN] The flush is reported
+    EXPECT_EQ(flushedCount, 1);
+    EXPECT_TRUE(m_sequencer.movePlaybackForward(10).empty());
+}
+
+TEST_F(Audio_EventSequencerTest, MovePlaybackForwardDoesNotAllocate)
+{
+    //! [GIVEN] Many events
+    std::vector<std::pair<msecs_t, int> > events;
+    for (int i = 0; i < 10000; ++i) {
+        events.emplace_back(i * 3, i % 128);
+    }
+
+    m_sequencer.setMainStream(events);
+    m_sequencer.setActive(true);
+
+    //! [WHEN] Play them block by block
+    size_t eventCount = 0;
+
+    tests::AllocationCounter::start();
+
+    for (int block = 0; block < 3000; ++block) {
+        TestEventSequencer::EventSpan span = m_sequencer.movePlaybackForward(10);
+        span.forEachGroup([&eventCount](const TestEventSequencer::TimedEvent* begin, const TestEventSequencer::TimedEvent* end,
+                                        msecs_t, bool) {
+            eventCount += end - begin;
+            return true;
+        });
+    }
+
+    size_t allocations = tests::AllocationCounter::stop();
+
+    //! [THEN] Every event is played once, without heap allocations
+    EXPECT_EQ(eventCount, events.size());
+    EXPECT_EQ(allocations, 0);
+}
+
+TEST_F(Audio_EventSequencerTest, TimelineReplacesEventsOfRange)
+{
+    //! [GIVEN] A timeline with events generated from three chords, some of them after the next chord starts
+    EventTimeline<int> timeline;
+
+    timeline.setOrigin(0);
+    timeline.add(0, 1);
+    timeline.add(30, 2);
+
+    timeline.setOrigin(10);
+    timeline.add(10, 3);
+    timeline.add(25, 4);
+
+    timeline.setOrigin(20);
+    timeline.add(20, 5);
+    timeline.sort();
+
+    //! [WHEN] The chord at 10 ms is replaced by another one
+    timeline.removeOrigins(10, 20);
+
+    timeline.setOrigin(10);
+    timeline.add(12, 6);
+    timeline.add(40, 7);
+    timeline.sort();
+
+    //! [THEN] Only the events generated from that chord are replaced, the order is kept
+    std::vector<std::pair<msecs_t, int> > events;
+    for (size_t i = 0; i < timeline.size(); ++i) {
+        events.emplace_back(timeline.data()[i].timestamp, timeline.data()[i].event);
+    }
+
+    std::vector<std::pair<msecs_t, int> > expected = { { 0, 1 }, { 12, 6 }, { 20, 5 }, { 30, 2 }, { 40, 7 } };
+    EXPECT_EQ(events, expected);
+}
+
+TEST_F(Audio_EventSequencerTest, MainStreamDeltaIsSplicedOrFallsBackToFullUpdate)
+{
+    //! [GIVEN] Loaded playback data with chords at 0, 10 and 20 ms
+    mpe::PlaybackData data;
+    data.originEvents = { { 0, {} }, { 10, {} }, { 20, {} } };
+
+    m_sequencer.load(data);
+    EXPECT_EQ(m_sequencer.fullUpdateCount, 1);
+
+    //! [WHEN] The chord at 10 ms is moved to 15 ms, while the sequencer is inactive and can't update a range
+    mpe::MainStreamDelta delta;
+    delta.from = 10;
+    delta.to = 20;
+    delta.events = { { 15, {} } };
+
+    data.mainStreamDelta.send(delta);
+
+    //! [THEN] The playback data is updated, the full update is deferred until the sequencer is activated
+    std::vector<mpe::timestamp_t> timestamps;
+    for (const auto& pair : m_sequencer.playbackData().originEvents) {
+        timestamps.push_back(pair.first);
+    }
+
+    EXPECT_EQ(timestamps, std::vector<mpe::timestamp_t>({ 0, 15, 20 }));
+    EXPECT_EQ(m_sequencer.fullUpdateCount, 1);
+
+    m_sequencer.setActive(true);
+    EXPECT_EQ(m_sequencer.fullUpdateCount, 2);
+
+    //! [WHEN] The sequencer can update a range
+    m_sequencer.supportsRangeUpdates = true;
+    delta.events = { { 12, {} } };
+    data.mainStreamDelta.send(delta);
+
+    //! [THEN] Only the range is updated
+    EXPECT_EQ(m_sequencer.fullUpdateCount, 2);
+    EXPECT_EQ(m_sequencer.rangeUpdateCount, 1);
+    EXPECT_EQ(m_sequencer.playbackData().originEvents.size(), 3);
+    EXPECT_TRUE(m_sequencer.playbackData().originEvents.count(12));
+}
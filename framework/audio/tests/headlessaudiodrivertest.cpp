@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include "audio/internal/platform/headless/headlessaudiodriver.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+static constexpr unsigned int HEADLESS_DRIVER_SAMPLE_RATE = 48000;
+static constexpr uint16_t HEADLESS_DRIVER_BLOCK_FRAMES = 480; // 10 ms
+
+class Audio_HeadlessAudioDriverTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(outputFilePath(), ec);
+    }
+
+    IAudioDriver::Spec spec()
+    {
+        IAudioDriver::Spec spec;
+        spec.sampleRate = HEADLESS_DRIVER_SAMPLE_RATE;
+        spec.format = IAudioDriver::Format::AudioF32;
+        spec.channels = 2;
+        spec.samples = HEADLESS_DRIVER_BLOCK_FRAMES;
+        spec.callback = [this](void*, uint8_t* stream, int byteCount) {
+            float* samples = reinterpret_cast<float*>(stream);
+            for (size_t i = 0; i < byteCount / sizeof(float); ++i) {
+                samples[i] = 0.5f;
+            }
+            ++m_callbacksCount;
+        };
+
+        return spec;
+    }
+
+    std::filesystem::path outputFilePath() const
+    {
+        return std::filesystem::temp_directory_path() / "muse_audio_headlessaudiodrivertest.wav";
+    }
+
+    std::atomic<size_t> m_callbacksCount = 0;
+};
+}
+
+TEST_F(Audio_HeadlessAudioDriverTest, ManualClockPullsExactBlocks)
+{
+    //! [GIVEN] The driver with the manual clock
+    HeadlessAudioDriver::Options options;
+    options.manualClock = true;
+
+    HeadlessAudioDriver driver(options);
+    ASSERT_TRUE(driver.open(spec(), nullptr));
+
+    //! [WHEN] Nothing is advanced
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    //! [THEN] Nothing is pulled
+    EXPECT_EQ(m_callbacksCount, 0);
+    EXPECT_EQ(driver.virtualTime(), 0);
+
+    //! [WHEN] The clock is advanced by 100 blocks
+    EXPECT_EQ(driver.advance(100), 100);
+
+    //! [THEN] Exactly 100 blocks are pulled, one second on the virtual clock
+    EXPECT_EQ(m_callbacksCount, 100);
+    EXPECT_EQ(driver.virtualTime(), 1000000);
+
+    HeadlessAudioDriver::Stats stats = driver.stats();
+    EXPECT_EQ(stats.blocksCount, 100);
+    EXPECT_DOUBLE_EQ(stats.blockDurationUs, 10000.0);
+    EXPECT_LE(stats.p50CallbackUs, stats.p99CallbackUs);
+    EXPECT_LE(stats.p99CallbackUs, stats.maxCallbackUs);
+
+    //! [WHEN] The stats are reset
+    driver.resetStats();
+
+    //! [THEN] The clock keeps its position
+    EXPECT_EQ(driver.stats().blocksCount, 0);
+    EXPECT_EQ(driver.virtualTime(), 1000000);
+
+    driver.close();
+}
+
+TEST_F(Audio_HeadlessAudioDriverTest, FreeRunningClock)
+{
+    //! [GIVEN] The driver with the clock as fast as possible
+    HeadlessAudioDriver::Options options;
+    options.speed = 0.0;
+
+    HeadlessAudioDriver driver(options);
+    ASSERT_TRUE(driver.open(spec(), nullptr));
+
+    //! [WHEN] It runs on its own thread
+    while (driver.virtualTime() < 1000000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    driver.close();
+
+    //! [THEN] Every pulled block is on the virtual clock, and the driver stops pulling when closed
+    const size_t callbacksCount = m_callbacksCount;
+    EXPECT_EQ(driver.virtualTime(), static_cast<msecs_t>(callbacksCount * 10000));
+    EXPECT_FALSE(driver.isOpened());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(m_callbacksCount, callbacksCount);
+}
+
+TEST_F(Audio_HeadlessAudioDriverTest, WritesWavFile)
+{
+    //! [GIVEN] The driver writing into a file
+    HeadlessAudioDriver::Options options;
+    options.manualClock = true;
+    options.outputFilePath = outputFilePath().string();
+
+    HeadlessAudioDriver driver(options);
+    ASSERT_TRUE(driver.open(spec(), nullptr));
+
+    //! [WHEN] 10 blocks are pulled and the driver is closed
+    driver.advance(10);
+    driver.close();
+
+    //! [THEN] The file is a float WAV with all the pulled samples
+    constexpr size_t HEADER_SIZE = 44;
+    constexpr size_t DATA_SIZE = 10 * HEADLESS_DRIVER_BLOCK_FRAMES * 2 * sizeof(float);
+    EXPECT_EQ(std::filesystem::file_size(outputFilePath()), HEADER_SIZE + DATA_SIZE);
+}
@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "audio/internal/dsp/lookaheadlimiter.h"
+#include "audio/internal/dsp/loudnessmeter.h"
+#include "utils/allocationcounter.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+namespace muse::audio {
+static constexpr sample_rate_t LIMITER_SAMPLE_RATE = 48000;
+static constexpr audioch_t LIMITER_CHANNELS_COUNT = 2;
+static constexpr double LIMITER_TWO_PI = 6.283185307179586;
+
+class Audio_LookAheadLimiterTest : public ::testing::Test
+{
+protected:
+    //! NOTE A sine, which jumps to the loud amplitude for a short burst in the middle
+    std::vector<float> burst(float quietAmplitude, float loudAmplitude, samples_t frames) const
+    {
+        std::vector<float> buffer(frames * LIMITER_CHANNELS_COUNT);
+
+        for (samples_t s = 0; s < frames; ++s) {
+            const bool isLoud = s > frames / 3 && s < frames / 2;
+            const float amplitude = isLoud ? loudAmplitude : quietAmplitude;
+            const float value = static_cast<float>(std::sin(LIMITER_TWO_PI * 3217.0 * s / LIMITER_SAMPLE_RATE + 0.3));
+
+            buffer[s * LIMITER_CHANNELS_COUNT] = amplitude * value;
+            buffer[s * LIMITER_CHANNELS_COUNT + 1] = -0.5f * amplitude * value;
+        }
+
+        return buffer;
+    }
+
+    void process(LookAheadLimiter& limiter, std::vector<float>& buffer, samples_t blockSize)
+    {
+        const samples_t frames = buffer.size() / LIMITER_CHANNELS_COUNT;
+
+        for (samples_t s = 0; s < frames; s += blockSize) {
+            limiter.process(buffer.data() + s * LIMITER_CHANNELS_COUNT, std::min(blockSize, frames - s));
+        }
+    }
+
+    float amplitudeOf(float dbfs) const
+    {
+        return std::pow(10.f, dbfs / 20.f);
+    }
+};
+}
+
+TEST_F(Audio_LookAheadLimiterTest, ReportsItsLatency)
+{
+    //! [GIVEN] A limiter with the shortest look-ahead
+    LookAheadLimiter limiter(LIMITER_SAMPLE_RATE, LIMITER_CHANNELS_COUNT, 1.f);
+
+    //! [THEN] The latency is the look-ahead plus the delay of the true-peak interpolation
+    EXPECT_EQ(limiter.latency(), 48 + 6);
+
+    //! [WHEN] The look-ahead is longer than allowed
+    limiter.setLookAheadMs(20.f);
+
+    //! [THEN] It is limited to 5 ms
+    EXPECT_FLOAT_EQ(limiter.lookAheadMs(), LookAheadLimiter::MAX_LOOK_AHEAD_MS);
+    EXPECT_EQ(limiter.latency(), 240 + 6);
+}
+
+TEST_F(Audio_LookAheadLimiterTest, QuietSignalIsOnlyDelayed)
+{
+    //! [GIVEN] A limiter and a signal well below its ceiling
+    LookAheadLimiter limiter(LIMITER_SAMPLE_RATE, LIMITER_CHANNELS_COUNT);
+    const std::vector<float> input = burst(amplitudeOf(-12.f), amplitudeOf(-6.f), LIMITER_SAMPLE_RATE / 4);
+
+    //! [WHEN] Process it
+    std::vector<float> output = input;
+    process(limiter, output, 441);
+
+    //! [THEN] The output is the input delayed by the latency
+    const size_t delay = limiter.latency() * LIMITER_CHANNELS_COUNT;
+
+    for (size_t i = 0; i < delay; ++i) {
+        EXPECT_FLOAT_EQ(output[i], 0.f);
+    }
+
+    for (size_t i = delay; i < output.size(); ++i) {
+        EXPECT_FLOAT_EQ(output[i], input[i - delay]);
+    }
+}
+
+TEST_F(Audio_LookAheadLimiterTest, TruePeakStaysBelowCeiling)
+{
+    //! [GIVEN] A limiter with the ceiling at -1 dBTP
+    LookAheadLimiter limiter(LIMITER_SAMPLE_RATE, LIMITER_CHANNELS_COUNT, 2.f);
+    limiter.setCeiling(-1.f);
+
+    //! [GIVEN] A signal, which jumps 7 dB over the ceiling
+    std::vector<float> buffer = burst(amplitudeOf(-6.f), amplitudeOf(6.f), LIMITER_SAMPLE_RATE / 2);
+
+    //! [WHEN] Process it in blocks of an odd size
+    process(limiter, buffer, 37);
+
+    //! [THEN] No sample is over the ceiling
+    const float ceiling = amplitudeOf(-1.f);
+    float samplePeak = 0.f;
+
+    for (float sample : buffer) {
+        samplePeak = std::max(samplePeak, std::abs(sample));
+    }
+
+    EXPECT_LE(samplePeak, ceiling * 1.0001f);
+    EXPECT_GT(samplePeak, ceiling * 0.9f);
+
+    //! [THEN] The true-peak of the output is at the ceiling too; the gain changes during
+    //! the interpolation window, so it may differ a bit from the detected one
+    LoudnessMeter meter(LIMITER_SAMPLE_RATE, LIMITER_CHANNELS_COUNT);
+    meter.process(buffer.data(), buffer.size() / LIMITER_CHANNELS_COUNT);
+
+    EXPECT_LE(meter.truePeak(), amplitudeOf(-0.9f));
+}
+
+TEST_F(Audio_LookAheadLimiterTest, OutputDoesNotDependOnBlockSize)
+{
+    //! [GIVEN] Two limiters and a signal over the ceiling
+    LookAheadLimiter smallBlocksLimiter(LIMITER_SAMPLE_RATE, LIMITER_CHANNELS_COUNT);
+    LookAheadLimiter largeBlocksLimiter(LIMITER_SAMPLE_RATE, LIMITER_CHANNELS_COUNT);
+
+    std::vector<float> smallBlocks = burst(amplitudeOf(-3.f), amplitudeOf(9.f), LIMITER_SAMPLE_RATE / 4);
+    std::vector<float> largeBlocks = smallBlocks;
+
+    //! [WHEN] The same signal is processed in blocks of different sizes
+    process(smallBlocksLimiter, smallBlocks, 32);
+    process(largeBlocksLimiter, largeBlocks, 2048);
+
+    //! [THEN] The outputs are the same, the gain envelope follows the samples and not the blocks
+    for (size_t i = 0; i < smallBlocks.size(); ++i) {
+        EXPECT_FLOAT_EQ(smallBlocks[i], largeBlocks[i]);
+    }
+}
+
+TEST_F(Audio_LookAheadLimiterTest, GainIsReleasedAfterPeak)
+{
+    //! [GIVEN] A limiter and a signal over the ceiling, which becomes quiet again
+    LookAheadLimiter limiter(LIMITER_SAMPLE_RATE, LIMITER_CHANNELS_COUNT);
+    std::vector<float> buffer = burst(amplitudeOf(-20.f), amplitudeOf(6.f), LIMITER_SAMPLE_RATE);
+
+    //! [WHEN] Process it up to the end of the loud part
+    const samples_t loudEnd = LIMITER_SAMPLE_RATE / 2;
+    limiter.process(buffer.data(), loudEnd);
+
+    //! [THEN] The gain is reduced
+    EXPECT_LT(limiter.currentGain(), 0.6f);
+
+    //! [WHEN] Process the quiet rest
+    limiter.process(buffer.data() + loudEnd * LIMITER_CHANNELS_COUNT, LIMITER_SAMPLE_RATE - loudEnd);
+
+    //! [THEN] The gain is back at unity
+    EXPECT_NEAR(limiter.currentGain(), 1.f, 1e-3f);
+}
+
+TEST_F(Audio_LookAheadLimiterTest, ProcessDoesNotAllocate)
+{
+    //! [GIVEN] A limiter and a block over the ceiling
+    LookAheadLimiter limiter(LIMITER_SAMPLE_RATE, LIMITER_CHANNELS_COUNT);
+    std::vector<float> buffer = burst(amplitudeOf(0.f), amplitudeOf(12.f), 4096);
+
+    //! [WHEN] Process it
+    tests::AllocationCounter::start();
+    limiter.process(buffer.data(), 4096);
+    size_t allocations = tests::AllocationCounter::stop();
+
+    //! [THEN] No heap allocations were made
+    EXPECT_EQ(allocations, 0);
+}
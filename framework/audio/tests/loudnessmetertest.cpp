@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "audio/internal/dsp/loudnessmeter.h"
+#include "utils/allocationcounter.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+namespace muse::audio {
+static constexpr sample_rate_t LOUDNESS_SAMPLE_RATE = 48000;
+static constexpr double LOUDNESS_TWO_PI = 6.283185307179586;
+
+class Audio_LoudnessMeterTest : public ::testing::Test
+{
+protected:
+    //! NOTE The same sine in every channel
+    std::vector<float> sine(float frequency, float amplitude, float seconds, audioch_t channels, double phase = 0.0) const
+    {
+        const samples_t frames = static_cast<samples_t>(seconds * LOUDNESS_SAMPLE_RATE);
+        std::vector<float> buffer(frames * channels);
+
+        for (samples_t s = 0; s < frames; ++s) {
+            const float sample = amplitude * static_cast<float>(std::sin(LOUDNESS_TWO_PI * frequency * s / LOUDNESS_SAMPLE_RATE + phase));
+
+            for (audioch_t ch = 0; ch < channels; ++ch) {
+                buffer[s * channels + ch] = sample;
+            }
+        }
+
+        return buffer;
+    }
+
+    //! NOTE Feeds the buffer in blocks of a typical playback size
+    void process(LoudnessMeter& meter, const std::vector<float>& buffer, samples_t blockSize = 441)
+    {
+        const audioch_t channels = meter.audioChannelsCount();
+        const samples_t frames = buffer.size() / channels;
+
+        for (samples_t s = 0; s < frames; s += blockSize) {
+            meter.process(buffer.data() + s * channels, std::min(blockSize, frames - s));
+        }
+    }
+
+    float amplitudeOf(float dbfs) const
+    {
+        return std::pow(10.f, dbfs / 20.f);
+    }
+};
+}
+
+TEST_F(Audio_LoudnessMeterTest, StereoSineReadsItsLevel)
+{
+    //! [GIVEN] A 1 kHz sine at -23 dBFS in both channels (the EBU Tech 3341 reference)
+    LoudnessMeter meter(LOUDNESS_SAMPLE_RATE, 2);
+    std::vector<float> buffer = sine(1000.f, amplitudeOf(-23.f), 20.f, 2);
+
+    //! [WHEN] Measure it
+    process(meter, buffer);
+
+    //! [THEN] All the loudness values are -23 LUFS
+    EXPECT_NEAR(meter.momentaryLoudness(), -23.f, 0.1f);
+    EXPECT_NEAR(meter.shortTermLoudness(), -23.f, 0.1f);
+    EXPECT_NEAR(meter.integratedLoudness(), -23.f, 0.1f);
+}
+
+TEST_F(Audio_LoudnessMeterTest, IntegratedLoudnessIsGated)
+{
+    //! [GIVEN] 10 s of a sine at -20 dBFS, 10 s of a sine at -36 dBFS and 10 s of silence
+    LoudnessMeter meter(LOUDNESS_SAMPLE_RATE, 2);
+
+    process(meter, sine(1000.f, amplitudeOf(-20.f), 10.f, 2));
+    process(meter, sine(1000.f, amplitudeOf(-36.f), 10.f, 2));
+    process(meter, std::vector<float>(10 * LOUDNESS_SAMPLE_RATE * 2, 0.f));
+
+    //! [THEN] The quiet part is below the relative gate and the silence below the absolute one, only the loud part counts
+    EXPECT_NEAR(meter.integratedLoudness(), -20.f, 0.1f);
+
+    //! [THEN] The short windows follow the silence
+    EXPECT_EQ(meter.momentaryLoudness(), MINIMUM_OPERABLE_DBFS_LEVEL);
+    EXPECT_EQ(meter.shortTermLoudness(), MINIMUM_OPERABLE_DBFS_LEVEL);
+
+    //! [WHEN] Reset it
+    meter.reset();
+
+    //! [THEN] Nothing is measured
+    EXPECT_EQ(meter.integratedLoudness(), MINIMUM_OPERABLE_DBFS_LEVEL);
+    EXPECT_EQ(meter.truePeak(), 0.f);
+}
+
+TEST_F(Audio_LoudnessMeterTest, TruePeakFindsInterSamplePeaks)
+{
+    //! [GIVEN] A sine at a quarter of the sample rate, sampled 45 degrees off its peaks
+    LoudnessMeter meter(LOUDNESS_SAMPLE_RATE, 1);
+    std::vector<float> buffer = sine(LOUDNESS_SAMPLE_RATE / 4.f, 0.5f, 1.f, 1, LOUDNESS_TWO_PI / 8.0);
+
+    float samplePeak = 0.f;
+    for (float sample : buffer) {
+        samplePeak = std::max(samplePeak, std::abs(sample));
+    }
+
+    //! [WHEN] Measure it
+    process(meter, buffer);
+
+    //! [THEN] The sample peak is 3 dB below the actual one, the true peak is close to it
+    EXPECT_NEAR(samplePeak, 0.5f * std::sqrt(0.5f), 1e-3f);
+    EXPECT_NEAR(meter.truePeak(), 0.5f, 0.5f * 0.06f);
+}
+
+TEST_F(Audio_LoudnessMeterTest, ProcessDoesNotAllocate)
+{
+    //! [GIVEN] A meter and a few seconds of audio
+    LoudnessMeter meter(LOUDNESS_SAMPLE_RATE, 2);
+    std::vector<float> buffer = sine(440.f, 0.5f, 5.f, 2);
+
+    //! [WHEN] Measure it
+    tests::AllocationCounter::start();
+    process(meter, buffer, 1024);
+    size_t allocations = tests::AllocationCounter::stop();
+
+    //! [THEN] No heap allocations were made
+    EXPECT_EQ(allocations, 0);
+    EXPECT_GT(meter.integratedLoudness(), MINIMUM_OPERABLE_DBFS_LEVEL);
+}
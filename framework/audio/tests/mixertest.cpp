@@ -0,0 +1,797 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "audio/internal/worker/mixer.h"
+#include "audio/internal/worker/clock.h"
+#include "audio/internal/audiosanitizer.h"
+
+#include "mocks/audioconfigurationmock.h"
+#include "mocks/fxresolvermock.h"
+#include "utils/allocationcounter.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr samples_t SAMPLES_TO_PREALLOCATE = 1024;
+
+//! NOTE Produces a constant signal
+class ConstantTrackSource : public ITrackAudioInput
+{
+public:
+    ConstantTrackSource(float value)
+        : m_value(value) {}
+
+    bool isActive() const override { return m_isActive; }
+    void setIsActive(bool arg) override { m_isActive = arg; }
+
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return AUDIO_CHANNELS_COUNT; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+    void notifyAudioChannelsCountChanged() { m_audioChannelsCountChanged.send(AUDIO_CHANNELS_COUNT); }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        std::fill(buffer, buffer + samplesPerChannel * AUDIO_CHANNELS_COUNT, m_value);
+        return samplesPerChannel;
+    }
+
+    void seek(const msecs_t) override {}
+    void flush() override {}
+
+    const AudioInputParams& inputParams() const override { return m_params; }
+    void applyInputParams(const AudioInputParams& params) override { m_params = params; }
+    async::Channel<AudioInputParams> inputParamsChanged() const override { return m_paramsChanged; }
+
+private:
+    float m_value = 0.f;
+    bool m_isActive = false;
+    AudioInputParams m_params;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+    async::Channel<AudioInputParams> m_paramsChanged;
+};
+
+//! NOTE Produces a different constant signal on each audio channel, renders planar audio natively
+class PlanarTrackSource : public ConstantTrackSource
+{
+public:
+    PlanarTrackSource(float left, float right)
+        : ConstantTrackSource(left), m_left(left), m_right(right) {}
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            buffer[s * AUDIO_CHANNELS_COUNT] = m_left;
+            buffer[s * AUDIO_CHANNELS_COUNT + 1] = m_right;
+        }
+
+        ++interleavedCalls;
+        return samplesPerChannel;
+    }
+
+    bool supportsPlanarProcessing() const override { return true; }
+
+    samples_t processPlanar(float* const* buffers, samples_t samplesPerChannel) override
+    {
+        std::fill(buffers[0], buffers[0] + samplesPerChannel, m_left);
+        std::fill(buffers[1], buffers[1] + samplesPerChannel, m_right);
+
+        ++planarCalls;
+        return samplesPerChannel;
+    }
+
+    size_t interleavedCalls = 0;
+    size_t planarCalls = 0;
+
+private:
+    float m_left = 0.f;
+    float m_right = 0.f;
+};
+
+//! NOTE Multiplies the signal by a constant gain
+class GainFxProcessor : public IFxProcessor
+{
+public:
+    GainFxProcessor(const AudioFxParams& params, float gain, bool planar = false)
+        : m_params(params), m_gain(gain), m_planar(planar) {}
+
+    AudioFxType type() const override { return m_params.type(); }
+    const AudioFxParams& params() const override { return m_params; }
+    async::Channel<audio::AudioFxParams> paramsChanged() const override { return m_paramsChanged; }
+    void setSampleRate(unsigned int) override {}
+
+    bool active() const override { return m_params.active; }
+    void setActive(bool active) override { m_params.active = active; }
+
+    void process(float* buffer, unsigned int sampleCount) override
+    {
+        std::transform(buffer, buffer + sampleCount * AUDIO_CHANNELS_COUNT, buffer, [this](float sample) {
+            return sample * m_gain;
+        });
+    }
+
+    bool supportsPlanarProcessing() const override { return m_planar; }
+
+    void processPlanar(float* const* buffers, unsigned int sampleCount) override
+    {
+        for (audioch_t ch = 0; ch < AUDIO_CHANNELS_COUNT; ++ch) {
+            std::transform(buffers[ch], buffers[ch] + sampleCount, buffers[ch], [this](float sample) {
+                return sample * m_gain;
+            });
+        }
+    }
+
+private:
+    AudioFxParams m_params;
+    float m_gain = 1.f;
+    bool m_planar = false;
+    async::Channel<audio::AudioFxParams> m_paramsChanged;
+};
+
+class Audio_MixerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+
+        ON_CALL(*m_configuration, audioChannelsCount()).WillByDefault(Return(AUDIO_CHANNELS_COUNT));
+        ON_CALL(*m_configuration, samplesToPreallocate()).WillByDefault(Return(SAMPLES_TO_PREALLOCATE));
+        ON_CALL(*m_configuration, desiredAudioThreadNumber()).WillByDefault(Return(2));
+
+        //! NOTE Render all tracks on the calling thread by default
+        ON_CALL(*m_configuration, minTrackCountForMultithreading()).WillByDefault(Return(std::numeric_limits<size_t>::max()));
+        ON_CALL(*m_configuration, audioThreadPoolType()).WillByDefault(Return(AudioThreadPoolType::WorkStealing));
+
+        m_fxResolver = std::make_shared<NiceMock<fx::FxResolverMock> >();
+
+        modularity::globalIoc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+        modularity::globalIoc()->registerExport<fx::IFxResolver>("utests", m_fxResolver);
+    }
+
+    void TearDown() override
+    {
+        m_mixer = nullptr;
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+        modularity::globalIoc()->unregister<fx::IFxResolver>("utests");
+    }
+
+    void initMixer()
+    {
+        m_mixer = std::make_shared<Mixer>(modularity::globalCtx());
+        m_mixer->setAudioChannelsCount(AUDIO_CHANNELS_COUNT);
+        m_mixer->setSampleRate(SAMPLE_RATE);
+        m_mixer->setIsIdle(false);
+        m_mixer->setIsActive(true);
+    }
+
+    void enableMultithreading(AudioThreadPoolType type)
+    {
+        ON_CALL(*m_configuration, minTrackCountForMultithreading()).WillByDefault(Return(2));
+        ON_CALL(*m_configuration, audioThreadPoolType()).WillByDefault(Return(type));
+    }
+
+    void expectProcessDoesNotAllocate()
+    {
+        std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+
+        //! [GIVEN] The mixer has already rendered a few blocks
+        for (int i = 0; i < 4; ++i) {
+            m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+        }
+
+        //! [WHEN] Process more blocks of different sizes
+        tests::AllocationCounter::start();
+
+        for (samples_t samples : { SAMPLES_TO_PREALLOCATE, samples_t(512), samples_t(128), SAMPLES_TO_PREALLOCATE }) {
+            m_mixer->process(buffer.data(), samples);
+        }
+
+        size_t allocations = tests::AllocationCounter::stop();
+
+        //! [THEN] No heap allocations were made
+        EXPECT_EQ(allocations, 0);
+    }
+
+    void addTracks(size_t count, float value)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            RetVal<MixerChannelPtr> channel = m_mixer->addChannel(static_cast<TrackId>(i), std::make_shared<ConstantTrackSource>(value));
+            ASSERT_TRUE(channel.ret);
+            m_trackChannels.push_back(channel.val);
+        }
+    }
+
+    //! NOTE Adds an aux bus with a gain fx, so that it is part of the processing graph
+    MixerChannelPtr addAuxBus(TrackId auxTrackId, float gain)
+    {
+        AudioFxParams fxParams;
+        fxParams.chainOrder = 0;
+        fxParams.active = true;
+        fxParams.resourceMeta.id = "gain";
+        fxParams.resourceMeta.type = AudioResourceType::MusePlugin;
+
+        ON_CALL(*m_fxResolver, resolveFxList(auxTrackId, _)).WillByDefault([fxParams, gain](const TrackId, const AudioFxChain&) {
+            return std::vector<IFxProcessorPtr> { std::make_shared<GainFxProcessor>(fxParams, gain) };
+        });
+
+        MixerChannelPtr aux = m_mixer->addAuxChannel(auxTrackId).val;
+
+        AudioOutputParams params;
+        params.fxChain.emplace(fxParams.chainOrder, fxParams);
+        aux->applyOutputParams(params);
+
+        return aux;
+    }
+
+    void addGainFx(MixerChannelPtr channel, float gain, bool planar)
+    {
+        AudioFxParams fxParams;
+        fxParams.chainOrder = 0;
+        fxParams.active = true;
+        fxParams.resourceMeta.id = "gain";
+        fxParams.resourceMeta.type = AudioResourceType::MusePlugin;
+
+        ON_CALL(*m_fxResolver, resolveFxList(channel->trackId(), _)).WillByDefault([fxParams, gain, planar](const TrackId,
+                                                                                                             const AudioFxChain&) {
+            return std::vector<IFxProcessorPtr> { std::make_shared<GainFxProcessor>(fxParams, gain, planar) };
+        });
+
+        AudioOutputParams params = channel->outputParams();
+        params.fxChain.emplace(fxParams.chainOrder, fxParams);
+        channel->applyOutputParams(params);
+    }
+
+    void sendTracksToAux(aux_channel_idx_t auxIdx, size_t firstTrack, size_t trackCount, float signalAmount)
+    {
+        for (size_t i = firstTrack; i < firstTrack + trackCount; ++i) {
+            AudioOutputParams params = m_trackChannels.at(i)->outputParams();
+            params.auxSends.resize(std::max<size_t>(params.auxSends.size(), auxIdx + 1));
+            params.auxSends[auxIdx] = AuxSendParams { signalAmount, true };
+            m_trackChannels.at(i)->applyOutputParams(params);
+        }
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+    std::shared_ptr<NiceMock<fx::FxResolverMock> > m_fxResolver;
+    std::vector<MixerChannelPtr> m_trackChannels;
+    MixerPtr m_mixer;
+};
+}
+
+TEST_F(Audio_MixerTest, SumsTrackChannels)
+{
+    //! [GIVEN] Three tracks producing a constant signal
+    initMixer();
+    addTracks(3, 0.1f);
+
+    //! [WHEN] Process a block
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    samples_t processed = m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The output is the sum of all tracks
+    EXPECT_EQ(processed, SAMPLES_TO_PREALLOCATE);
+
+    for (float sample : buffer) {
+        EXPECT_NEAR(sample, 0.3f, 1e-6f);
+    }
+}
+
+TEST_F(Audio_MixerTest, SumsTrackChannels_WorkStealing)
+{
+    //! [GIVEN] Many tracks rendered in parallel
+    enableMultithreading(AudioThreadPoolType::WorkStealing);
+    initMixer();
+    addTracks(32, 0.01f);
+
+    //! [WHEN] Process a block
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] Every track was mixed exactly once
+    for (float sample : buffer) {
+        EXPECT_NEAR(sample, 0.32f, 1e-5f);
+    }
+}
+
+TEST_F(Audio_MixerTest, PlanarChainIsInterleavedOnce)
+{
+    //! [GIVEN] A track with a planar source and a planar fx
+    initMixer();
+    auto source = std::make_shared<PlanarTrackSource>(0.1f, 0.2f);
+    MixerChannelPtr channel = m_mixer->addChannel(0, source).val;
+    addGainFx(channel, 2.f, true);
+
+    //! [WHEN] Process a block
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The source was rendered in the planar mode, and the channels are in their places in the output
+    EXPECT_EQ(source->planarCalls, 1);
+    EXPECT_EQ(source->interleavedCalls, 0);
+
+    for (samples_t s = 0; s < SAMPLES_TO_PREALLOCATE; ++s) {
+        EXPECT_NEAR(buffer[s * AUDIO_CHANNELS_COUNT], 0.2f, 1e-6f);
+        EXPECT_NEAR(buffer[s * AUDIO_CHANNELS_COUNT + 1], 0.4f, 1e-6f);
+    }
+}
+
+TEST_F(Audio_MixerTest, InterleavedFxDisablesPlanarChain)
+{
+    //! [GIVEN] A track with a planar source, but an fx which only works on interleaved buffers
+    initMixer();
+    auto source = std::make_shared<PlanarTrackSource>(0.1f, 0.2f);
+    MixerChannelPtr channel = m_mixer->addChannel(0, source).val;
+    addGainFx(channel, 2.f, false);
+
+    //! [WHEN] Process a block
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The whole chain ran interleaved, with the same result
+    EXPECT_EQ(source->planarCalls, 0);
+    EXPECT_EQ(source->interleavedCalls, 1);
+
+    for (samples_t s = 0; s < SAMPLES_TO_PREALLOCATE; ++s) {
+        EXPECT_NEAR(buffer[s * AUDIO_CHANNELS_COUNT], 0.2f, 1e-6f);
+        EXPECT_NEAR(buffer[s * AUDIO_CHANNELS_COUNT + 1], 0.4f, 1e-6f);
+    }
+}
+
+TEST_F(Audio_MixerTest, PlanarBuffersAreAllocatedBeforeProcessing)
+{
+    //! [GIVEN] A track with a planar source and a planar fx, which has only rendered small blocks so far
+    initMixer();
+    auto source = std::make_shared<PlanarTrackSource>(0.1f, 0.2f);
+    MixerChannelPtr channel = m_mixer->addChannel(0, source).val;
+    addGainFx(channel, 2.f, true);
+
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), 64);
+
+    //! [WHEN] Process a block of the largest size
+    tests::AllocationCounter::start();
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+    size_t allocations = tests::AllocationCounter::stop();
+
+    //! [THEN] The planar chain ran in the buffers allocated when the channel was added
+    EXPECT_EQ(source->planarCalls, 2);
+    EXPECT_EQ(allocations, 0);
+}
+
+TEST_F(Audio_MixerTest, MetersArePublishedWithoutNotifications)
+{
+    //! [GIVEN] Two tracks producing a constant signal
+    initMixer();
+    addTracks(2, 0.25f);
+
+    AudioMeterPtr trackMeter = m_trackChannels.front()->audioMeter();
+    AudioMeterPtr masterMeter = m_mixer->masterAudioMeter();
+
+    //! [WHEN] Process a block
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The track and master meters hold the levels of the block
+    EXPECT_EQ(trackMeter->channelsCount(), AUDIO_CHANNELS_COUNT);
+    EXPECT_EQ(masterMeter->channelsCount(), AUDIO_CHANNELS_COUNT);
+
+    for (audioch_t ch = 0; ch < AUDIO_CHANNELS_COUNT; ++ch) {
+        AudioMeterValue track = trackMeter->value(ch);
+        EXPECT_NEAR(track.peak, 0.25f, 1e-6f);
+        EXPECT_NEAR(track.rms, 0.25f, 1e-5f);
+        EXPECT_NEAR(track.peakHold, 0.25f, 1e-6f);
+
+        AudioMeterValue master = masterMeter->value(ch);
+        EXPECT_NEAR(master.peak, 0.5f, 1e-6f);
+        EXPECT_NEAR(master.rms, 0.5f, 1e-5f);
+    }
+
+    //! [WHEN] The master is muted
+    AudioOutputParams params = m_mixer->masterOutputParams();
+    params.muted = true;
+    m_mixer->setMasterOutputParams(params);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The master meter is reset
+    EXPECT_FLOAT_EQ(masterMeter->value(0).peak, 0.f);
+    EXPECT_FLOAT_EQ(masterMeter->value(0).peakHold, 0.f);
+}
+
+TEST_F(Audio_MixerTest, ProcessDoesNotAllocate)
+{
+    //! [GIVEN] A session with many tracks
+    initMixer();
+    addTracks(64, 0.01f);
+
+    expectProcessDoesNotAllocate();
+}
+
+TEST_F(Audio_MixerTest, ProcessDoesNotAllocate_WorkStealing)
+{
+    //! [GIVEN] A session with many tracks rendered in parallel
+    enableMultithreading(AudioThreadPoolType::WorkStealing);
+    initMixer();
+    addTracks(64, 0.01f);
+
+    expectProcessDoesNotAllocate();
+}
+
+TEST_F(Audio_MixerTest, LoudnessAnalysisDoesNotAllocate)
+{
+    //! [GIVEN] The loudness is analysed on the master and on a track
+    initMixer();
+    addTracks(64, 0.01f);
+
+    m_mixer->setMasterLoudnessAnalysisEnabled(true);
+    m_trackChannels.front()->setLoudnessAnalysisEnabled(true);
+
+    expectProcessDoesNotAllocate();
+
+    //! [THEN] The true-peak of the constant signal is published, its onset overshoots a bit in the interpolation
+    const float masterTruePeak = m_mixer->masterAudioMeter()->loudness().truePeakDbtp;
+    EXPECT_GE(masterTruePeak, AudioMeter::toDbfs(0.64f) - 0.05f);
+    EXPECT_LT(masterTruePeak, AudioMeter::toDbfs(0.64f) + 1.5f);
+
+    const float trackTruePeak = m_trackChannels.front()->audioMeter()->loudness().truePeakDbtp;
+    EXPECT_GE(trackTruePeak, AudioMeter::toDbfs(0.01f) - 0.05f);
+    EXPECT_LT(trackTruePeak, AudioMeter::toDbfs(0.01f) + 1.5f);
+
+    //! [WHEN] The analysis is disabled
+    m_mixer->setMasterLoudnessAnalysisEnabled(false);
+
+    //! [THEN] Nothing is published anymore
+    EXPECT_EQ(m_mixer->masterAudioMeter()->loudness().truePeakDbtp, MINIMUM_OPERABLE_DBFS_LEVEL);
+}
+
+TEST_F(Audio_MixerTest, LoudnessMeterIsRecreatedWhenLayoutChanges)
+{
+    //! [GIVEN] The loudness of a track is analysed
+    initMixer();
+
+    auto source = std::make_shared<ConstantTrackSource>(0.5f);
+    MixerChannelPtr channel = m_mixer->addChannel(0, source).val;
+    channel->setLoudnessAnalysisEnabled(true);
+
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+    EXPECT_GT(channel->audioMeter()->loudness().truePeakDbtp, MINIMUM_OPERABLE_DBFS_LEVEL);
+
+    //! [WHEN] The source reports a new layout
+    source->notifyAudioChannelsCountChanged();
+
+    //! [THEN] The measurement starts over, before the next block is processed
+    EXPECT_EQ(channel->audioMeter()->loudness().truePeakDbtp, MINIMUM_OPERABLE_DBFS_LEVEL);
+
+    //! [THEN] And the next blocks are measured without allocating
+    expectProcessDoesNotAllocate();
+    EXPECT_GT(channel->audioMeter()->loudness().truePeakDbtp, MINIMUM_OPERABLE_DBFS_LEVEL);
+}
+
+TEST_F(Audio_MixerTest, AuxBusesReceiveTrackSends)
+{
+    //! [GIVEN] Four tracks, the first two send to a bus doubling the signal, the last two to a bus muting it
+    enableMultithreading(AudioThreadPoolType::WorkStealing);
+    initMixer();
+    addTracks(4, 0.1f);
+
+    addAuxBus(100, 2.f);
+    addAuxBus(101, 0.f);
+    sendTracksToAux(0, 0, 2, 0.5f);
+    sendTracksToAux(1, 2, 2, 1.f);
+
+    //! [WHEN] Process a block
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The output is the sum of the tracks plus the first bus: 0.4 + (0.1 + 0.1) * 0.5 * 2
+    for (float sample : buffer) {
+        EXPECT_NEAR(sample, 0.6f, 1e-5f);
+    }
+}
+
+TEST_F(Audio_MixerTest, ProcessingGraphTimings)
+{
+    //! [GIVEN] Two tracks sending to an aux bus, and one track going straight to the master
+    initMixer();
+    addTracks(3, 0.1f);
+
+    addAuxBus(100, 1.f);
+    sendTracksToAux(0, 0, 2, 1.f);
+
+    //! [WHEN] Process a block
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    Mixer::ProcessingGraphTimings timings = m_mixer->lastBlockTimings();
+
+    //! [THEN] There is a node per track, one for the bus and one for the master
+    ASSERT_EQ(timings.nodes.size(), 5);
+    EXPECT_EQ(timings.nodes.back().type, Mixer::NodeTiming::Type::Master);
+
+    int64_t auxStartNs = -1;
+    int64_t lastAuxInputEndNs = -1;
+
+    for (const Mixer::NodeTiming& node : timings.nodes) {
+        EXPECT_LE(node.startNs, node.endNs);
+        EXPECT_LE(node.endNs, timings.nodes.back().endNs);
+
+        if (node.type == Mixer::NodeTiming::Type::Aux) {
+            auxStartNs = node.startNs;
+        } else if (node.type == Mixer::NodeTiming::Type::Track && node.trackId != 2) {
+            lastAuxInputEndNs = std::max(lastAuxInputEndNs, node.endNs);
+        }
+    }
+
+    //! [THEN] The bus started after its inputs were done
+    EXPECT_GE(auxStartNs, lastAuxInputEndNs);
+
+    //! [THEN] The critical path goes through one of the nodes and ends with the master
+    ASSERT_FALSE(timings.criticalPath.empty());
+    EXPECT_EQ(timings.criticalPath.back().type, Mixer::NodeTiming::Type::Master);
+
+    for (size_t i = 1; i < timings.criticalPath.size(); ++i) {
+        EXPECT_LE(timings.criticalPath[i - 1].endNs, timings.criticalPath[i].endNs);
+    }
+}
+
+TEST_F(Audio_MixerTest, ProcessWithAuxBusesDoesNotAllocate_WorkStealing)
+{
+    //! [GIVEN] Many tracks rendered in parallel, sending to two aux buses
+    enableMultithreading(AudioThreadPoolType::WorkStealing);
+    initMixer();
+    addTracks(64, 0.01f);
+
+    addAuxBus(100, 0.5f);
+    addAuxBus(101, 0.5f);
+    sendTracksToAux(0, 0, 32, 0.5f);
+    sendTracksToAux(1, 16, 48, 0.5f);
+
+    expectProcessDoesNotAllocate();
+}
+
+TEST_F(Audio_MixerTest, QueuedParamCommandsAreAppliedBeforeProcessing)
+{
+    //! [GIVEN] Two tracks and a parameter queue connected to the mixer
+    initMixer();
+    addTracks(2, 0.1f);
+
+    MixerParamQueuePtr queue = std::make_shared<MixerParamQueue>(16);
+    m_mixer->setParamQueue(queue);
+
+    //! [GIVEN] The first track is muted, the volume of the second one is changed
+    AudioOutputParams required = m_trackChannels.at(1)->outputParams();
+    required.volume = -6.f;
+
+    std::vector<MixerParamCommand> commands;
+    ASSERT_TRUE(makeMixerParamCommands(m_trackChannels.at(1)->outputParams(), required, commands));
+    ASSERT_EQ(commands.size(), 1);
+    commands.front().trackId = 1;
+
+    MixerParamCommand mute;
+    mute.type = MixerParamCommand::Type::Muted;
+    mute.trackId = 0;
+    mute.value = 1.f;
+    commands.push_back(mute);
+
+    for (const MixerParamCommand& command : commands) {
+        ASSERT_TRUE(queue->push(command));
+    }
+
+    //! [WHEN] Process a block
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The queue is drained and the new params are in effect for the whole block
+    EXPECT_TRUE(queue->empty());
+    EXPECT_TRUE(m_trackChannels.at(0)->outputParams().muted);
+    EXPECT_FLOAT_EQ(m_trackChannels.at(1)->outputParams().volume, -6.f);
+
+    const float expected = 0.1f * muse::db_to_linear(-6.f);
+    for (float sample : buffer) {
+        EXPECT_NEAR(sample, expected, 1e-5f);
+    }
+}
+
+TEST_F(Audio_MixerTest, ParamCommandsAreNotMadeForStructuralChanges)
+{
+    //! [GIVEN] Output params with one fx
+    AudioOutputParams current;
+    AudioFxParams fxParams;
+    fxParams.chainOrder = 0;
+    fxParams.active = true;
+    fxParams.resourceMeta.id = "gain";
+    current.fxChain.emplace(fxParams.chainOrder, fxParams);
+
+    std::vector<MixerParamCommand> commands;
+
+    //! [WHEN] Only the fx is bypassed
+    AudioOutputParams bypassed = current;
+    bypassed.fxChain.at(0).active = false;
+
+    //! [THEN] The change is expressed as a single command, which gives the required params back
+    ASSERT_TRUE(makeMixerParamCommands(current, bypassed, commands));
+    ASSERT_EQ(commands.size(), 1);
+
+    AudioOutputParams applied = current;
+    EXPECT_TRUE(applyMixerParamCommand(commands.front(), applied));
+    EXPECT_EQ(applied, bypassed);
+
+    //! [WHEN] The fx is replaced
+    AudioOutputParams replaced = current;
+    replaced.fxChain.at(0).resourceMeta.id = "other";
+
+    //! [THEN] A full update is required
+    commands.clear();
+    EXPECT_FALSE(makeMixerParamCommands(current, replaced, commands));
+}
+
+TEST_F(Audio_MixerTest, VolumeChangeIsRampedPerSample)
+{
+    //! [GIVEN] A track producing a constant signal, which has already been rendered once
+    initMixer();
+    addTracks(1, 0.5f);
+
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [WHEN] The volume is lowered by 20 dB and the next block is rendered
+    AudioOutputParams params = m_trackChannels.front()->outputParams();
+    params.volume = -20.f;
+    m_trackChannels.front()->applyOutputParams(params);
+
+    std::fill(buffer.begin(), buffer.end(), 0.f);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The gain moves from the old value to the new one without jumps
+    const samples_t rampSamples = SAMPLE_RATE / 100;
+    ASSERT_LT(rampSamples, SAMPLES_TO_PREALLOCATE);
+
+    EXPECT_NEAR(buffer.front(), 0.5f, 1e-3f);
+
+    for (samples_t s = 1; s < SAMPLES_TO_PREALLOCATE; ++s) {
+        for (audioch_t ch = 0; ch < AUDIO_CHANNELS_COUNT; ++ch) {
+            float previous = buffer[(s - 1) * AUDIO_CHANNELS_COUNT + ch];
+            float current = buffer[s * AUDIO_CHANNELS_COUNT + ch];
+
+            EXPECT_LE(current, previous + 1e-6f);
+            EXPECT_LT(previous - current, 0.01f);
+
+            if (s >= rampSamples) {
+                EXPECT_NEAR(current, 0.05f, 1e-5f);
+            }
+        }
+    }
+}
+
+TEST_F(Audio_MixerTest, ParamsChangeKeepsFxInstances)
+{
+    //! [GIVEN] An aux bus with one fx
+    initMixer();
+    MixerChannelPtr aux = addAuxBus(100, 2.f);
+
+    //! [WHEN] The volume is changed and the fx is bypassed
+    EXPECT_CALL(*m_fxResolver, resolveFxList(100, _)).Times(0);
+
+    AudioOutputParams params = aux->outputParams();
+    params.volume = -3.f;
+    params.fxChain.at(0).active = false;
+    aux->applyOutputParams(params);
+
+    //! [THEN] The fx chain isn't resolved again, the existing fx is bypassed
+    EXPECT_EQ(aux->outputParams(), params);
+    ::testing::Mock::VerifyAndClearExpectations(m_fxResolver.get());
+
+    //! [WHEN] The fx is replaced by another one
+    params.fxChain.at(0).resourceMeta.id = "other";
+
+    //! [THEN] The chain is resolved again
+    EXPECT_CALL(*m_fxResolver, resolveFxList(100, _)).WillOnce(Return(std::vector<IFxProcessorPtr> {}));
+    aux->applyOutputParams(params);
+
+    EXPECT_TRUE(aux->outputParams().fxChain.empty());
+}
+
+TEST_F(Audio_MixerTest, MasterLimiterKeepsOutputBelowCeiling)
+{
+    //! [GIVEN] Two tracks, which together go over the full scale
+    initMixer();
+    addTracks(2, 0.8f);
+
+    //! [THEN] Without the limiter the output isn't delayed
+    EXPECT_EQ(m_mixer->latency(), 0);
+
+    //! [WHEN] The master limiter is enabled
+    m_mixer->setMasterLimiterEnabled(true);
+
+    //! [THEN] Its look-ahead is reported as the latency of the mixer
+    EXPECT_GT(m_mixer->latency(), 0);
+
+    //! [WHEN] Process blocks for longer than the release of the gain reduced by the onset
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+
+    for (int i = 0; i < 32; ++i) {
+        m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+        //! [THEN] No sample goes over the ceiling
+        for (float sample : buffer) {
+            EXPECT_LE(std::abs(sample), 1.0001f);
+        }
+    }
+
+    //! [THEN] The constant signal ends up at the ceiling
+    EXPECT_NEAR(buffer.back(), 1.f, 1e-3f);
+}
+
+TEST_F(Audio_MixerTest, MasterLimiterFollowsConfigurationAndDelaysClocks)
+{
+    //! [GIVEN] The master limiter is enabled in the configuration
+    ON_CALL(*m_configuration, masterLimiterEnabled()).WillByDefault(Return(true));
+    initMixer();
+    addTracks(1, 0.5f);
+
+    //! [THEN] The mixer is delayed by its look-ahead
+    const samples_t latency = m_mixer->latency();
+    ASSERT_GT(latency, 0);
+
+    //! [GIVEN] A running clock driven by the mixer
+    auto clock = std::make_shared<Clock>();
+    clock->setTimeDuration(10 * 1000000);
+    m_mixer->addClock(clock);
+    clock->start();
+
+    double reportedSecs = -1.0;
+    clock->timeChanged().onReceive(nullptr, [&reportedSecs](secs_t secs) {
+        reportedSecs = secs.raw();
+    });
+
+    //! [WHEN] Process a few blocks
+    std::vector<float> buffer(SAMPLES_TO_PREALLOCATE * AUDIO_CHANNELS_COUNT, 0.f);
+    for (int i = 0; i < 8; ++i) {
+        m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+    }
+
+    //! [THEN] The clock reports the position being heard, which is behind the rendered one by the latency
+    const msecs_t latencyMsecs = static_cast<msecs_t>(latency) * 1000000 / SAMPLE_RATE;
+    EXPECT_NEAR(reportedSecs, (clock->currentTime() - latencyMsecs) / 1000000.0, 1e-6);
+
+    //! [WHEN] The limiter is disabled
+    m_mixer->setMasterLimiterEnabled(false);
+    m_mixer->process(buffer.data(), SAMPLES_TO_PREALLOCATE);
+
+    //! [THEN] The position isn't delayed anymore
+    EXPECT_EQ(m_mixer->latency(), 0);
+    EXPECT_NEAR(reportedSecs, clock->currentTime() / 1000000.0, 1e-6);
+}
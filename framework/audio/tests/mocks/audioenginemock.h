@@ -0,0 +1,44 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include "audio/internal/worker/iaudioengine.h"
+
+namespace muse::audio {
+class AudioEngineMock : public IAudioEngine
+{
+public:
+    MOCK_METHOD(sample_rate_t, sampleRate, (), (const, override));
+
+    MOCK_METHOD(void, setSampleRate, (const sample_rate_t), (override));
+    MOCK_METHOD(void, setReadBufferSize, (const uint16_t), (override));
+    MOCK_METHOD(void, setAudioChannelsCount, (const audioch_t), (override));
+
+    MOCK_METHOD(RenderMode, mode, (), (const, override));
+    MOCK_METHOD(void, setMode, (const RenderMode), (override));
+    MOCK_METHOD(async::Notification, modeChanged, (), (const, override));
+
+    MOCK_METHOD(MixerPtr, mixer, (), (const, override));
+};
+}
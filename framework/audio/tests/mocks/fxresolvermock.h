@@ -0,0 +1,39 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <gmock/gmock.h>
+
+#include "audio/ifxresolver.h"
+
+namespace muse::audio::fx {
+class FxResolverMock : public IFxResolver
+{
+public:
+    MOCK_METHOD(std::vector<IFxProcessorPtr>, resolveMasterFxList, (const AudioFxChain&), (override));
+    MOCK_METHOD(std::vector<IFxProcessorPtr>, resolveFxList, (const TrackId, const AudioFxChain&), (override));
+    MOCK_METHOD(AudioResourceMetaList, resolveAvailableResources, (), (const, override));
+    MOCK_METHOD(void, registerResolver, (const AudioFxType, IResolverPtr), (override));
+    MOCK_METHOD(void, clearFx, (const TrackId), (override));
+    MOCK_METHOD(void, clearAllFx, (), (override));
+};
+}
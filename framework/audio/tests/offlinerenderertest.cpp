@@ -0,0 +1,421 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <optional>
+#include <thread>
+
+#include "global/io/buffer.h"
+
+#include "audio/internal/soundtracks/offlinerenderer.h"
+#include "audio/internal/worker/tracksequence.h"
+#include "audio/internal/audiosanitizer.h"
+#include "audio/audioerrors.h"
+
+#include "mocks/audioconfigurationmock.h"
+#include "mocks/audioenginemock.h"
+#include "mocks/fxresolvermock.h"
+#include "mocks/synthresolvermock.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::soundtrack;
+
+namespace muse::audio {
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+static constexpr sample_rate_t SAMPLE_RATE = 8000;
+static constexpr samples_t RENDER_STEP = 512;
+
+static constexpr size_t WAV_HEADER_SIZE = 46;
+
+//! NOTE Produces a constant signal and remembers how it was used
+class ConstantSynth : public synth::ISynthesizer
+{
+public:
+    std::string name() const override { return "constant"; }
+    AudioSourceType type() const override { return AudioSourceType::Undefined; }
+    bool isValid() const override { return true; }
+
+    void setup(const mpe::PlaybackData& playbackData) override { m_playbackData = playbackData; }
+    const mpe::PlaybackData& playbackData() const override { return m_playbackData; }
+
+    const AudioInputParams& params() const override { return m_params; }
+    async::Channel<AudioInputParams> paramsChanged() const override { return m_paramsChanged; }
+
+    msecs_t playbackPosition() const override { return m_playbackPosition; }
+    void setPlaybackPosition(const msecs_t newPosition) override { m_playbackPosition = newPosition; }
+
+    void revokePlayingNotes() override {}
+    void flushSound() override {}
+
+    void setFixedRenderMode(const RenderMode mode) override { m_fixedRenderMode = mode; }
+    std::optional<RenderMode> fixedRenderMode() const { return m_fixedRenderMode; }
+
+    bool isActive() const override { return m_isActive; }
+    void setIsActive(bool arg) override { m_isActive = arg; }
+
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return AUDIO_CHANNELS_COUNT; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        //! NOTE Like a plugin, it is silent until it has been loaded
+        std::fill(buffer, buffer + samplesPerChannel * AUDIO_CHANNELS_COUNT, m_isReady ? 0.25f : 0.f);
+        m_processedSamples += samplesPerChannel;
+        return samplesPerChannel;
+    }
+
+    bool isReady() const override { return m_isReady; }
+    void setIsReady(bool ready) { m_isReady = ready; }
+
+    samples_t processedSamples() const { return m_processedSamples; }
+
+private:
+    mpe::PlaybackData m_playbackData;
+    AudioInputParams m_params;
+    async::Channel<AudioInputParams> m_paramsChanged;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+    msecs_t m_playbackPosition = 0;
+    std::optional<RenderMode> m_fixedRenderMode;
+    bool m_isActive = false;
+    std::atomic<bool> m_isReady = true;
+    std::atomic<samples_t> m_processedSamples = 0;
+};
+
+using ConstantSynthPtr = std::shared_ptr<ConstantSynth>;
+
+class Audio_OfflineRendererTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        ON_CALL(*m_configuration, audioChannelsCount()).WillByDefault(Return(AUDIO_CHANNELS_COUNT));
+        ON_CALL(*m_configuration, samplesToPreallocate()).WillByDefault(Return(RENDER_STEP));
+        ON_CALL(*m_configuration, desiredAudioThreadNumber()).WillByDefault(Return(1));
+        ON_CALL(*m_configuration, minTrackCountForMultithreading()).WillByDefault(Return(std::numeric_limits<size_t>::max()));
+
+        m_fxResolver = std::make_shared<NiceMock<fx::FxResolverMock> >();
+
+        m_synthResolver = std::make_shared<NiceMock<synth::SynthResolverMock> >();
+        ON_CALL(*m_synthResolver, resolveSynth(_, _, _)).WillByDefault([this](const TrackId, const AudioInputParams&,
+                                                                            const PlaybackSetupData&) {
+            ConstantSynthPtr synth = std::make_shared<ConstantSynth>();
+            m_synths.push_back(synth);
+            return synth;
+        });
+
+        m_audioEngine = std::make_shared<NiceMock<AudioEngineMock> >();
+        ON_CALL(*m_audioEngine, mode()).WillByDefault(Return(RenderMode::RealTimeMode));
+        ON_CALL(*m_audioEngine, sampleRate()).WillByDefault(Return(SAMPLE_RATE));
+
+        modularity::globalIoc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+        modularity::globalIoc()->registerExport<fx::IFxResolver>("utests", m_fxResolver);
+        modularity::globalIoc()->registerExport<synth::ISynthResolver>("utests", m_synthResolver);
+        modularity::globalIoc()->registerExport<IAudioEngine>("utests", m_audioEngine);
+
+        m_liveMixer = std::make_shared<Mixer>(modularity::globalCtx());
+        m_liveMixer->setAudioChannelsCount(AUDIO_CHANNELS_COUNT);
+        m_liveMixer->setSampleRate(SAMPLE_RATE);
+        m_liveMixer->setIsIdle(false);
+        ON_CALL(*m_audioEngine, mixer()).WillByDefault(Return(m_liveMixer));
+
+        m_sequence = std::make_shared<TrackSequence>(0, modularity::globalCtx());
+
+        for (const std::filesystem::path& destination : { destination(0), destination(1) }) {
+            std::error_code ec;
+            std::filesystem::remove(destination, ec);
+        }
+    }
+
+    void TearDown() override
+    {
+        m_sequence = nullptr;
+        m_liveMixer = nullptr;
+        m_synths.clear();
+
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+        modularity::globalIoc()->unregister<fx::IFxResolver>("utests");
+        modularity::globalIoc()->unregister<synth::ISynthResolver>("utests");
+        modularity::globalIoc()->unregister<IAudioEngine>("utests");
+
+        for (const std::filesystem::path& destination : { destination(0), destination(1) }) {
+            std::error_code ec;
+            std::filesystem::remove(destination, ec);
+        }
+    }
+
+    void addTracks(size_t count)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            mpe::PlaybackData playbackData;
+            playbackData.setupData = mpe::PlaybackSetupData(mpe::SoundId::Piano, mpe::SoundCategory::Keyboards);
+
+            ASSERT_TRUE(m_sequence->addTrack("track " + std::to_string(i), playbackData, AudioParams()).ret);
+        }
+    }
+
+    //! NOTE A float stereo WAV file with a constant signal, played by a sound track
+    void addSoundTrack(secs_t duration, float value)
+    {
+        const samples_t frames = static_cast<samples_t>(duration * SAMPLE_RATE);
+        const uint32_t dataSize = static_cast<uint32_t>(frames * AUDIO_CHANNELS_COUNT * sizeof(float));
+
+        ByteArray wav(44 + dataSize);
+        uint8_t* data = wav.data();
+        std::memset(data, 0, wav.size());
+
+        auto put = [data](size_t offset, uint32_t v, size_t bytes) {
+            for (size_t i = 0; i < bytes; ++i) {
+                data[offset + i] = static_cast<uint8_t>(v >> (i * 8));
+            }
+        };
+
+        std::memcpy(data, "RIFF", 4);
+        put(4, 36 + dataSize, 4);
+        std::memcpy(data + 8, "WAVEfmt ", 8);
+        put(16, 16, 4);
+        put(20, 3, 2); // IEEE float
+        put(22, AUDIO_CHANNELS_COUNT, 2);
+        put(24, SAMPLE_RATE, 4);
+        put(28, SAMPLE_RATE * AUDIO_CHANNELS_COUNT * sizeof(float), 4);
+        put(32, AUDIO_CHANNELS_COUNT * sizeof(float), 2);
+        put(34, 32, 2);
+        std::memcpy(data + 36, "data", 4);
+        put(40, dataSize, 4);
+
+        float* samples = reinterpret_cast<float*>(data + 44);
+        std::fill(samples, samples + frames * AUDIO_CHANNELS_COUNT, value);
+
+        m_soundDevice = std::make_unique<io::Buffer>(std::move(wav));
+        ASSERT_TRUE(m_sequence->addTrack("sound", m_soundDevice.get(), AudioParams()).ret);
+    }
+
+    std::vector<float> exportedSamples(int index) const
+    {
+        std::ifstream file(destination(index), std::ios::binary);
+        file.seekg(WAV_HEADER_SIZE);
+
+        std::vector<float> samples;
+        float sample = 0.f;
+        while (file.read(reinterpret_cast<char*>(&sample), sizeof(float))) {
+            samples.push_back(sample);
+        }
+
+        return samples;
+    }
+
+    std::filesystem::path destination(int index) const
+    {
+        return std::filesystem::temp_directory_path() / ("muse_audio_offlinerenderertest_" + std::to_string(index) + ".wav");
+    }
+
+    SoundTrackFormat wavFormat() const
+    {
+        SoundTrackFormat format;
+        format.type = SoundTrackType::WAV;
+        format.sampleRate = SAMPLE_RATE;
+        format.samplesPerChannel = RENDER_STEP;
+        format.audioChannelsNumber = AUDIO_CHANNELS_COUNT;
+
+        return format;
+    }
+
+    std::future<Ret> startExport(OfflineRenderer& renderer, int index, msecs_t duration)
+    {
+        auto finished = std::make_shared<std::promise<Ret> >();
+
+        renderer.start(destination(index).string(), wavFormat(), duration, Progress(), [finished](const Ret& ret) {
+            finished->set_value(ret);
+        });
+
+        return finished->get_future();
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+    std::shared_ptr<NiceMock<fx::FxResolverMock> > m_fxResolver;
+    std::shared_ptr<NiceMock<synth::SynthResolverMock> > m_synthResolver;
+    std::shared_ptr<NiceMock<AudioEngineMock> > m_audioEngine;
+
+    std::unique_ptr<io::Buffer> m_soundDevice;
+    MixerPtr m_liveMixer;
+    std::shared_ptr<TrackSequence> m_sequence;
+    std::vector<ConstantSynthPtr> m_synths;
+};
+}
+
+TEST_F(Audio_OfflineRendererTest, ExportDoesNotInterruptLivePlayback)
+{
+    //! [GIVEN] A sequence with two tracks, which is being played
+    addTracks(2);
+    ASSERT_EQ(m_synths.size(), 2);
+
+    m_liveMixer->setIsActive(true);
+
+    //! [THEN] The export doesn't touch the mode of the engine
+    EXPECT_CALL(*m_audioEngine, setMode(_)).Times(0);
+
+    //! [WHEN] Export 10 seconds of the sequence
+    OfflineRenderer renderer(modularity::globalCtx());
+    ASSERT_TRUE(renderer.init(m_sequence.get(), *m_liveMixer));
+
+    std::future<Ret> finished = startExport(renderer, 0, 10 * 1000000);
+
+    //! [WHEN] Keep playing meanwhile
+    std::vector<float> buffer(RENDER_STEP * AUDIO_CHANNELS_COUNT, 0.f);
+    samples_t liveSamples = 0;
+
+    while (finished.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+        m_liveMixer->process(buffer.data(), RENDER_STEP);
+        liveSamples += RENDER_STEP;
+    }
+
+    //! [THEN] The whole duration is exported
+    EXPECT_TRUE(finished.get());
+    EXPECT_EQ(std::filesystem::file_size(destination(0)),
+              WAV_HEADER_SIZE + 10 * SAMPLE_RATE * AUDIO_CHANNELS_COUNT * sizeof(float));
+
+    //! [THEN] The export was rendered by synths of its own, the live ones kept playing in real time mode
+    ASSERT_EQ(m_synths.size(), 4);
+
+    for (size_t i = 0; i < 2; ++i) {
+        EXPECT_FALSE(m_synths[i]->fixedRenderMode().has_value());
+        EXPECT_EQ(m_synths[i]->processedSamples(), liveSamples);
+    }
+
+    for (size_t i = 2; i < 4; ++i) {
+        EXPECT_EQ(m_synths[i]->fixedRenderMode(), RenderMode::OfflineMode);
+        EXPECT_GE(m_synths[i]->processedSamples(), 10 * SAMPLE_RATE);
+    }
+}
+
+TEST_F(Audio_OfflineRendererTest, ConcurrentExports)
+{
+    //! [GIVEN] A sequence with a few tracks
+    addTracks(3);
+
+    //! [WHEN] Export it twice at the same time
+    OfflineRenderer renderer1(modularity::globalCtx());
+    OfflineRenderer renderer2(modularity::globalCtx());
+    ASSERT_TRUE(renderer1.init(m_sequence.get(), *m_liveMixer));
+    ASSERT_TRUE(renderer2.init(m_sequence.get(), *m_liveMixer));
+
+    std::future<Ret> finished1 = startExport(renderer1, 0, 5 * 1000000);
+    std::future<Ret> finished2 = startExport(renderer2, 1, 5 * 1000000);
+
+    //! [THEN] Both exports are complete
+    EXPECT_TRUE(finished1.get());
+    EXPECT_TRUE(finished2.get());
+
+    for (int index : { 0, 1 }) {
+        EXPECT_EQ(std::filesystem::file_size(destination(index)),
+                  WAV_HEADER_SIZE + 5 * SAMPLE_RATE * AUDIO_CHANNELS_COUNT * sizeof(float));
+    }
+}
+
+TEST_F(Audio_OfflineRendererTest, SoundTracksAreExported)
+{
+    //! [GIVEN] A sequence with a sound track, 2 seconds of a constant signal
+    addSoundTrack(2.0, 0.5f);
+
+    //! [WHEN] Export it
+    OfflineRenderer renderer(modularity::globalCtx());
+    ASSERT_TRUE(renderer.init(m_sequence.get(), *m_liveMixer));
+
+    std::future<Ret> finished = startExport(renderer, 0, 2 * 1000000);
+    EXPECT_TRUE(finished.get());
+
+    //! [THEN] The whole file is in the export, without gaps, however fast it was rendered
+    const std::vector<float> samples = exportedSamples(0);
+    ASSERT_EQ(samples.size(), 2 * SAMPLE_RATE * AUDIO_CHANNELS_COUNT);
+
+    for (size_t i = 0; i < samples.size(); ++i) {
+        ASSERT_GT(std::abs(samples[i]), 0.1f) << "sample " << i;
+    }
+}
+
+TEST_F(Audio_OfflineRendererTest, ExportWaitsForPluginsToLoad)
+{
+    //! [GIVEN] A sequence with a track
+    addTracks(1);
+
+    OfflineRenderer renderer(modularity::globalCtx());
+    ASSERT_TRUE(renderer.init(m_sequence.get(), *m_liveMixer));
+
+    //! [GIVEN] The synth of the export loads late, like a plugin loaded on the main thread
+    ASSERT_EQ(m_synths.size(), 2);
+    ConstantSynthPtr offlineSynth = m_synths[1];
+    offlineSynth->setIsReady(false);
+
+    //! [WHEN] Export 2 seconds, the synth is loaded meanwhile
+    std::future<Ret> finished = startExport(renderer, 0, 2 * 1000000);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(offlineSynth->processedSamples(), 0);
+    offlineSynth->setIsReady(true);
+
+    //! [THEN] Nothing was rendered until it was loaded, so the export doesn't start silent
+    EXPECT_TRUE(finished.get());
+
+    const std::vector<float> samples = exportedSamples(0);
+    ASSERT_EQ(samples.size(), 2 * SAMPLE_RATE * AUDIO_CHANNELS_COUNT);
+
+    for (size_t i = 0; i < samples.size(); ++i) {
+        ASSERT_GT(std::abs(samples[i]), 0.1f) << "sample " << i;
+    }
+}
+
+TEST_F(Audio_OfflineRendererTest, ExportFailsIfPluginsDontLoad)
+{
+    //! [GIVEN] A sequence with a track, whose synth never loads in the export
+    addTracks(1);
+
+    OfflineRenderer renderer(modularity::globalCtx());
+    ASSERT_TRUE(renderer.init(m_sequence.get(), *m_liveMixer));
+    renderer.setLoadingTimeout(std::chrono::milliseconds(50));
+
+    ASSERT_EQ(m_synths.size(), 2);
+    m_synths[1]->setIsReady(false);
+
+    //! [WHEN] Export it
+    std::future<Ret> finished = startExport(renderer, 0, 2 * 1000000);
+
+    //! [THEN] The export fails after the timeout, instead of being written without the synth
+    const Ret ret = finished.get();
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::PluginLoadingTimeout));
+    EXPECT_EQ(m_synths[1]->processedSamples(), 0);
+}
@@ -0,0 +1,278 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "audio/internal/dsp/polyphaseresampler.h"
+
+#include "utils/allocationcounter.h"
+#include "utils/legacysamplerateconvertor.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+namespace muse::audio {
+static constexpr double TEST_PI = 3.14159265358979323846;
+
+class Audio_PolyphaseResamplerTest : public ::testing::Test
+{
+protected:
+    std::vector<float> sine(double frequency, sample_rate_t sampleRate, samples_t frames, float amplitude = 0.5f) const
+    {
+        std::vector<float> result(frames);
+
+        for (samples_t i = 0; i < frames; ++i) {
+            result[i] = amplitude * static_cast<float>(std::sin(2.0 * TEST_PI * frequency * i / sampleRate));
+        }
+
+        return result;
+    }
+
+    //! NOTE Feeds the mono input in blocks of the given size
+    std::vector<float> resample(PolyphaseResampler& resampler, const std::vector<float>& input, samples_t blockSize) const
+    {
+        std::vector<float> result;
+        std::vector<float> block;
+
+        for (samples_t from = 0; from < input.size(); from += blockSize) {
+            const samples_t frames = std::min<samples_t>(blockSize, input.size() - from);
+            block.resize(resampler.maxOutputFrames(frames));
+
+            const samples_t written = resampler.process(input.data() + from, frames, block.data());
+            EXPECT_LE(written, block.size());
+
+            result.insert(result.end(), block.begin(), block.begin() + written);
+        }
+
+        return result;
+    }
+
+    //! NOTE Fits a sine of the given frequency (least squares) and returns the power of the residual
+    //! relative to the power of the fitted sine, in dB
+    double thdPlusNoiseDb(const std::vector<float>& signal, size_t from, size_t to, double frequency, sample_rate_t sampleRate) const
+    {
+        double ss = 0.0, sc = 0.0, cc = 0.0, ys = 0.0, yc = 0.0;
+
+        for (size_t i = from; i < to; ++i) {
+            const double phase = 2.0 * TEST_PI * frequency * i / sampleRate;
+            const double s = std::sin(phase);
+            const double c = std::cos(phase);
+
+            ss += s * s;
+            sc += s * c;
+            cc += c * c;
+            ys += signal[i] * s;
+            yc += signal[i] * c;
+        }
+
+        const double det = ss * cc - sc * sc;
+        const double a = (ys * cc - yc * sc) / det;
+        const double b = (yc * ss - ys * sc) / det;
+
+        double residualPower = 0.0;
+        for (size_t i = from; i < to; ++i) {
+            const double phase = 2.0 * TEST_PI * frequency * i / sampleRate;
+            const double residual = signal[i] - (a * std::sin(phase) + b * std::cos(phase));
+            residualPower += residual * residual;
+        }
+
+        residualPower /= static_cast<double>(to - from);
+        const double sinePower = (a * a + b * b) / 2.0;
+
+        return 10.0 * std::log10(residualPower / sinePower);
+    }
+
+    double rms(const std::vector<float>& signal, size_t from, size_t to) const
+    {
+        double sum = 0.0;
+        for (size_t i = from; i < to; ++i) {
+            sum += signal[i] * signal[i];
+        }
+
+        return std::sqrt(sum / static_cast<double>(to - from));
+    }
+};
+}
+
+TEST_F(Audio_PolyphaseResamplerTest, OutputLength)
+{
+    for (sample_rate_t rateIn : { 44100, 48000, 96000 }) {
+        for (sample_rate_t rateOut : { 44100, 48000, 96000 }) {
+            PolyphaseResampler resampler(rateIn, rateOut, 2);
+
+            std::vector<float> input(rateIn * 2, 0.f);
+            std::vector<float> output(resampler.maxOutputFrames(rateIn) * 2);
+
+            //! NOTE One second of input gives one second of output
+            EXPECT_EQ(resampler.process(input.data(), rateIn, output.data()), rateOut);
+        }
+    }
+}
+
+TEST_F(Audio_PolyphaseResamplerTest, BlockSizeDoesNotChangeOutput)
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+    std::vector<float> input(10000);
+    for (float& sample : input) {
+        sample = dist(random);
+    }
+
+    PolyphaseResampler reference(44100, 48000, 1);
+    const std::vector<float> expected = resample(reference, input, input.size());
+
+    for (samples_t blockSize : { 1, 7, 64, 511 }) {
+        SCOPED_TRACE(blockSize);
+
+        //! NOTE The small preallocated history makes the resampler compact it often, and grow it for the larger blocks
+        PolyphaseResampler resampler(44100, 48000, 1, PolyphaseResampler::Quality::Medium, 64);
+        const std::vector<float> output = resample(resampler, input, blockSize);
+
+        ASSERT_EQ(output.size(), expected.size());
+        for (size_t i = 0; i < output.size(); ++i) {
+            ASSERT_FLOAT_EQ(output[i], expected[i]);
+        }
+    }
+}
+
+TEST_F(Audio_PolyphaseResamplerTest, ChannelsAreIndependent)
+{
+    const std::vector<float> left = sine(1000.0, 48000, 4800);
+    const std::vector<float> right = sine(3000.0, 48000, 4800);
+
+    std::vector<float> interleaved(left.size() * 2);
+    for (size_t i = 0; i < left.size(); ++i) {
+        interleaved[2 * i] = left[i];
+        interleaved[2 * i + 1] = right[i];
+    }
+
+    PolyphaseResampler stereo(48000, 44100, 2);
+    std::vector<float> output(stereo.maxOutputFrames(left.size()) * 2);
+    const samples_t frames = stereo.process(interleaved.data(), left.size(), output.data());
+
+    PolyphaseResampler leftMono(48000, 44100, 1);
+    PolyphaseResampler rightMono(48000, 44100, 1);
+    const std::vector<float> expectedLeft = resample(leftMono, left, left.size());
+    const std::vector<float> expectedRight = resample(rightMono, right, right.size());
+
+    ASSERT_EQ(frames, expectedLeft.size());
+    for (samples_t i = 0; i < frames; ++i) {
+        ASSERT_FLOAT_EQ(output[2 * i], expectedLeft[i]);
+        ASSERT_FLOAT_EQ(output[2 * i + 1], expectedRight[i]);
+    }
+}
+
+TEST_F(Audio_PolyphaseResamplerTest, ThdPlusNoiseIsLowerThanLegacy)
+{
+    const double frequency = 1000.0;
+    const std::vector<float> input = sine(frequency, 44100, 44100);
+
+    //! NOTE Skip the edges, where the filters see the start and the end of the signal
+    const size_t from = 2000;
+    const size_t to = 46000;
+
+    tests::LegacySampleRateConvertor legacy(input, 1, 44100, 48000);
+    const std::vector<float> legacyOutput = legacy.convert();
+    ASSERT_GE(legacyOutput.size(), to);
+    const double legacyThdN = thdPlusNoiseDb(legacyOutput, from, to, frequency, 48000);
+
+    const std::pair<PolyphaseResampler::Quality, double> presets[] = {
+        { PolyphaseResampler::Quality::Low, -70.0 },
+        { PolyphaseResampler::Quality::Medium, -100.0 },
+        { PolyphaseResampler::Quality::High, -120.0 },
+    };
+
+    for (const auto& [quality, maxThdN] : presets) {
+        SCOPED_TRACE(static_cast<int>(quality));
+
+        PolyphaseResampler resampler(44100, 48000, 1, quality);
+        const std::vector<float> output = resample(resampler, input, 512);
+        ASSERT_GE(output.size(), to);
+
+        const double thdN = thdPlusNoiseDb(output, from, to, frequency, 48000);
+        EXPECT_LT(thdN, maxThdN);
+        EXPECT_LT(thdN, legacyThdN);
+    }
+}
+
+TEST_F(Audio_PolyphaseResamplerTest, PassbandGain)
+{
+    for (double frequency : { 100.0, 1000.0, 10000.0, 18000.0 }) {
+        SCOPED_TRACE(frequency);
+
+        const std::vector<float> input = sine(frequency, 48000, 48000);
+
+        PolyphaseResampler resampler(48000, 44100, 1);
+        const std::vector<float> output = resample(resampler, input, 512);
+
+        const double gainDb = 20.0 * std::log10(rms(output, 2000, 40000) / rms(input, 2000, 40000));
+        EXPECT_NEAR(gainDb, 0.0, 0.1);
+    }
+}
+
+TEST_F(Audio_PolyphaseResamplerTest, DownsamplingRejectsAliases)
+{
+    //! NOTE 30 kHz is above the Nyquist frequency of 48 kHz, without filtering it would alias to 18 kHz
+    const std::vector<float> input = sine(30000.0, 96000, 96000);
+    const double inputRms = rms(input, 0, input.size());
+
+    const std::pair<PolyphaseResampler::Quality, double> presets[] = {
+        { PolyphaseResampler::Quality::Low, -70.0 },
+        { PolyphaseResampler::Quality::Medium, -100.0 },
+        { PolyphaseResampler::Quality::High, -120.0 },
+    };
+
+    for (const auto& [quality, maxLevel] : presets) {
+        SCOPED_TRACE(static_cast<int>(quality));
+
+        PolyphaseResampler resampler(96000, 48000, 1, quality);
+        const std::vector<float> output = resample(resampler, input, 512);
+
+        const double levelDb = 20.0 * std::log10(rms(output, 2000, 46000) / inputRms);
+        EXPECT_LT(levelDb, maxLevel);
+    }
+}
+
+TEST_F(Audio_PolyphaseResamplerTest, ProcessDoesNotAllocate)
+{
+    //! [GIVEN] A resampler prepared for blocks of 512 frames, and a few seconds of input
+    PolyphaseResampler resampler(44100, 48000, 2, PolyphaseResampler::Quality::Medium, 512);
+
+    const std::vector<float> input(44100 * 2 * 2, 0.25f);
+    std::vector<float> output(resampler.maxOutputFrames(512) * 2);
+
+    //! [WHEN] Process it block by block, so that the history is compacted several times
+    tests::AllocationCounter::start();
+    for (size_t from = 0; from + 512 <= input.size() / 2; from += 512) {
+        resampler.process(input.data() + from * 2, 512, output.data());
+    }
+    size_t allocations = tests::AllocationCounter::stop();
+
+    //! [THEN] No heap allocations were made
+    EXPECT_EQ(allocations, 0);
+}
@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "audio/internal/fx/reverb/reverbkernels.h"
+#include "audio/internal/fx/reverb/reverbprocessor.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::fx;
+
+namespace muse::audio {
+static const std::vector<int> REVERB_LINES_COUNTS = { 8, 12, 16, 24 };
+
+class Audio_ReverbKernelsTest : public ::testing::Test
+{
+protected:
+    //! NOTE Every compiled in and supported backend is checked against the scalar one
+    std::vector<ReverbKernelBackend> backendsToTest() const
+    {
+        std::vector<ReverbKernelBackend> result;
+
+        for (ReverbKernelBackend backend : { ReverbKernelBackend::SSE2, ReverbKernelBackend::NEON, ReverbKernelBackend::AVX2,
+                                             ReverbKernelBackend::AVX512 }) {
+            if (isReverbKernelBackendAvailable(backend)) {
+                result.push_back(backend);
+            }
+        }
+
+        return result;
+    }
+
+    //! NOTE Random, but stable filters
+    void setupRandomFilters(ReverbDecayFilterBank& bank, int linesCount)
+    {
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+        for (int i = 0; i < linesCount; ++i) {
+            bank.gain.b0[i] = 0.5f + 0.2f * dist(m_random);
+            bank.gain.b1[i] = 0.2f * dist(m_random);
+            bank.gain.a1[i] = -0.4f + 0.2f * dist(m_random);
+
+            for (ReverbDecayFilterBank::BiquadLanes& bq : bank.damping) {
+                bq.b0[i] = 0.8f + 0.1f * dist(m_random);
+                bq.b1[i] = 0.3f * dist(m_random);
+                bq.b2[i] = 0.1f * dist(m_random);
+                bq.a1[i] = 0.5f * dist(m_random);
+                bq.a2[i] = 0.15f + 0.1f * dist(m_random);
+            }
+        }
+    }
+
+    std::vector<float> randomBuffer(size_t size)
+    {
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+        std::vector<float> buffer(size);
+
+        for (float& sample : buffer) {
+            sample = dist(m_random);
+        }
+
+        return buffer;
+    }
+
+    const ReverbKernels* m_reference = reverbKernels(ReverbKernelBackend::Scalar);
+
+    std::mt19937 m_random { 42 };
+};
+}
+
+TEST_F(Audio_ReverbKernelsTest, DecayFiltersMatchScalar)
+{
+    constexpr int SAMPLES_COUNT = 1000;
+
+    for (ReverbKernelBackend backend : backendsToTest()) {
+        SCOPED_TRACE(reverbKernelBackendName(backend));
+        const ReverbKernels* kernels = reverbKernels(backend);
+
+        for (int linesCount : REVERB_LINES_COUNTS) {
+            SCOPED_TRACE(linesCount);
+
+            //! [GIVEN] The same filters for the reference and the tested backend
+            ReverbDecayFilterBank expectedBank;
+            setupRandomFilters(expectedBank, linesCount);
+            ReverbDecayFilterBank actualBank = expectedBank;
+
+            std::vector<float> input = randomBuffer(SAMPLES_COUNT * linesCount);
+
+            for (int s = 0; s < SAMPLES_COUNT; ++s) {
+                float expected[ReverbDecayFilterBank::MAX_LINES] = {};
+                float actual[ReverbDecayFilterBank::MAX_LINES] = {};
+                std::copy_n(input.data() + s * linesCount, linesCount, expected);
+                std::copy_n(input.data() + s * linesCount, linesCount, actual);
+
+                //! [WHEN] Both process the same signal
+                m_reference->processDecayFilters(expectedBank, expected, linesCount);
+                kernels->processDecayFilters(actualBank, actual, linesCount);
+
+                //! [THEN] The outputs match, the padding lanes stay silent
+                //! NOTE Wider backends may use fused multiply-add
+                for (int i = 0; i < linesCount; ++i) {
+                    ASSERT_NEAR(expected[i], actual[i], 1e-5f);
+                }
+
+                for (int i = linesCount; i < ReverbDecayFilterBank::MAX_LINES; ++i) {
+                    ASSERT_EQ(actual[i], 0.f);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(Audio_ReverbKernelsTest, ReverbOutputDoesNotDependOnBackend)
+{
+    constexpr unsigned int BLOCK_SIZE = 512;
+    constexpr int BLOCKS_COUNT = 20;
+
+    //! [GIVEN] Stereo input: an impulse followed by noise
+    std::vector<float> input = randomBuffer(BLOCK_SIZE * BLOCKS_COUNT * 2);
+    input[0] = input[1] = 1.f;
+
+    //! [GIVEN] The reference output, rendered with the scalar kernels
+    ReverbProcessor reference(AudioFxParams(), 2);
+    ASSERT_TRUE(reference.setKernelBackend(ReverbKernelBackend::Scalar));
+
+    std::vector<float> expected = input;
+    for (int block = 0; block < BLOCKS_COUNT; ++block) {
+        reference.process(expected.data() + block * BLOCK_SIZE * 2, BLOCK_SIZE);
+    }
+
+    for (ReverbKernelBackend backend : backendsToTest()) {
+        SCOPED_TRACE(reverbKernelBackendName(backend));
+
+        //! [WHEN] The same input is rendered with another backend
+        ReverbProcessor reverb(AudioFxParams(), 2);
+        ASSERT_TRUE(reverb.setKernelBackend(backend));
+
+        std::vector<float> actual = input;
+        for (int block = 0; block < BLOCKS_COUNT; ++block) {
+            reverb.process(actual.data() + block * BLOCK_SIZE * 2, BLOCK_SIZE);
+        }
+
+        //! [THEN] The output is the same
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(expected[i], actual[i], 1e-4f);
+        }
+    }
+}
+
+TEST_F(Audio_ReverbKernelsTest, PlanarOutputMatchesInterleaved)
+{
+    constexpr unsigned int BLOCK_SIZE = 512;
+    constexpr int BLOCKS_COUNT = 20;
+
+    //! [GIVEN] Stereo input: an impulse followed by noise
+    std::vector<float> input = randomBuffer(BLOCK_SIZE * BLOCKS_COUNT * 2);
+    input[0] = input[1] = 1.f;
+
+    //! [GIVEN] The output of the interleaved processing
+    ReverbProcessor interleavedReverb(AudioFxParams(), 2);
+
+    std::vector<float> expected = input;
+    for (int block = 0; block < BLOCKS_COUNT; ++block) {
+        interleavedReverb.process(expected.data() + block * BLOCK_SIZE * 2, BLOCK_SIZE);
+    }
+
+    //! [WHEN] The same input is processed in the planar mode
+    ReverbProcessor planarReverb(AudioFxParams(), 2);
+    ASSERT_TRUE(planarReverb.supportsPlanarProcessing());
+
+    std::vector<float> left(BLOCK_SIZE);
+    std::vector<float> right(BLOCK_SIZE);
+    float* channels[] = { left.data(), right.data() };
+
+    for (int block = 0; block < BLOCKS_COUNT; ++block) {
+        const float* frames = input.data() + block * BLOCK_SIZE * 2;
+        for (unsigned int i = 0; i < BLOCK_SIZE; ++i) {
+            left[i] = frames[i * 2];
+            right[i] = frames[i * 2 + 1];
+        }
+
+        planarReverb.processPlanar(channels, BLOCK_SIZE);
+
+        //! [THEN] The output is exactly the same
+        const float* expectedFrames = expected.data() + block * BLOCK_SIZE * 2;
+        for (unsigned int i = 0; i < BLOCK_SIZE; ++i) {
+            ASSERT_EQ(expectedFrames[i * 2], left[i]);
+            ASSERT_EQ(expectedFrames[i * 2 + 1], right[i]);
+        }
+    }
+}
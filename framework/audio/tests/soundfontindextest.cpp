@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "audio/internal/soundfontindex.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::synth;
+
+namespace muse::audio {
+class Audio_SoundFontIndexTest : public ::testing::Test
+{
+protected:
+    static SoundFontMeta meta(const SoundFontPath& path, size_t presetsCount)
+    {
+        SoundFontMeta result;
+        result.path = path;
+
+        for (size_t i = 0; i < presetsCount; ++i) {
+            SoundFontPreset preset;
+            preset.program = midi::Program(static_cast<midi::bank_t>(i / 128), static_cast<midi::program_t>(i % 128));
+            preset.name = "Preset " + std::to_string(i);
+            result.presets.push_back(preset);
+        }
+
+        return result;
+    }
+
+    static SoundFontFileStamp stamp(uint64_t size, int second)
+    {
+        SoundFontFileStamp result;
+        result.size = size;
+        result.lastModified = DateTime(Date(2024, 3, 1), Time(12, 30, second));
+
+        return result;
+    }
+};
+}
+
+TEST_F(Audio_SoundFontIndexTest, IndexSurvivesRestart)
+{
+    //! [GIVEN] An index of two SoundFonts
+    SoundFontIndex index;
+    index.insert(stamp(1000, 1), meta("/sf/first.sf2", 3));
+    index.insert(stamp(5000000000, 2), meta("/sf/second.sf3", 200));
+    EXPECT_TRUE(index.isChanged());
+
+    //! [WHEN] It is saved and loaded again
+    ByteArray data = index.toJson();
+    EXPECT_FALSE(index.isChanged());
+
+    SoundFontIndex loaded;
+    ASSERT_TRUE(loaded.fromJson(data));
+
+    //! [THEN] The presets of the unchanged files are known without parsing them
+    EXPECT_EQ(loaded.size(), 2);
+    EXPECT_FALSE(loaded.isChanged());
+
+    const SoundFontMeta* second = loaded.find("/sf/second.sf3", stamp(5000000000, 2));
+    ASSERT_TRUE(second);
+    ASSERT_EQ(second->presets.size(), 200);
+    EXPECT_EQ(second->path, SoundFontPath("/sf/second.sf3"));
+    EXPECT_EQ(second->presets[130].program, midi::Program(1, 2));
+    EXPECT_EQ(second->presets[130].name, "Preset 130");
+
+    EXPECT_TRUE(loaded.find("/sf/first.sf2", stamp(1000, 1)));
+}
+
+TEST_F(Audio_SoundFontIndexTest, ChangedFilesAreNotFound)
+{
+    //! [GIVEN] An indexed SoundFont
+    SoundFontIndex index;
+    index.insert(stamp(1000, 1), meta("/sf/first.sf2", 3));
+
+    //! [THEN] It has to be parsed again once its size or modification time changes
+    EXPECT_FALSE(index.find("/sf/first.sf2", stamp(1001, 1)));
+    EXPECT_FALSE(index.find("/sf/first.sf2", stamp(1000, 2)));
+    EXPECT_FALSE(index.find("/sf/other.sf2", stamp(1000, 1)));
+
+    //! [WHEN] It is parsed again
+    index.insert(stamp(1001, 2), meta("/sf/first.sf2", 4));
+
+    //! [THEN] The new version replaces the old one
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_FALSE(index.find("/sf/first.sf2", stamp(1000, 1)));
+    ASSERT_TRUE(index.find("/sf/first.sf2", stamp(1001, 2)));
+    EXPECT_EQ(index.find("/sf/first.sf2", stamp(1001, 2))->presets.size(), 4);
+}
+
+TEST_F(Audio_SoundFontIndexTest, RemovedFilesAreDropped)
+{
+    //! [GIVEN] An index of two SoundFonts, saved
+    SoundFontIndex index;
+    index.insert(stamp(1000, 1), meta("/sf/first.sf2", 3));
+    index.insert(stamp(2000, 1), meta("/sf/second.sf2", 3));
+    index.toJson();
+
+    //! [WHEN] Only one of them is still installed
+    index.retain({ "/sf/second.sf2" });
+
+    //! [THEN] The other one is dropped and the index has to be saved
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_TRUE(index.isChanged());
+    EXPECT_FALSE(index.find("/sf/first.sf2", stamp(1000, 1)));
+    EXPECT_TRUE(index.find("/sf/second.sf2", stamp(2000, 1)));
+}
+
+TEST_F(Audio_SoundFontIndexTest, BrokenIndexIsRebuilt)
+{
+    //! [GIVEN] A corrupted index file
+    SoundFontIndex index;
+    ASSERT_TRUE(index.fromJson(ByteArray("{\"version\":1,\"soundFonts\":[]}")));
+    EXPECT_EQ(index.size(), 0);
+
+    //! [THEN] Loading it fails and nothing is found
+    EXPECT_FALSE(index.fromJson(ByteArray("{\"version\":1,\"soundF")));
+    EXPECT_EQ(index.size(), 0);
+
+    //! [WHEN] The index has been written by another version
+    //! [THEN] It is ignored and will be rewritten
+    EXPECT_TRUE(index.fromJson(ByteArray("{\"version\":0,\"soundFonts\":[]}")));
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_TRUE(index.isChanged());
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "audio/internal/synthesizers/fluidsynth/soundfontsamplepool.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::synth;
+
+namespace muse::audio {
+static constexpr size_t SAMPLE_POOL_FILE_SIZE = 256 * 1024;
+
+class Audio_SoundFontSamplePoolTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_path = (std::filesystem::temp_directory_path() / "muse_audio_soundfontsamplepooltest.sf2").string();
+
+        m_content.resize(SAMPLE_POOL_FILE_SIZE);
+        for (size_t i = 0; i < m_content.size(); ++i) {
+            m_content[i] = static_cast<uint8_t>(i * 7);
+        }
+
+        std::FILE* file = std::fopen(m_path.c_str(), "wb");
+        ASSERT_TRUE(file);
+        ASSERT_EQ(std::fwrite(m_content.data(), 1, m_content.size(), file), m_content.size());
+        std::fclose(file);
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    std::string m_path;
+    std::vector<uint8_t> m_content;
+};
+}
+
+TEST_F(Audio_SoundFontSamplePoolTest, FileIsMappedOnceWhileUsed)
+{
+    SoundFontSamplePool* pool = SoundFontSamplePool::instance();
+
+    //! [WHEN] Two users acquire the same file
+    ASSERT_TRUE(pool->acquire(m_path));
+    ASSERT_TRUE(pool->acquire(m_path));
+
+    //! [THEN] They share one mapping of the whole file
+    const uint8_t* data = pool->data(m_path);
+    ASSERT_TRUE(data);
+    EXPECT_EQ(pool->size(m_path), SAMPLE_POOL_FILE_SIZE);
+    EXPECT_EQ(std::vector<uint8_t>(data, data + SAMPLE_POOL_FILE_SIZE), m_content);
+
+    //! [WHEN] One of them releases it
+    pool->release(m_path);
+
+    //! [THEN] The mapping stays
+    EXPECT_EQ(pool->data(m_path), data);
+
+    //! [WHEN] The last one releases it
+    pool->release(m_path);
+
+    //! [THEN] The file is unmapped
+    EXPECT_EQ(pool->data(m_path), nullptr);
+    EXPECT_EQ(pool->memoryUsage(m_path).fileBytes, 0);
+}
+
+TEST_F(Audio_SoundFontSamplePoolTest, SampleDataPointsIntoMapping)
+{
+    SoundFontSamplePool* pool = SoundFontSamplePool::instance();
+
+    //! [WHEN] The sample data of two presets is mapped
+    const uint8_t* first = static_cast<const uint8_t*>(pool->mapSampleData(m_path, 1024, 4096));
+    const uint8_t* second = static_cast<const uint8_t*>(pool->mapSampleData(m_path, 65536, 8192));
+
+    //! [THEN] It is the content of the file at these offsets, no copy is made
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second - first, 65536 - 1024);
+    EXPECT_EQ(first[0], m_content[1024]);
+    EXPECT_EQ(second[8191], m_content[65536 + 8191]);
+
+    //! [WHEN] The mapped samples are prefetched
+    pool->prefetchMappedSamples();
+
+    //! [THEN] The memory usage of the SoundFont is reported
+    SoundFontMemoryUsage usage = pool->memoryUsage(m_path);
+    EXPECT_EQ(usage.fileBytes, SAMPLE_POOL_FILE_SIZE);
+    EXPECT_EQ(usage.sampleBytes, 4096 + 8192);
+    EXPECT_GE(usage.residentBytes, 4096 + 8192);
+    EXPECT_LE(usage.residentBytes, SAMPLE_POOL_FILE_SIZE);
+
+    //! [WHEN] The samples are unmapped
+    pool->unmapSampleData(m_path, 4096);
+    EXPECT_EQ(pool->memoryUsage(m_path).sampleBytes, 8192);
+
+    pool->unmapSampleData(m_path, 8192);
+
+    //! [THEN] Nothing holds the file anymore
+    EXPECT_EQ(pool->data(m_path), nullptr);
+}
+
+TEST_F(Audio_SoundFontSamplePoolTest, SampleDataOutsideFileIsRejected)
+{
+    SoundFontSamplePool* pool = SoundFontSamplePool::instance();
+
+    //! [WHEN] A range past the end of the file is requested
+    //! [THEN] Nothing is mapped, so the caller reads the data as usual
+    EXPECT_EQ(pool->mapSampleData(m_path, SAMPLE_POOL_FILE_SIZE - 16, 32), nullptr);
+    EXPECT_EQ(pool->data(m_path), nullptr);
+
+    //! [WHEN] The file doesn't exist
+    //! [THEN] It can't be acquired
+    EXPECT_FALSE(pool->acquire(m_path + ".missing"));
+}
@@ -0,0 +1,282 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+
+#include "audio/internal/soundtracks/soundtrackwriter.h"
+#include "audio/internal/dsp/loudnessmeter.h"
+#include "audio/audioerrors.h"
+
+#include "utils/peakmemoryusage.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::soundtrack;
+
+namespace muse::audio {
+static constexpr audioch_t AUDIO_CHANNELS_COUNT = 2;
+static constexpr sample_rate_t SAMPLE_RATE = 8000;
+static constexpr samples_t RENDER_STEP = 1024;
+
+static constexpr size_t WAV_HEADER_SIZE = 46;
+static constexpr size_t MEGABYTE = 1024 * 1024;
+static constexpr float TWO_PI = 6.28318530718f;
+
+//! NOTE Produces a sine wave of any length
+class SyntheticAudioSource : public IAudioSource
+{
+public:
+    bool isActive() const override { return m_isActive; }
+    void setIsActive(bool arg) override { m_isActive = arg; }
+
+    void setSampleRate(unsigned int sampleRate) override { m_sampleRate = sampleRate; }
+    unsigned int audioChannelsCount() const override { return AUDIO_CHANNELS_COUNT; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        const float phaseStep = TWO_PI * 440.f / m_sampleRate;
+
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            float sample = 0.5f * std::sin(m_phase);
+            m_phase = std::fmod(m_phase + phaseStep, TWO_PI);
+
+            for (audioch_t ch = 0; ch < AUDIO_CHANNELS_COUNT; ++ch) {
+                buffer[s * AUDIO_CHANNELS_COUNT + ch] = sample;
+            }
+        }
+
+        m_processedSamples += samplesPerChannel;
+
+        return samplesPerChannel;
+    }
+
+    samples_t processedSamples() const { return m_processedSamples; }
+
+private:
+    bool m_isActive = false;
+    unsigned int m_sampleRate = 0;
+    float m_phase = 0.f;
+    samples_t m_processedSamples = 0;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+};
+
+class Audio_SoundTrackWriterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_destination = std::filesystem::temp_directory_path() / "muse_audio_soundtrackwritertest.wav";
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_destination, ec);
+    }
+
+    SoundTrackFormat wavFormat() const
+    {
+        SoundTrackFormat format;
+        format.type = SoundTrackType::WAV;
+        format.sampleRate = SAMPLE_RATE;
+        format.samplesPerChannel = RENDER_STEP;
+        format.audioChannelsNumber = AUDIO_CHANNELS_COUNT;
+
+        return format;
+    }
+
+    //! NOTE The samples of a float WAV file written by the test
+    std::vector<float> readWavSamples() const
+    {
+        std::vector<float> samples((std::filesystem::file_size(m_destination) - WAV_HEADER_SIZE) / sizeof(float));
+
+        std::FILE* file = std::fopen(m_destination.string().c_str(), "rb");
+        std::fseek(file, WAV_HEADER_SIZE, SEEK_SET);
+        EXPECT_EQ(std::fread(samples.data(), sizeof(float), samples.size(), file), samples.size());
+        std::fclose(file);
+
+        return samples;
+    }
+
+    std::filesystem::path m_destination;
+};
+}
+
+TEST_F(Audio_SoundTrackWriterTest, WritesWholeDuration)
+{
+    //! [GIVEN] A 10 seconds long source
+    const msecs_t duration = 10 * 1000000;
+    const samples_t expectedSamples = 10 * SAMPLE_RATE;
+
+    auto source = std::make_shared<SyntheticAudioSource>();
+    SoundTrackWriter writer(m_destination.string(), wavFormat(), duration, source, modularity::globalCtx());
+
+    //! [WHEN] Export it
+    Ret ret = writer.write();
+
+    //! [THEN] The file contains exactly the requested duration
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(std::filesystem::file_size(m_destination),
+              WAV_HEADER_SIZE + expectedSamples * AUDIO_CHANNELS_COUNT * sizeof(float));
+}
+
+TEST_F(Audio_SoundTrackWriterTest, LongExportHasBoundedMemoryUsage)
+{
+    if (!tests::PeakMemoryUsage::isSupported()) {
+        GTEST_SKIP() << "Peak memory usage is not available on this platform";
+    }
+
+    //! [GIVEN] A 10 minutes long source, rendering it in memory would take more than 70 MB
+    const msecs_t duration = msecs_t(10) * 60 * 1000000;
+    const samples_t expectedSamples = 10 * 60 * SAMPLE_RATE;
+
+    auto source = std::make_shared<SyntheticAudioSource>();
+    SoundTrackWriter writer(m_destination.string(), wavFormat(), duration, source, modularity::globalCtx());
+
+    //! [WHEN] Export it, watching the peak memory usage
+    tests::PeakMemoryUsage::reset();
+    const size_t rssBefore = tests::PeakMemoryUsage::currentResidentSetSize();
+
+    Ret ret = writer.write();
+
+    const size_t peakGrowth = tests::PeakMemoryUsage::peakResidentSetSize() - rssBefore;
+
+    //! [THEN] Everything is written
+    EXPECT_TRUE(ret);
+    EXPECT_GE(source->processedSamples(), expectedSamples);
+    EXPECT_EQ(std::filesystem::file_size(m_destination),
+              WAV_HEADER_SIZE + expectedSamples * AUDIO_CHANNELS_COUNT * sizeof(float));
+
+    //! [THEN] The memory usage doesn't depend on the duration
+    EXPECT_LT(peakGrowth, 8 * MEGABYTE);
+}
+
+TEST_F(Audio_SoundTrackWriterTest, Abort)
+{
+    //! [GIVEN] A long export
+    auto source = std::make_shared<SyntheticAudioSource>();
+    SoundTrackWriter writer(m_destination.string(), wavFormat(), msecs_t(60) * 60 * 1000000, source, modularity::globalCtx());
+
+    //! [GIVEN] It is aborted as soon as it reports progress
+    writer.progress().progressChanged().onReceive(nullptr, [&writer](int64_t current, int64_t, std::string) {
+        if (current > 0) {
+            writer.abort();
+        }
+    });
+
+    //! [WHEN] Export it
+    Ret ret = writer.write();
+
+    //! [THEN] The export is cancelled
+    EXPECT_EQ(ret.code(), static_cast<int>(Ret::Code::Cancel));
+}
+
+TEST_F(Audio_SoundTrackWriterTest, UnfinalizedFileFailsExport)
+{
+    //! NOTE Opening and buffered writes succeed on /dev/full, only writing to the disk fails
+    const std::filesystem::path fullDevice = "/dev/full";
+    if (!std::filesystem::exists(fullDevice)) {
+        GTEST_SKIP() << "/dev/full is not available on this platform";
+    }
+
+    //! [GIVEN] An export short enough to be kept in the buffers of the file until it is finalized
+    auto source = std::make_shared<SyntheticAudioSource>();
+    SoundTrackWriter writer(fullDevice.string(), wavFormat(), 10 * 1000, source, modularity::globalCtx());
+
+    //! [WHEN] Export it
+    Ret ret = writer.write();
+
+    //! [THEN] The export fails, since the file couldn't be finalized
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::ErrorEncode));
+}
+
+TEST_F(Audio_SoundTrackWriterTest, MeasuresLoudness)
+{
+    //! [GIVEN] A sine at -6 dBFS in both channels
+    auto source = std::make_shared<SyntheticAudioSource>();
+    SoundTrackWriter writer(m_destination.string(), wavFormat(), 10 * 1000000, source, modularity::globalCtx());
+
+    //! [WHEN] Export it
+    EXPECT_TRUE(writer.write());
+
+    //! [THEN] The loudness is measured (the K-weighting is about 0.5 dB lower at 440 Hz than at 1 kHz), nothing is changed
+    AudioLoudnessValue loudness = writer.loudness();
+    EXPECT_NEAR(loudness.integratedLufs, -6.5f, 0.2f);
+    EXPECT_NEAR(loudness.truePeakDbtp, -6.02f, 0.1f);
+    EXPECT_FLOAT_EQ(writer.normalizationGain(), 1.f);
+}
+
+TEST_F(Audio_SoundTrackWriterTest, NormalizesToTargetLoudness)
+{
+    //! [GIVEN] An export normalized to -20 LUFS
+    SoundTrackFormat format = wavFormat();
+    format.normalization.enabled = true;
+    format.normalization.targetLufs = -20.f;
+
+    auto source = std::make_shared<SyntheticAudioSource>();
+    SoundTrackWriter writer(m_destination.string(), format, 10 * 1000000, source, modularity::globalCtx());
+
+    //! [WHEN] Export it
+    Ret ret = writer.write();
+
+    //! [THEN] The source was rendered only once and all of it is written
+    EXPECT_TRUE(ret);
+    EXPECT_LT(source->processedSamples(), 10 * SAMPLE_RATE + RENDER_STEP);
+
+    std::vector<float> samples = readWavSamples();
+    ASSERT_EQ(samples.size(), 10 * SAMPLE_RATE * AUDIO_CHANNELS_COUNT);
+
+    //! [THEN] The written audio is at the target loudness
+    dsp::LoudnessMeter meter(SAMPLE_RATE, AUDIO_CHANNELS_COUNT);
+    meter.process(samples.data(), 10 * SAMPLE_RATE);
+
+    EXPECT_NEAR(meter.integratedLoudness(), -20.f, 0.1f);
+    EXPECT_NEAR(writer.normalizationGain(), std::pow(10.f, (-20.f - writer.loudness().integratedLufs) / 20.f), 1e-4f);
+}
+
+TEST_F(Audio_SoundTrackWriterTest, NormalizationKeepsTruePeakBelowCeiling)
+{
+    //! [GIVEN] A target loudness which would push the peaks above full scale
+    SoundTrackFormat format = wavFormat();
+    format.normalization.enabled = true;
+    format.normalization.targetLufs = 0.f;
+    format.normalization.truePeakCeilingDbtp = -1.f;
+
+    auto source = std::make_shared<SyntheticAudioSource>();
+    SoundTrackWriter writer(m_destination.string(), format, 10 * 1000000, source, modularity::globalCtx());
+
+    //! [WHEN] Export it
+    EXPECT_TRUE(writer.write());
+
+    //! [THEN] The gain is limited by the true-peak ceiling
+    float peak = 0.f;
+    for (float sample : readWavSamples()) {
+        peak = std::max(peak, std::abs(sample));
+    }
+
+    EXPECT_LE(peak, std::pow(10.f, -1.f / 20.f) + 1e-4f);
+    EXPECT_GT(peak, std::pow(10.f, -1.2f / 20.f));
+}
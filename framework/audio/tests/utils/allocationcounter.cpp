@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace muse::audio::tests;
+
+static std::atomic<bool> s_countingEnabled = false;
+static std::atomic<size_t> s_allocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+    if (s_countingEnabled.load(std::memory_order_relaxed)) {
+        s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void AllocationCounter::start()
+{
+    s_allocationCount = 0;
+    s_countingEnabled = true;
+}
+
+size_t AllocationCounter::stop()
+{
+    s_countingEnabled = false;
+    return s_allocationCount;
+}
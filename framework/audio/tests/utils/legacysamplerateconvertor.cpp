@@ -19,18 +19,18 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
-#include "samplerateconvertor.h"
+#include "legacysamplerateconvertor.h"
 
 #include <cmath>
 
 #include "log.h"
 
-using namespace muse::audio;
+using namespace muse::audio::tests;
 
-SampleRateConvertor::SampleRateConvertor(const std::vector<float>& data,
-                                         unsigned int channelsCount,
-                                         unsigned int sampleRateIn,
-                                         unsigned int sampleRateOut)
+LegacySampleRateConvertor::LegacySampleRateConvertor(const std::vector<float>& data,
+                                                     unsigned int channelsCount,
+                                                     unsigned int sampleRateIn,
+                                                     unsigned int sampleRateOut)
     : m_data(data), m_fir(), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
 {
     m_fir.resize(FIR_LENGTH, 0);
@@ -38,7 +38,7 @@ SampleRateConvertor::SampleRateConvertor(const std::vector<float>& data,
     initWindow();
 }
 
-std::vector<float> SampleRateConvertor::convert()
+std::vector<float> LegacySampleRateConvertor::convert()
 {
     std::vector<float> out;
     auto resultSamples = m_data.size() * m_sampleRateOut / (m_channelsCount * m_sampleRateIn);
@@ -53,7 +53,7 @@ std::vector<float> SampleRateConvertor::convert()
     return out;
 }
 
-unsigned int SampleRateConvertor::convert(float* buffer, unsigned int from, unsigned int count)
+unsigned int LegacySampleRateConvertor::convert(float* buffer, unsigned int from, unsigned int count)
 {
     unsigned int sample = from;
     unsigned int converted = 0;
@@ -69,7 +69,7 @@ unsigned int SampleRateConvertor::convert(float* buffer, unsigned int from, unsi
     return converted;
 }
 
-float SampleRateConvertor::y(unsigned int sample, unsigned int channel) const
+float LegacySampleRateConvertor::y(unsigned int sample, unsigned int channel) const
 {
     switch (m_method) {
     case SINC:
@@ -80,12 +80,12 @@ float SampleRateConvertor::y(unsigned int sample, unsigned int channel) const
     return 0.f;
 }
 
-void SampleRateConvertor::setChannelCount(unsigned int count)
+void LegacySampleRateConvertor::setChannelCount(unsigned int count)
 {
     m_channelsCount = count;
 }
 
-void SampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
+void LegacySampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
 {
     if (m_sampleRateIn != sampleRate) {
         m_sampleRateIn = sampleRate;
@@ -93,7 +93,7 @@ void SampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
     }
 }
 
-void SampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
+void LegacySampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
 {
     if (m_sampleRateOut != sampleRate) {
         m_sampleRateOut = sampleRate;
@@ -101,7 +101,7 @@ void SampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
     }
 }
 
-float SampleRateConvertor::ySinc(unsigned int sample, unsigned int channel) const
+float LegacySampleRateConvertor::ySinc(unsigned int sample, unsigned int channel) const
 {
     double currentOutputSampleTime = sample / static_cast<double>(m_sampleRateOut);
     auto zeroInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn);
@@ -119,7 +119,7 @@ float SampleRateConvertor::ySinc(unsigned int sample, unsigned int channel) cons
     return out;
 }
 
-float SampleRateConvertor::yFIR(unsigned int sample, unsigned int channel) const
+float LegacySampleRateConvertor::yFIR(unsigned int sample, unsigned int channel) const
 {
     auto x = [this, &channel](int m) -> float {
         int pos = m * m_M / m_L * m_channelsCount + channel;
@@ -137,7 +137,7 @@ float SampleRateConvertor::yFIR(unsigned int sample, unsigned int channel) const
     return y;
 }
 
-bool SampleRateConvertor::availableSamples(unsigned int sample) const
+bool LegacySampleRateConvertor::availableSamples(unsigned int sample) const
 {
     float currentOutputSampleTime = sample / static_cast<float>(m_sampleRateOut);
     auto firstInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn) - USE_SAMPLES / 2;
@@ -165,7 +165,7 @@ inline double zeroBessel(double x)
     return s;
 }
 
-void SampleRateConvertor::initWindow()
+void LegacySampleRateConvertor::initWindow()
 {
     int max = std::max(m_sampleRateIn, m_sampleRateOut), min = std::min(m_sampleRateIn, m_sampleRateOut);
     int maxCommonDivider = 1;
@@ -201,7 +201,7 @@ void SampleRateConvertor::initWindow()
     }
 }
 
-double SampleRateConvertor::sinc(double value) const
+double LegacySampleRateConvertor::sinc(double value) const
 {
     if (value == 0) {
         return 1.f;
@@ -19,21 +19,22 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
-#ifndef MUSE_AUDIO_SAMPLERATECONVERTOR_H
-#define MUSE_AUDIO_SAMPLERATECONVERTOR_H
+#pragma once
 
 #include <vector>
 #include <deque>
 
-namespace muse::audio {
-class SampleRateConvertor
+namespace muse::audio::tests {
+//! NOTE The sample rate convertor which AudioStream used before PolyphaseResampler,
+//! kept as the reference for the resampler tests and benchmarks
+class LegacySampleRateConvertor
 {
 public:
     enum Method {
         SINC, FIR
     };
-    explicit SampleRateConvertor(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
-                                 unsigned int sampleRateOut);
+    explicit LegacySampleRateConvertor(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
+                                       unsigned int sampleRateOut);
 
     //! offline convert full data set
     std::vector<float> convert();
@@ -76,5 +77,3 @@ private:
     Method m_method = FIR;
 };
 }
-
-#endif // MUSE_AUDIO_SAMPLERATECONVERTOR_H
@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "peakmemoryusage.h"
+
+#include <fstream>
+#include <string>
+
+using namespace muse::audio::tests;
+
+#ifdef __linux__
+static size_t readStatusField(const std::string& field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0) {
+            return std::stoull(line.substr(field.size())) * 1024; // the value is in kB
+        }
+    }
+
+    return 0;
+}
+#endif
+
+bool PeakMemoryUsage::isSupported()
+{
+#ifdef __linux__
+    return readStatusField("VmHWM:") != 0;
+#else
+    return false;
+#endif
+}
+
+void PeakMemoryUsage::reset()
+{
+#ifdef __linux__
+    //! NOTE See proc(5): writing 5 to clear_refs resets the peak RSS to the current RSS
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+}
+
+size_t PeakMemoryUsage::peakResidentSetSize()
+{
+#ifdef __linux__
+    return readStatusField("VmHWM:");
+#else
+    return 0;
+#endif
+}
+
+size_t PeakMemoryUsage::currentResidentSetSize()
+{
+#ifdef __linux__
+    return readStatusField("VmRSS:");
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,258 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "audio/internal/dsp/vectorkernels.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::dsp;
+
+namespace muse::audio {
+//! NOTE Odd sizes and channels counts exercise the scalar tails
+static const std::vector<audioch_t> CHANNELS_COUNTS = { 1, 2, 3, 4, 6, 8 };
+static const std::vector<samples_t> FRAMES_COUNTS = { 0, 1, 7, 64, 257, 1024 };
+
+class Audio_VectorKernelsTest : public ::testing::Test
+{
+protected:
+    //! NOTE Every compiled in and supported backend is checked against the scalar one
+    std::vector<VectorBackend> backendsToTest() const
+    {
+        std::vector<VectorBackend> result;
+
+        for (VectorBackend backend : { VectorBackend::SSE2, VectorBackend::AVX2, VectorBackend::NEON }) {
+            if (isVectorBackendAvailable(backend)) {
+                result.push_back(backend);
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<float> randomBuffer(size_t size)
+    {
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+        std::vector<float> buffer(size);
+
+        for (float& sample : buffer) {
+            sample = dist(m_random);
+        }
+
+        return buffer;
+    }
+
+    const VectorKernels* m_reference = vectorKernels(VectorBackend::Scalar);
+
+    std::mt19937 m_random { 42 };
+};
+}
+
+TEST_F(Audio_VectorKernelsTest, Accumulate)
+{
+    for (VectorBackend backend : backendsToTest()) {
+        SCOPED_TRACE(vectorBackendName(backend));
+        const VectorKernels* kernels = vectorKernels(backend);
+
+        for (samples_t frames : FRAMES_COUNTS) {
+            const size_t size = frames * 2;
+            std::vector<float> src = randomBuffer(size);
+            std::vector<float> expected = randomBuffer(size);
+            std::vector<float> actual = expected;
+
+            m_reference->accumulate(expected.data(), src.data(), size);
+            kernels->accumulate(actual.data(), src.data(), size);
+
+            for (size_t i = 0; i < size; ++i) {
+                ASSERT_FLOAT_EQ(expected[i], actual[i]);
+            }
+
+            m_reference->accumulateScaled(expected.data(), src.data(), 0.3f, size);
+            kernels->accumulateScaled(actual.data(), src.data(), 0.3f, size);
+
+            for (size_t i = 0; i < size; ++i) {
+                ASSERT_NEAR(expected[i], actual[i], 1e-6f);
+            }
+        }
+    }
+}
+
+TEST_F(Audio_VectorKernelsTest, ApplyGains)
+{
+    const gain_t gains[] = { 0.5f, 1.5f, 0.7f, 1.f, 2.f, 0.1f, 0.9f, 1.1f };
+
+    for (VectorBackend backend : backendsToTest()) {
+        SCOPED_TRACE(vectorBackendName(backend));
+        const VectorKernels* kernels = vectorKernels(backend);
+
+        for (audioch_t channels : CHANNELS_COUNTS) {
+            for (samples_t frames : FRAMES_COUNTS) {
+                std::vector<float> expected = randomBuffer(frames * channels);
+                std::vector<float> actual = expected;
+
+                std::vector<float> expectedSums(channels, -1.f);
+                std::vector<float> actualSums(channels, -1.f);
+
+                m_reference->applyGains(expected.data(), frames, channels, gains, expectedSums.data());
+                kernels->applyGains(actual.data(), frames, channels, gains, actualSums.data());
+
+                for (size_t i = 0; i < expected.size(); ++i) {
+                    ASSERT_FLOAT_EQ(expected[i], actual[i]);
+                }
+
+                //! NOTE The vector backends sum in a different order
+                for (audioch_t ch = 0; ch < channels; ++ch) {
+                    EXPECT_NEAR(expectedSums[ch], actualSums[ch], 1e-4f * (1.f + expectedSums[ch]));
+                }
+            }
+        }
+    }
+}
+
+TEST_F(Audio_VectorKernelsTest, SumOfSquares)
+{
+    for (VectorBackend backend : backendsToTest()) {
+        SCOPED_TRACE(vectorBackendName(backend));
+        const VectorKernels* kernels = vectorKernels(backend);
+
+        for (samples_t frames : FRAMES_COUNTS) {
+            std::vector<float> src = randomBuffer(frames * 2);
+
+            float expected = m_reference->sumOfSquares(src.data(), src.size());
+            float actual = kernels->sumOfSquares(src.data(), src.size());
+
+            EXPECT_NEAR(expected, actual, 1e-4f * (1.f + expected));
+        }
+    }
+}
+
+TEST_F(Audio_VectorKernelsTest, DotProduct)
+{
+    for (VectorBackend backend : backendsToTest()) {
+        SCOPED_TRACE(vectorBackendName(backend));
+        const VectorKernels* kernels = vectorKernels(backend);
+
+        for (samples_t frames : FRAMES_COUNTS) {
+            std::vector<float> a = randomBuffer(frames);
+            std::vector<float> b = randomBuffer(frames);
+
+            float expected = m_reference->dotProduct(a.data(), b.data(), frames);
+            float actual = kernels->dotProduct(a.data(), b.data(), frames);
+
+            EXPECT_NEAR(expected, actual, 1e-4f * (1.f + std::abs(expected)));
+        }
+    }
+}
+
+TEST_F(Audio_VectorKernelsTest, InterpolatedPeak)
+{
+    const size_t taps = 12;
+    std::vector<float> coefficients = randomBuffer(taps * 4);
+
+    for (VectorBackend backend : backendsToTest()) {
+        SCOPED_TRACE(vectorBackendName(backend));
+        const VectorKernels* kernels = vectorKernels(backend);
+
+        for (samples_t frames : FRAMES_COUNTS) {
+            std::vector<float> src = randomBuffer(frames + taps - 1);
+
+            float expected = m_reference->interpolatedPeak(src.data(), frames, coefficients.data(), taps);
+            float actual = kernels->interpolatedPeak(src.data(), frames, coefficients.data(), taps);
+
+            EXPECT_NEAR(expected, actual, 1e-4f * (1.f + expected));
+        }
+    }
+}
+
+TEST_F(Audio_VectorKernelsTest, InterleaveStereo)
+{
+    for (VectorBackend backend : backendsToTest()) {
+        SCOPED_TRACE(vectorBackendName(backend));
+        const VectorKernels* kernels = vectorKernels(backend);
+
+        for (samples_t frames : FRAMES_COUNTS) {
+            //! [GIVEN] Two planar channels
+            std::vector<float> left = randomBuffer(frames);
+            std::vector<float> right = randomBuffer(frames);
+
+            //! [WHEN] Interleave them
+            std::vector<float> interleaved(frames * 2, 0.f);
+            kernels->interleaveStereo(interleaved.data(), left.data(), right.data(), frames);
+
+            //! [THEN] The frames alternate between the channels
+            for (samples_t i = 0; i < frames; ++i) {
+                ASSERT_EQ(left[i], interleaved[i * 2]);
+                ASSERT_EQ(right[i], interleaved[i * 2 + 1]);
+            }
+
+            //! [WHEN] Deinterleave them back
+            std::vector<float> leftOut(frames, 0.f);
+            std::vector<float> rightOut(frames, 0.f);
+            kernels->deinterleaveStereo(leftOut.data(), rightOut.data(), interleaved.data(), frames);
+
+            //! [THEN] The channels are restored exactly
+            EXPECT_EQ(left, leftOut);
+            EXPECT_EQ(right, rightOut);
+        }
+    }
+}
+
+TEST_F(Audio_VectorKernelsTest, InterleaveAnyChannelsCount)
+{
+    for (audioch_t channels : CHANNELS_COUNTS) {
+        const samples_t frames = 257;
+
+        //! [GIVEN] An interleaved buffer
+        std::vector<float> interleaved = randomBuffer(frames * channels);
+
+        //! [WHEN] Deinterleave it and interleave it again
+        std::vector<std::vector<float> > planar(channels, std::vector<float>(frames, 0.f));
+        std::vector<float*> planarPtrs;
+        for (std::vector<float>& channel : planar) {
+            planarPtrs.push_back(channel.data());
+        }
+
+        deinterleave(planarPtrs.data(), interleaved.data(), channels, frames);
+
+        std::vector<float> restored(frames * channels, 0.f);
+        interleave(restored.data(), planarPtrs.data(), channels, frames);
+
+        //! [THEN] The planar channels hold the samples of each channel, and the round trip is exact
+        for (audioch_t ch = 0; ch < channels; ++ch) {
+            for (samples_t i = 0; i < frames; ++i) {
+                ASSERT_EQ(interleaved[i * channels + ch], planar[ch][i]);
+            }
+        }
+
+        EXPECT_EQ(interleaved, restored);
+    }
+}
+
+TEST_F(Audio_VectorKernelsTest, ActiveKernelsAreTheBestAvailable)
+{
+    EXPECT_EQ(&activeVectorKernels(), vectorKernels(bestAvailableVectorBackend()));
+}
@@ -0,0 +1,203 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "audio/internal/worker/voicebudget.h"
+
+#include "utils/allocationcounter.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+static constexpr int64_t VOICE_BUDGET_BLOCK_NS = 10000000; // 10 ms
+
+class Audio_VoiceBudgetTest : public ::testing::Test
+{
+protected:
+    static void update(VoiceBudget& budget, float load)
+    {
+        budget.update(static_cast<int64_t>(load * VOICE_BUDGET_BLOCK_NS), VOICE_BUDGET_BLOCK_NS);
+    }
+};
+}
+
+TEST_F(Audio_VoiceBudgetTest, FreeVoicesAreAvailableToEverySynth)
+{
+    //! [GIVEN] Two synths playing well below the budget
+    VoiceBudget budget(256);
+    VoiceBudget::ClientPtr first = budget.registerClient();
+    VoiceBudget::ClientPtr second = budget.registerClient();
+
+    first->report(50, 0);
+    second->report(30, 0);
+
+    //! [WHEN] A block has been rendered in time
+    update(budget, 0.2f);
+
+    //! [THEN] Each of them may start as many new voices as are free
+    EXPECT_EQ(budget.budget(), 256);
+    EXPECT_EQ(budget.activeVoices(), 80);
+    EXPECT_EQ(first->allowed(), 50 + 176);
+    EXPECT_EQ(second->allowed(), 30 + 176);
+}
+
+TEST_F(Audio_VoiceBudgetTest, BudgetIsSharedByDemand)
+{
+    //! [GIVEN] Two synths that need more voices than the budget together
+    VoiceBudget budget(256);
+    VoiceBudget::ClientPtr first = budget.registerClient();
+    VoiceBudget::ClientPtr second = budget.registerClient();
+
+    //! [WHEN] One of them had to steal voices to stay within its share
+    first->report(200, 100);
+    second->report(100, 0);
+    update(budget, 0.2f);
+
+    //! [THEN] The stolen voices still count, the budget is split by what the synths need
+    EXPECT_EQ(budget.stolenVoices(), 100);
+    EXPECT_EQ(first->allowed(), 256 * 300 / 400);
+    EXPECT_EQ(second->allowed(), 256 * 100 / 400);
+
+    //! [WHEN] A synth needs a few voices only
+    first->report(1000, 0);
+    second->report(1, 0);
+    update(budget, 0.2f);
+
+    //! [THEN] It keeps a minimum, so its new notes can still sound
+    EXPECT_EQ(second->allowed(), VoiceBudget::MIN_CLIENT_VOICES);
+}
+
+TEST_F(Audio_VoiceBudgetTest, OverloadCutsBudget)
+{
+    //! [GIVEN] Synths playing 400 voices
+    VoiceBudget budget(1024);
+    VoiceBudget::ClientPtr client = budget.registerClient();
+    client->report(400, 0);
+
+    //! [WHEN] Rendering a block took longer than the block lasts
+    update(budget, 1.2f);
+
+    //! [THEN] The budget is cut to what fits in the target load
+    EXPECT_EQ(budget.budget(), 200);
+    EXPECT_EQ(client->allowed(), 200);
+
+    //! [WHEN] The next blocks are rendered in time
+    client->report(200, 200);
+    update(budget, 0.6f);
+
+    //! [THEN] The budget stays, as long as the load isn't low for a while
+    EXPECT_EQ(budget.budget(), 200);
+
+    for (int i = 0; i < 200; ++i) {
+        client->report(budget.budget(), 0);
+        update(budget, 0.1f);
+    }
+
+    //! [THEN] Then it grows back up to the maximum
+    EXPECT_EQ(budget.budget(), 1024);
+}
+
+TEST_F(Audio_VoiceBudgetTest, BudgetHasLowerLimit)
+{
+    //! [GIVEN] A machine that can't render even a few voices in time
+    VoiceBudget budget(1024);
+    VoiceBudget::ClientPtr client = budget.registerClient();
+    client->report(10, 0);
+
+    //! [WHEN] It is heavily overloaded
+    update(budget, 5.f);
+
+    //! [THEN] The budget doesn't drop under the minimum
+    EXPECT_EQ(budget.budget(), VoiceBudget::MIN_VOICES);
+}
+
+TEST_F(Audio_VoiceBudgetTest, DeletedSynthsAreDropped)
+{
+    //! [GIVEN] Two synths sharing the budget
+    VoiceBudget budget(256);
+    VoiceBudget::ClientPtr first = budget.registerClient();
+    VoiceBudget::ClientPtr second = budget.registerClient();
+
+    first->report(300, 0);
+    second->report(300, 0);
+    update(budget, 0.2f);
+    EXPECT_EQ(first->allowed(), 128);
+
+    //! [WHEN] One of them is deleted
+    second.reset();
+    update(budget, 0.2f);
+
+    //! [THEN] The other one gets the whole budget
+    EXPECT_EQ(first->allowed(), 256);
+}
+
+TEST_F(Audio_VoiceBudgetTest, SlotsOfDeletedSynthsAreReused)
+{
+    //! [GIVEN] All the slots are taken
+    VoiceBudget budget(256);
+    std::vector<VoiceBudget::ClientPtr> clients;
+
+    for (size_t i = 0; i < VoiceBudget::MAX_CLIENTS; ++i) {
+        clients.push_back(budget.registerClient());
+        ASSERT_TRUE(clients.back());
+    }
+
+    //! [THEN] One more synth isn't limited
+    EXPECT_FALSE(budget.registerClient());
+
+    //! [WHEN] A synth is deleted
+    clients[42].reset();
+
+    //! [THEN] Its slot can be taken again, and the new synth starts with the whole budget
+    VoiceBudget::ClientPtr client = budget.registerClient();
+    ASSERT_TRUE(client);
+    EXPECT_EQ(client->allowed(), 256);
+    EXPECT_EQ(client->activeVoices, 0);
+}
+
+TEST_F(Audio_VoiceBudgetTest, UpdateDoesNotAllocate)
+{
+    //! [GIVEN] A few synths, some of them already deleted
+    VoiceBudget budget(256);
+    std::vector<VoiceBudget::ClientPtr> clients;
+
+    for (int i = 0; i < 16; ++i) {
+        clients.push_back(budget.registerClient());
+        clients.back()->report(20, 0);
+    }
+
+    clients[3].reset();
+    clients[7].reset();
+
+    //! [WHEN] The budget is updated
+    tests::AllocationCounter::start();
+    update(budget, 0.2f);
+    size_t allocations = tests::AllocationCounter::stop();
+
+    //! [THEN] No heap allocations were made
+    EXPECT_EQ(allocations, 0);
+    EXPECT_EQ(budget.activeVoices(), 14 * 20);
+}
@@ -54,16 +54,22 @@ struct _fluid_samplecache_entry_t
 
     int num_references;
     int mlocked;
+    const fluid_samplecache_mapper_t *mapper; /* the mapper of the file the sample data points into, or NULL */
 };
 
 static fluid_list_t *samplecache_list = NULL;
 static fluid_mutex_t samplecache_mutex = FLUID_MUTEX_INIT;
+static const fluid_samplecache_mapper_t *samplecache_mapper = NULL;
+static const fluid_samplecache_lock_t *samplecache_lock = NULL;
 
 static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf, unsigned int sample_start,
         unsigned int sample_end, int sample_type, time_t mtime);
 static fluid_samplecache_entry_t *get_samplecache_entry(SFData *sf, unsigned int sample_start,
         unsigned int sample_end, int sample_type, time_t mtime);
 static void delete_samplecache_entry(fluid_samplecache_entry_t *entry);
+static int map_sample_data(fluid_samplecache_entry_t *entry, SFData *sf);
+static void lock_samplecache(void);
+static void unlock_samplecache(void);
 
 static int fluid_get_file_modification_time(char *filename, time_t *modification_time);
 
@@ -78,7 +84,7 @@ int fluid_samplecache_load(SFData *sf,
     int ret;
     time_t mtime;
 
-    fluid_mutex_lock(samplecache_mutex);
+    lock_samplecache();
 
     if(fluid_get_file_modification_time(sf->fname, &mtime) == FLUID_FAILED)
     {
@@ -87,9 +93,10 @@ int fluid_samplecache_load(SFData *sf,
 
     entry = get_samplecache_entry(sf, sample_start, sample_end, sample_type, mtime);
 
+    /* MuseScore: the lock is held until the entry is referenced, so that another thread
+     * neither creates the same entry nor unloads it in between */
     if(entry == NULL)
     {
-        fluid_mutex_unlock(samplecache_mutex);
         entry = new_samplecache_entry(sf, sample_start, sample_end, sample_type, mtime);
 
         if(entry == NULL)
@@ -98,10 +105,8 @@ int fluid_samplecache_load(SFData *sf,
             goto unlock_exit;
         }
 
-        fluid_mutex_lock(samplecache_mutex);
         samplecache_list = fluid_list_prepend(samplecache_list, entry);
     }
-        fluid_mutex_unlock(samplecache_mutex);
 
     if(try_mlock && !entry->mlocked)
     {
@@ -132,16 +137,29 @@ int fluid_samplecache_load(SFData *sf,
     ret = entry->sample_count;
 
 unlock_exit:
+    unlock_samplecache();
     return ret;
 }
 
+void fluid_samplecache_set_mapper(const fluid_samplecache_mapper_t *mapper)
+{
+    lock_samplecache();
+    samplecache_mapper = mapper;
+    unlock_samplecache();
+}
+
+void fluid_samplecache_set_lock(const fluid_samplecache_lock_t *lock)
+{
+    samplecache_lock = lock;
+}
+
 int fluid_samplecache_unload(const short *sample_data)
 {
     fluid_list_t *entry_list;
     fluid_samplecache_entry_t *entry;
     int ret;
 
-    fluid_mutex_lock(samplecache_mutex);
+    lock_samplecache();
 
     entry_list = samplecache_list;
 
@@ -180,12 +198,32 @@ int fluid_samplecache_unload(const short *sample_data)
     ret = FLUID_FAILED;
 
 unlock_exit:
-    fluid_mutex_unlock(samplecache_mutex);
+    unlock_samplecache();
     return ret;
 }
 
 
 /* Private functions */
+static void lock_samplecache(void)
+{
+    fluid_mutex_lock(samplecache_mutex);
+
+    if(samplecache_lock != NULL)
+    {
+        samplecache_lock->lock(samplecache_lock->data);
+    }
+}
+
+static void unlock_samplecache(void)
+{
+    if(samplecache_lock != NULL)
+    {
+        samplecache_lock->unlock(samplecache_lock->data);
+    }
+
+    fluid_mutex_unlock(samplecache_mutex);
+}
+
 static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf,
         unsigned int sample_start,
         unsigned int sample_end,
@@ -221,8 +259,13 @@ static fluid_samplecache_entry_t *new_samplecache_entry(SFData *sf,
     entry->sample_type = sample_type;
     entry->modification_time = mtime;
 
-    entry->sample_count = fluid_sffile_read_sample_data(sf, sample_start, sample_end, sample_type,
-                          &entry->sample_data, &entry->sample_data24);
+    entry->sample_count = map_sample_data(entry, sf);
+
+    if(entry->sample_count <= 0)
+    {
+        entry->sample_count = fluid_sffile_read_sample_data(sf, sample_start, sample_end, sample_type,
+                              &entry->sample_data, &entry->sample_data24);
+    }
 
     if(entry->sample_count < 0)
     {
@@ -240,12 +283,80 @@ static void delete_samplecache_entry(fluid_samplecache_entry_t *entry)
 {
     fluid_return_if_fail(entry != NULL);
 
+    /* The mapper may have been replaced since, the data is returned to the one which mapped it */
+    if(entry->mapper != NULL)
+    {
+        entry->mapper->unmap(entry->mapper->data, entry->filename, entry->sample_data,
+                             entry->sample_count * sizeof(short));
+
+        if(entry->sample_data24 != NULL)
+        {
+            entry->mapper->unmap(entry->mapper->data, entry->filename, entry->sample_data24,
+                                 entry->sample_count);
+        }
+    }
+    else
+    {
+        FLUID_FREE(entry->sample_data);
+        FLUID_FREE(entry->sample_data24);
+    }
+
     FLUID_FREE(entry->filename);
-    FLUID_FREE(entry->sample_data);
-    FLUID_FREE(entry->sample_data24);
     FLUID_FREE(entry);
 }
 
+/* MuseScore: points the entry into the mapped SoundFont file. Only 16-bit little endian data
+ * can be used as it is stored, compressed samples are still decoded into heap buffers.
+ * Returns the number of sample points, or 0 if the data has to be read. */
+static int map_sample_data(fluid_samplecache_entry_t *entry, SFData *sf)
+{
+    const fluid_samplecache_mapper_t *mapper = samplecache_mapper;
+    const void *data;
+    const void *data24 = NULL;
+    unsigned int num_samples;
+
+    if(mapper == NULL || (entry->sample_type & FLUID_SAMPLETYPE_OGG_VORBIS) || FLUID_IS_BIG_ENDIAN)
+    {
+        return 0;
+    }
+
+    if(((entry->sample_end + 1) <= entry->sample_start)
+            || (entry->sample_start * sizeof(short) > sf->samplesize)
+            || (entry->sample_end * sizeof(short) > sf->samplesize))
+    {
+        return 0;
+    }
+
+    num_samples = (entry->sample_end + 1) - entry->sample_start;
+
+    data = mapper->map(mapper->data, sf->fname,
+                       sf->samplepos + (entry->sample_start * sizeof(short)), num_samples * sizeof(short));
+
+    if(data == NULL)
+    {
+        return 0;
+    }
+
+    if(((size_t)data) % sizeof(short) != 0)
+    {
+        mapper->unmap(mapper->data, sf->fname, data, num_samples * sizeof(short));
+        return 0;
+    }
+
+    /* As when reading, the samples are played without the 24-bit data if it can't be used */
+    if(sf->sample24pos && (entry->sample_start <= sf->sample24size) && (entry->sample_end <= sf->sample24size))
+    {
+        data24 = mapper->map(mapper->data, sf->fname, sf->sample24pos + entry->sample_start, num_samples);
+    }
+
+    /* The mapping is read-only, the sample data is never written to */
+    entry->sample_data = (short *)data;
+    entry->sample_data24 = (char *)data24;
+    entry->mapper = mapper;
+
+    return num_samples;
+}
+
 static fluid_samplecache_entry_t *get_samplecache_entry(SFData *sf,
         unsigned int sample_start,
         unsigned int sample_end,
@@ -300,14 +411,14 @@ int fluid_samplecache_count_entries(void)
     fluid_list_t *entry;
     int count = 0;
 
-    fluid_mutex_lock(samplecache_mutex);
+    lock_samplecache();
 
     for(entry = samplecache_list; entry != NULL; entry = fluid_list_next(entry))
     {
         count++;
     }
 
-    fluid_mutex_unlock(samplecache_mutex);
+    unlock_samplecache();
 
     return count;
 }
@@ -31,6 +31,41 @@ int fluid_samplecache_load(SFData *sf,
 
 int fluid_samplecache_unload(const short *sample_data);
 
+/* MuseScore: maps the sample data of uncompressed SoundFonts from the file instead of reading
+ * it into heap buffers. map returns a pointer to size bytes at offset of the file, or NULL to
+ * read the data as usual; every successful map is paired with an unmap of the same range. */
+typedef struct _fluid_samplecache_mapper_t
+{
+    void *data;
+    const void *(*map)(void *data, const char *filename, fluid_long_long_t offset, fluid_long_long_t size);
+    void (*unmap)(void *data, const char *filename, const void *ptr, fluid_long_long_t size);
+} fluid_samplecache_mapper_t;
+
+/* MuseScore: fluid is built without threads, so its mutex doesn't guard the cache. The cache is shared by
+ * all the instances of the process, the lock serializes the loads and unloads of those running on different threads */
+typedef struct _fluid_samplecache_lock_t
+{
+    void *data;
+    void (*lock)(void *data);
+    void (*unlock)(void *data);
+} fluid_samplecache_lock_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A mapper must stay valid until all the sample data mapped by it is unloaded, even after it's replaced.
+ * NULL disables the mapping */
+void fluid_samplecache_set_mapper(const fluid_samplecache_mapper_t *mapper);
+
+/* Must be set before the cache is used from more than one thread and stay valid afterwards.
+ * NULL leaves the cache unguarded */
+void fluid_samplecache_set_lock(const fluid_samplecache_lock_t *lock);
+
+#ifdef __cplusplus
+}
+#endif
+
 /* Only used for tests */
 int fluid_samplecache_count_entries(void);
 
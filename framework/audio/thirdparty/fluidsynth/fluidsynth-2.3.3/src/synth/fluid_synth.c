@@ -5106,6 +5106,73 @@ fluid_synth_free_voice_by_kill_LOCAL(fluid_synth_t *synth)
 }
 
 
+/* MuseScore: kills the voices with the lowest overflow priority (released, quiet, old ones first)
+ * until at most max_voices are playing. Used to share one voice budget between several synths.
+ * A killed voice stops on the next render, so the voices are picked in the order of (priority, index)
+ * instead of asking for the weakest one again. Returns the number of killed voices. */
+int
+fluid_synth_steal_voices(fluid_synth_t *synth, int max_voices)
+{
+    int i;
+    int stolen = 0;
+    int to_steal;
+    float best_prio;
+    float this_voice_prio;
+    int best_voice_index;
+    float last_prio = -OVERFLOW_PRIO_CANNOT_KILL;
+    int last_voice_index = -1;
+    fluid_voice_t *voice;
+    unsigned int ticks;
+
+    fluid_return_val_if_fail(synth != NULL, 0);
+    fluid_synth_api_enter(synth);
+
+    ticks = fluid_synth_get_ticks(synth);
+    to_steal = synth->active_voice_count - max_voices;
+
+    while(stolen < to_steal)
+    {
+        best_prio = OVERFLOW_PRIO_CANNOT_KILL - 1;
+        best_voice_index = -1;
+
+        for(i = 0; i < synth->polyphony; i++)
+        {
+            voice = synth->voice[i];
+
+            if(!fluid_voice_is_playing(voice))
+            {
+                continue;
+            }
+
+            this_voice_prio = fluid_voice_get_overflow_prio(voice, &synth->overflow, ticks);
+
+            /* skip the voices killed in the previous passes */
+            if(this_voice_prio < last_prio || (this_voice_prio == last_prio && i <= last_voice_index))
+            {
+                continue;
+            }
+
+            if(this_voice_prio < best_prio || (this_voice_prio == best_prio && i < best_voice_index))
+            {
+                best_voice_index = i;
+                best_prio = this_voice_prio;
+            }
+        }
+
+        if(best_voice_index < 0)
+        {
+            break;
+        }
+
+        fluid_voice_off(synth->voice[best_voice_index]);
+        last_prio = best_prio;
+        last_voice_index = best_voice_index;
+        stolen++;
+    }
+
+    FLUID_API_RETURN(stolen);
+}
+
 /**
  * Allocate a synthesis voice.
  * @param synth FluidSynth instance
@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_GLOBAL_SPSCQUEUE_H
+#define MUSE_GLOBAL_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace muse {
+//! NOTE Bounded lock-free ring for one producer thread and one consumer thread.
+//! The storage is allocated once in the constructor; push() and pop() neither lock nor allocate,
+//! so the queue can pass small messages to a real-time thread
+template<typename T>
+class SpscQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SpscQueue messages must be trivially copyable");
+
+public:
+    //! NOTE The capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        m_mask = size - 1;
+        m_data = std::make_unique<T[]>(size);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    //! NOTE Producer thread: the number of messages which can be pushed right now
+    size_t freeSpace() const
+    {
+        const size_t write = m_writeIndex.load(std::memory_order_relaxed);
+        const size_t read = m_readIndex.load(std::memory_order_acquire);
+
+        return capacity() - (write - read);
+    }
+
+    //! NOTE Producer thread. Returns false if the queue is full
+    bool push(const T& value)
+    {
+        const size_t write = m_writeIndex.load(std::memory_order_relaxed);
+        const size_t read = m_readIndex.load(std::memory_order_acquire);
+
+        if (write - read == capacity()) {
+            return false;
+        }
+
+        m_data[write & m_mask] = value;
+        m_writeIndex.store(write + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    //! NOTE Consumer thread. Returns false if the queue is empty
+    bool pop(T& value)
+    {
+        const size_t read = m_readIndex.load(std::memory_order_relaxed);
+        const size_t write = m_writeIndex.load(std::memory_order_acquire);
+
+        if (read == write) {
+            return false;
+        }
+
+        value = m_data[read & m_mask];
+        m_readIndex.store(read + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool empty() const
+    {
+        return m_readIndex.load(std::memory_order_acquire) == m_writeIndex.load(std::memory_order_acquire);
+    }
+
+private:
+    size_t m_mask = 0;
+    std::unique_ptr<T[]> m_data;
+
+    // the indices grow monotonically, the slot is index & m_mask
+    alignas(64) std::atomic<size_t> m_writeIndex = 0;
+    alignas(64) std::atomic<size_t> m_readIndex = 0;
+};
+}
+
+#endif // MUSE_GLOBAL_SPSCQUEUE_H
@@ -0,0 +1,365 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_GLOBAL_WORKSTEALINGSCHEDULER_H
+#define MUSE_GLOBAL_WORKSTEALINGSCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+#include "taskscheduler.h"
+#include "threadutils.h"
+#include "log.h"
+
+namespace muse {
+//! NOTE Fork/join executor for real-time work (e.g. rendering of the mixer channels)
+//!
+//! parallelFor() distributes the indices of the tasks over per-thread deques,
+//! the calling thread takes part in the work, idle threads steal from the others.
+//! Neither parallelFor() nor the workers allocate or take locks,
+//! except for waking up the workers which have been parked after a long idle period
+class WorkStealingScheduler
+{
+public:
+    //! NOTE The indices of a larger parallelFor() are forked in several rounds
+    static constexpr size_t MAX_TASKS_PER_FORK = 0xFFFF;
+
+    explicit WorkStealingScheduler(const thread_pool_size_t desiredThreadCount = 0)
+    {
+        setupThreads(validateThreadPoolCapacity(desiredThreadCount));
+    }
+
+    ~WorkStealingScheduler()
+    {
+        terminateThreads();
+    }
+
+    thread_pool_size_t threadPoolSize() const
+    {
+        return m_threadPoolSize;
+    }
+
+    std::set<std::thread::id> threadIdSet() const
+    {
+        std::set<std::thread::id> result;
+
+        for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+            result.insert(m_threadPool[i].get_id());
+        }
+
+        return result;
+    }
+
+    //! NOTE The workers which have been idle for long enough to sleep until the next fork
+    thread_pool_size_t parkedThreadCount() const
+    {
+        return static_cast<thread_pool_size_t>(m_parkedWorkers.load(std::memory_order_acquire));
+    }
+
+    bool setThreadsPriority(ThreadPriority priority)
+    {
+        for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+            if (!muse::setThreadPriority(m_threadPool[i], priority)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //! Calls func(index) for every index in [0, taskCount) and returns when all the calls are done
+    template<typename FuncT>
+    void parallelFor(size_t taskCount, FuncT& func)
+    {
+        if (taskCount == 0) {
+            return;
+        }
+
+        if (m_threadPoolSize == 0 || taskCount == 1) {
+            for (size_t i = 0; i < taskCount; ++i) {
+                func(i);
+            }
+            return;
+        }
+
+        for (size_t offset = 0; offset < taskCount; offset += MAX_TASKS_PER_FORK) {
+            size_t count = std::min(taskCount - offset, MAX_TASKS_PER_FORK);
+            Job job { &func, offset, &invokeTask<FuncT> };
+            fork(job, count);
+        }
+    }
+
+private:
+    static constexpr int SPIN_ITERATIONS_BEFORE_PARK = 1 << 14;
+    static constexpr int SPIN_ITERATIONS_BEFORE_YIELD = 1 << 10;
+
+    struct Job {
+        void* func = nullptr;
+        size_t offset = 0;
+        void (* invoke)(void* func, size_t index) = nullptr;
+    };
+
+    //! NOTE A deque of task indices: [begin, end) tagged with the epoch they belong to,
+    //! packed in one word, so that the owner (front) and the thieves (back) can use plain CAS
+    struct alignas(64) TaskDeque {
+        std::atomic<uint64_t> range = 0;
+    };
+
+    static uint64_t packRange(uint32_t epoch, uint64_t begin, uint64_t end)
+    {
+        return (static_cast<uint64_t>(epoch) << 32) | (begin << 16) | end;
+    }
+
+    static void unpackRange(uint64_t range, uint32_t& epoch, uint64_t& begin, uint64_t& end)
+    {
+        epoch = static_cast<uint32_t>(range >> 32);
+        begin = (range >> 16) & 0xFFFF;
+        end = range & 0xFFFF;
+    }
+
+    template<typename FuncT>
+    static void invokeTask(void* func, size_t index)
+    {
+        (*static_cast<FuncT*>(func))(index);
+    }
+
+    static void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile ("yield");
+#endif
+    }
+
+    thread_pool_size_t validateThreadPoolCapacity(const thread_pool_size_t desiredThreadCount) const
+    {
+        thread_pool_size_t maxCapacity = std::thread::hardware_concurrency();
+
+        if (maxCapacity <= 1) {
+            return 1;
+        }
+
+        //! NOTE The calling thread takes part in the work as well
+        if (desiredThreadCount <= 0) {
+            return maxCapacity / 2;
+        }
+
+        return desiredThreadCount;
+    }
+
+    void setupThreads(thread_pool_size_t threadCount)
+    {
+        m_threadPoolSize = threadCount;
+        m_threadPool = std::make_unique<std::thread[]>(threadCount);
+        m_deques = std::make_unique<TaskDeque[]>(threadCount + 1);
+
+        m_isActive = true;
+        for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+            m_threadPool[i] = std::thread(&WorkStealingScheduler::th_workerLoop, this, i + 1);
+        }
+
+        LOGD() << "Thread pool size: " << m_threadPoolSize;
+    }
+
+    void terminateThreads()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_parkMutex);
+            m_isActive = false;
+        }
+        m_wakeUpCv.notify_all();
+
+        for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+            m_threadPool[i].join();
+        }
+    }
+
+    void fork(const Job& job, size_t taskCount)
+    {
+        const uint32_t epoch = m_epoch.load(std::memory_order_relaxed) + 1;
+        const size_t dequeCount = m_threadPoolSize + 1;
+
+        m_job = job;
+        m_pendingTasks.store(taskCount, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < dequeCount; ++i) {
+            uint64_t begin = taskCount * i / dequeCount;
+            uint64_t end = taskCount * (i + 1) / dequeCount;
+            m_deques[i].range.store(packRange(epoch, begin, end), std::memory_order_relaxed);
+        }
+
+        m_epoch.store(epoch, std::memory_order_seq_cst);
+
+        if (m_parkedWorkers.load(std::memory_order_seq_cst) > 0) {
+            {
+                std::lock_guard<std::mutex> lock(m_parkMutex);
+            }
+            m_wakeUpCv.notify_all();
+        }
+
+        runTasks(0, epoch);
+
+        int spinCount = 0;
+        while (m_pendingTasks.load(std::memory_order_acquire) > 0) {
+            if (++spinCount < SPIN_ITERATIONS_BEFORE_YIELD) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void runTasks(size_t ownDeque, uint32_t epoch)
+    {
+        const size_t dequeCount = m_threadPoolSize + 1;
+        size_t index = 0;
+
+        for (;;) {
+            bool found = popFront(ownDeque, epoch, index);
+
+            for (size_t i = 1; !found && i < dequeCount; ++i) {
+                found = stealBack((ownDeque + i) % dequeCount, epoch, index);
+            }
+
+            if (!found) {
+                //! NOTE No new tasks appear during a fork, so there is nothing left to do
+                return;
+            }
+
+            m_job.invoke(m_job.func, m_job.offset + index);
+            m_pendingTasks.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    bool popFront(size_t dequeIdx, uint32_t epoch, size_t& index)
+    {
+        std::atomic<uint64_t>& range = m_deques[dequeIdx].range;
+        uint64_t current = range.load(std::memory_order_acquire);
+
+        for (;;) {
+            uint32_t rangeEpoch = 0;
+            uint64_t begin = 0;
+            uint64_t end = 0;
+            unpackRange(current, rangeEpoch, begin, end);
+
+            if (rangeEpoch != epoch || begin >= end) {
+                return false;
+            }
+
+            if (range.compare_exchange_weak(current, packRange(epoch, begin + 1, end), std::memory_order_acq_rel)) {
+                index = begin;
+                return true;
+            }
+        }
+    }
+
+    bool stealBack(size_t dequeIdx, uint32_t epoch, size_t& index)
+    {
+        std::atomic<uint64_t>& range = m_deques[dequeIdx].range;
+        uint64_t current = range.load(std::memory_order_acquire);
+
+        for (;;) {
+            uint32_t rangeEpoch = 0;
+            uint64_t begin = 0;
+            uint64_t end = 0;
+            unpackRange(current, rangeEpoch, begin, end);
+
+            if (rangeEpoch != epoch || begin >= end) {
+                return false;
+            }
+
+            if (range.compare_exchange_weak(current, packRange(epoch, begin, end - 1), std::memory_order_acq_rel)) {
+                index = end - 1;
+                return true;
+            }
+        }
+    }
+
+    void th_workerLoop(size_t ownDeque)
+    {
+        uint32_t lastEpoch = 0;
+
+        while (m_isActive) {
+            uint32_t epoch = waitForNewEpoch(lastEpoch);
+            if (!m_isActive) {
+                return;
+            }
+
+            lastEpoch = epoch;
+            runTasks(ownDeque, epoch);
+        }
+    }
+
+    uint32_t waitForNewEpoch(uint32_t lastEpoch)
+    {
+        for (int i = 0; i < SPIN_ITERATIONS_BEFORE_PARK; ++i) {
+            uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+            if (epoch != lastEpoch || !m_isActive) {
+                return epoch;
+            }
+
+            if (i < SPIN_ITERATIONS_BEFORE_YIELD) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(m_parkMutex);
+        m_parkedWorkers.fetch_add(1, std::memory_order_seq_cst);
+        m_wakeUpCv.wait(lock, [this, lastEpoch] {
+            return m_epoch.load(std::memory_order_seq_cst) != lastEpoch || !m_isActive;
+        });
+        m_parkedWorkers.fetch_sub(1, std::memory_order_relaxed);
+
+        return m_epoch.load(std::memory_order_acquire);
+    }
+
+    std::atomic<bool> m_isActive = false;
+
+    alignas(64) std::atomic<uint32_t> m_epoch = 0;
+    alignas(64) std::atomic<size_t> m_pendingTasks = 0;
+    alignas(64) std::atomic<int> m_parkedWorkers = 0;
+
+    Job m_job;
+    std::unique_ptr<TaskDeque[]> m_deques = nullptr;
+
+    std::mutex m_parkMutex;
+    std::condition_variable m_wakeUpCv;
+
+    thread_pool_size_t m_threadPoolSize = 0;
+    std::unique_ptr<std::thread[]> m_threadPool = nullptr;
+};
+}
+
+#endif // MUSE_GLOBAL_WORKSTEALINGSCHEDULER_H
@@ -72,6 +72,32 @@ public:
         return true;
     }
 
+    //! NOTE Returns when the time has elapsed or the event is signaled, whichever comes first
+    bool setAndWait(unsigned relativeTime100Ns, HANDLE event)
+    {
+        if (!event) {
+            return setAndWait(relativeTime100Ns);
+        }
+
+        LARGE_INTEGER dueTime = { 0 };
+        dueTime.QuadPart = static_cast<LONGLONG>(relativeTime100Ns) * -1;
+
+        BOOL res = ::SetWaitableTimerEx(m_timer, &dueTime, 0, NULL, NULL, NULL, FALSE);
+        if (!res) {
+            LOGD() << "SetWaitableTimerEx failed: " << std::to_string(::GetLastError());
+            return false;
+        }
+
+        const HANDLE handles[] = { m_timer, event };
+        DWORD waitRes = ::WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+        if (waitRes == WAIT_FAILED) {
+            LOGD() << "WaitForMultipleObjects failed: " << std::to_string(::GetLastError());
+            return false;
+        }
+
+        return true;
+    }
+
 private:
     HANDLE m_timer = NULL;
 };
@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "concurrency/spscqueue.h"
+
+using namespace muse;
+
+class Global_Concurrency_SpscQueueTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Concurrency_SpscQueueTests, PushPop)
+{
+    // [GIVEN]
+    SpscQueue<int> queue(3);
+
+    // [THEN] The capacity is rounded up to a power of two
+    EXPECT_EQ(queue.capacity(), 4);
+    EXPECT_TRUE(queue.empty());
+
+    // [WHEN] The queue is filled
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+
+    // [THEN] It rejects the next message
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_EQ(queue.freeSpace(), 0);
+
+    // [THEN] The messages come out in order
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.freeSpace(), 4);
+}
+
+TEST_F(Global_Concurrency_SpscQueueTests, WrapAround)
+{
+    // [GIVEN]
+    SpscQueue<int> queue(4);
+
+    // [WHEN] Many more messages than the capacity pass through the queue
+    int value = -1;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.push(i));
+        ASSERT_TRUE(queue.push(i + 1000));
+
+        // [THEN]
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i + 1000);
+    }
+}
+
+TEST_F(Global_Concurrency_SpscQueueTests, ProducerAndConsumerThreads)
+{
+    // [GIVEN] A queue much smaller than the number of messages
+    SpscQueue<uint64_t> queue(16);
+    constexpr uint64_t MESSAGES_COUNT = 200000;
+
+    // [WHEN] One thread produces, another one consumes
+    std::thread producer([&queue]() {
+        for (uint64_t i = 0; i < MESSAGES_COUNT;) {
+            if (queue.push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    bool ordered = true;
+
+    while (expected < MESSAGES_COUNT) {
+        if (queue.pop(value)) {
+            ordered = ordered && value == expected;
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    // [THEN] Nothing is lost, duplicated or reordered
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "concurrency/workstealingscheduler.h"
+
+using namespace muse;
+
+static constexpr thread_pool_size_t WORK_STEALING_TEST_THREADS = 3;
+
+class Global_Concurrency_WorkStealingSchedulerTests : public ::testing::Test
+{
+public:
+    //! NOTE Runs parallelFor() and returns how many times each index was called
+    static std::vector<int> runParallelFor(WorkStealingScheduler& scheduler, size_t taskCount)
+    {
+        std::vector<std::atomic<int> > calls(taskCount);
+        auto func = [&calls](size_t index) {
+            calls[index].fetch_add(1, std::memory_order_relaxed);
+        };
+
+        scheduler.parallelFor(taskCount, func);
+
+        std::vector<int> result(taskCount);
+        for (size_t i = 0; i < taskCount; ++i) {
+            result[i] = calls[i].load(std::memory_order_relaxed);
+        }
+
+        return result;
+    }
+
+    static bool waitUntilWorkersParked(const WorkStealingScheduler& scheduler)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+        while (scheduler.parkedThreadCount() < scheduler.threadPoolSize()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return true;
+    }
+};
+
+TEST_F(Global_Concurrency_WorkStealingSchedulerTests, EveryIndexRunsOnce)
+{
+    // [GIVEN]
+    WorkStealingScheduler scheduler(WORK_STEALING_TEST_THREADS);
+
+    for (size_t taskCount : { size_t(0), size_t(1), size_t(2), size_t(3), size_t(4), size_t(7), size_t(100), size_t(1000) }) {
+        // [WHEN]
+        const std::vector<int> calls = runParallelFor(scheduler, taskCount);
+
+        // [THEN] Every index was called exactly once
+        for (size_t i = 0; i < taskCount; ++i) {
+            ASSERT_EQ(calls[i], 1) << "task count: " << taskCount << ", index: " << i;
+        }
+    }
+}
+
+TEST_F(Global_Concurrency_WorkStealingSchedulerTests, MoreTasksThanOneFork)
+{
+    // [GIVEN] More tasks than fit in one fork
+    WorkStealingScheduler scheduler(WORK_STEALING_TEST_THREADS);
+    const size_t taskCount = WorkStealingScheduler::MAX_TASKS_PER_FORK * 2 + 5;
+
+    // [WHEN]
+    const std::vector<int> calls = runParallelFor(scheduler, taskCount);
+
+    // [THEN] The indices of every round were called exactly once
+    for (size_t i = 0; i < taskCount; ++i) {
+        ASSERT_EQ(calls[i], 1) << "index: " << i;
+    }
+}
+
+TEST_F(Global_Concurrency_WorkStealingSchedulerTests, BackToBackForks)
+{
+    // [GIVEN]
+    WorkStealingScheduler scheduler(WORK_STEALING_TEST_THREADS);
+
+    // [WHEN] Many forks follow each other without a pause, so the workers are still spinning on the previous epoch
+    for (size_t round = 0; round < 5000; ++round) {
+        const size_t taskCount = 1 + round % 37;
+        const std::vector<int> calls = runParallelFor(scheduler, taskCount);
+
+        // [THEN] No task is lost or run in the wrong epoch
+        for (size_t i = 0; i < taskCount; ++i) {
+            ASSERT_EQ(calls[i], 1) << "round: " << round << ", index: " << i;
+        }
+    }
+}
+
+TEST_F(Global_Concurrency_WorkStealingSchedulerTests, ParkedWorkersWakeUp)
+{
+    // [GIVEN] The workers have been idle long enough to park
+    WorkStealingScheduler scheduler(WORK_STEALING_TEST_THREADS);
+    ASSERT_TRUE(waitUntilWorkersParked(scheduler));
+
+    const std::set<std::thread::id> workerIds = scheduler.threadIdSet();
+    constexpr size_t TASK_COUNT = 64;
+
+    std::vector<std::atomic<int> > calls(TASK_COUNT);
+    std::atomic<int> callsOnWorkers = 0;
+
+    auto func = [&](size_t index) {
+        calls[index].fetch_add(1, std::memory_order_relaxed);
+
+        if (workerIds.count(std::this_thread::get_id()) > 0) {
+            callsOnWorkers.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //! NOTE Long enough for the woken workers to get a share of the tasks
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+
+    // [WHEN]
+    scheduler.parallelFor(TASK_COUNT, func);
+
+    // [THEN] Every index was called exactly once, and not only by the calling thread
+    for (size_t i = 0; i < TASK_COUNT; ++i) {
+        EXPECT_EQ(calls[i].load(), 1) << "index: " << i;
+    }
+
+    EXPECT_GT(callsOnWorkers.load(), 0);
+
+    // [WHEN] The workers park again
+    ASSERT_TRUE(waitUntilWorkersParked(scheduler));
+
+    // [THEN] They wake up for the next fork as well
+    const std::vector<int> nextCalls = runParallelFor(scheduler, TASK_COUNT);
+    for (size_t i = 0; i < TASK_COUNT; ++i) {
+        EXPECT_EQ(nextCalls[i], 1) << "index: " << i;
+    }
+}
+
+TEST_F(Global_Concurrency_WorkStealingSchedulerTests, DestroyWhileWorkersParked)
+{
+    // [GIVEN] A scheduler which has done some work, and whose workers are parked
+    auto scheduler = std::make_unique<WorkStealingScheduler>(WORK_STEALING_TEST_THREADS);
+    runParallelFor(*scheduler, 100);
+    ASSERT_TRUE(waitUntilWorkersParked(*scheduler));
+
+    // [WHEN] It is destroyed
+    scheduler.reset();
+
+    // [THEN] The workers were woken up and joined, instead of blocking the destructor
+    EXPECT_EQ(scheduler, nullptr);
+}
@@ -46,6 +46,9 @@ public:
     virtual MidiDeviceID deviceID() const = 0;
     virtual async::Notification deviceChanged() const = 0;
 
+    //! NOTE The timestamp is in the units of the platform clock, truncated to 32 bits:
+    //! the microseconds of the monotonic clock on Linux wrap around every ~71.6 minutes.
+    //! Compare the timestamps with inputTimestampDelta() only
     virtual async::Channel<tick_t, Event> eventReceived() const = 0;
 };
 }
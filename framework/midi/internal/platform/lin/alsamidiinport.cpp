@@ -21,6 +21,16 @@
  */
 #include "alsamidiinport.h"
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
+
 #include <alsa/asoundlib.h>
 #include <alsa/seq.h>
 #include <alsa/seq_midi_event.h>
@@ -34,11 +44,74 @@ struct muse::midi::AlsaMidiInPort::Alsa {
     snd_seq_t* midiIn = nullptr;
     int client = -1;
     int port = -1;
+
+    //! NOTE Wakes the input thread from poll() to stop it
+    int wakePipe[2] = { -1, -1 };
+
+    //! NOTE The bytes of the system exclusive message which are not sent yet
+    bool isSysExStarted = false;
+    bool isSysExPacketSent = false;
+    std::array<uint8_t, 6> sysExBytes = {};
+    size_t sysExBytesCount = 0;
 };
 
 using namespace muse;
 using namespace muse::midi;
 
+//! NOTE The microseconds wrap around every ~71.6 minutes, see IMidiInPort::eventReceived()
+static tick_t alsaMonotonicTimestamp()
+{
+    using namespace std::chrono;
+
+    return static_cast<tick_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+//! NOTE Returns 0 if the event is not a channel voice message
+static uint32_t alsaEventToMidi10Package(const snd_seq_event_t* ev)
+{
+    switch (ev->type) {
+    case SND_SEQ_EVENT_NOTEOFF:
+        return 0x80
+               | (ev->data.note.channel & 0x0F)
+               | ((ev->data.note.note & 0x7F) << 8)
+               | ((ev->data.note.velocity & 0x7F) << 16);
+    case SND_SEQ_EVENT_NOTEON:
+        return 0x90
+               | (ev->data.note.channel & 0x0F)
+               | ((ev->data.note.note & 0x7F) << 8)
+               | ((ev->data.note.velocity & 0x7F) << 16);
+    case SND_SEQ_EVENT_KEYPRESS:
+        return 0xA0
+               | (ev->data.note.channel & 0x0F)
+               | ((ev->data.note.note & 0x7F) << 8)
+               | ((ev->data.note.velocity & 0x7F) << 16);
+    case SND_SEQ_EVENT_CONTROLLER:
+        return 0xB0
+               | (ev->data.control.channel & 0x0F)
+               | ((ev->data.control.param & 0x7F) << 8)
+               | ((ev->data.control.value & 0x7F) << 16);
+    case SND_SEQ_EVENT_PGMCHANGE:
+        return 0xC0
+               | (ev->data.control.channel & 0x0F)
+               | ((ev->data.control.value & 0x7F) << 8);
+    case SND_SEQ_EVENT_CHANPRESS:
+        return 0xD0
+               | (ev->data.control.channel & 0x0F)
+               | ((ev->data.control.value & 0x7F) << 8);
+    case SND_SEQ_EVENT_PITCHBEND: {
+        uint32_t value = ev->data.control.value + 8192;
+        return 0xE0
+               | (ev->data.control.channel & 0x0F)
+               | ((value & 0x7F) << 8)
+               | (((value >> 7) & 0x7F) << 16);
+    }
+    default:
+        break;
+    }
+
+    return 0;
+}
+
 void AlsaMidiInPort::init()
 {
     m_alsa = std::make_shared<Alsa>();
@@ -198,11 +271,12 @@ void AlsaMidiInPort::disconnect()
         return;
     }
 
-    snd_seq_disconnect_to(m_alsa->midiIn, 0, m_alsa->client, m_alsa->port);
-    snd_seq_close(m_alsa->midiIn);
-
+    //! NOTE The input thread uses the sequencer until it is stopped
     stop();
 
+    snd_seq_disconnect_from(m_alsa->midiIn, 0, m_alsa->client, m_alsa->port);
+    snd_seq_close(m_alsa->midiIn);
+
     LOGD() << "Disconnected from " << m_deviceID;
 
     m_alsa->client = -1;
@@ -242,6 +316,12 @@ Ret AlsaMidiInPort::run()
         return Ret(true);
     }
 
+    if (pipe(m_alsa->wakePipe) < 0) {
+        return make_ret(Err::MidiFailedConnect, "failed create pipe, err: " + std::string(strerror(errno)));
+    }
+
+    m_alsa->isSysExStarted = false;
+
     m_running.store(true);
     m_thread = std::make_shared<std::thread>(process, this);
     return Ret(true);
@@ -255,8 +335,19 @@ void AlsaMidiInPort::stop()
     }
 
     m_running.store(false);
+
+    const char wake = 0;
+    if (write(m_alsa->wakePipe[1], &wake, 1) < 0) {
+        LOGE() << "failed wake the input thread, err: " << strerror(errno);
+    }
+
     m_thread->join();
     m_thread = nullptr;
+
+    close(m_alsa->wakePipe[0]);
+    close(m_alsa->wakePipe[1]);
+    m_alsa->wakePipe[0] = -1;
+    m_alsa->wakePipe[1] = -1;
 }
 
 void AlsaMidiInPort::process(AlsaMidiInPort* self)
@@ -266,86 +357,119 @@ void AlsaMidiInPort::process(AlsaMidiInPort* self)
 
 void AlsaMidiInPort::doProcess()
 {
-    snd_seq_event_t* ev = nullptr;
-    uint32_t data = 0;
-    uint32_t value = 0;
-    Event e;
+    const int alsaFdsCount = snd_seq_poll_descriptors_count(m_alsa->midiIn, POLLIN);
+    std::vector<pollfd> fds(std::max(alsaFdsCount, 0) + 1);
+    snd_seq_poll_descriptors(m_alsa->midiIn, fds.data(), alsaFdsCount, POLLIN);
+
+    pollfd& wakeFd = fds.back();
+    wakeFd.fd = m_alsa->wakePipe[0];
+    wakeFd.events = POLLIN;
+
+    while (m_running.load()) {
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            LOGE() << "poll failed, err: " << strerror(errno);
+            break;
+        }
+
+        if (wakeFd.revents & POLLIN) {
+            break;
+        }
+
+        //! NOTE The sequencer is non-blocking: read all the pending events, until it has no more
+        while (true) {
+            snd_seq_event_t* ev = nullptr;
+            int err = snd_seq_event_input(m_alsa->midiIn, &ev);
+
+            if (err == -ENOSPC) {
+                LOGW() << "input buffer overrun, some events are lost";
+                continue;
+            }
+
+            if (err < 0 || !ev) {
+                if (err != -EAGAIN) {
+                    LOGE() << "failed read event, err: " << snd_strerror(err);
+                }
+                break;
+            }
+
+            const tick_t timestamp = alsaMonotonicTimestamp();
+
+            if (ev->type == SND_SEQ_EVENT_SYSEX) {
+                processSysEx(static_cast<const uint8_t*>(ev->data.ext.ptr), ev->data.ext.len, timestamp);
+                continue;
+            }
 
-    while (m_running.load() && isConnected()) {
-        snd_seq_event_input(m_alsa->midiIn, &ev);
+            uint32_t data = alsaEventToMidi10Package(ev);
+            if (data == 0) {
+                NOT_SUPPORTED << "event type: " << ev->type;
+                continue;
+            }
 
-        auto sleep = []() {
-            std::this_thread::sleep_for(std::chrono::milliseconds(2));
-        };
+            Event e = Event::fromMidi10Package(data).toMIDI20();
+            if (e) {
+                m_eventReceived.send(timestamp, e);
+            }
+        }
+    }
+}
 
-        if (!ev) {
-            sleep();
+void AlsaMidiInPort::processSysEx(const uint8_t* data, size_t size, tick_t timestamp)
+{
+    //! NOTE A long message comes in several events, only the first one starts with 0xF0 and only the last one ends with 0xF7
+    for (size_t i = 0; i < size; ++i) {
+        const uint8_t byte = data[i];
+
+        if (byte == 0xF0) {
+            m_alsa->isSysExStarted = true;
+            m_alsa->isSysExPacketSent = false;
+            m_alsa->sysExBytesCount = 0;
             continue;
         }
 
-        switch (ev->type) {
-        case SND_SEQ_EVENT_SYSEX:
-        {
-            NOT_SUPPORTED << "event type: SND_SEQ_EVENT_SYSEX";
+        if (!m_alsa->isSysExStarted) {
             continue;
         }
-        case SND_SEQ_EVENT_NOTEOFF:
-            data = 0x80
-                   | (ev->data.note.channel & 0x0F)
-                   | ((ev->data.note.note & 0x7F) << 8)
-                   | ((ev->data.note.velocity & 0x7F) << 16);
-            break;
-        case SND_SEQ_EVENT_NOTEON:
-            data = 0x90
-                   | (ev->data.note.channel & 0x0F)
-                   | ((ev->data.note.note & 0x7F) << 8)
-                   | ((ev->data.note.velocity & 0x7F) << 16);
-            break;
-        case SND_SEQ_EVENT_KEYPRESS:
-            data = 0xA0
-                   | (ev->data.note.channel & 0x0F)
-                   | ((ev->data.note.note & 0x7F) << 8)
-                   | ((ev->data.note.velocity & 0x7F) << 16);
-            break;
-        case SND_SEQ_EVENT_CONTROLLER:
-            data = 0xB0
-                   | (ev->data.control.channel & 0x0F)
-                   | ((ev->data.control.param & 0x7F) << 8)
-                   | ((ev->data.control.value & 0x7F) << 16);
-            break;
-        case SND_SEQ_EVENT_PGMCHANGE:
-            data = 0xC0
-                   | (ev->data.control.channel & 0x0F)
-                   | ((ev->data.control.value & 0x7F) << 8);
-            break;
-        case SND_SEQ_EVENT_CHANPRESS:
-            data = 0xD0
-                   | (ev->data.control.channel & 0x0F)
-                   | ((ev->data.control.value & 0x7F) << 8);
-            break;
-        case SND_SEQ_EVENT_PITCHBEND:
-            value = ev->data.control.value + 8192;
-            data = 0xE0
-                   | (ev->data.note.channel & 0x0F)
-                   | ((value & 0x7F) << 8)
-                   | (((value >> 7) & 0x7F) << 16);
-            break;
-        default:
-            NOT_SUPPORTED << "event type: " << ev->type;
+
+        if (byte == 0xF7) {
+            sendSysExPacket(true, timestamp);
+            m_alsa->isSysExStarted = false;
             continue;
         }
 
-        e = Event::fromMidi10Package(data);
+        if (byte & 0x80) {
+            LOGW() << "unexpected status byte in a system exclusive message: " << int(byte);
+            m_alsa->isSysExStarted = false;
+            continue;
+        }
 
-        e = e.toMIDI20();
-        if (e) {
-            m_eventReceived.send(static_cast<tick_t>(ev->time.tick), e);
+        //! NOTE A full packet is sent once the next byte shows that it is not the last one
+        if (m_alsa->sysExBytesCount == m_alsa->sysExBytes.size()) {
+            sendSysExPacket(false, timestamp);
         }
 
-        sleep();
+        m_alsa->sysExBytes[m_alsa->sysExBytesCount++] = byte;
     }
 }
 
+void AlsaMidiInPort::sendSysExPacket(bool isLast, tick_t timestamp)
+{
+    Event::SysEx7Status status = Event::SysEx7Status::Continue;
+    if (isLast) {
+        status = m_alsa->isSysExPacketSent ? Event::SysEx7Status::End : Event::SysEx7Status::Complete;
+    } else if (!m_alsa->isSysExPacketSent) {
+        status = Event::SysEx7Status::Start;
+    }
+
+    m_eventReceived.send(timestamp, Event::fromSysEx7Packet(status, m_alsa->sysExBytes.data(), m_alsa->sysExBytesCount));
+
+    m_alsa->isSysExPacketSent = true;
+    m_alsa->sysExBytesCount = 0;
+}
+
 bool AlsaMidiInPort::deviceExists(const MidiDeviceID& deviceId) const
 {
     for (const MidiDevice& device : availableDevices()) {
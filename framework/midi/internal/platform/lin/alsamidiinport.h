@@ -31,6 +31,8 @@
 #include "internal/midideviceslistener.h"
 
 namespace muse::midi {
+//! NOTE The events are received by a thread which sleeps in poll() until the sequencer has input,
+//! and are timestamped in microseconds of a monotonic clock (wraps around every ~71 minutes)
 class AlsaMidiInPort : public IMidiInPort, public async::Asyncable
 {
 public:
@@ -57,6 +59,8 @@ private:
 
     static void process(AlsaMidiInPort* self);
     void doProcess();
+    void processSysEx(const uint8_t* data, size_t size, tick_t timestamp);
+    void sendSysExPacket(bool isLast, tick_t timestamp);
 
     bool deviceExists(const MidiDeviceID& deviceId) const;
 
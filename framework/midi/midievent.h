@@ -22,6 +22,7 @@
 #ifndef MUSE_MIDI_MIDIEVENT_H
 #define MUSE_MIDI_MIDIEVENT_H
 
+#include <algorithm>
 #include <cstdint>
 #include <array>
 #include <set>
@@ -94,6 +95,14 @@ struct Event {
         JRTimestamp = 0x02
     };
 
+    //! 7.7 System Exclusive (7-Bit) Messages
+    enum class SysEx7Status {
+        Complete = 0x0,
+        Start    = 0x1,
+        Continue = 0x2,
+        End      = 0x3
+    };
+
     Event()
         : m_data({ 0, 0, 0, 0 }) {}
     Event(const std::array<uint32_t, 4>& d)
@@ -170,6 +179,44 @@ struct Event {
         return 0;
     }
 
+    //! one packet of a system exclusive message: up to 6 data bytes, without 0xF0 and 0xF7
+    static Event fromSysEx7Packet(SysEx7Status status, const uint8_t* bytes, size_t count)
+    {
+        Event e;
+        assert(count <= 6);
+        count = std::min(count, size_t(6));
+        e.m_data[0] = (static_cast<uint32_t>(status) << 20) | (static_cast<uint32_t>(count) << 16);
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t byteVal = static_cast<uint32_t>(bytes[i] & 0x7F);
+            if (i < 2) {
+                e.m_data[0] |= byteVal << ((1 - i) * 8);
+            } else {
+                e.m_data[1] |= byteVal << ((5 - i) * 8);
+            }
+        }
+        e.setMessageType(MessageType::SystemExclusiveData);
+        return e;
+    }
+
+    SysEx7Status sysEx7Status() const
+    {
+        assertMessageType({ MessageType::SystemExclusiveData });
+        return static_cast<SysEx7Status>((m_data[0] >> 20) & 0b00001111);
+    }
+
+    //! copies the data bytes of the packet, returns their count
+    size_t sysEx7Bytes(uint8_t* bytes) const
+    {
+        assertMessageType({ MessageType::SystemExclusiveData });
+        size_t count = std::min(static_cast<size_t>((m_data[0] >> 16) & 0b00001111), size_t(6));
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t word = i < 2 ? m_data[0] : m_data[1];
+            size_t shift = i < 2 ? (1 - i) * 8 : (5 - i) * 8;
+            bytes[i] = static_cast<uint8_t>((word >> shift) & 0x7F);
+        }
+        return count;
+    }
+
     static Event fromMidi20Words(const uint32_t* data, size_t count)
     {
         Event e;
@@ -43,6 +43,13 @@ using note_idx_t = uint8_t;
 using TempoMap = std::map<tick_t, tempo_t>;
 using Events = std::map<tick_t, std::vector<Event> >;
 
+//! NOTE The timestamps of the input ports wrap around, so the time between two of them
+//! is only meaningful as their difference modulo 2^32
+inline tick_t inputTimestampDelta(tick_t from, tick_t to)
+{
+    return static_cast<tick_t>(to - from);
+}
+
 static constexpr int EXPRESSION_CONTROLLER = 11;
 static constexpr int SUSTAIN_PEDAL_CONTROLLER = 64;
 static constexpr int SOSTENUTO_PEDAL_CONTROLLER = 66;
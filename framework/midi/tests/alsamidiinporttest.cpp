@@ -0,0 +1,235 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <alsa/asoundlib.h>
+
+#include "global/async/asyncable.h"
+#include "global/async/processevents.h"
+
+#include "midi/internal/platform/lin/alsamidiinport.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::midi;
+
+namespace muse::midi {
+static constexpr std::chrono::seconds LOOPBACK_TIMEOUT(5);
+
+class Midi_AlsaMidiInPortTest : public ::testing::Test, public async::Asyncable
+{
+protected:
+    struct ReceivedEvent {
+        tick_t timestamp = 0;
+        Event event;
+    };
+
+    void SetUp() override
+    {
+        //! NOTE The events are sent from a virtual port of another client, as a hardware device would
+        if (snd_seq_open(&m_out, "default", SND_SEQ_OPEN_OUTPUT, 0) < 0) {
+            m_out = nullptr;
+            GTEST_SKIP() << "The ALSA sequencer is not available";
+        }
+
+        snd_seq_set_client_name(m_out, "muse_midi_tests");
+        m_outPort = snd_seq_create_simple_port(m_out, "Loopback", SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ,
+                                               SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_SOFTWARE | SND_SEQ_PORT_TYPE_PORT);
+        ASSERT_GE(m_outPort, 0);
+
+        m_inPort.init();
+
+        MidiDeviceID deviceId;
+        for (const MidiDevice& device : m_inPort.availableDevices()) {
+            std::vector<int> params = splitDeviceId(device.id);
+            if (params.size() == 3 && params[1] == snd_seq_client_id(m_out) && params[2] == m_outPort) {
+                deviceId = device.id;
+            }
+        }
+
+        ASSERT_FALSE(deviceId.empty());
+        ASSERT_TRUE(m_inPort.connect(deviceId));
+
+        m_inPort.eventReceived().onReceive(this, [this](tick_t timestamp, const Event& event) {
+            m_received.push_back({ timestamp, event });
+        });
+    }
+
+    void TearDown() override
+    {
+        if (!m_out) {
+            return;
+        }
+
+        m_inPort.deinit();
+        snd_seq_close(m_out);
+    }
+
+    void send(snd_seq_event_t* ev)
+    {
+        snd_seq_ev_set_source(ev, m_outPort);
+        snd_seq_ev_set_subs(ev);
+        snd_seq_ev_set_direct(ev);
+        snd_seq_event_output(m_out, ev);
+    }
+
+    void sendNoteOn(int note)
+    {
+        snd_seq_event_t ev;
+        snd_seq_ev_clear(&ev);
+        snd_seq_ev_set_noteon(&ev, 0, note, 100);
+        send(&ev);
+    }
+
+    bool waitForEvents(size_t count)
+    {
+        auto deadline = std::chrono::steady_clock::now() + LOOPBACK_TIMEOUT;
+
+        while (m_received.size() < count && std::chrono::steady_clock::now() < deadline) {
+            async::processEvents();
+            std::this_thread::yield();
+        }
+
+        return m_received.size() >= count;
+    }
+
+    static tick_t now()
+    {
+        using namespace std::chrono;
+        return static_cast<tick_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    snd_seq_t* m_out = nullptr;
+    int m_outPort = -1;
+
+    AlsaMidiInPort m_inPort;
+    std::vector<ReceivedEvent> m_received;
+};
+}
+
+TEST_F(Midi_AlsaMidiInPortTest, LoopbackLatency)
+{
+    //! [GIVEN] Single notes, sent one after another
+    constexpr size_t NOTES_COUNT = 200;
+    std::vector<tick_t> latencies;
+
+    for (size_t i = 0; i < NOTES_COUNT; ++i) {
+        //! [WHEN] A note is sent
+        const tick_t sentAt = now();
+        sendNoteOn(60);
+        snd_seq_drain_output(m_out);
+
+        ASSERT_TRUE(waitForEvents(i + 1));
+
+        //! [THEN] It is timestamped with the same monotonic clock, right when it arrived
+        const ReceivedEvent& received = m_received.back();
+        EXPECT_EQ(received.event.opcode(), Event::Opcode::NoteOn);
+        EXPECT_EQ(received.event.note(), 60);
+
+        latencies.push_back(inputTimestampDelta(sentAt, received.timestamp));
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const tick_t median = latencies[latencies.size() / 2];
+
+    //! [THEN] No timestamp is older than the note, even across a wrap of the clock
+    const tick_t timeoutUs = static_cast<tick_t>(std::chrono::microseconds(LOOPBACK_TIMEOUT).count());
+    EXPECT_LE(latencies.back(), timeoutUs);
+
+    //! NOTE The timing depends on the load of the machine, so it is only reported
+    LOGI() << "ALSA MIDI input latency, median: " << median << " us, max: " << latencies.back() << " us";
+}
+
+TEST_F(Midi_AlsaMidiInPortTest, LoopbackThroughput)
+{
+    //! [GIVEN] A fast burst of notes, in batches which fit into the input buffer of the sequencer
+    constexpr size_t NOTES_COUNT = 4000;
+    constexpr size_t BATCH_SIZE = 50;
+
+    //! [WHEN] They are sent
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < NOTES_COUNT; i += BATCH_SIZE) {
+        for (size_t j = 0; j < BATCH_SIZE; ++j) {
+            sendNoteOn(static_cast<int>((i + j) % 128));
+        }
+
+        snd_seq_drain_output(m_out);
+        ASSERT_TRUE(waitForEvents(i + BATCH_SIZE));
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    LOGI() << "ALSA MIDI input throughput: " << NOTES_COUNT * 1000 / std::max<int64_t>(elapsed.count(), 1) << " events/s";
+
+    //! [THEN] All of them are received in order, all the pending events are read on each wake up
+    ASSERT_EQ(m_received.size(), NOTES_COUNT);
+    for (size_t i = 0; i < NOTES_COUNT; ++i) {
+        EXPECT_EQ(m_received[i].event.note(), i % 128);
+    }
+}
+
+TEST_F(Midi_AlsaMidiInPortTest, LoopbackSysEx)
+{
+    //! [GIVEN] A system exclusive message, longer than one packet
+    std::vector<uint8_t> payload;
+    for (uint8_t i = 0; i < 20; ++i) {
+        payload.push_back(i * 5);
+    }
+
+    std::vector<uint8_t> message = { 0xF0 };
+    message.insert(message.end(), payload.begin(), payload.end());
+    message.push_back(0xF7);
+
+    //! [WHEN] It is sent
+    snd_seq_event_t ev;
+    snd_seq_ev_clear(&ev);
+    snd_seq_ev_set_sysex(&ev, message.size(), message.data());
+    send(&ev);
+    snd_seq_drain_output(m_out);
+
+    //! [THEN] It is received as 4 packets: 6 + 6 + 6 + 2 bytes
+    ASSERT_TRUE(waitForEvents(4));
+
+    const std::vector<Event::SysEx7Status> expectedStatuses = {
+        Event::SysEx7Status::Start, Event::SysEx7Status::Continue, Event::SysEx7Status::Continue, Event::SysEx7Status::End
+    };
+
+    std::vector<uint8_t> received;
+    for (size_t i = 0; i < m_received.size(); ++i) {
+        const Event& event = m_received[i].event;
+        ASSERT_EQ(event.messageType(), Event::MessageType::SystemExclusiveData);
+        EXPECT_EQ(event.sysEx7Status(), expectedStatuses.at(i));
+
+        uint8_t bytes[6] = {};
+        size_t count = event.sysEx7Bytes(bytes);
+        received.insert(received.end(), bytes, bytes + count);
+    }
+
+    EXPECT_EQ(received, payload);
+}
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "midi/midievent.h"
+
+using namespace muse;
+using namespace muse::midi;
+
+TEST(Midi_EventTest, SysEx7PacketRoundTrip)
+{
+    //! [GIVEN] The 6 data bytes of a packet
+    const std::vector<uint8_t> bytes = { 0x7E, 0x7F, 0x06, 0x01, 0x12, 0x34 };
+
+    //! [WHEN] They are packed into a system exclusive message
+    Event event = Event::fromSysEx7Packet(Event::SysEx7Status::Start, bytes.data(), bytes.size());
+
+    //! [THEN] It is a valid 64-bit UMP of the message type 0x3
+    EXPECT_TRUE(event);
+    EXPECT_EQ(event.messageType(), Event::MessageType::SystemExclusiveData);
+    EXPECT_EQ(event.midi20WordCount(), 2);
+    EXPECT_EQ(event.midi20Words()[0], 0x30167E7Fu);
+    EXPECT_EQ(event.midi20Words()[1], 0x06011234u);
+
+    //! [THEN] The status and the bytes are read back
+    uint8_t unpacked[6] = {};
+    EXPECT_EQ(event.sysEx7Status(), Event::SysEx7Status::Start);
+    ASSERT_EQ(event.sysEx7Bytes(unpacked), bytes.size());
+    EXPECT_EQ(std::vector<uint8_t>(unpacked, unpacked + 6), bytes);
+}
+
+TEST(Midi_EventTest, SysEx7ShortPacket)
+{
+    //! [WHEN] A message of 3 bytes is packed
+    const uint8_t bytes[] = { 0x41, 0x10, 0x42 };
+    Event event = Event::fromSysEx7Packet(Event::SysEx7Status::Complete, bytes, 3);
+
+    //! [THEN] Only these bytes are set
+    EXPECT_EQ(event.midi20Words()[0], 0x30034110u);
+    EXPECT_EQ(event.midi20Words()[1], 0x42000000u);
+    EXPECT_EQ(event.sysEx7Status(), Event::SysEx7Status::Complete);
+
+    uint8_t unpacked[6] = {};
+    EXPECT_EQ(event.sysEx7Bytes(unpacked), 3);
+    EXPECT_EQ(unpacked[2], 0x42);
+}
@@ -315,6 +315,50 @@ struct PlaybackParam {
     }
 };
 
+//! NOTE Replaces the main stream data within [from; to), the data outside of the range stays the same.
+//! Allows to send a score edit without resending and rebuilding the whole main stream
+struct MainStreamDelta {
+    timestamp_t from = 0;
+    timestamp_t to = 0;
+
+    PlaybackEventsMap events;
+    DynamicLevelLayers dynamics;
+    PlaybackParamLayers params;
+
+    bool contains(const timestamp_t timestamp) const
+    {
+        return timestamp >= from && timestamp < to;
+    }
+};
+
+using MainStreamDeltaChanges = async::Channel<MainStreamDelta>;
+
+template<typename Map>
+inline void replaceRange(Map& destination, const Map& source, const timestamp_t from, const timestamp_t to)
+{
+    destination.erase(destination.lower_bound(from), destination.lower_bound(to));
+    destination.insert(source.lower_bound(from), source.lower_bound(to));
+}
+
+template<typename Layers>
+inline void replaceRangeInLayers(Layers& destination, const Layers& source, const timestamp_t from, const timestamp_t to)
+{
+    for (auto& layer : destination) {
+        auto it = source.find(layer.first);
+        if (it != source.end()) {
+            replaceRange(layer.second, it->second, from, to);
+        } else {
+            layer.second.erase(layer.second.lower_bound(from), layer.second.lower_bound(to));
+        }
+    }
+
+    for (const auto& layer : source) {
+        if (destination.find(layer.first) == destination.end()) {
+            replaceRange(destination[layer.first], layer.second, from, to);
+        }
+    }
+}
+
 struct PlaybackData {
     PlaybackEventsMap originEvents;
     PlaybackSetupData setupData;
@@ -322,6 +366,7 @@ struct PlaybackData {
     PlaybackParamLayers params;
 
     MainStreamChanges mainStream;
+    MainStreamDeltaChanges mainStreamDelta;
     OffStreamChanges offStream;
 
     bool operator==(const PlaybackData& other) const
@@ -336,6 +381,13 @@ struct PlaybackData {
     {
         return setupData.isValid();
     }
+
+    void applyDelta(const MainStreamDelta& delta)
+    {
+        replaceRange(originEvents, delta.events, delta.from, delta.to);
+        replaceRangeInLayers(dynamics, delta.dynamics, delta.from, delta.to);
+        replaceRangeInLayers(params, delta.params, delta.from, delta.to);
+    }
 };
 }
 
@@ -151,18 +151,18 @@ void MuseSamplerSequencer::updateOffStreamEvents(const PlaybackEventsMap& events
             noteOn.msTrack = track;
 
             timestamp_t timestampFrom = arrangementCtx.actualTimestamp;
-            m_offStreamEvents[arrangementCtx.actualTimestamp].emplace(std::move(noteOn));
+            m_offStreamEvents.add(arrangementCtx.actualTimestamp, std::move(noteOn));
 
             AuditionStopNoteEvent noteOff;
             noteOff.msEvent = { noteOn.msEvent._pitch };
             noteOff.msTrack = track;
 
             timestamp_t timestampTo = timestampFrom + arrangementCtx.actualDuration;
-            m_offStreamEvents[timestampTo].emplace(std::move(noteOff));
+            m_offStreamEvents.add(timestampTo, std::move(noteOff));
         }
     }
 
-    updateOffSequenceIterator();
+    updateOffStreamCursor();
 }
 
 void MuseSamplerSequencer::updateMainStreamEvents(const PlaybackEventsMap& events, const DynamicLevelLayers& dynamics,
@@ -94,47 +94,76 @@ async::Channel<unsigned int> MuseSamplerWrapper::audioChannelsCountChanged() con
 
 samples_t MuseSamplerWrapper::process(float* buffer, samples_t samplesPerChannel)
 {
-    if (!m_samplerLib || !m_sampler) {
+    prepareOutputBuffer(samplesPerChannel);
+
+    if (!render(samplesPerChannel)) {
+        return 0;
+    }
+
+    extractOutputSamples(samplesPerChannel, buffer);
+
+    return samplesPerChannel;
+}
+
+bool MuseSamplerWrapper::supportsPlanarProcessing() const
+{
+    return true;
+}
+
+samples_t MuseSamplerWrapper::processPlanar(float* const* buffers, samples_t samplesPerChannel)
+{
+    //! NOTE The sampler overwrites its output bus, so it renders straight into the buffers of the caller
+    m_bus._num_channels = AUDIO_CHANNELS_COUNT;
+    m_bus._num_data_pts = samplesPerChannel;
+
+    m_internalBuffer[0] = buffers[0];
+    m_internalBuffer[1] = buffers[1];
+    m_bus._channels = m_internalBuffer.data();
+
+    if (!render(samplesPerChannel)) {
         return 0;
     }
 
+    return samplesPerChannel;
+}
+
+bool MuseSamplerWrapper::render(const samples_t samples)
+{
+    if (!m_samplerLib || !m_sampler) {
+        return false;
+    }
+
     if (m_allNotesOffRequested) {
         m_samplerLib->allNotesOff(m_sampler);
         m_allNotesOffRequested = false;
     }
 
-    prepareOutputBuffer(samplesPerChannel);
-
     bool active = isActive();
 
     if (!active) {
-        msecs_t nextMicros = samplesToMsecs(samplesPerChannel, m_sampleRate);
-        MuseSamplerSequencer::EventSequenceMap sequences = m_sequencer.movePlaybackForward(nextMicros);
+        msecs_t nextMicros = samplesToMsecs(samples, m_sampleRate);
+        const MuseSamplerSequencer::EventSpan events = m_sequencer.movePlaybackForward(nextMicros);
 
-        for (const auto& pair : sequences) {
-            for (const MuseSamplerSequencer::EventType& event : pair.second) {
-                handleAuditionEvents(event);
-            }
+        for (const MuseSamplerSequencer::TimedEvent& event : events) {
+            handleAuditionEvents(event.event);
         }
     }
 
     if (currentRenderMode() == RenderMode::OfflineMode) {
         if (m_samplerLib->processOffline(m_sampler, m_bus) != ms_Result_OK) {
-            return 0;
+            return false;
         }
     } else {
         if (m_samplerLib->process(m_sampler, m_bus, m_currentPosition) != ms_Result_OK) {
-            return 0;
+            return false;
         }
     }
 
-    extractOutputSamples(samplesPerChannel, buffer);
-
     if (active) {
-        m_currentPosition += samplesPerChannel;
+        m_currentPosition += samples;
     }
 
-    return samplesPerChannel;
+    return true;
 }
 
 std::string MuseSamplerWrapper::name() const
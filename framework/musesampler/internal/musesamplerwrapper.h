@@ -46,6 +46,8 @@ public:
     unsigned int audioChannelsCount() const override;
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     muse::audio::samples_t process(float* buffer, muse::audio::samples_t samplesPerChannel) override;
+    bool supportsPlanarProcessing() const override;
+    muse::audio::samples_t processPlanar(float* const* buffers, muse::audio::samples_t samplesPerChannel) override;
 
     std::string name() const override;
     muse::audio::AudioSourceType type() const override;
@@ -76,6 +78,7 @@ private:
     std::string resolveDefaultPresetCode(const InstrumentInfo& instrument) const;
 
     void prepareOutputBuffer(const muse::audio::samples_t samples);
+    bool render(const muse::audio::samples_t samples);
     void handleAuditionEvents(const MuseSamplerSequencer::EventType& event);
     void setCurrentPosition(const muse::audio::samples_t samples);
     void extractOutputSamples(muse::audio::samples_t samples, float* output);
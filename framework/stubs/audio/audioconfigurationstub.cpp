@@ -115,6 +115,25 @@ size_t AudioConfigurationStub::minTrackCountForMultithreading() const
     return 0;
 }
 
+AudioThreadPoolType AudioConfigurationStub::audioThreadPoolType() const
+{
+    return AudioThreadPoolType::TaskQueue;
+}
+
+bool AudioConfigurationStub::masterLimiterEnabled() const
+{
+    return false;
+}
+
+void AudioConfigurationStub::setMasterLimiterEnabled(bool)
+{
+}
+
+async::Channel<bool> AudioConfigurationStub::masterLimiterEnabledChanged() const
+{
+    return async::Channel<bool>();
+}
+
 // synthesizers
 AudioInputParams AudioConfigurationStub::defaultAudioInputParams() const
 {
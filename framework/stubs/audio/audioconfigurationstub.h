@@ -55,6 +55,11 @@ public:
 
     size_t desiredAudioThreadNumber() const override;
     size_t minTrackCountForMultithreading() const override;
+    AudioThreadPoolType audioThreadPoolType() const override;
+
+    bool masterLimiterEnabled() const override;
+    void setMasterLimiterEnabled(bool enabled) override;
+    async::Channel<bool> masterLimiterEnabledChanged() const override;
 
     // synthesizers
     AudioInputParams defaultAudioInputParams() const override;
@@ -43,6 +43,10 @@ void FxResolverStub::registerResolver(const AudioFxType, IResolverPtr)
 {
 }
 
+void FxResolverStub::clearFx(const TrackId)
+{
+}
+
 void FxResolverStub::clearAllFx()
 {
 }
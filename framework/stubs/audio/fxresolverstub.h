@@ -32,6 +32,7 @@ public:
     std::vector<IFxProcessorPtr> resolveFxList(const TrackId trackId, const AudioFxChain& fxChain) override;
     AudioResourceMetaList resolveAvailableResources() const override;
     void registerResolver(const AudioFxType type, IResolverPtr resolver) override;
+    void clearFx(const TrackId trackId) override;
     void clearAllFx() override;
 };
 }
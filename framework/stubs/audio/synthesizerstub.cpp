@@ -97,6 +97,10 @@ void SynthesizerStub::flushSound()
 {
 }
 
+void SynthesizerStub::setFixedRenderMode(const RenderMode)
+{
+}
+
 bool SynthesizerStub::isValid() const
 {
     return false;
@@ -53,6 +53,8 @@ public:
     void revokePlayingNotes() override;
     void flushSound() override;
 
+    void setFixedRenderMode(const RenderMode mode) override;
+
     bool isValid() const override;
     bool isActive() const override;
     void setIsActive(bool arg) override;
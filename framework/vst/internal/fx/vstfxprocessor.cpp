@@ -43,7 +43,7 @@ void VstFxProcessor::init()
     auto onPluginLoaded = [this, blockSize]() {
         m_pluginPtr->updatePluginConfig(m_params.configuration);
         m_vstAudioClient->setMaxSamplesPerBlock(blockSize);
-        m_inited = true;
+        m_inited.store(true, std::memory_order_release);
     };
 
     if (m_pluginPtr->isLoaded()) {
@@ -100,3 +100,22 @@ void VstFxProcessor::process(float* buffer, unsigned int sampleCount)
 
     m_vstAudioClient->process(buffer, sampleCount);
 }
+
+bool VstFxProcessor::supportsPlanarProcessing() const
+{
+    return true;
+}
+
+void VstFxProcessor::processPlanar(float* const* buffers, unsigned int sampleCount)
+{
+    if (!buffers || !m_inited) {
+        return;
+    }
+
+    m_vstAudioClient->processPlanar(buffers, sampleCount);
+}
+
+bool VstFxProcessor::isReady() const
+{
+    return m_inited.load(std::memory_order_acquire);
+}
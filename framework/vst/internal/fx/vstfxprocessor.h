@@ -22,6 +22,7 @@
 #ifndef MUSE_VST_VSTFXPROCESSOR_H
 #define MUSE_VST_VSTFXPROCESSOR_H
 
+#include <atomic>
 #include <memory>
 
 #include "async/asyncable.h"
@@ -50,9 +51,12 @@ public:
     bool active() const override;
     void setActive(bool active) override;
     void process(float* buffer, unsigned int sampleCount) override;
+    bool supportsPlanarProcessing() const override;
+    void processPlanar(float* const* buffers, unsigned int sampleCount) override;
+    bool isReady() const override;
 
 private:
-    bool m_inited = false;
+    std::atomic<bool> m_inited = false;
 
     IVstPluginInstancePtr m_pluginPtr = nullptr;
     std::unique_ptr<VstAudioClient> m_vstAudioClient = nullptr;
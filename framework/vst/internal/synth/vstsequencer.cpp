@@ -48,6 +48,25 @@ static constexpr int MIN_SUPPORTED_NOTE = 12; // VST equivalent for C0
 static constexpr mpe::pitch_level_t MAX_SUPPORTED_PITCH_LEVEL = mpe::pitchLevel(mpe::PitchClass::C, 8);
 static constexpr int MAX_SUPPORTED_NOTE = 108; // VST equivalent for C8
 
+static bool hasVstSostenutoPedal(const mpe::PlaybackEventsMap& events, const mpe::timestamp_t from, const mpe::timestamp_t to)
+{
+    for (auto it = events.lower_bound(from); it != events.end() && it->first < to; ++it) {
+        for (const mpe::PlaybackEvent& event : it->second) {
+            if (!std::holds_alternative<mpe::NoteEvent>(event)) {
+                continue;
+            }
+
+            for (const auto& articPair : std::get<mpe::NoteEvent>(event).expressionCtx().articulations) {
+                if (muse::contains(SOSTENUTO_PEDAL_CC_SUPPORTED_TYPES, articPair.second.meta.type)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
 void VstSequencer::init(ParamsMapping&& mapping, bool useDynamicEvents)
 {
     m_mapping = std::move(mapping);
@@ -61,7 +80,7 @@ void VstSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& events, c
 {
     flushOffstream();
     updatePlaybackEvents(m_offStreamEvents, events);
-    updateOffSequenceIterator();
+    updateOffStreamCursor();
 }
 
 void VstSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
@@ -72,19 +91,42 @@ void VstSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events,
     }
 
     m_mainStreamEvents.clear();
-    m_dynamicEvents.clear();
 
     if (m_onMainStreamFlushed) {
         m_onMainStreamFlushed();
     }
 
     updatePlaybackEvents(m_mainStreamEvents, events);
-    updateMainSequenceIterator();
 
     if (m_useDynamicEvents) {
-        updateDynamicEvents(m_dynamicEvents, dynamics);
-        updateDynamicChangesIterator();
+        updateDynamicEvents(m_mainStreamEvents, dynamics);
     }
+
+    updateMainStreamCursor();
+}
+
+bool VstSequencer::canUpdateMainStreamRange(const mpe::MainStreamDelta& delta) const
+{
+    //! NOTE The sostenuto pedal events depend on the neighbouring pedals, so they are only built by the full update
+    return m_inited
+           && !hasVstSostenutoPedal(playbackData().originEvents, delta.from, delta.to)
+           && !hasVstSostenutoPedal(delta.events, delta.from, delta.to);
+}
+
+void VstSequencer::updateMainStreamRange(const mpe::MainStreamDelta& delta)
+{
+    if (m_onMainStreamFlushed) {
+        m_onMainStreamFlushed();
+    }
+
+    m_mainStreamEvents.removeOrigins(delta.from, delta.to);
+    updatePlaybackEvents(m_mainStreamEvents, delta.events);
+
+    if (m_useDynamicEvents) {
+        updateDynamicEvents(m_mainStreamEvents, delta.dynamics);
+    }
+
+    updateMainStreamCursor();
 }
 
 muse::audio::gain_t VstSequencer::currentGain() const
@@ -97,11 +139,13 @@ muse::audio::gain_t VstSequencer::currentGain() const
     return 0.5f;
 }
 
-void VstSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& events)
+void VstSequencer::updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& events)
 {
     SostenutoTimeAndDurations sostenutoTimeAndDurations;
 
     for (const auto& evPair : events) {
+        destination.setOrigin(evPair.first);
+
         for (const mpe::PlaybackEvent& event : evPair.second) {
             if (!std::holds_alternative<mpe::NoteEvent>(event)) {
                 continue;
@@ -116,8 +160,8 @@ void VstSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe
             float velocityFraction = noteVelocityFraction(noteEvent);
             float tuning = noteTuning(noteEvent, noteId);
 
-            destination[timestampFrom].emplace(buildEvent(VstEvent::kNoteOnEvent, noteId, velocityFraction, tuning));
-            destination[timestampTo].emplace(buildEvent(VstEvent::kNoteOffEvent, noteId, velocityFraction, tuning));
+            destination.add(timestampFrom, buildEvent(VstEvent::kNoteOnEvent, noteId, velocityFraction, tuning));
+            destination.add(timestampTo, buildEvent(VstEvent::kNoteOffEvent, noteId, velocityFraction, tuning));
 
             for (const auto& articPair : noteEvent.expressionCtx().articulations) {
                 const mpe::ArticulationMeta& meta = articPair.second.meta;
@@ -135,7 +179,7 @@ void VstSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe
 
                 if (muse::contains(SOSTENUTO_PEDAL_CC_SUPPORTED_TYPES, meta.type)) {
                     const mpe::timestamp_t timestamp = timestampFrom + noteEvent.arrangementCtx().actualDuration * 0.1; // add offset for Sostenuto to take effect
-                    sostenutoTimeAndDurations.push_back(mpe::TimestampAndDuration { timestamp, meta.overallDuration });
+                    sostenutoTimeAndDurations.push_back(SostenutoPedal { evPair.first, { timestamp, meta.overallDuration } });
                     continue;
                 }
             }
@@ -145,16 +189,17 @@ void VstSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe
     appendSostenutoEvents(destination, sostenutoTimeAndDurations);
 }
 
-void VstSequencer::updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& layers)
+void VstSequencer::updateDynamicEvents(EventTimeline& destination, const mpe::DynamicLevelLayers& layers)
 {
     for (const auto& layer : layers) {
         for (const auto& dynamic : layer.second) {
-            destination[dynamic.first].emplace(expressionLevel(dynamic.second));
+            destination.setOrigin(dynamic.first);
+            destination.add(dynamic.first, expressionLevel(dynamic.second));
         }
     }
 }
 
-void VstSequencer::appendParamChange(EventSequenceMap& destination, const mpe::timestamp_t timestamp,
+void VstSequencer::appendParamChange(EventTimeline& destination, const mpe::timestamp_t timestamp,
                                      const ControlIdx controlIdx, const PluginParamValue value)
 {
     auto controlIt = m_mapping.find(controlIdx);
@@ -162,10 +207,10 @@ void VstSequencer::appendParamChange(EventSequenceMap& destination, const mpe::t
         return;
     }
 
-    destination[timestamp].emplace(ParamChangeEvent { controlIt->second, value });
+    destination.add(timestamp, ParamChangeEvent { controlIt->second, value });
 }
 
-void VstSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent,
+void VstSequencer::appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent,
                                    const mpe::ArticulationMeta& artMeta)
 {
     auto pitchBendIt = m_mapping.find(PITCH_BEND_IDX);
@@ -179,7 +224,7 @@ void VstSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::Not
     ParamChangeEvent event;
     event.paramId = pitchBendIt->second;
     event.value = 0.5f;
-    destination[pitchBendTimestampTo].insert(event);
+    destination.add(pitchBendTimestampTo, event);
 
     auto currIt = noteEvent.pitchCtx().pitchCurve.cbegin();
     auto nextIt = std::next(currIt);
@@ -212,16 +257,18 @@ void VstSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::Not
             if (time < pitchBendTimestampTo) {
                 float bendValue = static_cast<float>(point.y);
                 event.value = bendValue;
-                destination[time].insert(event);
+                destination.add(time, event);
             }
         }
     }
 }
 
-void VstSequencer::appendSostenutoEvents(EventSequenceMap& destination, const SostenutoTimeAndDurations& sostenutoTimeAndDurations)
+void VstSequencer::appendSostenutoEvents(EventTimeline& destination, const SostenutoTimeAndDurations& sostenutoTimeAndDurations)
 {
     for (size_t i = 0; i < sostenutoTimeAndDurations.size(); ++i) {
-        const mpe::TimestampAndDuration& currentTnD = sostenutoTimeAndDurations.at(i);
+        const mpe::TimestampAndDuration& currentTnD = sostenutoTimeAndDurations.at(i).timeAndDuration;
+        destination.setOrigin(sostenutoTimeAndDurations.at(i).origin);
+
         const mpe::timestamp_t timestampTo = currentTnD.timestamp + currentTnD.duration;
 
         appendParamChange(destination, currentTnD.timestamp, SOSTENUTO_IDX, 1);
@@ -231,7 +278,7 @@ void VstSequencer::appendSostenutoEvents(EventSequenceMap& destination, const So
             continue;
         }
 
-        const mpe::TimestampAndDuration& nextTnD = sostenutoTimeAndDurations.at(i + 1);
+        const mpe::TimestampAndDuration& nextTnD = sostenutoTimeAndDurations.at(i + 1).timeAndDuration;
         if (timestampTo <= nextTnD.timestamp) { // handle potential overlap
             appendParamChange(destination, timestampTo, SOSTENUTO_IDX, 0);
         }
@@ -65,16 +65,23 @@ private:
     void updateOffStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) override;
     void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                 const mpe::PlaybackParamLayers& params) override;
+    bool canUpdateMainStreamRange(const mpe::MainStreamDelta& delta) const override;
+    void updateMainStreamRange(const mpe::MainStreamDelta& delta) override;
 
-    void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& events);
-    void updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& layers);
+    void updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& events);
+    void updateDynamicEvents(EventTimeline& destination, const mpe::DynamicLevelLayers& layers);
 
-    void appendParamChange(EventSequenceMap& destination, const mpe::timestamp_t timestamp, const ControlIdx controlIdx,
+    void appendParamChange(EventTimeline& destination, const mpe::timestamp_t timestamp, const ControlIdx controlIdx,
                            const PluginParamValue value);
-    void appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationMeta& artMeta);
+    void appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationMeta& artMeta);
 
-    using SostenutoTimeAndDurations = std::vector<mpe::TimestampAndDuration>;
-    void appendSostenutoEvents(EventSequenceMap& destination, const SostenutoTimeAndDurations& sostenutoTimeAndDurations);
+    struct SostenutoPedal {
+        mpe::timestamp_t origin = 0;
+        mpe::TimestampAndDuration timeAndDuration;
+    };
+
+    using SostenutoTimeAndDurations = std::vector<SostenutoPedal>;
+    void appendSostenutoEvents(EventTimeline& destination, const SostenutoTimeAndDurations& sostenutoTimeAndDurations);
 
     VstEvent buildEvent(const Steinberg::Vst::Event::EventTypes type, const int32_t noteIdx, const float velocityFraction,
                         const float tuning) const;
@@ -56,6 +56,7 @@ void VstSynthesiser::init()
 
     m_audioChannelsCount = config()->audioChannelsCount();
     m_vstAudioClient->init(AudioPluginType::Instrument, m_pluginPtr, m_audioChannelsCount);
+    m_planarParts.resize(m_audioChannelsCount, nullptr);
 
     const samples_t blockSize = config()->samplesToPreallocate();
 
@@ -64,6 +65,7 @@ void VstSynthesiser::init()
         m_vstAudioClient->setMaxSamplesPerBlock(blockSize);
         m_vstAudioClient->loadSupportedParams();
         m_sequencer.init(m_vstAudioClient->paramsMapping(SUPPORTED_CONTROLLERS), m_useDynamicEvents);
+        m_isReady.store(true, std::memory_order_release);
     };
 
     if (m_pluginPtr->isLoaded()) {
@@ -198,39 +200,78 @@ samples_t VstSynthesiser::process(float* buffer, samples_t samplesPerChannel)
         return 0;
     }
 
+    return processEvents(samplesPerChannel, [this, buffer](samples_t sampleOffset, samples_t samples) {
+        return m_vstAudioClient->process(buffer + sampleOffset * m_audioChannelsCount, samples, m_sequencer.playbackPosition());
+    });
+}
+
+bool VstSynthesiser::supportsPlanarProcessing() const
+{
+    return true;
+}
+
+bool VstSynthesiser::isReady() const
+{
+    return m_isReady.load(std::memory_order_acquire);
+}
+
+samples_t VstSynthesiser::processPlanar(float* const* buffers, samples_t samplesPerChannel)
+{
+    if (!buffers || m_planarParts.size() != m_audioChannelsCount) {
+        return 0;
+    }
+
+    return processEvents(samplesPerChannel, [this, buffers](samples_t sampleOffset, samples_t samples) {
+        for (size_t ch = 0; ch < m_planarParts.size(); ++ch) {
+            m_planarParts[ch] = buffers[ch] + sampleOffset;
+        }
+
+        return m_vstAudioClient->processPlanar(m_planarParts.data(), samples, m_sequencer.playbackPosition());
+    });
+}
+
+template<typename Render>
+samples_t VstSynthesiser::processEvents(const samples_t samplesPerChannel, Render render)
+{
     if (samplesPerChannel > m_vstAudioClient->maxSamplesPerBlock()) {
         m_vstAudioClient->setMaxSamplesPerBlock(samplesPerChannel);
     }
 
     const msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
-    const VstSequencer::EventSequenceMap sequences = m_sequencer.movePlaybackForward(nextMsecs);
+    const VstSequencer::EventSpan events = m_sequencer.movePlaybackForward(nextMsecs);
 
     samples_t sampleOffset = 0;
     samples_t processedSamples = 0;
 
-    for (auto it = sequences.cbegin(); it != sequences.cend(); ++it) {
+    events.forEachGroup([&](const VstSequencer::TimedEvent* begin, const VstSequencer::TimedEvent* end, msecs_t duration, bool isLast) {
         samples_t durationInSamples = samplesPerChannel - sampleOffset;
 
-        auto nextIt = std::next(it);
-        if (nextIt != sequences.cend()) {
-            msecs_t duration = nextIt->first - it->first;
+        if (!isLast) {
             durationInSamples = microSecsToSamples(duration, m_sampleRate);
         }
 
         IF_ASSERT_FAILED(sampleOffset + durationInSamples <= samplesPerChannel) {
-            break;
+            return false;
+        }
+
+        handleSequenceEvents(begin, end);
+
+        if (durationInSamples > 0) {
+            processedSamples += render(sampleOffset, durationInSamples);
         }
 
-        processedSamples += processSequence(it->second, durationInSamples, buffer + sampleOffset * m_audioChannelsCount);
         sampleOffset += durationInSamples;
-    }
+        return true;
+    });
 
     return processedSamples;
 }
 
-samples_t VstSynthesiser::processSequence(const VstSequencer::EventSequence& sequence, const samples_t samples, float* buffer)
+void VstSynthesiser::handleSequenceEvents(const VstSequencer::TimedEvent* begin, const VstSequencer::TimedEvent* end)
 {
-    for (const VstSequencer::EventType& event : sequence) {
+    for (const VstSequencer::TimedEvent* it = begin; it != end; ++it) {
+        const VstSequencer::EventType& event = it->event;
+
         if (std::holds_alternative<VstEvent>(event)) {
             m_vstAudioClient->handleEvent(std::get<VstEvent>(event));
         } else if (std::holds_alternative<ParamChangeEvent>(event)) {
@@ -240,10 +281,4 @@ samples_t VstSynthesiser::processSequence(const VstSequencer::EventSequence& seq
             m_vstAudioClient->setVolumeGain(newGain);
         }
     }
-
-    if (samples == 0) {
-        return 0;
-    }
-
-    return m_vstAudioClient->process(buffer, samples, m_sequencer.playbackPosition());
 }
@@ -23,7 +23,9 @@
 #ifndef MUSE_VST_VSTSYNTHESISER_H
 #define MUSE_VST_VSTSYNTHESISER_H
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "audio/internal/abstractsynthesizer.h"
 #include "audio/iaudioconfiguration.h"
@@ -72,10 +74,17 @@ public:
     unsigned int audioChannelsCount() const override;
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
     muse::audio::samples_t process(float* buffer, muse::audio::samples_t samplesPerChannel) override;
+    bool supportsPlanarProcessing() const override;
+    muse::audio::samples_t processPlanar(float* const* buffers, muse::audio::samples_t samplesPerChannel) override;
+    bool isReady() const override;
 
 private:
     void toggleVolumeGain(const bool isActive);
-    audio::samples_t processSequence(const VstSequencer::EventSequence& sequence, const audio::samples_t samples, float* buffer);
+
+    //! NOTE Splits the block at the events, render(sampleOffset, samples) is called for every part
+    template<typename Render>
+    audio::samples_t processEvents(const audio::samples_t samplesPerChannel, Render render);
+    void handleSequenceEvents(const VstSequencer::TimedEvent* begin, const VstSequencer::TimedEvent* end);
 
     IVstPluginInstancePtr m_pluginPtr = nullptr;
     std::unique_ptr<VstAudioClient> m_vstAudioClient = nullptr;
@@ -83,11 +92,14 @@ private:
     unsigned int m_audioChannelsCount = 2;
     async::Channel<unsigned int> m_streamsCountChanged;
 
+    std::vector<float*> m_planarParts;
+
     VstSequencer m_sequencer;
 
     muse::audio::TrackId m_trackId = muse::audio::INVALID_TRACK_ID;
 
     bool m_useDynamicEvents = false;
+    std::atomic<bool> m_isReady = false;
 };
 
 using VstSynthPtr = std::shared_ptr<VstSynthesiser>;
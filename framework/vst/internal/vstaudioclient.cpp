@@ -21,6 +21,8 @@
  */
 #include "vstaudioclient.h"
 
+#include <algorithm>
+
 #include "log.h"
 
 using namespace muse;
@@ -115,6 +117,19 @@ void VstAudioClient::setVolumeGain(const muse::audio::gain_t newVolumeGain)
 
 muse::audio::samples_t VstAudioClient::process(float* output, muse::audio::samples_t samplesPerChannel,
                                                muse::audio::msecs_t playbackPosition)
+{
+    return doProcess(output, samplesPerChannel, playbackPosition);
+}
+
+muse::audio::samples_t VstAudioClient::processPlanar(float* const* output, muse::audio::samples_t samplesPerChannel,
+                                                     muse::audio::msecs_t playbackPosition)
+{
+    return doProcess(output, samplesPerChannel, playbackPosition);
+}
+
+template<typename Output>
+muse::audio::samples_t VstAudioClient::doProcess(Output output, muse::audio::samples_t samplesPerChannel,
+                                                 muse::audio::msecs_t playbackPosition)
 {
     IAudioProcessorPtr processor = pluginProcessor();
     if (!processor || !output) {
@@ -407,6 +422,21 @@ void VstAudioClient::extractInputSamples(samples_t sampleCount, const float* sou
     }
 }
 
+void VstAudioClient::extractInputSamples(samples_t sampleCount, const float* const* sourceBuffers)
+{
+    if (!m_processData.inputs || !sourceBuffers) {
+        return;
+    }
+
+    Steinberg::Vst::AudioBusBuffers& bus = m_processData.inputs[0];
+    const audioch_t channelsCount = std::min<audioch_t>(bus.numChannels, m_audioChannelsCount);
+
+    for (audioch_t audioChannelIndex = 0; audioChannelIndex < channelsCount; ++audioChannelIndex) {
+        std::copy(sourceBuffers[audioChannelIndex], sourceBuffers[audioChannelIndex] + sampleCount,
+                  bus.channelBuffers32[audioChannelIndex]);
+    }
+}
+
 bool VstAudioClient::fillOutputBufferInstrument(samples_t sampleCount, float* output)
 {
     if (!m_processData.outputs) {
@@ -435,6 +465,35 @@ bool VstAudioClient::fillOutputBufferInstrument(samples_t sampleCount, float* ou
     return !isSilence;
 }
 
+bool VstAudioClient::fillOutputBufferInstrument(samples_t sampleCount, float* const* output)
+{
+    if (!m_processData.outputs) {
+        return false;
+    }
+
+    bool isSilence = true;
+
+    for (const int busIndex : m_activeOutputBusses) {
+        Steinberg::Vst::AudioBusBuffers bus = m_processData.outputs[busIndex];
+        const audioch_t channelsCount = std::min<audioch_t>(bus.numChannels, m_audioChannelsCount);
+
+        for (audioch_t audioChannelIndex = 0; audioChannelIndex < channelsCount; ++audioChannelIndex) {
+            const float* source = bus.channelBuffers32[audioChannelIndex];
+            float* destination = output[audioChannelIndex];
+
+            if (isSilence) {
+                isSilence = std::all_of(source, source + sampleCount, [](float sample) { return sample == 0.f; });
+            }
+
+            for (samples_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex) {
+                destination[sampleIndex] += source[sampleIndex] * m_volumeGain;
+            }
+        }
+    }
+
+    return !isSilence;
+}
+
 bool VstAudioClient::fillOutputBufferFx(samples_t sampleCount, float* output)
 {
     if (!m_processData.outputs) {
@@ -463,6 +522,35 @@ bool VstAudioClient::fillOutputBufferFx(samples_t sampleCount, float* output)
     return !isSilence;
 }
 
+bool VstAudioClient::fillOutputBufferFx(samples_t sampleCount, float* const* output)
+{
+    if (!m_processData.outputs) {
+        return false;
+    }
+
+    bool isSilence = true;
+
+    for (const int busIndex : m_activeOutputBusses) {
+        Steinberg::Vst::AudioBusBuffers bus = m_processData.outputs[busIndex];
+        const audioch_t channelsCount = std::min<audioch_t>(bus.numChannels, m_audioChannelsCount);
+
+        for (audioch_t audioChannelIndex = 0; audioChannelIndex < channelsCount; ++audioChannelIndex) {
+            const float* source = bus.channelBuffers32[audioChannelIndex];
+            float* destination = output[audioChannelIndex];
+
+            if (isSilence) {
+                isSilence = std::all_of(source, source + sampleCount, [](float sample) { return sample == 0.f; });
+            }
+
+            for (samples_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex) {
+                destination[sampleIndex] = source[sampleIndex] * m_volumeGain;
+            }
+        }
+    }
+
+    return !isSilence;
+}
+
 void VstAudioClient::ensureActivity()
 {
     if (m_isActive) {
@@ -44,6 +44,10 @@ public:
 
     muse::audio::samples_t process(float* output, muse::audio::samples_t samplesPerChannel, muse::audio::msecs_t playbackPosition = 0);
 
+    //! NOTE The plugin buses are planar, so one buffer per audio channel is exchanged without transposing
+    muse::audio::samples_t processPlanar(float* const* output, muse::audio::samples_t samplesPerChannel,
+                                         muse::audio::msecs_t playbackPosition = 0);
+
     void flush();
     void allNotesOff();
 
@@ -70,10 +74,16 @@ private:
 
     void setUpProcessData();
     void updateProcessSetup();
+    template<typename Output>
+    muse::audio::samples_t doProcess(Output output, muse::audio::samples_t samplesPerChannel, muse::audio::msecs_t playbackPosition);
+
     void extractInputSamples(muse::audio::samples_t sampleCount, const float* sourceBuffer);
+    void extractInputSamples(muse::audio::samples_t sampleCount, const float* const* sourceBuffers);
 
     bool fillOutputBufferInstrument(muse::audio::samples_t sampleCount, float* output);
+    bool fillOutputBufferInstrument(muse::audio::samples_t sampleCount, float* const* output);
     bool fillOutputBufferFx(muse::audio::samples_t sampleCount, float* output);
+    bool fillOutputBufferFx(muse::audio::samples_t sampleCount, float* const* output);
 
     void ensureActivity();
     void disableActivity();